@@ -0,0 +1,142 @@
+#ifndef PICKC_BENCH_BENCH_UTILS_H_
+#define PICKC_BENCH_BENCH_UTILS_H_
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pickc/module_tree.h"
+
+// ベンチマークが共有するプロジェクトの生成と計測の補助。
+// 各ベンチマークは、作るプロジェクトの形だけを書く。
+namespace pickc::bench
+{
+  // プロジェクトのファイル。ソースディレクトリからの相対パスと内容。
+  using ProjectFiles = std::vector<std::pair<std::filesystem::path, std::string>>;
+
+  // pathにsourceを書き出す。ディレクトリがなければ作る。
+  inline void writeSource(const std::filesystem::path& path, const std::string& source)
+  {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream(path) << source;
+  }
+  // dirを作り直してfilesを書き出す。
+  inline void generateProject(const std::filesystem::path& dir, const ProjectFiles& files)
+  {
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    for(const auto& file : files) writeSource(dir / file.first, file.second);
+  }
+  inline std::string repeat(const std::string& text, size_t count)
+  {
+    std::string result;
+    result.reserve(text.size() * count);
+    for(size_t i = 0; i < count; ++i) result += text;
+    return result;
+  }
+
+  // computeのループの後に置く、結果を返す式。
+  inline const std::string COMPUTE_RESULT = "  if(total >= 100) { total - 100 } else { total }\n";
+  // whileでtotalをcount回更新してから返す関数compute<n>。
+  // loopはループの中の文、resultはループの後の文で、どちらも改行で終える。
+  inline std::string computeFunction(size_t n, const std::string& loop, const std::string& result = COMPUTE_RESULT, bool pub = false, const std::string& scaleType = "i32")
+  {
+    std::string source = pub ? "pub fn compute" : "fn compute";
+    source += std::to_string(n) + "(count: i32, scale: " + scaleType + "): i32 {\n";
+    source += "  mut total: i32 = 0;\n";
+    source += "  mut index: i32 = 0;\n";
+    source += "  while(index < count) {\n";
+    source += loop;
+    source += "    index += 1;\n";
+    source += "  };\n";
+    source += result;
+    source += "}\n";
+    return source;
+  }
+  // compute<n>をfunctions個並べ、mainからすべてを呼んで足す1ファイルのソース。
+  inline std::string computeProgram(size_t functions, const std::string& loop)
+  {
+    std::string source;
+    for(size_t n = 0; n < functions; ++n) source += computeFunction(n, loop);
+    source += "fn main(): i32 {\n  0";
+    for(size_t n = 0; n < functions; ++n) source += " + compute" + std::to_string(n) + "(1, 2)";
+    source += "\n}\n";
+    return source;
+  }
+
+  // モジュールmは10個ずつgroup<m / 10>に分けて置く。
+  inline std::string moduleName(size_t m)
+  {
+    return "bench::group" + std::to_string(m / 10) + "::module" + std::to_string(m);
+  }
+  inline std::filesystem::path modulePath(size_t m)
+  {
+    return std::filesystem::path("group" + std::to_string(m / 10)) / ("module" + std::to_string(m) + ".pick");
+  }
+  // importsのモジュールをimportし、compute0からそれぞれのcompute0を呼ぶモジュール。
+  // 最初の関数の引数scaleの型をscaleTypeにする。書き換えるとシグネチャが変わる。
+  inline std::string moduleSource(const std::vector<size_t>& imports, size_t functionsPerModule, const std::string& scaleType = "i32")
+  {
+    std::string source;
+    for(auto imp : imports) source += "import " + moduleName(imp) + ";\n";
+    const std::string loop = "    total += scale * 3 + 8 / (index + 1) - total % 7;\n";
+    for(size_t n = 0; n < functionsPerModule; ++n) {
+      std::string result;
+      if(n == 0) {
+        for(auto imp : imports) result += "  total += " + moduleName(imp) + "::compute0(count, 2);\n";
+      }
+      result += COMPUTE_RESULT;
+      source += computeFunction(n, loop, result, true, n == 0 ? scaleType : "i32");
+    }
+    return source;
+  }
+  // モジュールmをimportして、そのcompute0を呼ぶメインモジュール。
+  inline std::string mainSource(size_t m)
+  {
+    return "import " + moduleName(m) + ";\nfn main(): i32 {\n  " + moduleName(m) + "::compute0(1, 2)\n}\n";
+  }
+  // 各モジュールが1つ前のモジュールだけをimportする。
+  inline std::vector<size_t> chainImports(size_t m)
+  {
+    return m == 0 ? std::vector<size_t>{} : std::vector<size_t>{ m - 1 };
+  }
+  // modules個のモジュールをimportの鎖でつなぎ、最後のモジュールをメインモジュールから呼ぶ。
+  inline ProjectFiles chainProject(size_t modules, size_t functionsPerModule)
+  {
+    ProjectFiles files;
+    for(size_t m = 0; m < modules; ++m) files.emplace_back(modulePath(m), moduleSource(chainImports(m), functionsPerModule));
+    files.emplace_back("index.pick", mainSource(modules - 1));
+    return files;
+  }
+
+  // 木をサブモジュールごと解放する。
+  inline void deleteTree(ModuleTree* tree)
+  {
+    for(auto& sub : tree->submodules) deleteTree(sub.second);
+    delete tree;
+  }
+  template<typename T>
+  void printErrors(const T& errors)
+  {
+    for(const auto& err : errors) std::cerr << err << std::endl;
+  }
+  // fをiterations回実行し、最も短かった時間を秒で返す。
+  template<typename F>
+  double best(size_t iterations, F&& f)
+  {
+    double result = 0;
+    for(size_t i = 0; i < iterations; ++i) {
+      const auto start = std::chrono::steady_clock::now();
+      f();
+      const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      if(i == 0 || seconds < result) result = seconds;
+    }
+    return result;
+  }
+}
+
+#endif // PICKC_BENCH_BENCH_UTILS_H_
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <string>
+
+#include "parser/parser.h"
+#include "pickc/compiler_option.h"
+#include "bench/bench_utils.h"
+
+namespace
+{
+  // modules個のモジュールを10個ずつのディレクトリに分けて置いたプロジェクト。
+  pickc::bench::ProjectFiles project(size_t modules, size_t functionsPerModule)
+  {
+    using namespace pickc::bench;
+    const std::string loop = "    total += scale * 3 + 8 / (index + 1) << 1 | index & 7;\n";
+    const std::string result = "  if(total >= 100) { puts(1) } else { puts(0) };\n  return total;\n";
+    ProjectFiles files = { { "index.pick", "fn main(): i32 { 0 }\n" } };
+    for(size_t m = 0; m < modules; ++m) {
+      // 内容が同じファイルはキャッシュのエントリを共有するので、モジュールごとに中身を変える。
+      std::string source = "extern puts(str: i32): i32;\ndef module: i32 = " + std::to_string(m) + ";\n";
+      for(size_t n = 0; n < functionsPerModule; ++n) {
+        const auto id = std::to_string(n);
+        source += "// compute" + id + "はcount回の計算結果を返す。\n";
+        source += "def value" + id + ": i64 = " + id + "i64;\n";
+        source += computeFunction(n, loop, result);
+      }
+      files.emplace_back(modulePath(m), source);
+    }
+    return files;
+  }
+  bool parse(const pickc::CompilerOption& option, double& seconds)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    auto res = pickc::parser::Parser().parse(option);
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if(!res) {
+      pickc::bench::printErrors(res.err());
+      return false;
+    }
+    pickc::bench::deleteTree(res.get());
+    return true;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  size_t modules = 400;
+  size_t iterations = 3;
+  if(argc > 1) modules = std::stoul(argv[1]);
+  if(argc > 2) iterations = std::stoul(argv[2]);
+
+  const auto dir = std::filesystem::temp_directory_path() / "pickc_cache_bench";
+  const auto cacheDir = dir / "cache";
+  bench::generateProject(dir / "src", project(modules, 50));
+  std::cout << "Modules: " << modules + 1 << std::endl;
+
+  CompilerOption option;
+  option.projectName = "bench";
+  option.srcDir = (dir / "src").string();
+  option.numThreads = 1;
+  double none = 0, cold = 0, warm = 0, edited = 0;
+  for(size_t i = 0; i < iterations; ++i) {
+    double seconds;
+    option.cacheDir = "";
+    if(!parse(option, seconds)) return 1;
+    if(i == 0 || seconds < none) none = seconds;
+    // キャッシュが空の状態。構文解析に加えて書き込みの分だけ遅くなる。
+    std::filesystem::remove_all(cacheDir);
+    option.cacheDir = cacheDir.string();
+    if(!parse(option, seconds)) return 1;
+    if(i == 0 || seconds < cold) cold = seconds;
+    if(!parse(option, seconds)) return 1;
+    if(i == 0 || seconds < warm) warm = seconds;
+    // 1ファイルだけ書き換えた状態
+    std::ofstream(dir / "src" / "group0" / "module0.pick", std::ios::app) << "fn edited" << i << "(): i32 { " << i << " }\n";
+    if(!parse(option, seconds)) return 1;
+    if(i == 0 || seconds < edited) edited = seconds;
+  }
+  std::cout << "  no cache: " << none * 1000 << " ms" << std::endl;
+  std::cout << "  cold:     " << cold * 1000 << " ms" << std::endl;
+  std::cout << "  warm:     " << warm * 1000 << " ms (x" << none / warm << ")" << std::endl;
+  std::cout << "  1 edited: " << edited * 1000 << " ms" << std::endl;
+  std::filesystem::remove_all(dir);
+  return 0;
+}
\ No newline at end of file
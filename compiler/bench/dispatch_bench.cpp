@@ -0,0 +1,89 @@
+#include <iostream>
+#include <filesystem>
+#include <chrono>
+#include <string>
+
+#include "parser/parser.h"
+#include "pcir/semantic_analyzer.h"
+#include "bundler/bundler.h"
+#include "windows_x64/compiler.h"
+#include "pickc/compiler_option.h"
+#include "bench/bench_utils.h"
+
+namespace
+{
+  // 命令の多い関数をfunctions個持つプロジェクトのソース。
+  // 意味解析とコード生成の命令ごとの分岐を測るので、PCIRとx64の両方が対応している演算だけを使う。
+  std::string projectSource(size_t functions, size_t statements)
+  {
+    const std::string statement =
+      "    total += scale * 3 + 8 / (index + 1) - total % 7;\n"
+      "    total -= -index * (scale - 2);\n";
+    return pickc::bench::computeProgram(functions, pickc::bench::repeat(statement, statements));
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  size_t functions = 200;
+  size_t statements = 20;
+  size_t iterations = 5;
+  if(argc > 1) functions = std::stoul(argv[1]);
+  if(argc > 2) statements = std::stoul(argv[2]);
+  if(argc > 3) iterations = std::stoul(argv[3]);
+
+  const auto dir = std::filesystem::temp_directory_path() / "pickc_dispatch_bench";
+  bench::generateProject(dir / "src", { { "index.pick", projectSource(functions, statements) } });
+  CompilerOption option;
+  option.projectName = "bench";
+  option.mainModule = "bench";
+  option.out = "bench";
+  option.srcDir = (dir / "src").string();
+  option.outDir = (dir / "out").string();
+  option.numThreads = 1;
+  std::filesystem::create_directories(option.outDir);
+  std::cout << functions << " functions, " << statements * 2 << " statements per loop" << std::endl;
+
+  // 意味解析とPCIRの書き出し。構文解析は測らない。
+  double analyze = 0;
+  for(size_t i = 0; i < iterations; ++i) {
+    auto tree = parser::Parser().parse(option);
+    if(!tree) {
+      bench::printErrors(tree.err());
+      return 1;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    if(auto errs = pcir::SemanticAnalyzer(tree.get()).write(option)) {
+      bench::printErrors(errs.get());
+      return 1;
+    }
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    bench::deleteTree(tree.get());
+    if(i == 0 || seconds < analyze) analyze = seconds;
+  }
+  std::cout << "  semantic analysis: " << analyze * 1000 << " ms" << std::endl;
+
+  // 書き出したPCIRをまとめ、x64の命令選択だけを繰り返す。
+  auto bundle = bundler::Bundler().bundle(option);
+  if(!bundle) {
+    bench::printErrors(bundle.err());
+    return 1;
+  }
+  double codegen = 0;
+  for(size_t i = 0; i < iterations; ++i) {
+    // Compilerはバンドルを受け取ってしまうので、毎回計測の外でコピーを渡す。
+    auto input = bundle.get();
+    const auto start = std::chrono::steady_clock::now();
+    auto x64 = windows::x64::Compiler(std::move(input)).compile(option);
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if(!x64) {
+      bench::printErrors(x64.err());
+      return 1;
+    }
+    if(i == 0 || seconds < codegen) codegen = seconds;
+  }
+  std::cout << "  x64 codegen:       " << codegen * 1000 << " ms" << std::endl;
+  std::filesystem::remove_all(dir);
+  return 0;
+}
\ No newline at end of file
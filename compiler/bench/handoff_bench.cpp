@@ -0,0 +1,97 @@
+#include <iostream>
+#include <filesystem>
+#include <chrono>
+#include <string>
+
+#include "parser/parser.h"
+#include "pcir/semantic_analyzer.h"
+#include "pcir/pcir_struct.h"
+#include "pickc/compiler_option.h"
+#include "bench/bench_utils.h"
+
+namespace
+{
+  struct Measurement
+  {
+    double analyze;
+    double handoff;
+  };
+  // 意味解析と、その結果をPCIRFileとして受け取るまでを測る。
+  // inMemoryでなければ、以前のように<out>.pcirを書き出してから読み直す。
+  bool measure(const pickc::CompilerOption& option, bool inMemory, size_t iterations, Measurement& result)
+  {
+    using namespace pickc;
+    for(size_t i = 0; i < iterations; ++i) {
+      auto tree = parser::Parser().parse(option);
+      if(!tree) {
+        bench::printErrors(tree.err());
+        return false;
+      }
+      const auto start = std::chrono::steady_clock::now();
+      auto pcirBinary = pcir::SemanticAnalyzer(tree.get()).compile(option);
+      if(!pcirBinary) {
+        bench::printErrors(pcirBinary.err());
+        return false;
+      }
+      const auto analyzed = std::chrono::steady_clock::now();
+      const auto path = (std::filesystem::path(option.outDir) / (option.out + ".pcir")).string();
+      if(inMemory) {
+        auto file = pcir::PCIRLoader().load(path, pcirBinary.get()[0].binary);
+        if(!file) {
+          bench::printErrors(file.err());
+          return false;
+        }
+      }
+      else {
+        if(auto errs = pcir::SemanticAnalyzer::write(option, pcirBinary.get())) {
+          bench::printErrors(errs.get());
+          return false;
+        }
+        auto file = pcir::PCIRLoader().load(path);
+        if(!file) {
+          bench::printErrors(file.err());
+          return false;
+        }
+      }
+      const auto loaded = std::chrono::steady_clock::now();
+      bench::deleteTree(tree.get());
+      const auto analyze = std::chrono::duration<double>(analyzed - start).count();
+      const auto handoff = std::chrono::duration<double>(loaded - analyzed).count();
+      if(i == 0 || analyze < result.analyze) result.analyze = analyze;
+      if(i == 0 || handoff < result.handoff) result.handoff = handoff;
+    }
+    return true;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  size_t functions = 2000;
+  size_t statements = 10;
+  size_t iterations = 3;
+  if(argc > 1) functions = std::stoul(argv[1]);
+  if(argc > 2) statements = std::stoul(argv[2]);
+  if(argc > 3) iterations = std::stoul(argv[3]);
+
+  const auto dir = std::filesystem::temp_directory_path() / "pickc_handoff_bench";
+  // PCIRの大きさは関数の数と文の数にほぼ比例する。
+  const auto statement = "    total += scale * 3 + 8 / (index + 1) - total % 7;\n";
+  bench::generateProject(dir / "src", { { "index.pick", bench::computeProgram(functions, bench::repeat(statement, statements)) } });
+  CompilerOption option;
+  option.projectName = "bench";
+  option.mainModule = "bench";
+  option.out = "bench";
+  option.srcDir = (dir / "src").string();
+  option.outDir = (dir / "out").string();
+  option.numThreads = 1;
+  std::cout << functions << " functions, " << statements << " statements per loop" << std::endl;
+  for(bool inMemory : { false, true }) {
+    Measurement m{ 0, 0 };
+    if(!measure(option, inMemory, iterations, m)) return 1;
+    std::cout << "  " << (inMemory ? "in memory   " : "via .pcir   ") << ": semantic analysis " << m.analyze * 1000 << " ms, handoff " << m.handoff * 1000 << " ms" << std::endl;
+  }
+  std::cout << "  .pcir size: " << std::filesystem::file_size(dir / "out" / "bench.pcir") << " bytes" << std::endl;
+  std::filesystem::remove_all(dir);
+  return 0;
+}
\ No newline at end of file
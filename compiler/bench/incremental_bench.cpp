@@ -0,0 +1,124 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <string>
+
+#include "parser/parser.h"
+#include "pcir/semantic_analyzer.h"
+#include "bundler/bundler.h"
+#include "windows_x64/compiler.h"
+#include "windows_x64/linker.h"
+#include "pickc/compiler_option.h"
+#include "bench/bench_utils.h"
+
+namespace
+{
+  struct Timing
+  {
+    // 構文解析と意味解析
+    double front;
+    // リンクまで
+    double total;
+  };
+  bool build(const pickc::CompilerOption& option, Timing& timing)
+  {
+    using namespace pickc;
+    const auto start = std::chrono::steady_clock::now();
+    auto tree = parser::Parser().parse(option);
+    if(!tree) {
+      bench::printErrors(tree.err());
+      return false;
+    }
+    auto units = pcir::SemanticAnalyzer(tree.get()).compile(option);
+    if(!units) {
+      bench::printErrors(units.err());
+      return false;
+    }
+    const auto analyzed = std::chrono::steady_clock::now();
+    auto bundle = bundler::Bundler().bundle(option, units.get());
+    if(!bundle) {
+      bench::printErrors(bundle.err());
+      return false;
+    }
+    auto x64 = windows::x64::Compiler(std::move(bundle.get())).compile(option);
+    if(!x64) {
+      bench::printErrors(x64.err());
+      return false;
+    }
+    auto res = windows::x64::Linker(std::move(x64.get())).link(option);
+    if(!res) {
+      bench::printErrors(res.err());
+      return false;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    timing.front = std::chrono::duration<double>(analyzed - start).count();
+    timing.total = std::chrono::duration<double>(end - start).count();
+    return true;
+  }
+  void keepBest(Timing& best, const Timing& timing, size_t i)
+  {
+    if(i == 0 || timing.front < best.front) best.front = timing.front;
+    if(i == 0 || timing.total < best.total) best.total = timing.total;
+  }
+  void print(const char* name, const Timing& timing)
+  {
+    std::cout << "  " << name << timing.front * 1000 << " ms / " << timing.total * 1000 << " ms" << std::endl;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  size_t modules = 500;
+  size_t functionsPerModule = 10;
+  size_t iterations = 3;
+  if(argc > 1) modules = std::stoul(argv[1]);
+  if(argc > 2) functionsPerModule = std::stoul(argv[2]);
+  if(argc > 3) iterations = std::stoul(argv[3]);
+
+  const auto dir = std::filesystem::temp_directory_path() / "pickc_incremental_bench";
+  const auto srcDir = dir / "src";
+  const auto cacheDir = dir / "cache";
+  bench::generateProject(srcDir, bench::chainProject(modules, functionsPerModule));
+  std::cout << "Modules: " << modules + 1 << ", " << functionsPerModule << " functions per module" << std::endl;
+  std::cout << "  (parse + semantic analysis / total)" << std::endl;
+
+  CompilerOption option;
+  option.projectName = "bench";
+  option.mainModule = "bench";
+  option.out = "bench";
+  option.srcDir = srcDir.string();
+  option.outDir = (dir / "out").string();
+  option.numThreads = 1;
+  // 書き換えるのは依存の連鎖の中ほどにあるモジュール
+  const auto edited = modules / 2;
+  Timing none{}, cold{}, warm{}, body{}, signature{};
+  for(size_t i = 0; i < iterations; ++i) {
+    Timing timing;
+    option.cacheDir = "";
+    if(!build(option, timing)) return 1;
+    keepBest(none, timing, i);
+    std::filesystem::remove_all(cacheDir);
+    option.cacheDir = cacheDir.string();
+    if(!build(option, timing)) return 1;
+    keepBest(cold, timing, i);
+    if(!build(option, timing)) return 1;
+    keepBest(warm, timing, i);
+    // 関数の本体だけを書き換える。公開インターフェースは変わらないので、解析し直すのはこのモジュールだけ。
+    std::ofstream(srcDir / bench::modulePath(edited), std::ios::app) << "fn edited" << i << "(): i32 { " << i << " }\n";
+    if(!build(option, timing)) return 1;
+    keepBest(body, timing, i);
+    // 公開関数の引数の型を書き換える。importしているモジュールも解析し直す。
+    std::ofstream(srcDir / bench::modulePath(edited)) << bench::moduleSource(bench::chainImports(edited), functionsPerModule, i % 2 == 0 ? "i16" : "i32");
+    if(!build(option, timing)) return 1;
+    keepBest(signature, timing, i);
+  }
+  print("no cache:           ", none);
+  print("cold:               ", cold);
+  print("warm:               ", warm);
+  print("1 body edited:      ", body);
+  print("1 signature edited: ", signature);
+  std::filesystem::remove_all(dir);
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <atomic>
+
+#include "utils/interner.h"
+#include "utils/thread_pool.h"
+#include "bench/bench_utils.h"
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  size_t modules = 500;
+  size_t symbols = 50;
+  size_t iterations = 5;
+  if(argc > 1) modules = std::stoul(argv[1]);
+  if(argc > 2) symbols = std::stoul(argv[2]);
+  if(argc > 3) iterations = std::stoul(argv[3]);
+
+  std::vector<std::string> moduleNames;
+  std::vector<std::string> symbolNames;
+  for(size_t m = 0; m < modules; ++m) moduleNames.push_back("bench::group" + std::to_string(m / 10) + "::module" + std::to_string(m));
+  for(size_t s = 0; s < symbols; ++s) symbolNames.push_back("compute" + std::to_string(s));
+  std::cout << modules << " modules, " << symbols << " symbols per module (best of " << iterations << ")" << std::endl;
+
+  // 以前のように完全修飾名を文字列で連結し、文字列をキーにした表を引く。
+  // 宣言で名前を作り、テキストの集合と名前の表に入れ、参照のたびに同じ名前で表を引く。
+  size_t found = 0;
+  const auto stringTime = bench::best(iterations, [&] {
+    std::set<std::string> texts;
+    std::unordered_map<std::string, size_t> table;
+    for(size_t m = 0; m < modules; ++m) {
+      for(size_t s = 0; s < symbols; ++s) {
+        auto name = moduleNames[m] + "::" + symbolNames[s];
+        texts.insert(name);
+        table[name] = m * symbols + s;
+      }
+    }
+    for(size_t m = 0; m < modules; ++m) {
+      for(size_t s = 0; s < symbols; ++s) found += table.count(moduleNames[m] + "::" + symbolNames[s]);
+    }
+  });
+  // 同じことをAtomで行う。モジュール名とシンボル名はソースを読んだときに登録済みとする。
+  std::vector<Atom> moduleAtoms;
+  std::vector<Atom> symbolAtoms;
+  for(const auto& name : moduleNames) moduleAtoms.push_back(Atom::intern(name));
+  for(const auto& name : symbolNames) symbolAtoms.push_back(Atom::intern(name));
+  const auto atomTime = bench::best(iterations, [&] {
+    std::unordered_set<Atom> texts;
+    std::unordered_map<Atom, size_t> table;
+    for(size_t m = 0; m < modules; ++m) {
+      for(size_t s = 0; s < symbols; ++s) {
+        const auto name = Atom::join(moduleAtoms[m], symbolAtoms[s]);
+        texts.insert(name);
+        table[name] = m * symbols + s;
+      }
+    }
+    for(size_t m = 0; m < modules; ++m) {
+      for(size_t s = 0; s < symbols; ++s) found += table.count(Atom::join(moduleAtoms[m], symbolAtoms[s]));
+    }
+  });
+  std::cout << "  std::string keys: " << stringTime * 1000 << " ms" << std::endl;
+  std::cout << "  atoms:            " << atomTime * 1000 << " ms (x" << stringTime / atomTime << ")" << std::endl;
+
+  // 構文解析を並列に行ったときのように、複数のスレッドから同じ名前を登録する。
+  std::atomic<size_t> interned{ 0 };
+  for(size_t threads : { 1, 2, 4, 8 }) {
+    const auto seconds = bench::best(iterations, [&] {
+      ThreadPool pool(threads);
+      for(size_t t = 0; t < threads; ++t) {
+        pool.submit([&, t] {
+          size_t count = 0;
+          for(size_t m = t; m < modules; m += threads) {
+            for(const auto& name : symbolNames) count += Atom::intern(name).id != 0;
+            count += Atom::intern(moduleNames[m]).id != 0;
+          }
+          interned += count;
+        });
+      }
+      pool.wait();
+    });
+    std::cout << "  intern -j " << threads << ":     " << seconds * 1000 << " ms" << std::endl;
+  }
+  std::cout << "  (" << Interner::size() << " strings, " << Interner::bytes() << " bytes, " << found + interned << " lookups)" << std::endl;
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <filesystem>
+#include <chrono>
+#include <string>
+
+#include "parser/parser.h"
+#include "pcir/semantic_analyzer.h"
+#include "pickc/compiler_option.h"
+#include "bench/bench_utils.h"
+
+namespace
+{
+  // functions個の関数を持つlibと、そのうちused個だけを呼び出すメインモジュール。
+  pickc::bench::ProjectFiles project(size_t functions, size_t used)
+  {
+    using namespace pickc::bench;
+    std::string main = "import bench::lib;\nfn main(): i32 {\n  0";
+    for(size_t n = 0; n < used; ++n) main += " + bench::lib::compute" + std::to_string(n * (functions / used)) + "(1, 2)";
+    main += "\n}\n";
+    std::string lib;
+    for(size_t n = 0; n < functions; ++n) lib += computeFunction(n, "    total += scale * 3 + 8 / (index + 1);\n", COMPUTE_RESULT, true);
+    return { { "index.pick", main }, { "lib.pick", lib } };
+  }
+  struct Measurement
+  {
+    double parse;
+    double frontEnd;
+  };
+  // 構文解析からPCIRの書き出しまでを測る。
+  bool measure(pickc::CompilerOption& option, size_t iterations, Measurement& result)
+  {
+    using namespace pickc;
+    for(size_t i = 0; i < iterations; ++i) {
+      const auto start = std::chrono::steady_clock::now();
+      auto tree = parser::Parser().parse(option);
+      const auto parsed = std::chrono::steady_clock::now();
+      if(!tree) {
+        bench::printErrors(tree.err());
+        return false;
+      }
+      if(auto errs = pcir::SemanticAnalyzer(tree.get()).write(option)) {
+        bench::printErrors(errs.get());
+        return false;
+      }
+      const auto end = std::chrono::steady_clock::now();
+      bench::deleteTree(tree.get());
+      const auto parse = std::chrono::duration<double>(parsed - start).count();
+      const auto frontEnd = std::chrono::duration<double>(end - start).count();
+      if(i == 0 || parse < result.parse) result.parse = parse;
+      if(i == 0 || frontEnd < result.frontEnd) result.frontEnd = frontEnd;
+    }
+    return true;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  size_t functions = 2000;
+  size_t used = 5;
+  size_t iterations = 3;
+  if(argc > 1) functions = std::stoul(argv[1]);
+  if(argc > 2) used = std::stoul(argv[2]);
+  if(argc > 3) iterations = std::stoul(argv[3]);
+
+  const auto dir = std::filesystem::temp_directory_path() / "pickc_lazy_bench";
+  bench::generateProject(dir / "src", project(functions, used));
+  CompilerOption option;
+  option.projectName = "bench";
+  option.mainModule = "bench";
+  option.out = "bench";
+  option.srcDir = (dir / "src").string();
+  option.outDir = (dir / "out").string();
+  option.numThreads = 1;
+  std::cout << "lib: " << functions << " functions, main uses " << used << std::endl;
+  for(bool lazy : { false, true }) {
+    option.lazy = lazy;
+    Measurement m{ 0, 0 };
+    if(!measure(option, iterations, m)) return 1;
+    std::cout << "  " << (lazy ? "--lazy" : "eager ") << ": parse " << m.parse * 1000 << " ms, front end " << m.frontEnd * 1000 << " ms" << std::endl;
+  }
+  std::filesystem::remove_all(dir);
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <string>
+
+#include "parser/token.h"
+#include "parser/ast.h"
+#include "parser/scan.h"
+
+namespace
+{
+  // 字句解析器が扱う要素をひと通り含む関数を並べた合成ソースを生成する。
+  std::string generateCorpus(size_t bytes)
+  {
+    std::string corpus;
+    corpus.reserve(bytes + 512);
+    corpus += "import std::io;\n";
+    corpus += "extern puts(str: ptr<char>): i32;\n";
+    for(size_t n = 0; corpus.size() < bytes; ++n) {
+      const auto id = std::to_string(n);
+      corpus += "// function number " + id + "\n";
+      corpus += "pub def value" + id + ": i64 = " + id + "i64;\n";
+      corpus += "fn compute" + id + "(count: i32, scale: f64): f64 {\n";
+      corpus += "  mut total = 0.5e-3f64;\n";
+      corpus += "  mut index: u32 = 0u32;\n";
+      corpus += "  while(index < count) {\n";
+      corpus += "    total += scale * 1.25 + 3e8 / (index + 1);\n";
+      corpus += "    index += 1u32;\n";
+      corpus += "  };\n";
+      corpus += "  if(total >= 100.0f64) { puts(\"large " + id + "\\n\") } else { puts(\"small\") };\n";
+      corpus += "  return total;\n";
+      corpus += "}\n";
+    }
+    return corpus;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  size_t sizeMB = 8;
+  size_t iterations = 5;
+  if(argc > 1) sizeMB = std::stoul(argv[1]);
+  if(argc > 2) iterations = std::stoul(argv[2]);
+
+  const auto path = std::filesystem::temp_directory_path() / "pickc_lexer_bench.pick";
+  const auto corpus = generateCorpus(sizeMB * 1024 * 1024);
+  {
+    std::ofstream stream(path, std::ios::binary);
+    if(!stream) {
+      std::cerr << "ファイル " << path.string() << " が開けません。" << std::endl;
+      return 1;
+    }
+    stream.write(corpus.data(), corpus.size());
+  }
+
+  const auto megaBytes = static_cast<double>(corpus.size()) / (1024 * 1024);
+  std::cout << "Corpus:     " << megaBytes << " MB" << std::endl;
+  for(auto kernel : { parser::ScanKernel::Scalar, parser::ScanKernel::SSE2, parser::ScanKernel::AVX2 }) {
+    if(!parser::isScanKernelSupported(kernel)) continue;
+    parser::setScanKernel(kernel);
+    size_t numTokens = 0;
+    double best = 0;
+    for(size_t i = 0; i < iterations; ++i) {
+      const auto start = std::chrono::steady_clock::now();
+      auto res = parser::Tokenizer(path.string()).tokenize();
+      const auto end = std::chrono::steady_clock::now();
+      if(!res) {
+        for(const auto& err : res.err()) std::cerr << err << std::endl;
+        return 1;
+      }
+      numTokens = res.get().size();
+      const auto seconds = std::chrono::duration<double>(end - start).count();
+      if(i == 0 || seconds < best) best = seconds;
+    }
+    std::cout << '[' << parser::scanKernelName(kernel) << ']' << std::endl;
+    std::cout << "  Tokens:     " << numTokens << std::endl;
+    std::cout << "  Best time:  " << best * 1000 << " ms (" << iterations << " runs)" << std::endl;
+    std::cout << "  Throughput: " << megaBytes / best << " MB/s, " << numTokens / best << " tokens/s" << std::endl;
+  }
+
+  // 構文解析。字句解析の時間は含まない。
+  parser::setScanKernel(parser::bestScanKernel());
+  auto res = parser::Tokenizer(path.string()).tokenize();
+  if(!res) {
+    for(const auto& err : res.err()) std::cerr << err << std::endl;
+    return 1;
+  }
+  const auto& sequence = res.get();
+  double best = 0;
+  for(size_t i = 0; i < iterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    Arena arena;
+    auto ast = parser::ASTGenerator(sequence, arena).generate();
+    const auto end = std::chrono::steady_clock::now();
+    if(!ast) {
+      for(const auto& err : ast.err()) std::cerr << err << std::endl;
+      return 1;
+    }
+    const auto seconds = std::chrono::duration<double>(end - start).count();
+    if(i == 0 || seconds < best) best = seconds;
+  }
+  std::cout << "[parse]" << std::endl;
+  std::cout << "  Token size: " << parser::TokenSequence::bytesPerToken << " bytes/token, "
+    << static_cast<double>(sequence.size() * parser::TokenSequence::bytesPerToken) / (1024 * 1024) << " MB ("
+    << sequence.comments.size() << " comments kept aside)" << std::endl;
+  std::cout << "  Best time:  " << best * 1000 << " ms (" << iterations << " runs)" << std::endl;
+  std::cout << "  Throughput: " << megaBytes / best << " MB/s, " << sequence.size() / best << " tokens/s" << std::endl;
+  std::filesystem::remove(path);
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include <iostream>
+#include <filesystem>
+#include <chrono>
+#include <string>
+
+#include "parser/parser.h"
+#include "pickc/compiler_option.h"
+#include "utils/thread_pool.h"
+#include "bench/bench_utils.h"
+
+namespace
+{
+  // modules個のモジュールを10個ずつのディレクトリに分けて置いたプロジェクト。
+  pickc::bench::ProjectFiles project(size_t modules, size_t functionsPerModule)
+  {
+    using namespace pickc::bench;
+    const std::string loop = "    total += scale * 3 + 8 / (index + 1) << 1 | index & 7;\n";
+    const std::string result = "  if(total >= 100) { puts(1) } else { puts(0) };\n  return total;\n";
+    ProjectFiles files = { { "index.pick", "fn main(): i32 { 0 }\n" } };
+    for(size_t m = 0; m < modules; ++m) {
+      std::string source = "extern puts(str: i32): i32;\n";
+      for(size_t n = 0; n < functionsPerModule; ++n) {
+        const auto id = std::to_string(n);
+        source += "def value" + id + ": i64 = " + id + "i64;\n";
+        source += computeFunction(n, loop, result);
+      }
+      files.emplace_back(modulePath(m), source);
+    }
+    return files;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  size_t modules = 400;
+  size_t iterations = 3;
+  if(argc > 1) modules = std::stoul(argv[1]);
+  if(argc > 2) iterations = std::stoul(argv[2]);
+
+  const auto dir = std::filesystem::temp_directory_path() / "pickc_module_bench";
+  bench::generateProject(dir, project(modules, 50));
+  std::cout << "Modules:  " << modules + 1 << " (hardware threads: " << ThreadPool::hardwareThreads() << ")" << std::endl;
+
+  CompilerOption option;
+  option.projectName = "bench";
+  option.srcDir = dir.string();
+  double base = 0;
+  for(size_t threads : { 1, 2, 4, 8 }) {
+    option.numThreads = threads;
+    double best = 0;
+    for(size_t i = 0; i < iterations; ++i) {
+      const auto start = std::chrono::steady_clock::now();
+      auto res = parser::Parser().parse(option);
+      const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      if(!res) {
+        bench::printErrors(res.err());
+        return 1;
+      }
+      bench::deleteTree(res.get());
+      if(i == 0 || seconds < best) best = seconds;
+    }
+    if(threads == 1) base = best;
+    std::cout << "  -j " << threads << ": " << best * 1000 << " ms (x" << base / best << ")" << std::endl;
+  }
+  std::filesystem::remove_all(dir);
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include <iostream>
+#include <iomanip>
+#include <filesystem>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <thread>
+
+#include "parser/parser.h"
+#include "pcir/semantic_analyzer.h"
+#include "pickc/compiler_option.h"
+#include "utils/time_report.h"
+#include "bench/bench_utils.h"
+
+namespace
+{
+  // 生成するプロジェクトのimportの形。
+  struct Shape
+  {
+    const char* name;
+    // モジュールmがimportするモジュール。m未満の番号だけを返す。
+    std::vector<size_t> (*imports)(size_t m);
+  };
+  const Shape shapes[] = {
+    // 1つ前のモジュールだけをimportする。並列にできる部分はない。
+    { "chain", pickc::bench::chainImports },
+    // 二分木。親のモジュールをimportする。
+    { "tree", [](size_t m) { return m == 0 ? std::vector<size_t>{} : std::vector<size_t>{ (m - 1) / 2 }; } },
+    // 100個ずつの層に分け、1つ前の層の2つのモジュールをimportする。
+    { "layers", [](size_t m) { return m < 100 ? std::vector<size_t>{} : std::vector<size_t>{ m - 100, m - 100 - m % 100 + (m + 1) % 100 }; } },
+  };
+  pickc::bench::ProjectFiles project(const Shape& shape, size_t modules, size_t functionsPerModule)
+  {
+    using namespace pickc::bench;
+    ProjectFiles files;
+    for(size_t m = 0; m < modules; ++m) files.emplace_back(modulePath(m), moduleSource(shape.imports(m), functionsPerModule));
+    files.emplace_back("index.pick", mainSource(0));
+    return files;
+  }
+  struct Measurement
+  {
+    // 宣言と解析の経過時間
+    double wall;
+    // モジュールごとの解析の経過時間
+    std::unordered_map<std::string, double> modules;
+  };
+  // 構文解析の後、宣言と解析にかかった時間を測る。
+  bool measure(const pickc::CompilerOption& option, Measurement& result)
+  {
+    using namespace pickc;
+    auto tree = parser::Parser().parse(option);
+    if(!tree) {
+      bench::printErrors(tree.err());
+      return false;
+    }
+    TimeReport::reset();
+    TimeReport::enable();
+    auto units = pcir::SemanticAnalyzer(tree.get()).compile(option);
+    if(!units) {
+      bench::printErrors(units.err());
+      return false;
+    }
+    result.wall = 0;
+    result.modules.clear();
+    for(const auto& record : TimeReport::records()) {
+      if(record.phase != "declare" && record.phase != "analyze") continue;
+      if(record.item.empty()) result.wall += record.stats.wall;
+      else result.modules[record.item] = record.stats.wall;
+    }
+    TimeReport::reset();
+    bench::deleteTree(tree.get());
+    return true;
+  }
+  // 1スレッドで測ったモジュールごとの時間から、解析全体の時間と、importを辿った最長の経路の時間の比を求める。
+  // スレッドが十分にあるときに得られる速度向上の上限になる。
+  double parallelism(const Shape& shape, size_t modules, const Measurement& serial)
+  {
+    std::vector<double> finish(modules);
+    double total = 0, critical = 0;
+    for(size_t m = 0; m < modules; ++m) {
+      const auto itr = serial.modules.find(pickc::bench::moduleName(m));
+      const auto time = itr == serial.modules.end() ? 0.0 : itr->second;
+      double start = 0;
+      for(auto imp : shape.imports(m)) start = std::max(start, finish[imp]);
+      finish[m] = start + time;
+      total += time;
+      critical = std::max(critical, finish[m]);
+    }
+    return critical > 0 ? total / critical : 0;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  size_t modules = 1000;
+  size_t functionsPerModule = 10;
+  size_t iterations = 3;
+  if(argc > 1) modules = std::stoul(argv[1]);
+  if(argc > 2) functionsPerModule = std::stoul(argv[2]);
+  if(argc > 3) iterations = std::stoul(argv[3]);
+
+  const auto dir = std::filesystem::temp_directory_path() / "pickc_parallel_analysis_bench";
+  CompilerOption option;
+  option.projectName = "bench";
+  option.mainModule = "bench";
+  option.out = "bench";
+  option.srcDir = (dir / "src").string();
+  option.outDir = (dir / "out").string();
+  std::cout << "Modules: " << modules + 1 << ", " << functionsPerModule << " functions per module, hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+  std::cout << "  (declare + analyze, best of " << iterations << ")" << std::endl;
+  for(const auto& shape : shapes) {
+    bench::generateProject(dir / "src", project(shape, modules, functionsPerModule));
+    std::cout << shape.name << ":" << std::endl;
+    Measurement serial;
+    for(size_t numThreads : { 1, 2, 4, 8 }) {
+      option.numThreads = numThreads;
+      double best = 0;
+      for(size_t i = 0; i < iterations; ++i) {
+        Measurement m;
+        if(!measure(option, m)) return 1;
+        if(i == 0 || m.wall < best) {
+          best = m.wall;
+          if(numThreads == 1) serial = std::move(m);
+        }
+      }
+      std::cout << "  -j" << numThreads << ": " << std::fixed << std::setprecision(1) << best * 1000 << " ms, speedup "
+        << std::setprecision(2) << serial.wall / best << std::endl;
+    }
+    std::cout << "  parallelism (analyze time / critical path): " << std::setprecision(1) << parallelism(shape, modules, serial) << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+  }
+  std::filesystem::remove_all(dir);
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <new>
+
+#include "parser/token.h"
+#include "parser/ast.h"
+#include "utils/arena.h"
+
+namespace
+{
+  // 構文解析中のヒープ確保の回数を数える。
+  size_t numHeapAllocations = 0;
+}
+
+void* operator new(size_t size)
+{
+  ++numHeapAllocations;
+  if(auto p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+void operator delete(void* p, size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace
+{
+  // 長い二項演算の連なり。1 + 2 + ... + terms
+  std::string generateLongExpression(size_t terms)
+  {
+    std::string source = "fn main(): i32 {\n  1";
+    for(size_t i = 2; i <= terms; ++i) source += " + " + std::to_string(i % 100);
+    source += "\n}\n";
+    return source;
+  }
+  // 深く入れ子になったブロック。{ { ... 0 ... } }
+  std::string generateNestedBlocks(size_t depth)
+  {
+    std::string source = "fn main(): i32 ";
+    source.append(depth, '{');
+    source += " 0 ";
+    source.append(depth, '}');
+    source += "\n";
+    return source;
+  }
+  // 優先順位の異なる演算子を混ぜた式の文を並べる。
+  std::string generateExpressions(size_t statements)
+  {
+    std::string source = "fn main(): i32 {\n  mut x: i32 = 0;\n";
+    for(size_t n = 0; n < statements; n += 2) {
+      const auto id = std::to_string(n % 100);
+      source += "  x += x * " + id + " + (x - 1) / 3 % 7 << 2 | x & " + id + " ^ -x;\n";
+      source += "  x = x >= " + id + " && x != 0 || !(x < 5) == ~x > 1;\n";
+    }
+    source += "  x\n}\n";
+    return source;
+  }
+  // 小さな関数を並べたモジュール
+  std::string generateFunctions(size_t count)
+  {
+    std::string source = "extern puts(str: i32): i32;\n";
+    for(size_t n = 0; n < count; ++n) {
+      const auto id = std::to_string(n);
+      source += "def value" + id + ": i64 = " + id + "i64;\n";
+      source += "fn compute" + id + "(count: i32, scale: i32): i32 {\n";
+      source += "  mut total: i32 = 0;\n";
+      source += "  mut index: i32 = 0;\n";
+      source += "  while(index < count) {\n";
+      source += "    total += scale * 3 + 8 / (index + 1);\n";
+      source += "    index += 1;\n";
+      source += "  };\n";
+      source += "  if(total >= 100) { puts(1) } else { puts(0) };\n";
+      source += "  return total;\n";
+      source += "}\n";
+    }
+    return source;
+  }
+  struct Measurement
+  {
+    // 最短の時間(秒)
+    double parse;
+    double frontEnd;
+    // 1回の構文解析でのヒープとアリーナの確保回数
+    size_t heapAllocations;
+    size_t arenaAllocations;
+  };
+  // sourceを字句解析、構文解析し、ASTを解放するまでを測る。
+  // parseは構文解析だけ、frontEndは字句解析から解放までの時間。
+  bool measure(const std::string& source, size_t iterations, Measurement& result)
+  {
+    using namespace pickc;
+    const auto path = std::filesystem::temp_directory_path() / "pickc_parser_bench.pick";
+    {
+      std::ofstream stream(path, std::ios::binary);
+      stream.write(source.data(), source.size());
+    }
+    result = Measurement{ 0, 0, 0, 0 };
+    for(size_t i = 0; i < iterations; ++i) {
+      const auto start = std::chrono::steady_clock::now();
+      auto res = parser::Tokenizer(path.string()).tokenize();
+      if(!res) {
+        for(const auto& err : res.err()) std::cerr << err << std::endl;
+        return false;
+      }
+      double parse;
+      {
+        Arena arena;
+        const auto heapBefore = numHeapAllocations;
+        const auto parseStart = std::chrono::steady_clock::now();
+        auto ast = parser::ASTGenerator(res.get(), arena).generate();
+        parse = std::chrono::duration<double>(std::chrono::steady_clock::now() - parseStart).count();
+        result.heapAllocations = numHeapAllocations - heapBefore;
+        result.arenaAllocations = arena.allocationCount();
+        if(!ast) {
+          for(const auto& err : ast.err()) std::cerr << err << std::endl;
+          return false;
+        }
+      }
+      const auto frontEnd = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      if(i == 0 || parse < result.parse) result.parse = parse;
+      if(i == 0 || frontEnd < result.frontEnd) result.frontEnd = frontEnd;
+    }
+    std::filesystem::remove(path);
+    return true;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  size_t iterations = 5;
+  if(argc > 1) iterations = std::stoul(argv[1]);
+  Measurement m;
+
+  // 計算量が線形なら、要素数を倍にしたとき要素あたりの時間はほぼ変わらない。
+  std::cout << "[long expression]" << std::endl;
+  for(size_t terms : { 1250, 2500, 5000, 10000 }) {
+    if(!measure(generateLongExpression(terms), iterations, m)) return 1;
+    std::cout << "  " << terms << " terms: " << m.parse * 1000 << " ms, " << m.parse * 1e9 / terms << " ns/term" << std::endl;
+  }
+  std::cout << "[nested blocks]" << std::endl;
+  for(size_t depth : { 250, 500, 1000, 2000 }) {
+    if(!measure(generateNestedBlocks(depth), iterations, m)) return 1;
+    std::cout << "  depth " << depth << ": " << m.parse * 1000 << " ms, " << m.parse * 1e9 / depth << " ns/level" << std::endl;
+  }
+  std::cout << "[expressions]" << std::endl;
+  for(size_t statements : { 10000, 100000 }) {
+    if(!measure(generateExpressions(statements), iterations, m)) return 1;
+    std::cout << "  " << statements << " statements: " << m.parse * 1000 << " ms, " << m.parse * 1e9 / statements << " ns/statement" << std::endl;
+  }
+  std::cout << "[functions]" << std::endl;
+  for(size_t count : { 1000, 10000 }) {
+    if(!measure(generateFunctions(count), iterations, m)) return 1;
+    std::cout << "  " << count << " functions: parse " << m.parse * 1000 << " ms, front end " << m.frontEnd * 1000 << " ms" << std::endl;
+    std::cout << "    allocations: " << m.heapAllocations << " heap, " << m.arenaAllocations << " arena" << std::endl;
+  }
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include <iostream>
+#include <filesystem>
+#include <string>
+
+#include "parser/parser.h"
+#include "pcir/semantic_analyzer.h"
+#include "pcir/pcir_struct.h"
+#include "pickc/compiler_option.h"
+#include "utils/time_report.h"
+#include "bench/bench_utils.h"
+
+namespace
+{
+  // 1つの関数にstatements個の文を並べたプロジェクトを作る。文1つごとにレジスタが数個できる。
+  std::string projectSource(size_t statements)
+  {
+    std::string source;
+    source += "fn compute(count: i32, scale: i32): i32 {\n";
+    source += "  mut total: i32 = 0;\n";
+    for(size_t s = 0; s < statements; ++s) source += "  total += scale * 3 + count % 7;\n";
+    source += "  total\n";
+    source += "}\n";
+    source += "fn main(): i32 { compute(1, 2) }\n";
+    return source;
+  }
+  struct Measurement
+  {
+    double encode;
+    double analyze;
+    size_t registers;
+  };
+  bool measure(const pickc::CompilerOption& option, Measurement& result)
+  {
+    using namespace pickc;
+    TimeReport::reset();
+    TimeReport::enable();
+    auto tree = parser::Parser().parse(option);
+    if(!tree) {
+      bench::printErrors(tree.err());
+      return false;
+    }
+    auto units = pcir::SemanticAnalyzer(tree.get()).compile(option);
+    if(!units) {
+      bench::printErrors(units.err());
+      return false;
+    }
+    for(const auto& record : TimeReport::records()) {
+      if(!record.item.empty()) continue;
+      if(record.phase == "pcir encode") result.encode = record.stats.wall;
+      else if(record.phase == "analyze") result.analyze = record.stats.wall;
+    }
+    auto file = pcir::PCIRLoader().load("bench.pcir", units.get().front().binary);
+    if(!file) return false;
+    result.registers = 0;
+    for(const auto fn : file.get().fnSection) {
+      if(!pcir::PCIRLoader::loadBody(file.get(), fn)) return false;
+      result.registers += fn->regs.size();
+    }
+    return true;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  size_t iterations = 3;
+  if(argc > 1) iterations = std::stoul(argv[1]);
+
+  const auto dir = std::filesystem::temp_directory_path() / "pickc_pcir_encode_bench";
+  CompilerOption option;
+  option.projectName = "bench";
+  option.mainModule = "bench";
+  option.srcDir = dir.string();
+  option.numThreads = 1;
+  std::cout << "PCIR encode of one function (best of " << iterations << ")" << std::endl;
+  // 文1つで6個のレジスタができる。
+  for(size_t registers : { 10000, 25000, 50000, 100000 }) {
+    bench::generateProject(dir, { { "index.pick", projectSource(registers / 6) } });
+    Measurement best{};
+    for(size_t i = 0; i < iterations; ++i) {
+      Measurement m{};
+      if(!measure(option, m)) {
+        std::cerr << "build failed" << std::endl;
+        return 1;
+      }
+      if(i == 0 || m.encode < best.encode) best.encode = m.encode;
+      if(i == 0 || m.analyze < best.analyze) best.analyze = m.analyze;
+      best.registers = m.registers;
+    }
+    std::cout << "  " << best.registers << " registers: encode " << best.encode * 1000 << " ms ("
+      << best.encode * 1e9 / best.registers << " ns/register), analyze " << best.analyze * 1000 << " ms" << std::endl;
+  }
+  std::filesystem::remove_all(dir);
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include <iostream>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "parser/parser.h"
+#include "pcir/semantic_analyzer.h"
+#include "pcir/pcir_struct.h"
+#include "pickc/compiler_option.h"
+#include "utils/time_report.h"
+#include "bench/bench_utils.h"
+
+namespace
+{
+  // ライブラリに近い形として、引数と定数を使う算術、分岐、ほかの関数の呼び出しを持つ関数をfunctions個並べる。
+  std::string projectSource(size_t functions, size_t statements)
+  {
+    std::string source = "extern puts(s: ptr<i8>): i32;\n";
+    for(size_t n = 0; n < functions; ++n) {
+      const auto id = std::to_string(n);
+      source += "fn lib" + id + "(a: i32, b: i32): i32 {\n";
+      source += "  mut t: i32 = a;\n";
+      for(size_t s = 0; s < statements; ++s) {
+        const auto c = std::to_string(s * 7 + n % 13 + 1);
+        if(s % 4 == 3 && n > 0) source += "  t += lib" + std::to_string(n - 1) + "(t, " + c + ");\n";
+        else if(s % 4 == 2) source += "  if(t > " + c + ") { t -= b * " + c + "; } else { t += a % " + c + "; };\n";
+        else source += "  t += a * " + c + " + b;\n";
+      }
+      source += "  t\n";
+      source += "}\n";
+    }
+    source += "fn main(): i32 {\n";
+    source += "  puts(\"bench\");\n";
+    source += "  lib" + std::to_string(functions - 1) + "(1, 2)\n";
+    source += "}\n";
+    return source;
+  }
+  struct Measurement
+  {
+    size_t size;
+    size_t bodies;
+    double encode;
+    double decode;
+  };
+  bool measure(pickc::CompilerOption& option, pickc::PCIREncoding encoding, size_t iterations, Measurement& result)
+  {
+    using namespace pickc;
+    option.pcirEncoding = encoding;
+    BinaryVec binary;
+    for(size_t i = 0; i < iterations; ++i) {
+      TimeReport::reset();
+      TimeReport::enable();
+      auto tree = parser::Parser().parse(option);
+      if(!tree) {
+        bench::printErrors(tree.err());
+        return false;
+      }
+      auto units = pcir::SemanticAnalyzer(tree.get()).compile(option);
+      if(!units) {
+        bench::printErrors(units.err());
+        return false;
+      }
+      for(const auto& record : TimeReport::records()) {
+        if(record.item.empty() && record.phase == "pcir encode" && (i == 0 || record.stats.wall < result.encode)) result.encode = record.stats.wall;
+      }
+      binary = std::move(units.get().front().binary);
+    }
+    result.size = binary.size();
+    // バンドラと同じく、ファイルを読み込んで全関数の本体を読み、読んだ本体は解放する。
+    bool loaded = true;
+    result.decode = bench::best(iterations, [&] {
+      auto file = pcir::PCIRLoader().load("bench.pcir", binary);
+      if(!file) {
+        loaded = false;
+        return;
+      }
+      result.bodies = 0;
+      for(auto fn : file.get().fnSection) {
+        if(!pcir::PCIRLoader::loadBody(file.get(), fn)) loaded = false;
+        result.bodies += fn->bodyLoaded;
+        fn->releaseBody();
+      }
+    });
+    return loaded;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  size_t functions = 20000;
+  size_t iterations = 3;
+  if(argc > 1) functions = std::stoul(argv[1]);
+  if(argc > 2) iterations = std::stoul(argv[2]);
+  if(functions == 0) functions = 1;
+
+  const auto dir = std::filesystem::temp_directory_path() / "pickc_pcir_encoding_bench";
+  bench::generateProject(dir, { { "index.pick", projectSource(functions, 12) } });
+  CompilerOption option;
+  option.projectName = "bench";
+  option.mainModule = "bench";
+  option.srcDir = dir.string();
+  option.numThreads = 1;
+  const std::pair<PCIREncoding, const char*> encodings[] = {
+    { PCIREncoding::Fixed, "fixed " },
+    { PCIREncoding::Varint, "varint" },
+    { PCIREncoding::VarintLZ, "lz    " },
+  };
+  std::cout << "PCIR of " << functions << " functions (best of " << iterations << ")" << std::endl;
+  Measurement fixed{};
+  for(const auto& encoding : encodings) {
+    Measurement m{};
+    if(!measure(option, encoding.first, iterations, m)) {
+      std::cerr << "build failed" << std::endl;
+      return 1;
+    }
+    if(encoding.first == PCIREncoding::Fixed) fixed = m;
+    std::cout << "  " << encoding.second << ": " << m.size / 1024 << " KiB (x" << static_cast<double>(m.size) / fixed.size
+      << "), encode " << m.encode * 1000 << " ms, load + decode " << m.bodies << " bodies " << m.decode * 1000 << " ms ("
+      << m.size / m.decode / (1024 * 1024) << " MiB/s of PCIR)" << std::endl;
+  }
+  std::filesystem::remove_all(dir);
+  return 0;
+}
\ No newline at end of file
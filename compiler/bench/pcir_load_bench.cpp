@@ -0,0 +1,143 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "parser/parser.h"
+#include "pcir/semantic_analyzer.h"
+#include "pcir/pcir_struct.h"
+#include "pcir/pcir_format.h"
+#include "pcir/pcir_code.h"
+#include "pickc/compiler_option.h"
+#include "bench/bench_utils.h"
+
+namespace
+{
+  // 本体に文をstatements個ずつ持つ関数をfunctions個並べ、mainからはそのうちreachable個だけを呼ぶ。
+  std::string projectSource(size_t functions, size_t reachable, size_t statements)
+  {
+    std::string source;
+    for(size_t n = 0; n < functions; ++n) {
+      source += "fn lib" + std::to_string(n) + "(a: i32): i32 {\n";
+      source += "  mut t: i32 = a;\n";
+      for(size_t s = 0; s < statements; ++s) source += "  t += a * 3 + " + std::to_string(s) + ";\n";
+      source += "  t\n";
+      source += "}\n";
+    }
+    source += "fn main(): i32 {\n";
+    source += "  mut r: i32 = 0;\n";
+    for(size_t n = 0; n < reachable; ++n) source += "  r += lib" + std::to_string(n * (functions / reachable)) + "(1);\n";
+    source += "  r\n";
+    source += "}\n";
+    return source;
+  }
+  // バンドラと同じように、シンボルの初期化関数を読み、LoadFnで指している本体も読む。
+  size_t loadSymbol(const pickc::pcir::PCIRFile& file, pickc::pcir::SymbolSection* symbol)
+  {
+    using namespace pickc;
+    auto init = symbol->init;
+    if(!pcir::PCIRLoader::loadBody(file, init)) return 0;
+    const auto& code = init->entryFlow->code;
+    if(code.size() < 9 || code[0] != pcir::LoadFn) return 1;
+    size_t i = 0;
+    get32(code, i);
+    auto fn = get32(code, i);
+    if(fn >= file.fnSection.size() || !pcir::PCIRLoader::loadBody(file, file.fnSection[fn])) return 1;
+    return 2;
+  }
+  void release(const pickc::pcir::PCIRFile& file)
+  {
+    for(auto fn : file.fnSection) fn->releaseBody();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  size_t functions = 20000;
+  size_t reachable = 200;
+  size_t iterations = 3;
+  if(argc > 1) functions = std::stoul(argv[1]);
+  if(argc > 2) reachable = std::stoul(argv[2]);
+  if(argc > 3) iterations = std::stoul(argv[3]);
+  if(reachable == 0 || reachable > functions) reachable = functions;
+
+  const auto dir = std::filesystem::temp_directory_path() / "pickc_pcir_load_bench";
+  bench::generateProject(dir, { { "index.pick", projectSource(functions, reachable, 8) } });
+  CompilerOption option;
+  option.projectName = "bench";
+  option.mainModule = "bench";
+  option.srcDir = dir.string();
+  option.numThreads = 1;
+  auto tree = parser::Parser().parse(option);
+  if(!tree) {
+    bench::printErrors(tree.err());
+    return 1;
+  }
+  auto units = pcir::SemanticAnalyzer(tree.get()).compile(option);
+  if(!units) {
+    bench::printErrors(units.err());
+    return 1;
+  }
+  const auto path = (dir / "bench.pcir").string();
+  const auto& binary = units.get().front().binary;
+  std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(binary.data()), binary.size());
+  // 版を0.0に書き換えると、ローダーは関数の位置の表とシンボルの索引を使わずに読む。
+  const auto noIndexPath = (dir / "bench.noindex.pcir").string();
+  auto noIndex = binary;
+  noIndex[14] = noIndex[15] = 0;
+  std::ofstream(noIndexPath, std::ios::binary).write(reinterpret_cast<const char*>(noIndex.data()), noIndex.size());
+
+  // mainから呼ぶ関数の名前。バンドラが到達できる関数だけを求める代わりに使う。
+  std::vector<std::string> usedNames{ "bench::main" };
+  for(size_t n = 0; n < reachable; ++n) usedNames.push_back("bench::lib" + std::to_string(n * (functions / reachable)));
+
+  // 関数の位置の表がなければ、関数の本体を読み飛ばしながら関数の表を辿る。
+  const auto loadTime = [&](const std::string& file) {
+    return bench::best(iterations, [&] { pcir::PCIRLoader().load(file); });
+  };
+  // 索引がなければ、シンボルを名前で引くたびにモジュールを順に探す。
+  size_t found = 0;
+  const auto findTime = [&](const std::string& file) {
+    auto loaded = pcir::PCIRLoader().load(file);
+    if(!loaded) return 0.0;
+    return bench::best(iterations, [&] {
+      found = 0;
+      for(const auto& name : usedNames) found += pcir::PCIRLoader::findSymbol(loaded.get(), name) != nullptr;
+    });
+  };
+  const auto loadNoIndex = loadTime(noIndexPath);
+  const auto loadIndex = loadTime(path);
+  const auto findNoIndex = findTime(noIndexPath);
+  const auto findIndex = findTime(path);
+
+  size_t eagerBodies = 0;
+  const auto eager = bench::best(iterations, [&] {
+    auto file = pcir::PCIRLoader().load(path);
+    if(!file) return;
+    eagerBodies = 0;
+    for(auto fn : file.get().fnSection) eagerBodies += static_cast<bool>(pcir::PCIRLoader::loadBody(file.get(), fn));
+    release(file.get());
+  });
+  size_t lazyBodies = 0;
+  const auto lazy = bench::best(iterations, [&] {
+    auto file = pcir::PCIRLoader().load(path);
+    if(!file) return;
+    lazyBodies = 0;
+    for(const auto& name : usedNames) {
+      if(auto symbol = pcir::PCIRLoader::findSymbol(file.get(), name)) lazyBodies += loadSymbol(file.get(), symbol);
+    }
+    release(file.get());
+  });
+  std::cout << functions << " functions, " << reachable << " reachable from main, "
+    << binary.size() / 1024 << " KiB of PCIR (best of " << iterations << ")" << std::endl;
+  std::cout << "  load + decode every body:    " << eager * 1000 << " ms (" << eagerBodies << " bodies)" << std::endl;
+  std::cout << "  load + decode reachable:     " << lazy * 1000 << " ms (" << lazyBodies << " bodies, x" << eager / lazy << ")" << std::endl;
+  std::cout << "  load, PCIR 0.0 (no index):   " << loadNoIndex * 1000 << " ms" << std::endl;
+  std::cout << "  load, indexed:               " << loadIndex * 1000 << " ms (x" << loadNoIndex / loadIndex << ")" << std::endl;
+  std::cout << "  find " << usedNames.size() << " symbols, 0.0:       " << findNoIndex * 1000 << " ms" << std::endl;
+  std::cout << "  find " << usedNames.size() << " symbols, indexed:   " << findIndex * 1000 << " ms (x" << findNoIndex / findIndex << ", " << found << " found)" << std::endl;
+  std::filesystem::remove_all(dir);
+  return 0;
+}
\ No newline at end of file
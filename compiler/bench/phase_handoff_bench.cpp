@@ -0,0 +1,147 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parser/parser.h"
+#include "pcir/semantic_analyzer.h"
+#include "bundler/bundler.h"
+#include "windows_x64/compiler.h"
+#include "windows_x64/linker.h"
+#include "pickc/compiler_option.h"
+#include "utils/time_report.h"
+#include "bench/bench_utils.h"
+
+namespace
+{
+  // 以前のインターフェースがフェーズの境界で行っていたコピーを再現する。
+  // ok()は値を3回コピーしていた。受け取る側がメンバにコピーしたものは、元の値と一緒に最後まで残っていた。
+  class Copies
+  {
+    std::vector<std::shared_ptr<const void>> retained;
+  public:
+    size_t count = 0;
+    double seconds = 0;
+    template<typename T>
+    void make(const T& value, bool retain)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      for(int i = 0; i < 3; ++i) {
+        auto copy = std::make_shared<const T>(value);
+        ++count;
+      }
+      if(retain) {
+        retained.push_back(std::make_shared<const T>(value));
+        ++count;
+      }
+      seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+  };
+  // 構文解析からリンクまでを1回行い、経過時間とピークRSSをresultPathに書く。
+  int runChild(bool copy, const pickc::CompilerOption& option, const std::string& resultPath)
+  {
+    using namespace pickc;
+    Copies copies;
+    const auto start = std::chrono::steady_clock::now();
+    auto tree = parser::Parser().parse(option);
+    if(!tree) {
+      bench::printErrors(tree.err());
+      return 1;
+    }
+    auto units = pcir::SemanticAnalyzer(tree.get()).compile(option);
+    if(!units) {
+      bench::printErrors(units.err());
+      return 1;
+    }
+    if(copy) copies.make(units.get(), false);
+    auto bundle = bundler::Bundler().bundle(option, units.get());
+    if(!bundle) {
+      bench::printErrors(bundle.err());
+      return 1;
+    }
+    if(copy) copies.make(bundle.get(), true);
+    auto x64 = windows::x64::Compiler(std::move(bundle.get())).compile(option);
+    if(!x64) {
+      bench::printErrors(x64.err());
+      return 1;
+    }
+    if(copy) copies.make(x64.get(), true);
+    auto res = windows::x64::Linker(std::move(x64.get())).link(option);
+    if(!res) {
+      bench::printErrors(res.err());
+      return 1;
+    }
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::ofstream(resultPath) << seconds << ' ' << TimeReport::processPeakRSS() << ' ' << copies.count << ' ' << copies.seconds;
+    return 0;
+  }
+  struct Measurement
+  {
+    double seconds;
+    uint64_t peakRSS;
+    size_t copies;
+    double copySeconds;
+  };
+  // ピークRSSを比べるため、それぞれの計測は別のプロセスで行う。
+  bool measure(const std::string& self, const char* mode, const std::filesystem::path& dir, Measurement& result)
+  {
+    const auto resultPath = (dir / "result.txt").string();
+    std::filesystem::remove(resultPath);
+    const auto command = "\"" + self + "\" --child " + mode + " \"" + dir.string() + "\"";
+    if(std::system(command.c_str()) != 0) return false;
+    std::ifstream file(resultPath);
+    return static_cast<bool>(file >> result.seconds >> result.peakRSS >> result.copies >> result.copySeconds);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  CompilerOption option;
+  option.projectName = "bench";
+  option.mainModule = "bench";
+  option.out = "bench";
+  option.numThreads = 1;
+  if(argc == 4 && std::string(argv[1]) == "--child") {
+    const std::filesystem::path dir(argv[3]);
+    option.srcDir = (dir / "src").string();
+    option.outDir = (dir / "out").string();
+    return runChild(std::string(argv[2]) == "copy", option, (dir / "result.txt").string());
+  }
+  size_t functions = 2000;
+  size_t statements = 20;
+  size_t iterations = 3;
+  if(argc > 1) functions = std::stoul(argv[1]);
+  if(argc > 2) statements = std::stoul(argv[2]);
+  if(argc > 3) iterations = std::stoul(argv[3]);
+
+  const auto dir = std::filesystem::temp_directory_path() / "pickc_phase_handoff_bench";
+  // フェーズの間で受け渡す構造の大きさは関数の数と文の数にほぼ比例する。
+  const auto statement = "    total += scale * 3 + 8 / (index + 1) - total % 7;\n";
+  bench::generateProject(dir / "src", { { "index.pick", bench::computeProgram(functions, bench::repeat(statement, statements)) } });
+  std::cout << functions << " functions, " << statements << " statements per loop" << std::endl;
+  std::cout << "  (parse to link in a fresh process, best of " << iterations << ")" << std::endl;
+  for(const auto mode : { "copy", "move" }) {
+    Measurement best{};
+    for(size_t i = 0; i < iterations; ++i) {
+      Measurement m;
+      if(!measure(argv[0], mode, dir, m)) {
+        std::cerr << "build failed" << std::endl;
+        return 1;
+      }
+      if(i == 0 || m.seconds < best.seconds) best.seconds = m.seconds;
+      if(i == 0 || m.peakRSS < best.peakRSS) best.peakRSS = m.peakRSS;
+      best.copies = m.copies;
+      best.copySeconds = m.copySeconds;
+    }
+    std::cout << "  " << (std::string(mode) == "copy" ? "copy at handoff (before)" : "move at handoff         ")
+      << ": " << best.seconds * 1000 << " ms, peak RSS " << best.peakRSS / (1024 * 1024) << " MiB, "
+      << best.copies << " whole-program copies (" << best.copySeconds * 1000 << " ms)" << std::endl;
+  }
+  std::filesystem::remove_all(dir);
+  return 0;
+}
\ No newline at end of file
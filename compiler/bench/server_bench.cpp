@@ -0,0 +1,96 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <vector>
+
+#include "pickc/config.h"
+#include "pickc/compiler_option.h"
+#include "pickc/driver.h"
+#include "pickc/server.h"
+#include "bench/bench_utils.h"
+
+namespace
+{
+  template<typename F>
+  double measure(F f)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    if(f() != pickc::STATUS_SUCCESS) {
+      std::cerr << "build failed" << std::endl;
+      std::exit(1);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+  void keepBest(double& best, double time, size_t i)
+  {
+    if(i == 0 || time < best) best = time;
+  }
+  void print(const char* name, double time)
+  {
+    std::cout << "  " << name << time * 1000 << " ms" << std::endl;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  size_t modules = 500;
+  size_t functionsPerModule = 10;
+  size_t iterations = 3;
+  if(argc > 1) modules = std::stoul(argv[1]);
+  if(argc > 2) functionsPerModule = std::stoul(argv[2]);
+  if(argc > 3) iterations = std::stoul(argv[3]);
+
+  const auto dir = std::filesystem::temp_directory_path() / "pickc_server_bench";
+  const auto srcDir = dir / "src";
+  // incremental_benchと同じプロジェクト。
+  bench::generateProject(srcDir, bench::chainProject(modules, functionsPerModule));
+  std::cout << "Modules: " << modules + 1 << ", " << functionsPerModule << " functions per module" << std::endl;
+  std::cout << "  (latency of a request to --server; compare with incremental_bench for a standalone pickc)" << std::endl;
+
+  // 同じプロセスで単体のビルドを繰り返すと、解放されない構造が溜まって後の計測が遅くなるので、ここでは要求だけを測る。
+  const std::vector<std::string> args = { "pickc", "-p", "bench", "-d", (dir / "out").string(), "-j", "1", srcDir.string() };
+  const auto edited = modules / 2;
+  // 1回のiterationで行うビルドは、無変更、本体の書き換え、シグネチャの書き換えの3つ。
+  const size_t buildsPerIteration = 3;
+
+  CompilerOption serverOption;
+  serverOption.server = (dir / "server.sock").string();
+  serverOption.cacheDir = (dir / "cache").string();
+  auto server = Server::open(serverOption);
+  if(!server) {
+    std::cerr << server.err() << std::endl;
+    return 1;
+  }
+  const auto request = [&] {
+    auto status = forwardToServer(serverOption.server, args);
+    return status ? status.get() : STATUS_SERVER_ERROR;
+  };
+  // コンパイルするのはメインスレッドにする。別スレッドではmallocのアリーナが変わり、pickc --serverと同じ条件にならない。
+  double cold = 0, resident = 0, warm = 0, body = 0, signature = 0;
+  std::thread client([&] {
+    // 最初の要求はディスクにもキャッシュがない。2回目は出力を作り直すが、キャッシュはすべてメモリから読む。
+    cold = measure(request);
+    std::filesystem::remove_all(dir / "out");
+    resident = measure(request);
+    for(size_t i = 0; i < iterations; ++i) {
+      keepBest(warm, measure(request), i);
+      std::ofstream(srcDir / bench::modulePath(edited), std::ios::app) << "fn edited" << i << "(): i32 { " << i << " }\n";
+      keepBest(body, measure(request), i);
+      std::ofstream(srcDir / bench::modulePath(edited)) << bench::moduleSource(bench::chainImports(edited), functionsPerModule, i % 2 == 0 ? "i16" : "i32");
+      keepBest(signature, measure(request), i);
+    }
+  });
+  for(size_t i = 0; i < 2 + iterations * buildsPerIteration; ++i) server.get().serveOne();
+  client.join();
+  print("cold:               ", cold);
+  print("output removed:     ", resident);
+  print("no change:          ", warm);
+  print("1 body edited:      ", body);
+  print("1 signature edited: ", signature);
+  std::filesystem::remove_all(dir);
+  return 0;
+}
\ No newline at end of file
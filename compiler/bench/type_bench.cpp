@@ -0,0 +1,95 @@
+#include <iostream>
+#include <filesystem>
+#include <string>
+
+#include "parser/parser.h"
+#include "pcir/semantic_analyzer.h"
+#include "pcir/type.h"
+#include "pickc/compiler_option.h"
+#include "utils/time_report.h"
+#include "bench/bench_utils.h"
+
+namespace
+{
+  // 関数型とポインタ型の引数を持つ関数をfunctions個並べたプロジェクトを作る。
+  // 呼び出しのたびに関数型の比較(castable)と合成(merge)が起き、レジスタの多くが関数型になる。
+  std::string projectSource(size_t functions)
+  {
+    std::string source = "extern puts(s: ptr<i8>): i32;\n";
+    source += "fn apply(f: fn(i32, ptr<ptr<u8> >): i64, g: fn(fn(i32, ptr<ptr<u8> >): i64): i32, v: i32): i32 { g(f) + v }\n";
+    for(size_t n = 0; n < functions; ++n) {
+      const auto id = std::to_string(n);
+      source += "fn step" + id + "(a: i32, p: ptr<ptr<u8> >): i64 { 1i64 }\n";
+      source += "fn wrap" + id + "(f: fn(i32, ptr<ptr<u8> >): i64): i32 {\n";
+      source += "  def g = step" + id + ";\n";
+      source += "  apply(g, wrap" + id + ", 1) + apply(f, wrap" + id + ", 2)\n";
+      source += "}\n";
+    }
+    source += "fn main(): i32 { puts(\"bench\"); 0 }\n";
+    return source;
+  }
+  struct Measurement
+  {
+    double declare;
+    double analyze;
+    double encode;
+  };
+  bool measure(const pickc::CompilerOption& option, Measurement& result)
+  {
+    using namespace pickc;
+    TimeReport::reset();
+    TimeReport::enable();
+    auto tree = parser::Parser().parse(option);
+    if(!tree) {
+      bench::printErrors(tree.err());
+      return false;
+    }
+    auto units = pcir::SemanticAnalyzer(tree.get()).compile(option);
+    if(!units) {
+      bench::printErrors(units.err());
+      return false;
+    }
+    for(const auto& record : TimeReport::records()) {
+      if(!record.item.empty()) continue;
+      if(record.phase == "declare") result.declare = record.stats.wall;
+      else if(record.phase == "analyze") result.analyze = record.stats.wall;
+      else if(record.phase == "pcir encode") result.encode = record.stats.wall;
+    }
+    return true;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace pickc;
+  size_t functions = 5000;
+  size_t iterations = 3;
+  if(argc > 1) functions = std::stoul(argv[1]);
+  if(argc > 2) iterations = std::stoul(argv[2]);
+
+  const auto dir = std::filesystem::temp_directory_path() / "pickc_type_bench";
+  bench::generateProject(dir, { { "index.pick", projectSource(functions) } });
+  CompilerOption option;
+  option.projectName = "bench";
+  option.mainModule = "bench";
+  option.srcDir = dir.string();
+  option.numThreads = 1;
+  Measurement best{};
+  for(size_t i = 0; i < iterations; ++i) {
+    Measurement m{};
+    if(!measure(option, m)) {
+      std::cerr << "build failed" << std::endl;
+      return 1;
+    }
+    if(i == 0 || m.declare < best.declare) best.declare = m.declare;
+    if(i == 0 || m.analyze < best.analyze) best.analyze = m.analyze;
+    if(i == 0 || m.encode < best.encode) best.encode = m.encode;
+  }
+  std::cout << functions * 2 << " functions with function-typed arguments (best of " << iterations << ")" << std::endl;
+  std::cout << "  declare: " << best.declare * 1000 << " ms" << std::endl;
+  std::cout << "  analyze: " << best.analyze * 1000 << " ms" << std::endl;
+  std::cout << "  encode:  " << best.encode * 1000 << " ms" << std::endl;
+  std::cout << "  (" << pcir::TypeContext::size() << " type ids)" << std::endl;
+  std::filesystem::remove_all(dir);
+  return 0;
+}
\ No newline at end of file
@@ -4,18 +4,31 @@
 #include <map>
 #include <unordered_map>
 #include <set>
+#include <string>
 
 #include "symbol.h"
+#include "utils/interner.h"
 
 namespace pickc::bundler
 {
   struct Bundle
   {
-    std::unordered_map<std::string, std::unordered_set<pcir::SymbolSection*>> modules;
+    // key = モジュールの完全修飾名
+    std::unordered_map<Atom, std::unordered_set<pcir::SymbolSection*>> modules;
     std::map<pcir::SymbolSection*, Symbol*> symbols;
-    std::unordered_map<std::string, pcir::SymbolSection*> symbolNames;
+    // key = シンボルの完全修飾名。LoadSymbolのテキストと同じAtomになる。
+    std::unordered_map<Atom, pcir::SymbolSection*> symbolNames;
     std::map<pcir::FunctionSection*, Function*> fns;
+    // シンボルの初期化関数と関数の本体に付けた、シンボルの完全修飾名による名前。--time-reportの表示に使う。
+    std::unordered_map<pcir::FunctionSection*, std::string> fnNames;
   };
+  // fnの表示名。名前の付いていない関数は(anonymous)とする。
+  inline std::string functionName(const Bundle& bundle, pcir::FunctionSection* fn)
+  {
+    auto itr = bundle.fnNames.find(fn);
+    if(itr == bundle.fnNames.end()) return "(anonymous)";
+    return itr->second;
+  }
 }
 
 #endif // PICKC_BUNDLER_BUNDLE_H_
\ No newline at end of file
@@ -3,7 +3,9 @@
 #include <filesystem>
 
 #include "utils/vector_utils.h"
+#include "utils/time_report.h"
 #include "pcir/pcir_format.h"
+#include "pcir/pcir_code.h"
 
 #include "fn_compiler.h"
 
@@ -12,39 +14,88 @@ namespace pickc::bundler
   Bundler::Bundler() {}
   Result<Bundle, std::vector<std::string>> Bundler::bundle(const CompilerOption& option)
   {
+    auto path = std::filesystem::path(option.outDir) / (option.out + ".pcir");
+    {
+      TimeReport::Scope scope("pcir load");
+      auto res = pcir::PCIRLoader().load(path.string());
+      if(!res) return error(std::move(res.err()));
+      pcirs.push_back(std::move(res.get()));
+    }
+    return bundlePCIRs(option);
+  }
+  Result<Bundle, std::vector<std::string>> Bundler::bundle(const CompilerOption& option, const std::vector<pcir::PCIRUnit>& units)
+  {
+    {
+      TimeReport::Scope scope("pcir load");
+      for(const auto& unit : units) {
+        auto path = std::filesystem::path(option.outDir) / unit.fileName(option.out);
+        auto res = pcir::PCIRLoader().load(path.string(), unit.binary);
+        if(!res) return error(std::move(res.err()));
+        pcirs.push_back(std::move(res.get()));
+      }
+    }
+    return bundlePCIRs(option);
+  }
+  void Bundler::nameFunctions(const pcir::PCIRFile& file, pcir::SymbolSection* symbol, const std::string& name)
+  {
+    // 関数のシンボルの初期化関数は本体をLoadFnするだけなので、本体にシンボルの名前を付ける。
+    auto init = symbol->init;
+    // 初期化関数の本体はどのみちこの後で読み込むので、ここで読み込んでおく。読み込めなかったときのエラーはそのときに出す。
+    if(init->fnType == pcir::FN_TYPE_FUNCTION && pcir::PCIRLoader::loadBody(file, init) && init->entryFlow->code.size() >= 9 && init->entryFlow->code[0] == pcir::LoadFn) {
+      size_t i = 0;
+      get32(init->entryFlow->code, i);
+      auto fn = get32(init->entryFlow->code, i);
+      if(fn < file.fnSection.size()) {
+        b.fnNames[file.fnSection[fn]] = name;
+        b.fnNames[init] = name + " (init)";
+        return;
+      }
+    }
+    b.fnNames[init] = name;
+  }
+  Result<Bundle, std::vector<std::string>> Bundler::bundlePCIRs(const CompilerOption& option)
+  {
+    TimeReport::Scope scope("bundle");
     std::vector<std::string> errors;
 
-    auto path = std::filesystem::path(option.outDir) / (option.out + ".pcir");
-    auto res = pcir::PCIRLoader().load(path.string());
-    if(!res) errors += res.err();
-    pcirs.push_back(res.get());
     for(const auto& lib : option.libraries) {
       // TODO: Load PCIRs
     }
 
-    if(!errors.empty()) return error(errors);
+    if(!errors.empty()) return error(std::move(errors));
 
     for(const auto& pcir : pcirs) {
       for(const auto& module : pcir.moduleSection) {
         for(const auto& symbol : module->symbols) {
           b.symbols[symbol] = new Symbol(symbol->init);
+          const auto name = Atom::join(module->name->text, symbol->name->text);
           b.modules[module->name->text].insert(symbol);
-          b.symbolNames[module->name->text + "::" + symbol->name->text] = symbol;
+          b.symbolNames[name] = symbol;
+          nameFunctions(pcir, symbol, name.str());
         }
       }
     }
 
     for(auto& pcir : pcirs) {
       for(auto& fn : pcir.fnSection) {
+        TimeReport::Scope fnScope("bundle", TimeReport::enabled() ? functionName(b, fn) : "");
+        // 本体はここで初めて読み込み、命令列に変換したらすぐに解放する。
+        auto body = pcir::PCIRLoader::loadBody(pcir, fn);
+        if(!body) {
+          errors += body.err();
+          continue;
+        }
         if(auto res = FnCompiler(&b, &pcir, fn).compile()) {
           b.fns[fn] = res.get();
         }
         else {
           errors += res.err();
         }
+        // 以降は命令列だけを使う。
+        fn->releaseBody();
       }
     }
 
-    return ok(b);
+    return ok(std::move(b));
   }
 }
\ No newline at end of file
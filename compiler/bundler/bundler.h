@@ -4,6 +4,7 @@
 #include "pickc/compiler_option.h"
 #include "pcir/pcir_struct.h"
 #include "utils/result.h"
+#include "utils/binary_vec.h"
 
 #include "bundle.h"
 
@@ -13,9 +14,15 @@ namespace pickc::bundler
   {
     Bundle b;
     std::vector<pcir::PCIRFile> pcirs;
+    Result<Bundle, std::vector<std::string>> bundlePCIRs(const CompilerOption& option);
+    // --time-reportに表示するために、symbolの関数にnameを付ける。
+    void nameFunctions(const pcir::PCIRFile& file, pcir::SymbolSection* symbol, const std::string& name);
   public:
     Bundler();
+    // <outDir>/<out>.pcirを読み込んでまとめる。
     Result<Bundle, std::vector<std::string>> bundle(const CompilerOption& option);
+    // SemanticAnalyzer::compileの結果をファイルを経由せずにまとめる。
+    Result<Bundle, std::vector<std::string>> bundle(const CompilerOption& option, const std::vector<pcir::PCIRUnit>& units);
   };
 }
 
@@ -27,6 +27,8 @@ namespace pickc::bundler
         }
       }
       for(auto& reg : regs) {
+        // usedは生存期間を求めるためだけに使い、キーのフローはこの後解放される。
+        reg.second->used = {};
         fn->regs.insert(reg.second);
       }
     }
@@ -35,7 +37,7 @@ namespace pickc::bundler
     }
     
     if(errors.empty()) return ok(fn);
-    return error(errors);
+    return error(std::move(errors));
   }
 
   namespace {
@@ -155,7 +157,7 @@ namespace pickc::bundler
           auto inst = new CallInstruction();
           inst->dist = regs[pcirFn->regs[dist]];
           inst->fn = regs[pcirFn->regs[fn]];
-          for(size_t j = 0, l = pcirFn->regs[fn]->type->type.fn.args.size(); j < l; ++j) {
+          for(size_t j = 0, l = pcirFn->regs[fn]->type->type.args().size(); j < l; ++j) {
             auto arg = get32(flow->code, i);
             inst->args.push_back(regs[pcirFn->regs[arg]]);
           }
@@ -350,10 +352,10 @@ namespace pickc::bundler
       std::stringstream ss;
       ss << "PCIRエラー: flow typeが予期しないものでした。flow type: 0x" << std::hex << flow->flowType;
       errors.push_back(ss.str());
-      return error(errors);
+      return error(std::move(errors));
     }
     if(errors.empty()) return ok();
-    return error(errors);
+    return error(std::move(errors));
   }
 
   std::unordered_set<pcir::FlowStruct*> FnCompiler::downstream(pcir::FlowStruct* flow)
@@ -3,4 +3,13 @@
 namespace pickc::bundler
 {
   Instruction::~Instruction() {}
+  Function::~Function()
+  {
+    // 1つのグループは複数のレジスタから指される。
+    std::unordered_set<PhiGroup*> groups;
+    for(const auto& phi : phis) groups.insert(phi.second);
+    for(auto group : groups) delete group;
+    for(auto reg : regs) delete reg;
+    for(auto inst : insts) delete inst;
+  }
 }
\ No newline at end of file
@@ -15,102 +15,212 @@ namespace pickc::bundler
     // このレジスタの生存期間
     size_t lifeEnd;
   };
+  // 命令の種類。RoutineCompilerはdynamic_castの連鎖ではなく、これでswitchする。
+  // BinaryInstructionの派生はAddからLeまで連続して並べること。
+  enum struct InstructionKind : uint8_t
+  {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Mod,
+    Eq,
+    Neq,
+    Gt,
+    Ge,
+    Lt,
+    Le,
+    Inc,
+    Dec,
+    Pos,
+    Neg,
+    LoadFn,
+    LoadArg,
+    LoadSymbol,
+    LoadString,
+    LoadElem,
+    Alloc,
+    Call,
+    Imm,
+    Ret,
+    Jmp,
+  };
   struct Instruction
   {
+    const InstructionKind kind;
+  protected:
+    Instruction(InstructionKind kind) : kind(kind) {}
+  public:
     virtual ~Instruction() = 0;
   };
   struct BinaryInstruction : public Instruction
   {
-    Register* dist;
-    Register* left;
-    Register* right;
-  };
-  struct AddInstruction : public BinaryInstruction {};
-  struct SubInstruction : public BinaryInstruction {};
-  struct MulInstruction : public BinaryInstruction {};
-  struct DivInstruction : public BinaryInstruction {};
-  struct ModInstruction : public BinaryInstruction {};
-  struct EqInstruction : public BinaryInstruction {};
-  struct NeqInstruction : public BinaryInstruction {};
-  struct GtInstruction : public BinaryInstruction {};
-  struct GeInstruction : public BinaryInstruction {};
-  struct LtInstruction : public BinaryInstruction {};
-  struct LeInstruction : public BinaryInstruction {};
+    Register* dist = nullptr;
+    Register* left = nullptr;
+    Register* right = nullptr;
+  protected:
+    BinaryInstruction(InstructionKind kind) : Instruction(kind) {}
+  public:
+    static bool classof(const Instruction* inst) { return InstructionKind::Add <= inst->kind && inst->kind <= InstructionKind::Le; }
+  };
+  struct AddInstruction : public BinaryInstruction
+  {
+    AddInstruction() : BinaryInstruction(InstructionKind::Add) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Add; }
+  };
+  struct SubInstruction : public BinaryInstruction
+  {
+    SubInstruction() : BinaryInstruction(InstructionKind::Sub) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Sub; }
+  };
+  struct MulInstruction : public BinaryInstruction
+  {
+    MulInstruction() : BinaryInstruction(InstructionKind::Mul) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Mul; }
+  };
+  struct DivInstruction : public BinaryInstruction
+  {
+    DivInstruction() : BinaryInstruction(InstructionKind::Div) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Div; }
+  };
+  struct ModInstruction : public BinaryInstruction
+  {
+    ModInstruction() : BinaryInstruction(InstructionKind::Mod) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Mod; }
+  };
+  struct EqInstruction : public BinaryInstruction
+  {
+    EqInstruction() : BinaryInstruction(InstructionKind::Eq) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Eq; }
+  };
+  struct NeqInstruction : public BinaryInstruction
+  {
+    NeqInstruction() : BinaryInstruction(InstructionKind::Neq) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Neq; }
+  };
+  struct GtInstruction : public BinaryInstruction
+  {
+    GtInstruction() : BinaryInstruction(InstructionKind::Gt) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Gt; }
+  };
+  struct GeInstruction : public BinaryInstruction
+  {
+    GeInstruction() : BinaryInstruction(InstructionKind::Ge) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Ge; }
+  };
+  struct LtInstruction : public BinaryInstruction
+  {
+    LtInstruction() : BinaryInstruction(InstructionKind::Lt) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Lt; }
+  };
+  struct LeInstruction : public BinaryInstruction
+  {
+    LeInstruction() : BinaryInstruction(InstructionKind::Le) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Le; }
+  };
   struct IncInstruction : public Instruction
   {
-    Register* dist;
-    Register* src;
+    Register* dist = nullptr;
+    Register* src = nullptr;
+    IncInstruction() : Instruction(InstructionKind::Inc) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Inc; }
   };
   struct DecInstruction : public Instruction
   {
-    Register* dist;
-    Register* src;
+    Register* dist = nullptr;
+    Register* src = nullptr;
+    DecInstruction() : Instruction(InstructionKind::Dec) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Dec; }
   };
   struct PosInstruction : public Instruction
   {
-    Register* dist;
-    Register* src;
+    Register* dist = nullptr;
+    Register* src = nullptr;
+    PosInstruction() : Instruction(InstructionKind::Pos) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Pos; }
   };
   struct NegInstruction : public Instruction
   {
-    Register* dist;
-    Register* src;
+    Register* dist = nullptr;
+    Register* src = nullptr;
+    NegInstruction() : Instruction(InstructionKind::Neg) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Neg; }
   };
   struct LoadFnInstruction : public Instruction
   {
-    Register* dist;
-    pcir::FunctionSection* fn;
+    Register* dist = nullptr;
+    pcir::FunctionSection* fn = nullptr;
+    LoadFnInstruction() : Instruction(InstructionKind::LoadFn) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::LoadFn; }
   };
   struct LoadArgInstruction : public Instruction
   {
-    Register* dist;
-    uint32_t indexOfArg;
+    Register* dist = nullptr;
+    uint32_t indexOfArg = 0;
+    LoadArgInstruction() : Instruction(InstructionKind::LoadArg) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::LoadArg; }
   };
   struct LoadSymbolInstruction : public Instruction
   {
-    Register* dist;
-    pcir::SymbolSection* symbol;
+    Register* dist = nullptr;
+    pcir::SymbolSection* symbol = nullptr;
+    LoadSymbolInstruction() : Instruction(InstructionKind::LoadSymbol) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::LoadSymbol; }
   };
   struct LoadStringInstruction : public Instruction
   {
-    Register* dist;
-    pcir::TextSection* text;
+    Register* dist = nullptr;
+    pcir::TextSection* text = nullptr;
+    LoadStringInstruction() : Instruction(InstructionKind::LoadString) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::LoadString; }
   };
   struct LoadElemInstruction : public Instruction
   {
-    Register* dist;
-    Register* array;
-    Register* index;
+    Register* dist = nullptr;
+    Register* array = nullptr;
+    Register* index = nullptr;
+    LoadElemInstruction() : Instruction(InstructionKind::LoadElem) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::LoadElem; }
   };
   struct AllocInstruction : public Instruction
   {
-    Register* dist;
-    Register* src;
+    Register* dist = nullptr;
+    Register* src = nullptr;
+    AllocInstruction() : Instruction(InstructionKind::Alloc) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Alloc; }
   };
   struct CallInstruction : public Instruction
   {
-    Register* dist;
+    Register* dist = nullptr;
     std::vector<Register*> args;
-    Register* fn;
+    Register* fn = nullptr;
+    CallInstruction() : Instruction(InstructionKind::Call) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Call; }
   };
   struct ImmInstruction : public Instruction
   {
-    Register* dist;
-    int64_t imm;
+    Register* dist = nullptr;
+    int64_t imm = 0;
+    ImmInstruction() : Instruction(InstructionKind::Imm) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Imm; }
   };
   struct RetInstruction : public Instruction
   {
     // voidの場合はnullptr
-    Register* value;
+    Register* value = nullptr;
+    RetInstruction() : Instruction(InstructionKind::Ret) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Ret; }
   };
   struct JmpInstruction : public Instruction
   {
     // Function::insts上の条件が真か無条件の場合にジャンプしたい命令への絶対インデックス
-    size_t then;
+    size_t then = 0;
     // Function::insts上の条件が偽の場合にジャンプしたい命令への絶対インデックス
-    size_t els;
+    size_t els = 0;
     // ジャンプする条件。無条件ジャンプならnullptr
-    Register* cond;
+    Register* cond = nullptr;
+    JmpInstruction() : Instruction(InstructionKind::Jmp) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Jmp; }
   };
 
   struct PhiGroup
@@ -125,6 +235,11 @@ namespace pickc::bundler
     std::unordered_set<Register*> regs;
     std::unordered_map<Register*, PhiGroup*> phis;
     std::vector<Instruction*> insts;
+    Function() = default;
+    Function(const Function&) = delete;
+    Function& operator=(const Function&) = delete;
+    // レジスタ、φ関数のグループ、命令はFunctionが持ち、一緒に解放する。
+    ~Function();
   };
 }
 
@@ -1,70 +1,73 @@
 #include "ast.h"
 
+#include <algorithm>
+
 #include "pickc/config.h"
 #include "utils/vector_utils.h"
 
 namespace pickc::parser
 {
-  ASTGenerator::ASTGenerator(const TokenSequence& sequence) : sequence(sequence), _tokenIndex(-1) {}
+  ASTGenerator::ASTGenerator(const TokenSequence& sequence, Arena& arena, bool deferBodies) : sequence(sequence), arena(arena), deferBodies(deferBodies), _tokenIndex(-1) {}
   Option<Token> ASTGenerator::nextToken(bool index)
   {
-    if(_tokenIndex + 1 < sequence.tokens.size()) {
-      if(includes({ TokenKind::LineComment }, sequence.tokens[_tokenIndex + 1].kind)) {
-        ++_tokenIndex;
-        return nextToken(index);
-      }
-      if(index) return some(sequence.tokens[++_tokenIndex]);
-      return some(sequence.tokens[_tokenIndex + 1]);
+    if(_tokenIndex + 1 < static_cast<int>(sequence.size())) {
+      if(index) return some(sequence[++_tokenIndex]);
+      return some(sequence[_tokenIndex + 1]);
     }
     if(index) ++_tokenIndex;
     return none;
   }
   Option<Token> ASTGenerator::backToken(bool index)
   {
-    if(_tokenIndex > 0) {
-      if(includes({ TokenKind::LineComment }, sequence.tokens[_tokenIndex - 1].kind)) {
-        --_tokenIndex;
-        return backToken(index);
-      }
-      if(index) return some(sequence.tokens[--_tokenIndex]);
-      return some(sequence.tokens[_tokenIndex - 1]);
-    }
+    // ファイルの終わりでnextTokenを呼ぶと_tokenIndexはトークン列の外に出るので、そのときは最後のトークンを返す。
+    const auto size = static_cast<int>(sequence.size());
     if(index) --_tokenIndex;
+    const auto back = index ? _tokenIndex : _tokenIndex - 1;
+    if(back >= 0 && size > 0) return some(sequence[std::min(back, size - 1)]);
     return none;
   }
   Token ASTGenerator::currentToken()
   {
-    return sequence.tokens[_tokenIndex];
+    return sequence[_tokenIndex];
   }
   bool ASTGenerator::hasNext()
   {
-    auto res = nextToken();
-    backToken(true);
-    return res;
+    return _tokenIndex + 1 < static_cast<int>(sequence.size());
   }
-  std::vector<pickc::parser::Token>::iterator ASTGenerator::currentTokenIter()
+  SourceSpan ASTGenerator::spanFrom(int begin)
   {
-    return sequence.tokens.begin() + _tokenIndex;
+    const auto last = std::min(_tokenIndex, static_cast<int>(sequence.size()) - 1);
+    return SourceSpan{ static_cast<uint32_t>(begin), static_cast<uint32_t>(std::max(begin, last)) };
+  }
+  int ASTGenerator::matchingBrace(int open)
+  {
+    const auto kinds = sequence.kinds.data();
+    int depth = 0;
+    for(int i = open, l = static_cast<int>(sequence.size()); i < l; ++i) {
+      if(kinds[i] == TokenKind::LBrace) ++depth;
+      else if(kinds[i] == TokenKind::RBrase && --depth == 0) return i;
+    }
+    return -1;
   }
   std::string ASTGenerator::createASTError(const std::string& message, const Token& token)
   {
+    const auto line = sequence.line(token) - 1;
+    const auto letter = sequence.letter(token) - 1;
     std::string res;
     res += "構文エラー: ";
     res += message;
     res += "\nat ";
     res += sequence.file;
     res += ' ';
-    res += std::to_string(token.line);
+    res += std::to_string(line + 1);
     res += "行目 ";
-    res += std::to_string(token.letter);
+    res += std::to_string(letter + 1);
     res += "文字目\n";
-    const auto line = token.line - 1;
-    const auto letter = token.letter - 1;
     if(line > 0) res += sequence.toOutputString(line - 1);
     res += sequence.toOutputString(line);
     auto digit = 3 + letter;
     {
-      auto n = token.line;
+      auto n = line + 1;
       while(n != 0) {
           n /= 10;
           ++digit;
@@ -72,9 +75,9 @@ namespace pickc::parser
     }
     res += CONSOLE_FG_RED;
     res.append(digit, ' ');
-    res.append(token.value.size(), '^');
+    res.append(token.length, '^');
     res += '\n';
-    if(line + 1 < sequence.rawFileData.size()) sequence.toOutputString(line + 1);
+    if(line + 1 < sequence.numLines()) sequence.toOutputString(line + 1);
     return res;
   }
   std::vector<std::string> ASTGenerator::createEOTError(const std::string& addMessage)
@@ -96,7 +99,7 @@ namespace pickc::parser
       }
       switch(token.get().kind) {
         case TokenKind::FnKeyword:
-          if(auto fnDefRes = fnDefGenerate()) {
+          if(auto fnDefRes = fnDefGenerate(deferBodies)) {
             auto fnDef = fnDefRes.get();
             fnDef->isPub = isPub;
             rootNode.nodes.push_back(fnDef);
@@ -158,8 +161,18 @@ namespace pickc::parser
           }
       }
     }
-    rootNode.tokens = std::move(sequence.tokens);
     if(errors.empty()) return ok(std::move(rootNode));
-    else return error(errors);
+    else return error(std::move(errors));
+  }
+  Option<std::vector<std::string>> ASTGenerator::deferredBodyGenerate(FunctionDefineNode* fnDef)
+  {
+    assert(fnDef->isBodyDeferred);
+    _tokenIndex = fnDef->bodySpan.first;
+    auto body = exprGenerate();
+    if(!body) return some(std::move(body.err()));
+    assert(_tokenIndex == static_cast<int>(fnDef->bodySpan.last));
+    fnDef->body = body.get();
+    fnDef->isBodyDeferred = false;
+    return none;
   }
 }
\ No newline at end of file
@@ -8,17 +8,24 @@ namespace pickc::parser
 { 
   class ASTGenerator
   {
-    TokenSequence sequence;
+    const TokenSequence& sequence;
+    // ノードはすべてここに確保する。
+    Arena& arena;
+    // trueならトップレベルの関数の本文を読み飛ばし、deferredBodyGenerateで後から構文解析する。
+    bool deferBodies;
     int _tokenIndex;
   private:
     Option<Token> nextToken(bool index = true);
     Option<Token> backToken(bool index = false);
     Token currentToken();
     bool hasNext();
-    std::vector<pickc::parser::Token>::iterator currentTokenIter();
+    // begin番目から現在のトークンまでの範囲
+    SourceSpan spanFrom(int begin);
+    // open番目の{に対応する}の位置。見つからなければ-1。
+    int matchingBrace(int open);
     std::string createASTError(const std::string& message, const Token& token);
     std::vector<std::string> createEOTError(const std::string& addMessage);
-    Result<FunctionDefineNode*, std::vector<std::string>> fnDefGenerate();
+    Result<FunctionDefineNode*, std::vector<std::string>> fnDefGenerate(bool deferBody = false);
     Result<VariableDefineNode*, std::vector<std::string>> varDefGenerate();
     Result<ClassDefineNode*, std::vector<std::string>> clsDefGenerate();
     Result<AliasDefineNode*, std::vector<std::string>> alsDefGenerate();
@@ -26,18 +33,18 @@ namespace pickc::parser
     Result<ExternNode*, std::vector<std::string>> externGenerate();
     Result<VariableNode*, std::vector<std::string>> variableGenerate();
     Result<TypeNode*, std::vector<std::string>> typeGenerate();
-    Result<std::vector<ArgumentDefineNode*>, std::vector<std::string>> argDefGenerate();
+    Result<ArenaVector<ArgumentDefineNode*>, std::vector<std::string>> argDefGenerate();
     Result<ExpressionNode*, std::vector<std::string>> exprGenerate();
-    Result<ExpressionNode*, std::vector<std::string>> asignGenerate();
-    Result<ExpressionNode*, std::vector<std::string>> compGenerate();
-    Result<ExpressionNode*, std::vector<std::string>> termGenerate();
-    Result<ExpressionNode*, std::vector<std::string>> factorGenerate();
+    // minPrecedenceより弱い二項演算子の手前で止まる。0ならすべての演算子を読む。
+    Result<ExpressionNode*, std::vector<std::string>> binaryGenerate(uint8_t minPrecedence = 0);
     Result<ExpressionNode*, std::vector<std::string>> frontUnaryGenerate();
     Result<ExpressionNode*, std::vector<std::string>> backUnaryGenerate();
     Result<ExpressionNode*, std::vector<std::string>> primaryGenerate();
   public:
-    ASTGenerator(const TokenSequence& sequence);
+    ASTGenerator(const TokenSequence& sequence, Arena& arena, bool deferBodies = false);
     Result<RootNode, std::vector<std::string>> generate();
+    // 後回しにしたfnDefの本文を構文解析する。
+    Option<std::vector<std::string>> deferredBodyGenerate(FunctionDefineNode* fnDef);
   };
 }
 
@@ -0,0 +1,717 @@
+#include "ast_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+
+#include "pickc/config.h"
+#include "utils/hash.h"
+#include "utils/mapped_file.h"
+#include "utils/resident_cache.h"
+
+namespace pickc::parser
+{
+  namespace
+  {
+    // 木は前順で並べ、各ノードはNodeKind、span、フィールドの順に書く。nullptrはNULL_NODEの1バイトだけを書く。
+    // 個数、長さ、トークンの位置、spanはLEB128で書く。spanは直前のノードのfirstとの差で書くので、ほとんどが1バイトになる。
+    // NodeKindやTokenKindの値を変えたらFORMAT_VERSIONを上げる。
+    constexpr uint8_t NULL_NODE = 0xFF;
+    constexpr uint32_t FORMAT_VERSION = 2;
+    constexpr char MAGIC[4] = { 'P', 'A', 'S', 'T' };
+    struct Header
+    {
+      char magic[4];
+      uint32_t formatVersion;
+      uint64_t key;
+      uint64_t sourceSize;
+      uint32_t numTokens;
+      uint32_t numComments;
+    };
+    static_assert(sizeof(Header) == 32);
+
+    class Writer
+    {
+      std::string& out;
+      uint32_t prevFirst;
+    public:
+      Writer(std::string& out) : out(out), prevFirst(0) {}
+      template<typename T>
+      void write(const T& value)
+      {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+      void writeVarint(uint64_t value)
+      {
+        while(value >= 0x80) {
+          out.push_back(static_cast<char>(value | 0x80));
+          value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+      }
+      // 負になりうる差はzigzag符号化して書く。
+      void writeDelta(uint32_t value, uint32_t base)
+      {
+        const auto delta = static_cast<int64_t>(value) - static_cast<int64_t>(base);
+        writeVarint(delta < 0 ? ((-delta) << 1) - 1 : delta << 1);
+      }
+      void writeSpan(const SourceSpan& span)
+      {
+        writeDelta(span.first, prevFirst);
+        writeDelta(span.last, span.first);
+        prevFirst = span.first;
+      }
+      // トークンの位置は直前のトークンの末尾からの差で書く。
+      void writeTokens(const std::vector<Token>& tokens)
+      {
+        uint32_t prevEnd = 0;
+        for(const auto& token : tokens) write(token.kind);
+        for(const auto& token : tokens) {
+          writeDelta(token.offset, prevEnd);
+          writeVarint(token.length);
+          prevEnd = token.offset + token.length;
+        }
+      }
+      void writeTokens(const TokenSequence& sequence)
+      {
+        uint32_t prevEnd = 0;
+        out.append(reinterpret_cast<const char*>(sequence.kinds.data()), sequence.kinds.size());
+        for(size_t i = 0, l = sequence.size(); i < l; ++i) {
+          writeDelta(sequence.offsets[i], prevEnd);
+          writeVarint(sequence.lengths[i]);
+          prevEnd = sequence.offsets[i] + sequence.lengths[i];
+        }
+      }
+      void writeString(const std::string& str)
+      {
+        writeVarint(str.size());
+        out.append(str);
+      }
+      void writeNames(const std::vector<std::string>& names)
+      {
+        writeVarint(names.size());
+        for(const auto& name : names) writeString(name);
+      }
+      template<typename T, typename Allocator>
+      void writeNodes(const std::vector<T*, Allocator>& nodes)
+      {
+        writeVarint(nodes.size());
+        for(auto node : nodes) writeNode(node);
+      }
+      template<typename T>
+      void writeValue(const Node* node)
+      {
+        write(static_cast<const T*>(node)->value);
+      }
+      void writeNode(const Node* node)
+      {
+        if(node == nullptr) {
+          write(NULL_NODE);
+          return;
+        }
+        write(node->kind);
+        writeSpan(node->span);
+        switch(node->kind) {
+          case NodeKind::PtrType:
+            writeNode(static_cast<const PtrTypeNode*>(node)->base);
+            break;
+          case NodeKind::ArrayType: {
+            auto arrayType = static_cast<const ArrayTypeNode*>(node);
+            writeNode(arrayType->elemType);
+            writeVarint(arrayType->length);
+            break;
+          }
+          case NodeKind::FnType: {
+            auto fnType = static_cast<const FnTypeNode*>(node);
+            writeNode(fnType->ret);
+            writeNodes(fnType->args);
+            break;
+          }
+          case NodeKind::GenericsType: {
+            auto genericsType = static_cast<const GenericsTypeNode*>(node);
+            writeNames(genericsType->name);
+            writeNodes(genericsType->generics);
+            break;
+          }
+          case NodeKind::UserDefineType:
+            writeNames(static_cast<const UserDefineTypeNode*>(node)->name);
+            break;
+          case NodeKind::Block:
+            writeNodes(static_cast<const BlockNode*>(node)->nodes);
+            break;
+          case NodeKind::If: {
+            auto ifNode = static_cast<const IfNode*>(node);
+            writeNode(ifNode->comp);
+            writeNode(ifNode->thenExpr);
+            writeNode(ifNode->elseExpr);
+            break;
+          }
+          case NodeKind::While: {
+            auto whileNode = static_cast<const WhileNode*>(node);
+            writeNode(whileNode->comp);
+            writeNode(whileNode->body);
+            break;
+          }
+          case NodeKind::Variable:
+          case NodeKind::ScopedVariable: {
+            auto variable = static_cast<const VariableNode*>(node);
+            writeString(variable->name);
+            writeNodes(variable->generics);
+            if(node->kind == NodeKind::ScopedVariable) writeNode(static_cast<const ScopedVariableNode*>(node)->child);
+            break;
+          }
+          case NodeKind::IntegerLiteral: writeValue<IntegerLiteral>(node); break;
+          case NodeKind::I8Literal: writeValue<I8Literal>(node); break;
+          case NodeKind::I16Literal: writeValue<I16Literal>(node); break;
+          case NodeKind::I32Literal: writeValue<I32Literal>(node); break;
+          case NodeKind::I64Literal: writeValue<I64Literal>(node); break;
+          case NodeKind::U8Literal: writeValue<U8Literal>(node); break;
+          case NodeKind::U16Literal: writeValue<U16Literal>(node); break;
+          case NodeKind::U32Literal: writeValue<U32Literal>(node); break;
+          case NodeKind::U64Literal: writeValue<U64Literal>(node); break;
+          case NodeKind::FloatLiteral: writeValue<FloatLiteral>(node); break;
+          case NodeKind::F32Literal: writeValue<F32Literal>(node); break;
+          case NodeKind::F64Literal: writeValue<F64Literal>(node); break;
+          case NodeKind::BoolLiteral: writeValue<BoolLiteral>(node); break;
+          case NodeKind::CharLiteral: writeValue<CharLiteral>(node); break;
+          case NodeKind::StringLiteral:
+            writeString(static_cast<const StringLiteral*>(node)->value);
+            break;
+          case NodeKind::ArrayLiteral:
+            writeNodes(static_cast<const ArrayLiteral*>(node)->value);
+            break;
+          case NodeKind::MemberAccess: {
+            auto memberAccess = static_cast<const MemberAccessNode*>(node);
+            writeNode(memberAccess->base);
+            writeNode(memberAccess->member);
+            break;
+          }
+          case NodeKind::ArrayAccess: {
+            auto arrayAccess = static_cast<const ArrayAccessNode*>(node);
+            writeNode(arrayAccess->base);
+            writeNode(arrayAccess->suffix);
+            break;
+          }
+          case NodeKind::Call: {
+            auto call = static_cast<const CallNode*>(node);
+            writeNode(call->base);
+            writeNodes(call->args);
+            break;
+          }
+          case NodeKind::Return:
+            writeNode(static_cast<const ReturnNode*>(node)->value);
+            break;
+          case NodeKind::VariableDefine: {
+            auto varDef = static_cast<const VariableDefineNode*>(node);
+            write(varDef->isPub);
+            write(varDef->isMut);
+            writeNode(varDef->name);
+            writeNode(varDef->type);
+            writeNode(varDef->init);
+            break;
+          }
+          case NodeKind::ArgumentDefine: {
+            auto argDef = static_cast<const ArgumentDefineNode*>(node);
+            write(argDef->isMut);
+            writeNode(argDef->name);
+            writeNode(argDef->type);
+            writeNode(argDef->init);
+            break;
+          }
+          case NodeKind::FunctionDefine:
+          case NodeKind::Extern: {
+            auto fnDef = static_cast<const FunctionDefineNode*>(node);
+            write(fnDef->isPub);
+            writeNode(fnDef->name);
+            writeNodes(fnDef->args);
+            writeNode(fnDef->retType);
+            writeNode(fnDef->body);
+            write(fnDef->isBodyDeferred);
+            writeSpan(fnDef->bodySpan);
+            break;
+          }
+          case NodeKind::Import:
+            writeNode(static_cast<const ImportNode*>(node)->name);
+            break;
+          default:
+            if(UnaryNode::classof(node)) {
+              writeNode(static_cast<const UnaryNode*>(node)->base);
+            }
+            else if(BinaryNode::classof(node)) {
+              auto binary = static_cast<const BinaryNode*>(node);
+              writeNode(binary->left);
+              writeNode(binary->right);
+            }
+            // それ以外はフィールドを持たない。
+            break;
+        }
+      }
+    };
+
+    // 読み取りは範囲外を読もうとした時点でfailedにし、以降は何も作らない。
+    // 古いビルドが書いたものや途中で切れたものも読むので、トークンの種類と位置、spanも確かめる。
+    class Reader
+    {
+      const char* cur;
+      const char* end;
+      Arena& arena;
+      uint32_t prevFirst;
+      uint64_t sourceSize;
+      uint32_t numTokens;
+    public:
+      bool failed;
+    public:
+      Reader(const char* cur, const char* end, Arena& arena) : cur(cur), end(end), arena(arena), prevFirst(0), sourceSize(0), numTokens(0), failed(false) {}
+      // ヘッダーを読んだ後に、ソースの大きさとトークンの数を設定する。
+      void limit(uint64_t sourceSize, uint32_t numTokens)
+      {
+        this->sourceSize = sourceSize;
+        this->numTokens = numTokens;
+      }
+      bool atEnd() const
+      {
+        return cur == end;
+      }
+      template<typename T>
+      T read()
+      {
+        T value{};
+        if(static_cast<size_t>(end - cur) < sizeof(T)) {
+          failed = true;
+          return value;
+        }
+        std::memcpy(&value, cur, sizeof(T));
+        cur += sizeof(T);
+        return value;
+      }
+      uint64_t readVarint()
+      {
+        uint64_t value = 0;
+        for(int shift = 0; shift < 64; shift += 7) {
+          if(cur == end) break;
+          const auto byte = static_cast<uint8_t>(*cur++);
+          value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+          if((byte & 0x80) == 0) return value;
+        }
+        failed = true;
+        return 0;
+      }
+      uint32_t readDelta(uint32_t base)
+      {
+        const auto zigzag = readVarint();
+        const auto delta = (zigzag & 1) ? -static_cast<int64_t>((zigzag + 1) >> 1) : static_cast<int64_t>(zigzag >> 1);
+        return static_cast<uint32_t>(base + delta);
+      }
+      // spanはトークンの番号の範囲。トークンがなければ{ 0, 0 }になる。
+      SourceSpan readSpan()
+      {
+        SourceSpan span;
+        span.first = readDelta(prevFirst);
+        span.last = readDelta(span.first);
+        prevFirst = span.first;
+        if(span.first > span.last || span.last >= std::max<uint32_t>(numTokens, 1)) failed = true;
+        return span;
+      }
+      // トークンの種類が範囲内(Identifyが最後)で、ソースに収まっているか確かめる。
+      void checkToken(TokenKind kind, uint32_t offset, uint32_t length)
+      {
+        if(kind > TokenKind::Identify || static_cast<uint64_t>(offset) + length > sourceSize) failed = true;
+      }
+      void readTokens(TokenSequence& sequence, size_t size)
+      {
+        if(static_cast<size_t>(end - cur) < size) {
+          failed = true;
+          return;
+        }
+        sequence.kinds.resize(size);
+        std::memcpy(sequence.kinds.data(), cur, size);
+        cur += size;
+        sequence.offsets.resize(size);
+        sequence.lengths.resize(size);
+        uint32_t prevEnd = 0;
+        for(size_t i = 0; i < size && !failed; ++i) {
+          sequence.offsets[i] = readDelta(prevEnd);
+          sequence.lengths[i] = static_cast<uint32_t>(readVarint());
+          checkToken(sequence.kinds[i], sequence.offsets[i], sequence.lengths[i]);
+          prevEnd = sequence.offsets[i] + sequence.lengths[i];
+        }
+      }
+      void readTokens(std::vector<Token>& tokens, size_t size)
+      {
+        if(static_cast<size_t>(end - cur) < size) {
+          failed = true;
+          return;
+        }
+        tokens.resize(size);
+        for(auto& token : tokens) token.kind = read<TokenKind>();
+        uint32_t prevEnd = 0;
+        for(size_t i = 0; i < size && !failed; ++i) {
+          tokens[i].offset = readDelta(prevEnd);
+          tokens[i].length = static_cast<uint32_t>(readVarint());
+          checkToken(tokens[i].kind, tokens[i].offset, tokens[i].length);
+          prevEnd = tokens[i].offset + tokens[i].length;
+        }
+      }
+      std::string readString()
+      {
+        const auto size = readVarint();
+        if(failed || static_cast<size_t>(end - cur) < size) {
+          failed = true;
+          return "";
+        }
+        std::string str(cur, size);
+        cur += size;
+        return str;
+      }
+      std::vector<std::string> readNames()
+      {
+        const auto size = readVarint();
+        std::vector<std::string> names;
+        for(uint64_t i = 0; i < size && !failed; ++i) names.push_back(readString());
+        return names;
+      }
+      template<typename T, typename Allocator>
+      void readNodes(std::vector<T*, Allocator>& nodes)
+      {
+        const auto size = readVarint();
+        // 1ノードは少なくとも1バイトあるので、残りより多ければ壊れている。
+        if(failed || static_cast<size_t>(end - cur) < size) {
+          failed = true;
+          return;
+        }
+        nodes.reserve(size);
+        for(uint64_t i = 0; i < size && !failed; ++i) nodes.push_back(readNodeAs<T>());
+      }
+      template<typename T>
+      T* readNodeAs()
+      {
+        auto node = readNode();
+        if(node == nullptr) return nullptr;
+        if constexpr(!std::is_same_v<T, Node>) {
+          if(!T::classof(node)) {
+            failed = true;
+            return nullptr;
+          }
+        }
+        return static_cast<T*>(node);
+      }
+      template<typename T>
+      Node* readLiteral()
+      {
+        return arena.make<T>(read<decltype(T::value)>());
+      }
+      template<typename T>
+      Node* readUnary()
+      {
+        auto base = readNodeAs<ExpressionNode>();
+        return arena.make<T>(base);
+      }
+      template<typename T>
+      Node* readBinary()
+      {
+        auto left = readNodeAs<ExpressionNode>();
+        auto right = readNodeAs<ExpressionNode>();
+        return arena.make<T>(left, right);
+      }
+      template<typename T>
+      Node* readFunction()
+      {
+        auto fnDef = arena.make<T>(arena);
+        fnDef->isPub = read<bool>();
+        fnDef->name = readNodeAs<VariableNode>();
+        readNodes(fnDef->args);
+        fnDef->retType = readNodeAs<TypeNode>();
+        fnDef->body = readNodeAs<ExpressionNode>();
+        fnDef->isBodyDeferred = read<bool>();
+        fnDef->bodySpan = readSpan();
+        return fnDef;
+      }
+      Node* readNode()
+      {
+        const auto kind = read<uint8_t>();
+        if(failed || kind == NULL_NODE) return nullptr;
+        if(kind > static_cast<uint8_t>(NodeKind::Root)) {
+          failed = true;
+          return nullptr;
+        }
+        const auto span = readSpan();
+        Node* node = nullptr;
+        switch(static_cast<NodeKind>(kind)) {
+          case NodeKind::I8Type: node = arena.make<I8TypeNode>(); break;
+          case NodeKind::I16Type: node = arena.make<I16TypeNode>(); break;
+          case NodeKind::I32Type: node = arena.make<I32TypeNode>(); break;
+          case NodeKind::I64Type: node = arena.make<I64TypeNode>(); break;
+          case NodeKind::U8Type: node = arena.make<U8TypeNode>(); break;
+          case NodeKind::U16Type: node = arena.make<U16TypeNode>(); break;
+          case NodeKind::U32Type: node = arena.make<U32TypeNode>(); break;
+          case NodeKind::U64Type: node = arena.make<U64TypeNode>(); break;
+          case NodeKind::F32Type: node = arena.make<F32TypeNode>(); break;
+          case NodeKind::F64Type: node = arena.make<F64TypeNode>(); break;
+          case NodeKind::CharType: node = arena.make<CharTypeNode>(); break;
+          case NodeKind::BoolType: node = arena.make<BoolTypeNode>(); break;
+          case NodeKind::VoidType: node = arena.make<VoidTypeNode>(); break;
+          case NodeKind::PtrType: node = arena.make<PtrTypeNode>(readNodeAs<TypeNode>()); break;
+          case NodeKind::ArrayType: {
+            auto elemType = readNodeAs<TypeNode>();
+            node = arena.make<ArrayTypeNode>(elemType, static_cast<size_t>(readVarint()));
+            break;
+          }
+          case NodeKind::FnType: {
+            auto fnType = arena.make<FnTypeNode>(readNodeAs<TypeNode>(), ArenaVector<TypeNode*>(arena));
+            readNodes(fnType->args);
+            node = fnType;
+            break;
+          }
+          case NodeKind::GenericsType: {
+            auto genericsType = arena.make<GenericsTypeNode>(readNames(), ArenaVector<TypeNode*>(arena));
+            readNodes(genericsType->generics);
+            node = genericsType;
+            break;
+          }
+          case NodeKind::UserDefineType: node = arena.make<UserDefineTypeNode>(readNames()); break;
+          case NodeKind::Block: {
+            auto block = arena.make<BlockNode>(ArenaVector<Node*>(arena));
+            readNodes(block->nodes);
+            node = block;
+            break;
+          }
+          case NodeKind::If: {
+            auto ifNode = arena.make<IfNode>();
+            ifNode->comp = readNodeAs<ExpressionNode>();
+            ifNode->thenExpr = readNodeAs<ExpressionNode>();
+            ifNode->elseExpr = readNodeAs<ExpressionNode>();
+            node = ifNode;
+            break;
+          }
+          case NodeKind::While: {
+            auto whileNode = arena.make<WhileNode>();
+            whileNode->comp = readNodeAs<ExpressionNode>();
+            whileNode->body = readNodeAs<ExpressionNode>();
+            node = whileNode;
+            break;
+          }
+          case NodeKind::Variable: {
+            auto variable = arena.make<VariableNode>(readString(), ArenaVector<TypeNode*>(arena));
+            readNodes(variable->generics);
+            node = variable;
+            break;
+          }
+          case NodeKind::ScopedVariable: {
+            auto variable = arena.make<ScopedVariableNode>(readString(), ArenaVector<TypeNode*>(arena), nullptr);
+            readNodes(variable->generics);
+            variable->child = readNodeAs<VariableNode>();
+            node = variable;
+            break;
+          }
+          case NodeKind::IntegerLiteral: node = readLiteral<IntegerLiteral>(); break;
+          case NodeKind::I8Literal: node = readLiteral<I8Literal>(); break;
+          case NodeKind::I16Literal: node = readLiteral<I16Literal>(); break;
+          case NodeKind::I32Literal: node = readLiteral<I32Literal>(); break;
+          case NodeKind::I64Literal: node = readLiteral<I64Literal>(); break;
+          case NodeKind::U8Literal: node = readLiteral<U8Literal>(); break;
+          case NodeKind::U16Literal: node = readLiteral<U16Literal>(); break;
+          case NodeKind::U32Literal: node = readLiteral<U32Literal>(); break;
+          case NodeKind::U64Literal: node = readLiteral<U64Literal>(); break;
+          case NodeKind::FloatLiteral: node = readLiteral<FloatLiteral>(); break;
+          case NodeKind::F32Literal: node = readLiteral<F32Literal>(); break;
+          case NodeKind::F64Literal: node = readLiteral<F64Literal>(); break;
+          case NodeKind::BoolLiteral: node = readLiteral<BoolLiteral>(); break;
+          case NodeKind::NullLiteral: node = arena.make<NullLiteral>(); break;
+          case NodeKind::CharLiteral: node = readLiteral<CharLiteral>(); break;
+          case NodeKind::StringLiteral: node = arena.make<StringLiteral>(readString()); break;
+          case NodeKind::ArrayLiteral: {
+            auto array = arena.make<ArrayLiteral>(ArenaVector<ExpressionNode*>(arena));
+            readNodes(array->value);
+            node = array;
+            break;
+          }
+          case NodeKind::MemberAccess: {
+            auto base = readNodeAs<ExpressionNode>();
+            node = arena.make<MemberAccessNode>(base, readNodeAs<VariableNode>());
+            break;
+          }
+          case NodeKind::ArrayAccess: {
+            auto base = readNodeAs<ExpressionNode>();
+            node = arena.make<ArrayAccessNode>(base, readNodeAs<ExpressionNode>());
+            break;
+          }
+          case NodeKind::Call: {
+            auto call = arena.make<CallNode>(readNodeAs<ExpressionNode>(), ArenaVector<ExpressionNode*>(arena));
+            readNodes(call->args);
+            node = call;
+            break;
+          }
+          case NodeKind::BackIncrement: node = readUnary<BackIncrementNode>(); break;
+          case NodeKind::BackDecrement: node = readUnary<BackDecrementNode>(); break;
+          case NodeKind::Plus: node = readUnary<PlusNode>(); break;
+          case NodeKind::Minus: node = readUnary<MinusNode>(); break;
+          case NodeKind::Copy: node = readUnary<CopyNode>(); break;
+          case NodeKind::BitNot: node = readUnary<BitNotNode>(); break;
+          case NodeKind::LogicalNot: node = readUnary<LogicalNotNode>(); break;
+          case NodeKind::FrontIncrement: node = readUnary<FrontIncrementNode>(); break;
+          case NodeKind::FrontDecrement: node = readUnary<FrontDecrementNode>(); break;
+          case NodeKind::Mul: node = readBinary<MulNode>(); break;
+          case NodeKind::Div: node = readBinary<DivNode>(); break;
+          case NodeKind::Mod: node = readBinary<ModNode>(); break;
+          case NodeKind::Add: node = readBinary<AddNode>(); break;
+          case NodeKind::Sub: node = readBinary<SubNode>(); break;
+          case NodeKind::Equal: node = readBinary<EqualNode>(); break;
+          case NodeKind::NotEqual: node = readBinary<NotEqualNode>(); break;
+          case NodeKind::GreaterEqual: node = readBinary<GreaterEqualNode>(); break;
+          case NodeKind::GreaterThan: node = readBinary<GreaterThanNode>(); break;
+          case NodeKind::LessEqual: node = readBinary<LessEqualNode>(); break;
+          case NodeKind::LessThan: node = readBinary<LessThanNode>(); break;
+          case NodeKind::LShift: node = readBinary<LShiftNode>(); break;
+          case NodeKind::RShift: node = readBinary<RShiftNode>(); break;
+          case NodeKind::BitAnd: node = readBinary<BitAndNode>(); break;
+          case NodeKind::BitOr: node = readBinary<BitOrNode>(); break;
+          case NodeKind::BitXor: node = readBinary<BitXorNode>(); break;
+          case NodeKind::LogicalAnd: node = readBinary<LogicalAndNode>(); break;
+          case NodeKind::LogicalOr: node = readBinary<LogicalOrNode>(); break;
+          case NodeKind::Asign: node = readBinary<AsignNode>(); break;
+          case NodeKind::AddAsign: node = readBinary<AddAsignNode>(); break;
+          case NodeKind::SubAsign: node = readBinary<SubAsignNode>(); break;
+          case NodeKind::MulAsign: node = readBinary<MulAsignNode>(); break;
+          case NodeKind::DivAsign: node = readBinary<DivAsignNode>(); break;
+          case NodeKind::ModAsign: node = readBinary<ModAsignNode>(); break;
+          case NodeKind::BitAndAsign: node = readBinary<BitAndAsignNode>(); break;
+          case NodeKind::BitOrAsign: node = readBinary<BitOrAsignNode>(); break;
+          case NodeKind::BitXorAsign: node = readBinary<BitXorAsignNode>(); break;
+          case NodeKind::LShiftAsign: node = readBinary<LShiftAsignNode>(); break;
+          case NodeKind::RShiftAsign: node = readBinary<RShiftAsignNode>(); break;
+          case NodeKind::Return: node = arena.make<ReturnNode>(readNodeAs<ExpressionNode>()); break;
+          case NodeKind::VariableDefine: {
+            auto varDef = arena.make<VariableDefineNode>();
+            varDef->isPub = read<bool>();
+            varDef->isMut = read<bool>();
+            varDef->name = readNodeAs<VariableNode>();
+            varDef->type = readNodeAs<TypeNode>();
+            varDef->init = readNodeAs<ExpressionNode>();
+            node = varDef;
+            break;
+          }
+          case NodeKind::ArgumentDefine: {
+            auto argDef = arena.make<ArgumentDefineNode>();
+            argDef->isMut = read<bool>();
+            argDef->name = readNodeAs<VariableNode>();
+            argDef->type = readNodeAs<TypeNode>();
+            argDef->init = readNodeAs<ExpressionNode>();
+            node = argDef;
+            break;
+          }
+          case NodeKind::FunctionDefine: node = readFunction<FunctionDefineNode>(); break;
+          case NodeKind::Extern: node = readFunction<ExternNode>(); break;
+          case NodeKind::ClassDefine: node = arena.make<ClassDefineNode>(); break;
+          case NodeKind::AliasDefine: node = arena.make<AliasDefineNode>(); break;
+          case NodeKind::Import: node = arena.make<ImportNode>(readNodeAs<VariableNode>()); break;
+          default:
+            failed = true;
+            return nullptr;
+        }
+        node->span = span;
+        return node;
+      }
+    };
+  }
+  ASTCache::ASTCache(const std::string& dir, bool deferBodies) :
+    dir(dir),
+    seed(hashBytes(std::string_view(VERSION), FORMAT_VERSION * 2 + (deferBodies ? 1 : 0)))
+  {
+    // 作れなければstoreが失敗するだけなので、エラーは無視する。
+    std::error_code err;
+    std::filesystem::create_directories(dir, err);
+  }
+  std::string ASTCache::entryPath(uint64_t key) const
+  {
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(dir) / (std::string(name) + ".ast")).string();
+  }
+  uint64_t ASTCache::key(const SourceFile& source) const
+  {
+    return hashBytes(source.text(), seed);
+  }
+  bool ASTCache::load(uint64_t key, const std::shared_ptr<const SourceFile>& source, TokenSequence& sequence, RootNode& ast, Arena& arena) const
+  {
+    const auto path = entryPath(key);
+    if(auto entry = ResidentCache::get(path)) return decode(entry->data(), entry->data() + entry->size(), key, source, sequence, ast, arena);
+    auto file = MappedFile::open(path);
+    if(!file) return false;
+    const auto data = file.get().data();
+    if(!decode(data, data + file.get().size(), key, source, sequence, ast, arena)) return false;
+    if(ResidentCache::enabled()) ResidentCache::put(path, std::string(file.get().view()));
+    return true;
+  }
+  bool ASTCache::decode(const char* begin, const char* end, uint64_t key, const std::shared_ptr<const SourceFile>& source, TokenSequence& sequence, RootNode& ast, Arena& arena) const
+  {
+    Reader reader(begin, end, arena);
+    const auto header = reader.read<Header>();
+    if(reader.failed
+      || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+      || header.formatVersion != FORMAT_VERSION
+      || header.key != key
+      || header.sourceSize != source->text().size()) {
+      return false;
+    }
+    reader.limit(header.sourceSize, header.numTokens);
+
+    TokenSequence loaded{ source->getPath(), source, {}, {}, {}, {} };
+    reader.readTokens(loaded, header.numTokens);
+    reader.readTokens(loaded.comments, header.numComments);
+    if(reader.failed) return false;
+
+    RootNode root;
+    root.span = reader.readSpan();
+    const auto numNodes = reader.readVarint();
+    for(uint64_t i = 0; i < numNodes && !reader.failed; ++i) root.nodes.push_back(reader.readNodeAs<Node>());
+    if(reader.failed || !reader.atEnd()) return false;
+
+    sequence = std::move(loaded);
+    ast = std::move(root);
+    return true;
+  }
+  void ASTCache::store(uint64_t key, const TokenSequence& sequence, const RootNode& ast) const
+  {
+    std::string out;
+    out.reserve(sizeof(Header) + sequence.size() * 8);
+    Writer writer(out);
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.key = key;
+    header.sourceSize = sequence.source->text().size();
+    header.numTokens = static_cast<uint32_t>(sequence.size());
+    header.numComments = static_cast<uint32_t>(sequence.comments.size());
+    writer.write(header);
+    writer.writeTokens(sequence);
+    writer.writeTokens(sequence.comments);
+    writer.writeSpan(ast.span);
+    writer.writeVarint(ast.nodes.size());
+    for(auto node : ast.nodes) writer.writeNode(node);
+
+    // 書きかけのファイルを読まれないよう、一時ファイルに書いてから置き換える。
+    std::error_code err;
+    const auto path = entryPath(key);
+    std::ostringstream tmp;
+    tmp << path << '.' << std::this_thread::get_id() << '.' << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+    {
+      std::ofstream file(tmp.str(), std::ios::binary | std::ios::trunc);
+      if(!file) return;
+      file.write(out.data(), out.size());
+      if(!file) {
+        file.close();
+        std::filesystem::remove(tmp.str(), err);
+        return;
+      }
+    }
+    std::filesystem::rename(tmp.str(), path, err);
+    if(err) std::filesystem::remove(tmp.str(), err);
+    else ResidentCache::put(path, std::move(out));
+  }
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef PICKC_PARSER_AST_CACHE_H_
+#define PICKC_PARSER_AST_CACHE_H_
+
+#include <string>
+#include <memory>
+#include <cstdint>
+
+#include "utils/arena.h"
+#include "source.h"
+#include "token.h"
+#include "ast_node.h"
+
+namespace pickc::parser
+{
+  // 字句解析と構文解析の結果をディレクトリに保存し、内容の変わっていないファイルの構文解析を省略する。
+  // キーはソースの内容のハッシュで、コンパイラのバージョンと本文を後回しにするかどうかも混ぜてある。
+  // エントリは書き込み後にrenameで置くので、複数のスレッドやプロセスが同じディレクトリを使ってもよい。
+  // ResidentCacheが有効なら、エントリはメモリからも読む。
+  class ASTCache
+  {
+    std::string dir;
+    uint64_t seed;
+    std::string entryPath(uint64_t key) const;
+    bool decode(const char* begin, const char* end, uint64_t key, const std::shared_ptr<const SourceFile>& source, TokenSequence& sequence, RootNode& ast, Arena& arena) const;
+  public:
+    ASTCache(const std::string& dir, bool deferBodies);
+    uint64_t key(const SourceFile& source) const;
+    // keyのエントリがあればトークン列とASTを復元してtrueを返す。ノードはarenaに確保する。
+    // エントリが無いか壊れていればfalseを返す。このときarenaに確保したものは解放しない。
+    bool load(uint64_t key, const std::shared_ptr<const SourceFile>& source, TokenSequence& sequence, RootNode& ast, Arena& arena) const;
+    // 書き込めなくてもコンパイルには影響しないので、失敗は無視する。
+    void store(uint64_t key, const TokenSequence& sequence, const RootNode& ast) const;
+  };
+}
+
+#endif // PICKC_PARSER_AST_CACHE_H_
\ No newline at end of file
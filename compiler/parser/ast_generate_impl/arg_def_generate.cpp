@@ -4,19 +4,19 @@
 
 namespace pickc::parser
 {
-  Result<std::vector<ArgumentDefineNode*>, std::vector<std::string>> ASTGenerator::argDefGenerate()
+  Result<ArenaVector<ArgumentDefineNode*>, std::vector<std::string>> ASTGenerator::argDefGenerate()
   {
     assert(currentToken().kind == TokenKind::LParen);
 
     auto token = nextToken();
     if(!token) return error(createEOTError(")が必要です。"));
-    if(token.get().kind == TokenKind::RParen) return ok(std::vector<ArgumentDefineNode*>());
+    ArenaVector<ArgumentDefineNode*> args(arena);
+    if(token.get().kind == TokenKind::RParen) return ok(args);
 
-    std::vector<std::unique_ptr<ArgumentDefineNode>> args;
     std::vector<std::string> errors;
     const auto argGen = [&]() -> Option<std::vector<std::string>> {
-      auto begin = currentTokenIter();
-      auto argDef = std::make_unique<ArgumentDefineNode>();
+      const auto begin = _tokenIndex;
+      auto argDef = arena.make<ArgumentDefineNode>();
       if(token.get().kind == TokenKind::DefKeyword) {
         argDef->isMut = false;
         token = nextToken();
@@ -48,8 +48,8 @@ namespace pickc::parser
         else errors += expr.err();
       }
 
-      argDef->tokens = std::vector(begin, currentTokenIter() + 1);
-      args.emplace_back(std::move(argDef));
+      argDef->span = spanFrom(begin);
+      args.push_back(argDef);
       return none;
     };
 
@@ -69,13 +69,7 @@ namespace pickc::parser
       }
     }
 
-    if(errors.empty()) {
-      std::vector<ArgumentDefineNode*> result;
-      for(auto& arg : args) {
-        result.push_back(arg.release());
-      }
-      return ok(std::move(result));
-    }
-    return error(errors);
+    if(errors.empty()) return ok(args);
+    return error(std::move(errors));
   }
 }
\ No newline at end of file
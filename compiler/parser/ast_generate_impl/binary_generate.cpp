@@ -0,0 +1,97 @@
+#include "ast.h"
+
+#include <array>
+
+namespace pickc::parser
+{
+  namespace
+  {
+    // 二項演算子の優先順位。値が大きいほど強く結合する。
+    enum Precedence : uint8_t
+    {
+      None,
+      Asign,          // = += -= *= /= %= &= |= ^= <<= >>= (右結合)
+      LogicalOr,      // ||
+      LogicalAnd,     // &&
+      BitOr,          // |
+      BitXor,         // ^
+      BitAnd,         // &
+      Comparison,     // == != < <= > >=
+      Shift,          // << >>
+      Additive,       // + -
+      Multiplicative, // * / %
+    };
+    struct BinaryOperator
+    {
+      Precedence precedence;
+      BinaryNode* (*make)(Arena& arena, ExpressionNode* left, ExpressionNode* right);
+    };
+    template<typename T>
+    BinaryNode* makeBinary(Arena& arena, ExpressionNode* left, ExpressionNode* right)
+    {
+      return arena.make<T>(left, right);
+    }
+    // TokenKindで引く演算子表。演算子でないトークンはNoneになる。
+    constexpr std::array<BinaryOperator, 1 << (8 * sizeof(TokenKind))> createBinaryOperators()
+    {
+      std::array<BinaryOperator, 1 << (8 * sizeof(TokenKind))> table{};
+      const auto set = [&table](TokenKind kind, Precedence precedence, auto make) {
+        table[static_cast<size_t>(kind)] = BinaryOperator{ precedence, make };
+      };
+      set(TokenKind::Asign, Asign, makeBinary<AsignNode>);
+      set(TokenKind::AddAsign, Asign, makeBinary<AddAsignNode>);
+      set(TokenKind::SubAsign, Asign, makeBinary<SubAsignNode>);
+      set(TokenKind::MulAsign, Asign, makeBinary<MulAsignNode>);
+      set(TokenKind::DivAsign, Asign, makeBinary<DivAsignNode>);
+      set(TokenKind::ModAsign, Asign, makeBinary<ModAsignNode>);
+      set(TokenKind::BitAndAsign, Asign, makeBinary<BitAndAsignNode>);
+      set(TokenKind::BitOrAsign, Asign, makeBinary<BitOrAsignNode>);
+      set(TokenKind::BitXorAsign, Asign, makeBinary<BitXorAsignNode>);
+      set(TokenKind::LShiftAsign, Asign, makeBinary<LShiftAsignNode>);
+      set(TokenKind::RShiftAsign, Asign, makeBinary<RShiftAsignNode>);
+      set(TokenKind::LogicalOr, LogicalOr, makeBinary<LogicalOrNode>);
+      set(TokenKind::LogicalAnd, LogicalAnd, makeBinary<LogicalAndNode>);
+      set(TokenKind::BitOr, BitOr, makeBinary<BitOrNode>);
+      set(TokenKind::BitXor, BitXor, makeBinary<BitXorNode>);
+      set(TokenKind::BitAnd, BitAnd, makeBinary<BitAndNode>);
+      set(TokenKind::Equal, Comparison, makeBinary<EqualNode>);
+      set(TokenKind::NotEqual, Comparison, makeBinary<NotEqualNode>);
+      set(TokenKind::GreaterEqual, Comparison, makeBinary<GreaterEqualNode>);
+      set(TokenKind::GreaterThan, Comparison, makeBinary<GreaterThanNode>);
+      set(TokenKind::LessEqual, Comparison, makeBinary<LessEqualNode>);
+      set(TokenKind::LessThan, Comparison, makeBinary<LessThanNode>);
+      set(TokenKind::LShift, Shift, makeBinary<LShiftNode>);
+      set(TokenKind::RShift, Shift, makeBinary<RShiftNode>);
+      set(TokenKind::Plus, Additive, makeBinary<AddNode>);
+      set(TokenKind::Minus, Additive, makeBinary<SubNode>);
+      set(TokenKind::Asterisk, Multiplicative, makeBinary<MulNode>);
+      set(TokenKind::Slash, Multiplicative, makeBinary<DivNode>);
+      set(TokenKind::Percent, Multiplicative, makeBinary<ModNode>);
+      return table;
+    }
+    constexpr auto binaryOperators = createBinaryOperators();
+  }
+  // 優先順位がminPrecedence以上の二項演算子だけを読む優先順位法。
+  // 代入以外は左結合で、右辺は一つ上の優先順位から読む。
+  Result<ExpressionNode*, std::vector<std::string>> ASTGenerator::binaryGenerate(uint8_t minPrecedence)
+  {
+    const auto begin = _tokenIndex;
+    auto left = frontUnaryGenerate();
+    if(!left) return error(std::move(left.err()));
+
+    auto result = left.get();
+    while(hasNext()) {
+      const auto& op = binaryOperators[static_cast<size_t>(sequence.kinds[_tokenIndex + 1])];
+      if(op.precedence == None || op.precedence < minPrecedence) break;
+      ++_tokenIndex;
+      if(!nextToken()) return error(createEOTError("式が必要です。"));
+      // 代入の右辺にはfnやdefも書ける。
+      auto right = op.precedence == Asign ? exprGenerate() : binaryGenerate(op.precedence + 1);
+      if(!right) return error(std::move(right.err()));
+      result = op.make(arena, result, right.get());
+      result->span = spanFrom(begin);
+      if(op.precedence == Asign) break;
+    }
+    return ok(result);
+  }
+}
\ No newline at end of file
@@ -9,17 +9,17 @@ namespace pickc::parser
     switch(currentToken().kind) {
       case TokenKind::FnKeyword: {
         auto fn = fnDefGenerate();
-        if(!fn) return error(fn.err());
+        if(!fn) return error(std::move(fn.err()));
         return ok(fn.get());
       }
       case TokenKind::DefKeyword:
       case TokenKind::MutKeyword: {
         auto var = varDefGenerate();
-        if(!var) return error(var.err());
+        if(!var) return error(std::move(var.err()));
         return ok(var.get());
       }
       default:
-        return asignGenerate();
+        return binaryGenerate();
     }
   }
 }
\ No newline at end of file
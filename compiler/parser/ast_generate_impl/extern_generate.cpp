@@ -7,8 +7,8 @@ namespace pickc::parser
   Result<ExternNode*, std::vector<std::string>> ASTGenerator::externGenerate()
   {
     assert(currentToken().kind == TokenKind::ExternKeyword);
-    auto begin = currentTokenIter();
-    auto ext = std::make_unique<ExternNode>();
+    const auto begin = _tokenIndex;
+    auto ext = arena.make<ExternNode>(arena);
     std::vector<std::string> errors;
     if(!nextToken()) return error(createEOTError("関数名が必要です。"));
     if(currentToken().kind != TokenKind::Identify) errors.push_back(createASTError("関数名が必要です。", currentToken()));
@@ -25,8 +25,8 @@ namespace pickc::parser
       if(auto retType = typeGenerate()) ext->retType = retType.get();
       else errors += retType.err();
     }
-    ext->tokens = std::vector(begin, currentTokenIter() + 1);
-    if(errors.empty()) return ok(ext.release());
-    return error(errors);
+    ext->span = spanFrom(begin);
+    if(errors.empty()) return ok(ext);
+    return error(std::move(errors));
   }
 }
\ No newline at end of file
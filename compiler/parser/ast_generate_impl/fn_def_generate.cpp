@@ -4,11 +4,11 @@
 
 namespace pickc::parser
 {
-  Result<FunctionDefineNode*, std::vector<std::string>> ASTGenerator::fnDefGenerate()
+  Result<FunctionDefineNode*, std::vector<std::string>> ASTGenerator::fnDefGenerate(bool deferBody)
   {
     assert(currentToken().kind == TokenKind::FnKeyword);
-    auto begin = currentTokenIter();
-    auto fnDef = std::make_unique<FunctionDefineNode>();
+    const auto begin = _tokenIndex;
+    auto fnDef = arena.make<FunctionDefineNode>(arena);
     std::vector<std::string> errors;
     if(!nextToken()) return error(createEOTError("関数名または(が必要です。"));
     if(currentToken().kind == TokenKind::Identify) {
@@ -26,12 +26,26 @@ namespace pickc::parser
       else errors += retType.err();
       if(!nextToken()) return error(errors + createEOTError("関数の本文が必要です。"));
     }
-    if(auto body = exprGenerate()) fnDef->body = body.get();
-    else errors += body.err();
+    // 本文が{ ... }だけなら対応する}まで読み飛ばす。後ろに演算子などが続く場合は後回しにできない。
+    if(deferBody && currentToken().kind == TokenKind::LBrace) {
+      const auto last = matchingBrace(_tokenIndex);
+      if(last >= 0 && (last + 1 == static_cast<int>(sequence.size()) || includes({
+        TokenKind::Semicolon, TokenKind::PubKeyword, TokenKind::PriKeyword, TokenKind::FnKeyword, TokenKind::DefKeyword, TokenKind::MutKeyword,
+        TokenKind::ClassKeyword, TokenKind::TypeKeyword, TokenKind::ImportKeyword, TokenKind::ExternKeyword
+      }, sequence.kinds[last + 1]))) {
+        fnDef->isBodyDeferred = true;
+        fnDef->bodySpan = SourceSpan{ static_cast<uint32_t>(_tokenIndex), static_cast<uint32_t>(last) };
+        _tokenIndex = last;
+      }
+    }
+    if(!fnDef->isBodyDeferred) {
+      if(auto body = exprGenerate()) fnDef->body = body.get();
+      else errors += body.err();
+    }
     if(errors.empty()) {
-      fnDef->tokens = std::vector(begin, currentTokenIter() + 1);
-      return ok(fnDef.release());
+      fnDef->span = spanFrom(begin);
+      return ok(fnDef);
     }
-    return error(errors);
+    return error(std::move(errors));
   }
 }
\ No newline at end of file
@@ -6,33 +6,39 @@ namespace pickc::parser
 {
   Result<ExpressionNode*, std::vector<std::string>> ASTGenerator::frontUnaryGenerate()
   {
-    if(includes({ TokenKind::Plus, TokenKind::Minus, TokenKind::Inc, TokenKind::Dec }, currentToken().kind)) {
-      auto begin = currentTokenIter();
+    if(includes({ TokenKind::Plus, TokenKind::Minus, TokenKind::Inc, TokenKind::Dec, TokenKind::BitNot, TokenKind::LogicalNot, TokenKind::Copy }, currentToken().kind)) {
+      const auto begin = _tokenIndex;
       const auto op = currentToken().kind;
       if(!nextToken()) return error(createEOTError("式が必要です。"));
       auto base = frontUnaryGenerate();
-      if(!base) return error(base.err());
+      if(!base) return error(std::move(base.err()));
       FrontUnaryNode* node = nullptr;
       switch(op) {
         case TokenKind::Plus:
-          node = new PlusNode(base.get());
+          node = arena.make<PlusNode>(base.get());
           break;
         case TokenKind::Minus:
-          node = new MinusNode(base.get());
+          node = arena.make<MinusNode>(base.get());
           break;
         case TokenKind::Inc:
-          node = new FrontIncrementNode(base.get());
+          node = arena.make<FrontIncrementNode>(base.get());
           break;
         case TokenKind::Dec:
-          node = new FrontDecrementNode(base.get());
+          node = arena.make<FrontDecrementNode>(base.get());
+          break;
+        case TokenKind::BitNot:
+          node = arena.make<BitNotNode>(base.get());
+          break;
+        case TokenKind::LogicalNot:
+          node = arena.make<LogicalNotNode>(base.get());
           break;
         case TokenKind::Copy:
-          node = new CopyNode(base.get());
+          node = arena.make<CopyNode>(base.get());
           break;
         default:
           assert(false);
       }
-      node->tokens = std::vector(begin, currentTokenIter() + 1);
+      node->span = spanFrom(begin);
       return ok(node);
     }
     return backUnaryGenerate();
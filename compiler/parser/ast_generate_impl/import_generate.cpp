@@ -8,20 +8,20 @@ namespace pickc::parser
   {
     assert(currentToken().kind == TokenKind::ImportKeyword);
     std::vector<std::string> errors;
-    auto begin = currentTokenIter();
+    const auto begin = _tokenIndex;
     if(!nextToken()) return error(createEOTError("モジュール名が必要です。"));
     if(currentToken().kind != TokenKind::Identify) errors.push_back(createASTError("モジュール名に記号やキーワードは使用できません。", currentToken()));
-    auto cur = std::make_unique<VariableNode>(currentToken().value, std::vector<TypeNode*>{});
+    VariableNode* cur = arena.make<VariableNode>(sequence.value(currentToken()), ArenaVector<TypeNode*>(arena));
     while(true) {
       if(!nextToken() || currentToken().kind != TokenKind::Scope) {
         backToken(true);
-        auto import = new ImportNode(cur.release());
-        import->tokens = std::vector(begin, currentTokenIter() + 1);
+        auto import = arena.make<ImportNode>(cur);
+        import->span = spanFrom(begin);
         return ok(import);
       }
       if(!nextToken()) return error(errors + createEOTError("モジュール名が必要です。"));
       if(currentToken().kind != TokenKind::Identify) errors.push_back(createASTError("モジュール名に記号やキーワードは使用できません。", currentToken()));
-      cur = std::unique_ptr<VariableNode>(new ScopedVariableNode(currentToken().value, {}, cur.release()));
+      cur = arena.make<ScopedVariableNode>(sequence.value(currentToken()), ArenaVector<TypeNode*>(arena), cur);
     }
   }
 }
\ No newline at end of file
@@ -6,59 +6,59 @@ namespace pickc::parser
 {
   Result<ExpressionNode*, std::vector<std::string>> ASTGenerator::primaryGenerate()
   {
-    auto begin = currentTokenIter();
+    const auto begin = _tokenIndex;
     const auto kind = currentToken().kind;
-    const auto value = currentToken().value;
+    const auto value = sequence.value(currentToken());
     ExpressionNode* node = nullptr;
     switch(kind) {
       case TokenKind::Integer:
-        node = new IntegerLiteral(std::stoi(value));
+        node = arena.make<IntegerLiteral>(std::stoi(value));
         break;
       case TokenKind::I8:
-        node = new I8Literal(static_cast<int8_t>(std::stoi(value.substr(0, value.size() - 2))));
+        node = arena.make<I8Literal>(static_cast<int8_t>(std::stoi(value.substr(0, value.size() - 2))));
         break;
       case TokenKind::I16:
-        node = new I16Literal(static_cast<int16_t>(std::stoi(value.substr(0, value.size() - 3))));
+        node = arena.make<I16Literal>(static_cast<int16_t>(std::stoi(value.substr(0, value.size() - 3))));
         break;
       case TokenKind::I32:
-        node = new I32Literal(std::stoi(value.substr(0, value.size() - 3)));
+        node = arena.make<I32Literal>(std::stoi(value.substr(0, value.size() - 3)));
         break;
       case TokenKind::I64:
-        node = new I64Literal(std::stoll(value.substr(0, value.size() - 3)));
+        node = arena.make<I64Literal>(std::stoll(value.substr(0, value.size() - 3)));
         break;
       case TokenKind::U8:
-        node = new U8Literal(static_cast<uint8_t>(std::stoul(value.substr(0, value.size() - 2))));
+        node = arena.make<U8Literal>(static_cast<uint8_t>(std::stoul(value.substr(0, value.size() - 2))));
         break;
       case TokenKind::U16:
-        node = new U16Literal(static_cast<uint16_t>(std::stoul(value.substr(0, value.size() - 3))));
+        node = arena.make<U16Literal>(static_cast<uint16_t>(std::stoul(value.substr(0, value.size() - 3))));
         break;
       case TokenKind::U32:
-        node = new U32Literal(std::stoul(value.substr(0, value.size() - 3)));
+        node = arena.make<U32Literal>(std::stoul(value.substr(0, value.size() - 3)));
         break;
       case TokenKind::U64:
-        node = new U64Literal(std::stoull(value.substr(0, value.size() - 3)));
+        node = arena.make<U64Literal>(std::stoull(value.substr(0, value.size() - 3)));
         break;
       case TokenKind::Float:
-        node = new FloatLiteral(std::stod(value));
+        node = arena.make<FloatLiteral>(std::stod(value));
         break;
       case TokenKind::F32:
-        node = new F32Literal(std::stof(value));
+        node = arena.make<F32Literal>(std::stof(value));
         break;
       case TokenKind::F64:
-        node = new F64Literal(std::stod(value));
+        node = arena.make<F64Literal>(std::stod(value));
         break;
       case TokenKind::Bool:
         assert(value == "true" || value == "false");
-        node = new BoolLiteral(value == "true");
+        node = arena.make<BoolLiteral>(value == "true");
         break;
       case TokenKind::Null:
-        node = new NullLiteral();
+        node = arena.make<NullLiteral>();
         break;
       case TokenKind::Char:
-        node = new CharLiteral(value[0]);
+        node = arena.make<CharLiteral>(value[0]);
         break;
       case TokenKind::String:
-        node = new StringLiteral(value);
+        node = arena.make<StringLiteral>(value);
         break;
       case TokenKind::LBracket: {
         // TODO: 配列リテラル
@@ -66,7 +66,7 @@ namespace pickc::parser
       }
       case TokenKind::Identify: {
         auto var = variableGenerate();
-        if(!var) return error(var.err());
+        if(!var) return error(std::move(var.err()));
         auto result = var.get();
         while(true) {
           auto scope = nextToken();
@@ -77,29 +77,23 @@ namespace pickc::parser
           }
           if(!nextToken()) return error(createEOTError("変数名が必要です。"));
           var = variableGenerate();
-          if(!var) return error(var.err());
-          result = new ScopedVariableNode(var.get()->name, var.get()->generics, result);
+          if(!var) return error(std::move(var.err()));
+          result = arena.make<ScopedVariableNode>(var.get()->name, var.get()->generics, result);
         }
         break;
       }
       case TokenKind::LParen: {
         if(!nextToken()) return error(createEOTError("式が必要です。"));
         auto expr = exprGenerate();
-        if(!expr) return error(expr.err());
+        if(!expr) return error(std::move(expr.err()));
         auto rp = nextToken();
-        if(!rp) {
-          delete expr.get();
-          return error(createEOTError(")が必要です。"));
-        }
-        if(rp.get().kind != TokenKind::RParen) {
-          delete expr.get();
-          return error(std::vector{ createASTError(")が必要です。", rp.get()) });
-        }
+        if(!rp) return error(createEOTError(")が必要です。"));
+        if(rp.get().kind != TokenKind::RParen) return error(std::vector{ createASTError(")が必要です。", rp.get()) });
         node = expr.get();
         break;
       }
       case TokenKind::LBrace: {
-        std::vector<std::unique_ptr<Node>> unodes;
+        ArenaVector<Node*> nodes(arena);
         std::vector<std::string> errors;
         while(true) {
           auto next = nextToken();
@@ -108,29 +102,29 @@ namespace pickc::parser
           switch(next.get().kind) {
             case TokenKind::DefKeyword:
             case TokenKind::MutKeyword: {
-              if(auto varDef = varDefGenerate()) unodes.emplace_back(std::move(varDef.get()));
+              if(auto varDef = varDefGenerate()) nodes.push_back(varDef.get());
               else errors += varDef.err();
               break;
             }
             case TokenKind::FnKeyword: {
-              if(auto fnDef = fnDefGenerate()) unodes.emplace_back(std::move(fnDef.get()));
+              if(auto fnDef = fnDefGenerate()) nodes.push_back(fnDef.get());
               else errors += fnDef.err();
               break;
             }
             case TokenKind::ReturnKeyword: {
-              auto now = currentTokenIter();
+              const auto now = _tokenIndex;
               next = nextToken();
               if(!next) return error(createEOTError("式が必要です。"));
               if(includes({ TokenKind::Semicolon, TokenKind::RBrase }, next.get().kind)) {
-                auto ret = std::make_unique<ReturnNode>(nullptr);
-                ret->tokens = std::vector(now, currentTokenIter() + 1);
-                unodes.emplace_back(std::move(ret));
+                auto ret = arena.make<ReturnNode>(nullptr);
+                ret->span = spanFrom(now);
+                nodes.push_back(ret);
               }
               else {
                 auto expr = exprGenerate();
-                auto ret = std::make_unique<ReturnNode>(expr.get());
-                ret->tokens = std::vector(now, currentTokenIter() + 1);
-                if(expr) unodes.emplace_back(std::move(ret));
+                auto ret = arena.make<ReturnNode>(expr.get());
+                ret->span = spanFrom(now);
+                if(expr) nodes.push_back(ret);
                 else errors += expr.err();
               }
               break;
@@ -140,21 +134,16 @@ namespace pickc::parser
               break;
             default: {
               auto expr = exprGenerate();
-              if(expr) unodes.emplace_back(std::unique_ptr<Node>(expr.get()));
+              if(expr) nodes.push_back(expr.get());
               else errors += expr.err();
             }
           }
         }
         if(errors.empty()) {
-          auto block = new BlockNode();
-          block->nodes.reserve(unodes.size());
-          for(auto& unode : unodes) {
-            block->nodes.push_back(unode.release());
-          }
-          node = block;
+          node = arena.make<BlockNode>(nodes);
         }
         else {
-          return error(errors);
+          return error(std::move(errors));
         }
         break;
       }
@@ -179,14 +168,14 @@ namespace pickc::parser
           }
         }
         if(errors.empty()) {
-          auto ifNode = new IfNode();
+          auto ifNode = arena.make<IfNode>();
           ifNode->comp = comp.get();
           ifNode->thenExpr = thenExpr.get();
           ifNode->elseExpr = elseExpr;
           node = ifNode;
         }
         else {
-          return error(errors);
+          return error(std::move(errors));
         }
         break;
       }
@@ -202,7 +191,7 @@ namespace pickc::parser
         if(!nextToken()) return error(errors + createEOTError("式が必要です。"));
         auto body = exprGenerate();
         if(!body) errors += body.err();
-        auto whileNode = new WhileNode();
+        auto whileNode = arena.make<WhileNode>();
         whileNode->comp = comp.get();
         whileNode->body = body.get();
         node = whileNode;
@@ -212,7 +201,7 @@ namespace pickc::parser
         assert(false);
         return error(std::vector{ createASTError("予期しないトークンです。", currentToken()) });
     }
-    node->tokens = std::vector(begin, currentTokenIter() + 1);
+    node->span = spanFrom(begin);
     return ok(node);
   }
 }
\ No newline at end of file
@@ -6,48 +6,48 @@ namespace pickc::parser
 {
   Result<TypeNode*, std::vector<std::string>> ASTGenerator::typeGenerate()
   {
-    auto begin = currentTokenIter();
-    std::unique_ptr<TypeNode> type;
+    const auto begin = _tokenIndex;
+    TypeNode* type = nullptr;
     std::vector<std::string> errors;
     switch(currentToken().kind) {
       case TokenKind::I8Keyword:
-        type = std::make_unique<I8TypeNode>();
+        type = arena.make<I8TypeNode>();
         break;
       case TokenKind::I16Keyword:
-        type = std::make_unique<I16TypeNode>();
+        type = arena.make<I16TypeNode>();
         break;
       case TokenKind::I32Keyword:
-        type = std::make_unique<I32TypeNode>();
+        type = arena.make<I32TypeNode>();
         break;
       case TokenKind::I64Keyword:
-        type = std::make_unique<I64TypeNode>();
+        type = arena.make<I64TypeNode>();
         break;
       case TokenKind::U8Keyword:
-        type = std::make_unique<U8TypeNode>();
+        type = arena.make<U8TypeNode>();
         break;
       case TokenKind::U16Keyword:
-        type = std::make_unique<U16TypeNode>();
+        type = arena.make<U16TypeNode>();
         break;
       case TokenKind::U32Keyword:
-        type = std::make_unique<U32TypeNode>();
+        type = arena.make<U32TypeNode>();
         break;
       case TokenKind::U64Keyword:
-        type = std::make_unique<U64TypeNode>();
+        type = arena.make<U64TypeNode>();
         break;
       case TokenKind::F32Keyword:
-        type = std::make_unique<F32TypeNode>();
+        type = arena.make<F32TypeNode>();
         break;
       case TokenKind::F64Keyword:
-        type = std::make_unique<F64TypeNode>();
+        type = arena.make<F64TypeNode>();
         break;
       case TokenKind::CharKeyword:
-        type = std::make_unique<CharTypeNode>();
+        type = arena.make<CharTypeNode>();
         break;
       case TokenKind::BoolKeyword:
-        type = std::make_unique<BoolTypeNode>();
+        type = arena.make<BoolTypeNode>();
         break;
       case TokenKind::VoidKeyword:
-        type = std::make_unique<VoidTypeNode>();
+        type = arena.make<VoidTypeNode>();
         break;
       case TokenKind::PtrKeyword: {
         auto next = nextToken();
@@ -55,11 +55,11 @@ namespace pickc::parser
         if(next.get().kind != TokenKind::LessThan) return error(std::vector{ createASTError("<が必要です。", next.get()) });
         if(!nextToken()) return error(createEOTError("型名が必要です。"));
         auto base = typeGenerate();
-        if(!base) return error(base.err());
+        if(!base) return error(std::move(base.err()));
         next = nextToken();
         if(!next) return error(createEOTError(">が必要です。"));
         if(next.get().kind != TokenKind::GreaterThan) return error(std::vector{ createASTError(">が必要です。", next.get()) });
-        type = std::make_unique<PtrTypeNode>(base.get());
+        type = arena.make<PtrTypeNode>(base.get());
         break;
       }
       case TokenKind::FnKeyword: {
@@ -71,7 +71,7 @@ namespace pickc::parser
         }
         next = nextToken();
         if(!next) return error(errors + createEOTError(")が必要です。"));
-        std::vector<std::unique_ptr<TypeNode>> uargs;
+        ArenaVector<TypeNode*> args(arena);
         if(next.get().kind != TokenKind::RParen) {
           while(true) {
             auto arg = typeGenerate();
@@ -79,7 +79,7 @@ namespace pickc::parser
               errors += arg.err();
               break;
             }
-            uargs.push_back(std::unique_ptr<TypeNode>(arg.get()));
+            args.push_back(arg.get());
             next = nextToken();
             if(!next) return error(errors + createEOTError(")が必要です。"));
             if(next.get().kind == TokenKind::RParen) break;
@@ -100,16 +100,11 @@ namespace pickc::parser
           errors += retType.err();
           break;
         }
-        std::vector<TypeNode*> args;
-        args.reserve(uargs.size());
-        for(auto& arg : uargs) {
-          args.push_back(arg.release());
-        }
-        type = std::make_unique<FnTypeNode>(retType.get(), args);
+        type = arena.make<FnTypeNode>(retType.get(), args);
         break;
       }
       case TokenKind::Identify: {
-        std::vector<std::string> name{ currentToken().value };
+        std::vector<std::string> name{ sequence.value(currentToken()) };
         while(auto token = nextToken()) {
           if(token.get().kind == TokenKind::Scope) {
             token = nextToken();
@@ -118,28 +113,28 @@ namespace pickc::parser
               errors.push_back(createASTError("型名にキーワードや記号は使用できません。", token.get()));
               continue;
             }
-            name.push_back(token.get().value);
+            name.push_back(sequence.value(token.get()));
           }
           else {
             backToken(true);
             break;
           }
         }
-        type = std::make_unique<UserDefineTypeNode>(name);
+        type = arena.make<UserDefineTypeNode>(name);
         auto next = nextToken();
         if(!next || next.get().kind != TokenKind::LessThan) {
           backToken(true);
           break;
         }
         if(!nextToken()) return error(errors + createEOTError("型名が必要です。"));
-        std::vector<std::unique_ptr<TypeNode>> types;
+        ArenaVector<TypeNode*> generics(arena);
         while(true) {
           auto gen = typeGenerate();
           if(!gen) {
             errors += gen.err();
             break;
           }
-          types.emplace_back(std::unique_ptr<TypeNode>(gen.get()));
+          generics.push_back(gen.get());
           next = nextToken();
           if(!next) return error(errors + createEOTError(">が必要です。"));
           if(next.get().kind == TokenKind::GreaterThan) break;
@@ -150,12 +145,7 @@ namespace pickc::parser
           errors.push_back(">が必要です。");
           break;
         }
-        std::vector<TypeNode*> generics;
-        generics.reserve(types.size());
-        for(auto& t : types) {
-          generics.push_back(t.release());
-        }
-        type = std::make_unique<GenericsTypeNode>(dynamic_cast<UserDefineTypeNode*>(type.release())->name, generics);
+        type = arena.make<GenericsTypeNode>(dynamic_cast<UserDefineTypeNode*>(type)->name, generics);
         break;
       }
       default:
@@ -166,7 +156,7 @@ namespace pickc::parser
       token = nextToken();
       if(!token) return error(createEOTError("配列の大きさが必要です。"));
       if(token.get().kind != TokenKind::Integer) return error(std::vector{ createASTError("配列の大きさが必要です。", token.get()) });
-      type = std::make_unique<ArrayTypeNode>(type.release(), std::stoull(token.get().value));
+      type = arena.make<ArrayTypeNode>(type, std::stoull(sequence.value(token.get())));
       token = nextToken();
       if(!token) return error(createEOTError("]が必要です。"));
       if(token.get().kind != TokenKind::RBracket) return error(std::vector{ createASTError("]が必要です。", token.get()) });
@@ -174,9 +164,9 @@ namespace pickc::parser
     }
     backToken(true);
     if(errors.empty()) {
-      type->tokens = std::vector(begin, currentTokenIter() + 1);
-      return ok(type.release());
+      type->span = spanFrom(begin);
+      return ok(type);
     }
-    return error(errors);
+    return error(std::move(errors));
   }
 }
\ No newline at end of file
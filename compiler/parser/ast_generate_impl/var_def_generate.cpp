@@ -7,8 +7,8 @@ namespace pickc::parser
   Result<VariableDefineNode*, std::vector<std::string>> ASTGenerator::varDefGenerate()
   {
     assert(currentToken().kind == TokenKind::DefKeyword || currentToken().kind ==  TokenKind::MutKeyword);
-    auto begin = currentTokenIter();
-    auto varDef = std::make_unique<VariableDefineNode>();
+    const auto begin = _tokenIndex;
+    auto varDef = arena.make<VariableDefineNode>();
     std::vector<std::string> errors;
     varDef->isMut = currentToken().kind == TokenKind::MutKeyword;
     if(!nextToken()) return error(createEOTError("変数名が必要です。"));
@@ -20,8 +20,8 @@ namespace pickc::parser
         if(auto type = typeGenerate()) varDef->type = std::move(type.get());
         else errors += type.err();
         if (!(token = nextToken())) {
-          varDef->tokens = std::vector(begin, currentTokenIter() + 1);
-          return ok(varDef.release());
+          varDef->span = spanFrom(begin);
+          return ok(varDef);
         }
       }
       if(token.get().kind == TokenKind::Asign) {
@@ -31,9 +31,9 @@ namespace pickc::parser
       }
     }
     if(errors.empty()) {
-      varDef->tokens = std::vector(begin, currentTokenIter() + 1);
-      return ok(varDef.release());
+      varDef->span = spanFrom(begin);
+      return ok(varDef);
     }
-    return error(errors);
+    return error(std::move(errors));
   }
 }
\ No newline at end of file
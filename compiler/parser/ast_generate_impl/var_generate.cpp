@@ -4,25 +4,26 @@ namespace pickc::parser
 {
   Result<VariableNode*, std::vector<std::string>> ASTGenerator::variableGenerate()
   {
-    auto begin = currentTokenIter();
+    const auto begin = _tokenIndex;
     auto token = currentToken();
     if(token.kind == TokenKind::Identify) {
-      auto name = token.value;
-      std::vector<TypeNode*> generics;
+      auto name = sequence.value(token);
+      ArenaVector<TypeNode*> generics(arena);
       const auto backup = _tokenIndex;
       auto generic = nextToken();
       if(generic && generic.get().kind == TokenKind::LessThan) {
         nextToken();
-        std::vector<std::unique_ptr<TypeNode>> ugenerics;
         while(true) {
           auto type = typeGenerate();
           if(!type) {
+            generics.clear();
             _tokenIndex = backup;
             break;
           }
-          ugenerics.push_back(std::unique_ptr<TypeNode>(type.get()));
+          generics.push_back(type.get());
           auto next = nextToken();
           if(!next || (next.get().kind != TokenKind::Comma && next.get().kind != TokenKind::GreaterThan)) {
+            generics.clear();
             _tokenIndex = backup;
             break;
           }
@@ -31,10 +32,6 @@ namespace pickc::parser
             continue;
           }
           else if(next.get().kind == TokenKind::GreaterThan) {
-            generics.reserve(ugenerics.size());
-            for(auto& gen : ugenerics) {
-              generics.push_back(gen.release());
-            }
             break;
           }
           else {
@@ -45,8 +42,8 @@ namespace pickc::parser
       else {
         _tokenIndex = backup;
       }
-      auto var = new VariableNode(name, generics);
-      var->tokens = std::vector(begin, currentTokenIter() + 1);
+      auto var = arena.make<VariableNode>(name, generics);
+      var->span = spanFrom(begin);
       return ok(var);
     }
     return error(std::vector{ createASTError("キーワードや記号は使用できません。", token) });
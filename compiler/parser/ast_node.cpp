@@ -4,7 +4,9 @@
 
 namespace pickc::parser
 {
+  Node::Node(NodeKind kind) : kind(kind) {}
   Node::~Node() {}
+  BlockNode::BlockNode(const ArenaVector<Node*>& nodes) : PrimaryNode(NodeKind::Block), nodes(nodes) {}
   void BlockNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Block" << std::endl;
@@ -12,6 +14,7 @@ namespace pickc::parser
       nodes[i]->dump(indent2 + "+--", indent2 + (i + 1 < l ? "|  " : "   "));
     }
   }
+  IfNode::IfNode() : PrimaryNode(NodeKind::If), comp(nullptr), thenExpr(nullptr), elseExpr(nullptr) {}
   void IfNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "If" << std::endl;
@@ -24,6 +27,7 @@ namespace pickc::parser
       elseExpr->dump(indent2 + "   +--", indent2 + "      ");
     }
   }
+  WhileNode::WhileNode() : PrimaryNode(NodeKind::While), comp(nullptr), body(nullptr) {}
   void WhileNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "While" << std::endl;
@@ -32,85 +36,87 @@ namespace pickc::parser
     std::cout << indent2 << "+--Body" << std::endl;
     body->dump(indent2 + "   +--", indent2 + "      ");
   }
-  IntegerLiteral::IntegerLiteral(int value) : value(value) {}
+  IntegerLiteral::IntegerLiteral(int value) : LiteralNode(NodeKind::IntegerLiteral), value(value) {}
   void IntegerLiteral::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Integer Literal (" << value << ")" << std::endl;
   }
-  I8Literal::I8Literal(int8_t value) : value(value) {}
+  I8Literal::I8Literal(int8_t value) : LiteralNode(NodeKind::I8Literal), value(value) {}
   void I8Literal::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "I8 Literal (" << static_cast<int>(value) << ")" << std::endl;
   }
-  I16Literal::I16Literal(int16_t value) : value(value) {}
+  I16Literal::I16Literal(int16_t value) : LiteralNode(NodeKind::I16Literal), value(value) {}
   void I16Literal::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "I16 Literal (" << value << ")" << std::endl;
   }
-  I32Literal::I32Literal(int32_t value) : value(value) {}
+  I32Literal::I32Literal(int32_t value) : LiteralNode(NodeKind::I32Literal), value(value) {}
   void I32Literal::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "I32 Literal (" << value << ")" << std::endl;
   }
-  I64Literal::I64Literal(int64_t value) : value(value) {}
+  I64Literal::I64Literal(int64_t value) : LiteralNode(NodeKind::I64Literal), value(value) {}
   void I64Literal::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "I64 Literal (" << value << ")" << std::endl;
   }
-  U8Literal::U8Literal(uint8_t value) : value(value) {}
+  U8Literal::U8Literal(uint8_t value) : LiteralNode(NodeKind::U8Literal), value(value) {}
   void U8Literal::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "U8 Literal (" << static_cast<unsigned>(value) << ")" << std::endl;
   }
-  U16Literal::U16Literal(uint16_t value) : value(value) {}
+  U16Literal::U16Literal(uint16_t value) : LiteralNode(NodeKind::U16Literal), value(value) {}
   void U16Literal::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "U16 Literal (" << value << ")" << std::endl;
   }
-  U32Literal::U32Literal(uint32_t value) : value(value) {}
+  U32Literal::U32Literal(uint32_t value) : LiteralNode(NodeKind::U32Literal), value(value) {}
   void U32Literal::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "U32 Literal (" << value << ")" << std::endl;
   }
-  U64Literal::U64Literal(uint64_t value) : value(value) {}
+  U64Literal::U64Literal(uint64_t value) : LiteralNode(NodeKind::U64Literal), value(value) {}
   void U64Literal::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "U64 Literal (" << value << ")" << std::endl;
   }
-  FloatLiteral::FloatLiteral(double value) : value(value) {}
+  FloatLiteral::FloatLiteral(double value) : LiteralNode(NodeKind::FloatLiteral), value(value) {}
   void FloatLiteral::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Float Literal (" << value << ")" << std::endl;
   }
-  F32Literal::F32Literal(float value) : value(value) {}
+  F32Literal::F32Literal(float value) : LiteralNode(NodeKind::F32Literal), value(value) {}
   void F32Literal::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "F32 Literal (" << value << ")" << std::endl;
   }
-  F64Literal::F64Literal(double value) : value(value) {}
+  F64Literal::F64Literal(double value) : LiteralNode(NodeKind::F64Literal), value(value) {}
   void F64Literal::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "F64 Literal (" << value << ")" << std::endl;
   }
-  BoolLiteral::BoolLiteral(bool value) : value(value) {}
+  BoolLiteral::BoolLiteral(bool value) : LiteralNode(NodeKind::BoolLiteral), value(value) {}
   void BoolLiteral::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Bool Literal (" << (value ? "true" : "false") << ")" << std::endl;
   }
+  NullLiteral::NullLiteral() : LiteralNode(NodeKind::NullLiteral) {}
   void NullLiteral::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Null Literal (null)" << std::endl;
   }
-  CharLiteral::CharLiteral(char value) : value(value) {}
+  CharLiteral::CharLiteral(char value) : LiteralNode(NodeKind::CharLiteral), value(value) {}
   void CharLiteral::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Char Literal (" << value << ")" << std::endl;
   }
-  StringLiteral::StringLiteral(const std::string& value) : value(value) {}
+  StringLiteral::StringLiteral(const std::string& value) : LiteralNode(NodeKind::StringLiteral), value(value) {}
   void StringLiteral::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "String Literal (" << value << ")" << std::endl;
   }
+  ArrayLiteral::ArrayLiteral(const ArenaVector<ExpressionNode*>& value) : LiteralNode(NodeKind::ArrayLiteral), value(value) {}
   void ArrayLiteral::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Array Literal" << std::endl;
@@ -118,7 +124,8 @@ namespace pickc::parser
       value[i]->dump(indent2 + "+--", indent2 + (i + 1 < l ? "|  " : "   "));
     }
   }
-  VariableNode::VariableNode(const std::string& name, const std::vector<TypeNode*>& generics) : name(name), generics(generics) {}
+  VariableNode::VariableNode(const std::string& name, const ArenaVector<TypeNode*>& generics) : VariableNode(NodeKind::Variable, name, generics) {}
+  VariableNode::VariableNode(NodeKind kind, const std::string& name, const ArenaVector<TypeNode*>& generics) : PrimaryNode(kind), name(name), atom(Atom::intern(name)), generics(generics) {}
   void VariableNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Variable" << std::endl;
@@ -131,7 +138,7 @@ namespace pickc::parser
       }
     }
   }
-  ScopedVariableNode::ScopedVariableNode(const std::string& name, const std::vector<TypeNode*>& generics, VariableNode* child) : VariableNode(name, generics), child(child) {}
+  ScopedVariableNode::ScopedVariableNode(const std::string& name, const ArenaVector<TypeNode*>& generics, VariableNode* child) : VariableNode(NodeKind::ScopedVariable, name, generics), child(child) {}
   void ScopedVariableNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Scoped Variable (" << name[0];
@@ -141,65 +148,78 @@ namespace pickc::parser
     if(child) child->dump(indent2 + "+--", indent2 + "   ");
     std::cout << ')' << std::endl;
   }
+  I8TypeNode::I8TypeNode() : TypeNode(NodeKind::I8Type) {}
   void I8TypeNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Type I8" << std::endl;
   }
+  I16TypeNode::I16TypeNode() : TypeNode(NodeKind::I16Type) {}
   void I16TypeNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Type I16" << std::endl;
   }
+  I32TypeNode::I32TypeNode() : TypeNode(NodeKind::I32Type) {}
   void I32TypeNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Type I32" << std::endl;
   }
+  I64TypeNode::I64TypeNode() : TypeNode(NodeKind::I64Type) {}
   void I64TypeNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Type I64" << std::endl;
   }
+  U8TypeNode::U8TypeNode() : TypeNode(NodeKind::U8Type) {}
   void U8TypeNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Type U8" << std::endl;
   }
+  U16TypeNode::U16TypeNode() : TypeNode(NodeKind::U16Type) {}
   void U16TypeNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Type U16" << std::endl;
   }
+  U32TypeNode::U32TypeNode() : TypeNode(NodeKind::U32Type) {}
   void U32TypeNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Type U32" << std::endl;
   }
+  U64TypeNode::U64TypeNode() : TypeNode(NodeKind::U64Type) {}
   void U64TypeNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Type U64" << std::endl;
   }
+  F32TypeNode::F32TypeNode() : TypeNode(NodeKind::F32Type) {}
   void F32TypeNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Type F32" << std::endl;
   }
+  F64TypeNode::F64TypeNode() : TypeNode(NodeKind::F64Type) {}
   void F64TypeNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Type F64" << std::endl;
   }
+  CharTypeNode::CharTypeNode() : TypeNode(NodeKind::CharType) {}
   void CharTypeNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Type Char" << std::endl;
   }
+  BoolTypeNode::BoolTypeNode() : TypeNode(NodeKind::BoolType) {}
   void BoolTypeNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Type Bool" << std::endl;
   }
+  VoidTypeNode::VoidTypeNode() : TypeNode(NodeKind::VoidType) {}
   void VoidTypeNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Type Void" << std::endl;
   }
-  PtrTypeNode::PtrTypeNode(TypeNode* base) : base(base) {}
+  PtrTypeNode::PtrTypeNode(TypeNode* base) : TypeNode(NodeKind::PtrType), base(base) {}
   void PtrTypeNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Type Ptr" << std::endl;
     base->dump(indent2 + "+--", indent2 + "   ");
   }
-  ArrayTypeNode::ArrayTypeNode(TypeNode* elemType, size_t length) : elemType(elemType), length(length) {}
+  ArrayTypeNode::ArrayTypeNode(TypeNode* elemType, size_t length) : TypeNode(NodeKind::ArrayType), elemType(elemType), length(length) {}
   void ArrayTypeNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Type Array" << std::endl;
@@ -207,7 +227,7 @@ namespace pickc::parser
     elemType->dump(indent2 + "|  +--", indent2 + "|     ");
     std::cout << indent2 << "+--Size " << length << std::endl;
   }
-  FnTypeNode::FnTypeNode(TypeNode* ret, const std::vector<TypeNode*>& args) : ret(ret), args(args) {}
+  FnTypeNode::FnTypeNode(TypeNode* ret, const ArenaVector<TypeNode*>& args) : TypeNode(NodeKind::FnType), ret(ret), args(args) {}
   void FnTypeNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Type Function" << std::endl;
@@ -218,7 +238,7 @@ namespace pickc::parser
       args[i]->dump(indent2 + "   +--", indent2 + "   " + (i + 1 < l ? "|  " : "   "));
     }
   }
-  GenericsTypeNode::GenericsTypeNode(const std::vector<std::string>& name, const std::vector<TypeNode*>& generics) : name(name), generics(generics) {}
+  GenericsTypeNode::GenericsTypeNode(const std::vector<std::string>& name, const ArenaVector<TypeNode*>& generics) : TypeNode(NodeKind::GenericsType), name(name), generics(generics) {}
   void GenericsTypeNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Type Generics (" << name[0];
@@ -228,26 +248,28 @@ namespace pickc::parser
       generics[i]->dump(indent2 + "+--", indent2 + (i + 1 < l ? "|  " : "   "));
     }
   }
-  UserDefineTypeNode::UserDefineTypeNode(const std::vector<std::string>& name) : name(name) {}
+  UserDefineTypeNode::UserDefineTypeNode(const std::vector<std::string>& name) : TypeNode(NodeKind::UserDefineType), name(name) {}
   void UserDefineTypeNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Type User Define (" << name[0];
     for(size_t i = 1, l = name.size(); i < l; ++i) std::cout << "::" << name[i];
     std::cout << ")" << std::endl;
   }
-  UnaryNode::UnaryNode(ExpressionNode* base) : base(base) {}
-  BinaryNode::BinaryNode(ExpressionNode* left, ExpressionNode* right) : left(left), right(right) {}
+  UnaryNode::UnaryNode(NodeKind kind, ExpressionNode* base) : ExpressionNode(kind), base(base) {}
+  BinaryNode::BinaryNode(NodeKind kind, ExpressionNode* left, ExpressionNode* right) : ExpressionNode(kind), left(left), right(right) {}
+  BackIncrementNode::BackIncrementNode(ExpressionNode* base) : BackUnaryNode(NodeKind::BackIncrement, base) {}
   void BackIncrementNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Back Increment" << std::endl;
     base->dump(indent2 + "+--", indent2 + "   ");
   }
+  BackDecrementNode::BackDecrementNode(ExpressionNode* base) : BackUnaryNode(NodeKind::BackDecrement, base) {}
   void BackDecrementNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Back Decrement" << std::endl;
     base->dump(indent2 + "+--", indent2 + "   ");
   }
-  MemberAccessNode::MemberAccessNode(ExpressionNode* base, VariableNode* member) : BackUnaryNode(base), member(member) {}
+  MemberAccessNode::MemberAccessNode(ExpressionNode* base, VariableNode* member) : BackUnaryNode(NodeKind::MemberAccess, base), member(member) {}
   void MemberAccessNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Member Access" << std::endl;
@@ -256,7 +278,7 @@ namespace pickc::parser
     std::cout << indent2 << "+--Member" << std::endl;
     member->dump(indent2 + "   +--", indent2 + "      ");
   }
-  ArrayAccessNode::ArrayAccessNode(ExpressionNode* base, ExpressionNode* suffix) : BackUnaryNode(base), suffix(suffix) {}
+  ArrayAccessNode::ArrayAccessNode(ExpressionNode* base, ExpressionNode* suffix) : BackUnaryNode(NodeKind::ArrayAccess, base), suffix(suffix) {}
   void ArrayAccessNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Array Access" << std::endl;
@@ -265,7 +287,7 @@ namespace pickc::parser
     std::cout << indent2 << "+--Suffix" << std::endl;
     suffix->dump(indent2 + "   +--", indent2 + "      ");
   }
-  CallNode::CallNode(ExpressionNode* base, std::vector<ExpressionNode*> args) : BackUnaryNode(base), args(args) {}
+  CallNode::CallNode(ExpressionNode* base, const ArenaVector<ExpressionNode*>& args) : BackUnaryNode(NodeKind::Call, base), args(args) {}
   void CallNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Call" << std::endl;
@@ -276,26 +298,43 @@ namespace pickc::parser
       args[i]->dump(indent2 + "   +--", indent2 + "   " + (i + 1 < l ? "|  " : "   "));
     }
   }
+  PlusNode::PlusNode(ExpressionNode* base) : FrontUnaryNode(NodeKind::Plus, base) {}
   void PlusNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Plus" << std::endl;
     base->dump(indent2 + "+--", indent2 + "   ");
   }
+  MinusNode::MinusNode(ExpressionNode* base) : FrontUnaryNode(NodeKind::Minus, base) {}
   void MinusNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Minus" << std::endl;
     base->dump(indent2 + "+--", indent2 + "   ");
   }
+  CopyNode::CopyNode(ExpressionNode* base) : FrontUnaryNode(NodeKind::Copy, base) {}
   void CopyNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Copy" << std::endl;
     base->dump(indent2 + "+--", indent2 + "   ");
   }
+  BitNotNode::BitNotNode(ExpressionNode* base) : FrontUnaryNode(NodeKind::BitNot, base) {}
+  void BitNotNode::dump(const std::string& indent, const std::string& indent2) const
+  {
+    std::cout << indent << "Bit Not" << std::endl;
+    base->dump(indent2 + "+--", indent2 + "   ");
+  }
+  LogicalNotNode::LogicalNotNode(ExpressionNode* base) : FrontUnaryNode(NodeKind::LogicalNot, base) {}
+  void LogicalNotNode::dump(const std::string& indent, const std::string& indent2) const
+  {
+    std::cout << indent << "Logical Not" << std::endl;
+    base->dump(indent2 + "+--", indent2 + "   ");
+  }
+  FrontIncrementNode::FrontIncrementNode(ExpressionNode* base) : FrontUnaryNode(NodeKind::FrontIncrement, base) {}
   void FrontIncrementNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Front Increment" << std::endl;
     base->dump(indent2 + "+--", indent2 + "   ");
   }
+  FrontDecrementNode::FrontDecrementNode(ExpressionNode* base) : FrontUnaryNode(NodeKind::FrontDecrement, base) {}
   void FrontDecrementNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Front Decrement" << std::endl;
@@ -312,75 +351,153 @@ namespace pickc::parser
       right->dump(indent2 + "   +--", indent2 + "      ");
     }
   }
+  MulNode::MulNode(ExpressionNode* left, ExpressionNode* right) : FactorNode(NodeKind::Mul, left, right) {}
   void MulNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Mul", left, right);
   }
+  DivNode::DivNode(ExpressionNode* left, ExpressionNode* right) : FactorNode(NodeKind::Div, left, right) {}
   void DivNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Div", left, right);
   }
+  ModNode::ModNode(ExpressionNode* left, ExpressionNode* right) : FactorNode(NodeKind::Mod, left, right) {}
   void ModNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent , indent2, "Mod", left, right);
   }
+  AddNode::AddNode(ExpressionNode* left, ExpressionNode* right) : TermNode(NodeKind::Add, left, right) {}
   void AddNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Add", left, right);
   }
+  SubNode::SubNode(ExpressionNode* left, ExpressionNode* right) : TermNode(NodeKind::Sub, left, right) {}
   void SubNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Sub", left, right);
   }
+  EqualNode::EqualNode(ExpressionNode* left, ExpressionNode* right) : ComparisonNode(NodeKind::Equal, left, right) {}
   void EqualNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Equal", left, right);
   }
+  NotEqualNode::NotEqualNode(ExpressionNode* left, ExpressionNode* right) : ComparisonNode(NodeKind::NotEqual, left, right) {}
   void NotEqualNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Not Equal", left, right);
   }
+  GreaterEqualNode::GreaterEqualNode(ExpressionNode* left, ExpressionNode* right) : ComparisonNode(NodeKind::GreaterEqual, left, right) {}
   void GreaterEqualNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Greater Equal", left, right);
   }
+  GreaterThanNode::GreaterThanNode(ExpressionNode* left, ExpressionNode* right) : ComparisonNode(NodeKind::GreaterThan, left, right) {}
   void GreaterThanNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Greater Than", left, right);
   }
+  LessEqualNode::LessEqualNode(ExpressionNode* left, ExpressionNode* right) : ComparisonNode(NodeKind::LessEqual, left, right) {}
   void LessEqualNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Less Equal", left, right);
   }
+  LessThanNode::LessThanNode(ExpressionNode* left, ExpressionNode* right) : ComparisonNode(NodeKind::LessThan, left, right) {}
   void LessThanNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Less Than", left, right);
   }
+  LShiftNode::LShiftNode(ExpressionNode* left, ExpressionNode* right) : ShiftNode(NodeKind::LShift, left, right) {}
+  void LShiftNode::dump(const std::string& indent, const std::string& indent2) const
+  {
+    binaryDump(indent, indent2, "Left Shift", left, right);
+  }
+  RShiftNode::RShiftNode(ExpressionNode* left, ExpressionNode* right) : ShiftNode(NodeKind::RShift, left, right) {}
+  void RShiftNode::dump(const std::string& indent, const std::string& indent2) const
+  {
+    binaryDump(indent, indent2, "Right Shift", left, right);
+  }
+  BitAndNode::BitAndNode(ExpressionNode* left, ExpressionNode* right) : BitwiseNode(NodeKind::BitAnd, left, right) {}
+  void BitAndNode::dump(const std::string& indent, const std::string& indent2) const
+  {
+    binaryDump(indent, indent2, "Bit And", left, right);
+  }
+  BitOrNode::BitOrNode(ExpressionNode* left, ExpressionNode* right) : BitwiseNode(NodeKind::BitOr, left, right) {}
+  void BitOrNode::dump(const std::string& indent, const std::string& indent2) const
+  {
+    binaryDump(indent, indent2, "Bit Or", left, right);
+  }
+  BitXorNode::BitXorNode(ExpressionNode* left, ExpressionNode* right) : BitwiseNode(NodeKind::BitXor, left, right) {}
+  void BitXorNode::dump(const std::string& indent, const std::string& indent2) const
+  {
+    binaryDump(indent, indent2, "Bit Xor", left, right);
+  }
+  LogicalAndNode::LogicalAndNode(ExpressionNode* left, ExpressionNode* right) : LogicalNode(NodeKind::LogicalAnd, left, right) {}
+  void LogicalAndNode::dump(const std::string& indent, const std::string& indent2) const
+  {
+    binaryDump(indent, indent2, "Logical And", left, right);
+  }
+  LogicalOrNode::LogicalOrNode(ExpressionNode* left, ExpressionNode* right) : LogicalNode(NodeKind::LogicalOr, left, right) {}
+  void LogicalOrNode::dump(const std::string& indent, const std::string& indent2) const
+  {
+    binaryDump(indent, indent2, "Logical Or", left, right);
+  }
+  AsignNode::AsignNode(ExpressionNode* left, ExpressionNode* right) : AsignNode(NodeKind::Asign, left, right) {}
+  AsignNode::AsignNode(NodeKind kind, ExpressionNode* left, ExpressionNode* right) : BinaryNode(kind, left, right) {}
   void AsignNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Asign", left, right);
   }
+  AddAsignNode::AddAsignNode(ExpressionNode* left, ExpressionNode* right) : AsignNode(NodeKind::AddAsign, left, right) {}
   void AddAsignNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Add Asign", left, right);
   }
+  SubAsignNode::SubAsignNode(ExpressionNode* left, ExpressionNode* right) : AsignNode(NodeKind::SubAsign, left, right) {}
   void SubAsignNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Sub Asign", left, right);
   }
+  MulAsignNode::MulAsignNode(ExpressionNode* left, ExpressionNode* right) : AsignNode(NodeKind::MulAsign, left, right) {}
   void MulAsignNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Mul Asign", left, right);
   }
+  DivAsignNode::DivAsignNode(ExpressionNode* left, ExpressionNode* right) : AsignNode(NodeKind::DivAsign, left, right) {}
   void DivAsignNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Div Asign", left, right);
   }
+  ModAsignNode::ModAsignNode(ExpressionNode* left, ExpressionNode* right) : AsignNode(NodeKind::ModAsign, left, right) {}
   void ModAsignNode::dump(const std::string& indent, const std::string& indent2) const
   {
     binaryDump(indent, indent2, "Mod Asign", left, right);
   }
-  ReturnNode::ReturnNode(ExpressionNode* value) : value(value) {}
+  BitAndAsignNode::BitAndAsignNode(ExpressionNode* left, ExpressionNode* right) : AsignNode(NodeKind::BitAndAsign, left, right) {}
+  void BitAndAsignNode::dump(const std::string& indent, const std::string& indent2) const
+  {
+    binaryDump(indent, indent2, "Bit And Asign", left, right);
+  }
+  BitOrAsignNode::BitOrAsignNode(ExpressionNode* left, ExpressionNode* right) : AsignNode(NodeKind::BitOrAsign, left, right) {}
+  void BitOrAsignNode::dump(const std::string& indent, const std::string& indent2) const
+  {
+    binaryDump(indent, indent2, "Bit Or Asign", left, right);
+  }
+  BitXorAsignNode::BitXorAsignNode(ExpressionNode* left, ExpressionNode* right) : AsignNode(NodeKind::BitXorAsign, left, right) {}
+  void BitXorAsignNode::dump(const std::string& indent, const std::string& indent2) const
+  {
+    binaryDump(indent, indent2, "Bit Xor Asign", left, right);
+  }
+  LShiftAsignNode::LShiftAsignNode(ExpressionNode* left, ExpressionNode* right) : AsignNode(NodeKind::LShiftAsign, left, right) {}
+  void LShiftAsignNode::dump(const std::string& indent, const std::string& indent2) const
+  {
+    binaryDump(indent, indent2, "Left Shift Asign", left, right);
+  }
+  RShiftAsignNode::RShiftAsignNode(ExpressionNode* left, ExpressionNode* right) : AsignNode(NodeKind::RShiftAsign, left, right) {}
+  void RShiftAsignNode::dump(const std::string& indent, const std::string& indent2) const
+  {
+    binaryDump(indent, indent2, "Right Shift Asign", left, right);
+  }
+  ReturnNode::ReturnNode(ExpressionNode* value) : Node(NodeKind::Return), value(value) {}
   void ReturnNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Return" << std::endl;
@@ -388,6 +505,7 @@ namespace pickc::parser
       value->dump(indent2 + "+--", indent2 + "   ");
     }
   }
+  VariableDefineNode::VariableDefineNode() : ExpressionNode(NodeKind::VariableDefine), isPub(false), isMut(false), name(nullptr), type(nullptr), init(nullptr) {}
   void VariableDefineNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Variable Define" << std::endl;
@@ -402,6 +520,7 @@ namespace pickc::parser
       init->dump(indent2 + "   +--", indent2 + "      ");
     }
   }
+  ArgumentDefineNode::ArgumentDefineNode() : Node(NodeKind::ArgumentDefine), isMut(false), name(nullptr), type(nullptr), init(nullptr) {}
   void ArgumentDefineNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Argument Define" << std::endl;
@@ -416,6 +535,8 @@ namespace pickc::parser
       init->dump(indent2 + "   +--", indent2 + "      ");
     }
   }
+  FunctionDefineNode::FunctionDefineNode(Arena& arena) : FunctionDefineNode(NodeKind::FunctionDefine, arena) {}
+  FunctionDefineNode::FunctionDefineNode(NodeKind kind, Arena& arena) : ExpressionNode(kind), isPub(false), name(nullptr), args(arena), retType(nullptr), body(nullptr), isBodyDeferred(false), bodySpan{ 0, 0 } {}
   void FunctionDefineNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Function Define" << std::endl;
@@ -431,23 +552,30 @@ namespace pickc::parser
       std::cout << indent2 << "+--Return Type" << std::endl;
       retType->dump(indent2 + "|  +--", indent2 + "|     ");
     }
+    if(isBodyDeferred) {
+      std::cout << indent2 << "+--Body (Deferred)" << std::endl;
+      return;
+    }
     std::cout << indent2 << "+--Body" << std::endl;
     body->dump(indent2 + "   +--", indent2 + "      ");
   }
+  ClassDefineNode::ClassDefineNode() : Node(NodeKind::ClassDefine) {}
   void ClassDefineNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Class Define" << std::endl;
   }
+  AliasDefineNode::AliasDefineNode() : Node(NodeKind::AliasDefine) {}
   void AliasDefineNode::dump(const std::string& indent, const std::string&) const
   {
     std::cout << indent << "Alias Define" << std::endl;
   }
-  ImportNode::ImportNode(VariableNode* name) : name(name) {}
+  ImportNode::ImportNode(VariableNode* name) : Node(NodeKind::Import), name(name) {}
   void ImportNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Import Module" << std::endl;
     name->dump(indent2 + "+--", indent2 + "   ");
   }
+  ExternNode::ExternNode(Arena& arena) : FunctionDefineNode(NodeKind::Extern, arena) {}
   void ExternNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Extern Declare" << std::endl;
@@ -460,6 +588,7 @@ namespace pickc::parser
     std::cout << indent2 << "+--Return Type" << std::endl;
     retType->dump(indent2 + "   +--", indent2 + "      ");
   }
+  RootNode::RootNode() : Node(NodeKind::Root) {}
   void RootNode::dump(const std::string& indent, const std::string& indent2) const
   {
     std::cout << indent << "Root Node" << std::endl;
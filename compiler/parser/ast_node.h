@@ -5,82 +5,220 @@
 #include <string>
 
 #include "token.h"
+#include "utils/arena.h"
+#include "utils/interner.h"
 
 namespace pickc::parser
 {
+  // ノードが覆うトークンの範囲。モジュールのTokenSequenceの添字で、lastも範囲に含む。
+  struct SourceSpan
+  {
+    uint32_t first;
+    uint32_t last;
+  };
+  // ノードの具象クラスの種類。派生関係ごとに連続して並べ、抽象クラスのclassofは範囲で判定する。
+  enum struct NodeKind : uint8_t
+  {
+    I8Type,
+    I16Type,
+    I32Type,
+    I64Type,
+    U8Type,
+    U16Type,
+    U32Type,
+    U64Type,
+    F32Type,
+    F64Type,
+    CharType,
+    BoolType,
+    VoidType,
+    PtrType,
+    ArrayType,
+    FnType,
+    GenericsType,
+    UserDefineType,
+    Block,
+    If,
+    While,
+    Variable,
+    ScopedVariable,
+    IntegerLiteral,
+    I8Literal,
+    I16Literal,
+    I32Literal,
+    I64Literal,
+    U8Literal,
+    U16Literal,
+    U32Literal,
+    U64Literal,
+    FloatLiteral,
+    F32Literal,
+    F64Literal,
+    BoolLiteral,
+    NullLiteral,
+    CharLiteral,
+    StringLiteral,
+    ArrayLiteral,
+    BackIncrement,
+    BackDecrement,
+    MemberAccess,
+    ArrayAccess,
+    Call,
+    Plus,
+    Minus,
+    Copy,
+    BitNot,
+    LogicalNot,
+    FrontIncrement,
+    FrontDecrement,
+    Mul,
+    Div,
+    Mod,
+    Add,
+    Sub,
+    Equal,
+    NotEqual,
+    GreaterEqual,
+    GreaterThan,
+    LessEqual,
+    LessThan,
+    LShift,
+    RShift,
+    BitAnd,
+    BitOr,
+    BitXor,
+    LogicalAnd,
+    LogicalOr,
+    Asign,
+    AddAsign,
+    SubAsign,
+    MulAsign,
+    DivAsign,
+    ModAsign,
+    BitAndAsign,
+    BitOrAsign,
+    BitXorAsign,
+    LShiftAsign,
+    RShiftAsign,
+    VariableDefine,
+    FunctionDefine,
+    Extern,
+    Return,
+    ArgumentDefine,
+    ClassDefine,
+    AliasDefine,
+    Import,
+    Root,
+  };
   class Node
   {
   public:
-    std::vector<Token> tokens;
+    // 具象クラスの種類。コンストラクタで決まり、switchでの分岐やinstanceof、dynCastに使う。
+    NodeKind kind;
+    SourceSpan span{ 0, 0 };
+  protected:
+    Node(NodeKind kind);
   public:
     virtual ~Node();
     virtual void dump(const std::string& indent, const std::string& indent2) const = 0;
   };
-  class TypeNode : public Node {};
+  class TypeNode : public Node
+  {
+  protected:
+    using Node::Node;
+  public:
+    static bool classof(const Node* node) { return NodeKind::I8Type <= node->kind && node->kind <= NodeKind::UserDefineType; }
+  };
   class I8TypeNode : public TypeNode
   {
   public:
+    I8TypeNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::I8Type; }
   };
   class I16TypeNode : public TypeNode
   {
   public:
+    I16TypeNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::I16Type; }
   };
   class I32TypeNode : public TypeNode
   {
   public:
+    I32TypeNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::I32Type; }
   };
   class I64TypeNode : public TypeNode
   {
   public:
+    I64TypeNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::I64Type; }
   };
   class U8TypeNode : public TypeNode
   {
   public:
+    U8TypeNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::U8Type; }
   };
   class U16TypeNode : public TypeNode
   {
   public:
+    U16TypeNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::U16Type; }
   };
   class U32TypeNode : public TypeNode
   {
   public:
+    U32TypeNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::U32Type; }
   };
   class U64TypeNode : public TypeNode
   {
   public:
+    U64TypeNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::U64Type; }
   };
   class F32TypeNode : public TypeNode
   {
   public:
+    F32TypeNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::F32Type; }
   };
   class F64TypeNode : public TypeNode
   {
   public:
+    F64TypeNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::F64Type; }
   };
   class CharTypeNode : public TypeNode
   {
   public:
+    CharTypeNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::CharType; }
   };
   class BoolTypeNode : public TypeNode
   {
   public:
+    BoolTypeNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::BoolType; }
   };
   class VoidTypeNode : public TypeNode
   {
   public:
+    VoidTypeNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::VoidType; }
   };
   class PtrTypeNode : public TypeNode
   {
@@ -89,6 +227,7 @@ namespace pickc::parser
   public:
     PtrTypeNode(TypeNode* base);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::PtrType; }
   };
   class ArrayTypeNode : public TypeNode
   {
@@ -98,24 +237,27 @@ namespace pickc::parser
   public:
     ArrayTypeNode(TypeNode* elemType, size_t length);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ArrayType; }
   };
   class FnTypeNode : public TypeNode
   {
   public:
     TypeNode* ret;
-    std::vector<TypeNode*> args;
+    ArenaVector<TypeNode*> args;
   public:
-    FnTypeNode(TypeNode* ret, const std::vector<TypeNode*>& args);
+    FnTypeNode(TypeNode* ret, const ArenaVector<TypeNode*>& args);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::FnType; }
   };
   class GenericsTypeNode : public TypeNode
   {
   public:
     std::vector<std::string> name;
-    std::vector<TypeNode*> generics;
+    ArenaVector<TypeNode*> generics;
   public:
-    GenericsTypeNode(const std::vector<std::string>& name, const std::vector<TypeNode*>& generics);
+    GenericsTypeNode(const std::vector<std::string>& name, const ArenaVector<TypeNode*>& generics);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::GenericsType; }
   };
   class UserDefineTypeNode : public TypeNode
   {
@@ -124,15 +266,30 @@ namespace pickc::parser
   public:
     UserDefineTypeNode(const std::vector<std::string>& name);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::UserDefineType; }
+  };
+  class ExpressionNode : public Node
+  {
+  protected:
+    using Node::Node;
+  public:
+    static bool classof(const Node* node) { return NodeKind::Block <= node->kind && node->kind <= NodeKind::Extern; }
+  };
+  class PrimaryNode : public ExpressionNode
+  {
+  protected:
+    using ExpressionNode::ExpressionNode;
+  public:
+    static bool classof(const Node* node) { return NodeKind::Block <= node->kind && node->kind <= NodeKind::ArrayLiteral; }
   };
-  class ExpressionNode : public Node {};
-  class PrimaryNode : public ExpressionNode {};
   class BlockNode : public PrimaryNode
   {
   public:
-    std::vector<Node*> nodes;
+    ArenaVector<Node*> nodes;
   public:
+    BlockNode(const ArenaVector<Node*>& nodes);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Block; }
   };
   class IfNode : public PrimaryNode
   {
@@ -141,7 +298,9 @@ namespace pickc::parser
     ExpressionNode* thenExpr;
     ExpressionNode* elseExpr;
   public:
+    IfNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::If; }
   };
   class WhileNode : public PrimaryNode
   {
@@ -149,26 +308,40 @@ namespace pickc::parser
     ExpressionNode* comp;
     ExpressionNode* body;
   public:
+    WhileNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::While; }
   };
   class VariableNode : public PrimaryNode
   {
   public:
     std::string name;
-    std::vector<TypeNode*> generics;
+    // nameをInternerに登録したもの。意味解析では名前の比較とハッシュにこちらを使う。
+    Atom atom;
+    ArenaVector<TypeNode*> generics;
+  protected:
+    VariableNode(NodeKind kind, const std::string& name, const ArenaVector<TypeNode*>& generics);
   public:
-    VariableNode(const std::string& name, const std::vector<TypeNode*>& generics);
+    VariableNode(const std::string& name, const ArenaVector<TypeNode*>& generics);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return NodeKind::Variable <= node->kind && node->kind <= NodeKind::ScopedVariable; }
   };
   class ScopedVariableNode : public VariableNode
   {
   public:
     VariableNode* child;
   public:
-    ScopedVariableNode(const std::string& name, const std::vector<TypeNode*>& generics, VariableNode* child);
+    ScopedVariableNode(const std::string& name, const ArenaVector<TypeNode*>& generics, VariableNode* child);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ScopedVariable; }
+  };
+  class LiteralNode : public PrimaryNode
+  {
+  protected:
+    using PrimaryNode::PrimaryNode;
+  public:
+    static bool classof(const Node* node) { return NodeKind::IntegerLiteral <= node->kind && node->kind <= NodeKind::ArrayLiteral; }
   };
-  class LiteralNode : public PrimaryNode {};
   class IntegerLiteral : public LiteralNode
   {
   public:
@@ -176,6 +349,7 @@ namespace pickc::parser
   public:
     IntegerLiteral(int value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::IntegerLiteral; }
   };
   class I8Literal : public LiteralNode
   {
@@ -184,6 +358,7 @@ namespace pickc::parser
   public:
     I8Literal(int8_t value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::I8Literal; }
   };
   class I16Literal : public LiteralNode
   {
@@ -192,6 +367,7 @@ namespace pickc::parser
   public:
     I16Literal(int16_t value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::I16Literal; }
   };
   class I32Literal : public LiteralNode
   {
@@ -200,6 +376,7 @@ namespace pickc::parser
   public:
     I32Literal(int32_t value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::I32Literal; }
   };
   class I64Literal : public LiteralNode
   {
@@ -208,6 +385,7 @@ namespace pickc::parser
   public:
     I64Literal(int64_t value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::I64Literal; }
   };
   class U8Literal : public LiteralNode
   {
@@ -216,6 +394,7 @@ namespace pickc::parser
   public:
     U8Literal(uint8_t value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::U8Literal; }
   };
   class U16Literal : public LiteralNode
   {
@@ -224,6 +403,7 @@ namespace pickc::parser
   public:
     U16Literal(uint16_t value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::U16Literal; }
   };
   class U32Literal : public LiteralNode
   {
@@ -232,6 +412,7 @@ namespace pickc::parser
   public:
     U32Literal(uint32_t value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::U32Literal; }
   };
   class U64Literal : public LiteralNode
   {
@@ -240,6 +421,7 @@ namespace pickc::parser
   public:
     U64Literal(uint64_t value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::U64Literal; }
   };
   class FloatLiteral : public LiteralNode
   {
@@ -248,6 +430,7 @@ namespace pickc::parser
   public:
     FloatLiteral(double value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::FloatLiteral; }
   };
   class F32Literal : public LiteralNode
   {
@@ -256,6 +439,7 @@ namespace pickc::parser
   public:
     F32Literal(float value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::F32Literal; }
   };
   class F64Literal : public LiteralNode
   {
@@ -264,6 +448,7 @@ namespace pickc::parser
   public:
     F64Literal(double value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::F64Literal; }
   };
   class BoolLiteral : public LiteralNode
   {
@@ -272,11 +457,14 @@ namespace pickc::parser
   public:
     BoolLiteral(bool value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::BoolLiteral; }
   };
   class NullLiteral : public LiteralNode
   {
   public:
+    NullLiteral();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::NullLiteral; }
   };
   class CharLiteral : public LiteralNode
   {
@@ -285,6 +473,7 @@ namespace pickc::parser
   public:
     CharLiteral(char value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::CharLiteral; }
   };
   class StringLiteral : public LiteralNode
   {
@@ -293,43 +482,56 @@ namespace pickc::parser
   public:
     StringLiteral(const std::string& value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::StringLiteral; }
   };
   class ArrayLiteral : public LiteralNode
   {
   public:
-    std::vector<ExpressionNode*> value;
+    ArenaVector<ExpressionNode*> value;
   public:
+    ArrayLiteral(const ArenaVector<ExpressionNode*>& value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ArrayLiteral; }
   };
   class UnaryNode : public ExpressionNode
   {
   public:
     ExpressionNode* base;
+  protected:
+    UnaryNode(NodeKind kind, ExpressionNode* base);
   public:
-    UnaryNode(ExpressionNode* base);
+    static bool classof(const Node* node) { return NodeKind::BackIncrement <= node->kind && node->kind <= NodeKind::FrontDecrement; }
   };
   class BinaryNode : public ExpressionNode
   {
   public:
     ExpressionNode* left;
     ExpressionNode* right;
+  protected:
+    BinaryNode(NodeKind kind, ExpressionNode* left, ExpressionNode* right);
   public:
-    BinaryNode(ExpressionNode* left, ExpressionNode* right);
+    static bool classof(const Node* node) { return NodeKind::Mul <= node->kind && node->kind <= NodeKind::RShiftAsign; }
   };
-  class BackUnaryNode : public UnaryNode {
+  class BackUnaryNode : public UnaryNode
+  {
+  protected:
     using UnaryNode::UnaryNode;
+  public:
+    static bool classof(const Node* node) { return NodeKind::BackIncrement <= node->kind && node->kind <= NodeKind::Call; }
   };
   class BackIncrementNode : public BackUnaryNode
   {
   public:
-    using BackUnaryNode::BackUnaryNode;
+    BackIncrementNode(ExpressionNode* base);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::BackIncrement; }
   };
   class BackDecrementNode : public BackUnaryNode
   {
   public:
-    using BackUnaryNode::BackUnaryNode;
+    BackDecrementNode(ExpressionNode* base);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::BackDecrement; }
   };
   class MemberAccessNode : public BackUnaryNode
   {
@@ -338,6 +540,7 @@ namespace pickc::parser
   public:
     MemberAccessNode(ExpressionNode* base, VariableNode* member);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::MemberAccess; }
   };
   class ArrayAccessNode : public BackUnaryNode
   {
@@ -346,162 +549,319 @@ namespace pickc::parser
   public:
     ArrayAccessNode(ExpressionNode* base, ExpressionNode* suffix);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ArrayAccess; }
   };
   class CallNode : public BackUnaryNode
   {
   public:
-    std::vector<ExpressionNode*> args;
+    ArenaVector<ExpressionNode*> args;
   public:
-    CallNode(ExpressionNode* base, std::vector<ExpressionNode*> args);
+    CallNode(ExpressionNode* base, const ArenaVector<ExpressionNode*>& args);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Call; }
   };
-  class FrontUnaryNode : public UnaryNode {
-  public:
+  class FrontUnaryNode : public UnaryNode
+  {
+  protected:
     using UnaryNode::UnaryNode;
+  public:
+    static bool classof(const Node* node) { return NodeKind::Plus <= node->kind && node->kind <= NodeKind::FrontDecrement; }
   };
   class PlusNode : public FrontUnaryNode
   {
   public:
-    using FrontUnaryNode::FrontUnaryNode;
+    PlusNode(ExpressionNode* base);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Plus; }
   };
   class MinusNode : public FrontUnaryNode
   {
   public:
-    using FrontUnaryNode::FrontUnaryNode;
+    MinusNode(ExpressionNode* base);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Minus; }
   };
   class CopyNode : public FrontUnaryNode
   {
   public:
-    using FrontUnaryNode::FrontUnaryNode;
+    CopyNode(ExpressionNode* base);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Copy; }
+  };
+  class BitNotNode : public FrontUnaryNode
+  {
+  public:
+    BitNotNode(ExpressionNode* base);
+    virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::BitNot; }
+  };
+  class LogicalNotNode : public FrontUnaryNode
+  {
+  public:
+    LogicalNotNode(ExpressionNode* base);
+    virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::LogicalNot; }
   };
   class FrontIncrementNode : public FrontUnaryNode
   {
   public:
-    using FrontUnaryNode::FrontUnaryNode;
+    FrontIncrementNode(ExpressionNode* base);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::FrontIncrement; }
   };
   class FrontDecrementNode : public FrontUnaryNode
   {
   public:
-    using FrontUnaryNode::FrontUnaryNode;
+    FrontDecrementNode(ExpressionNode* base);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::FrontDecrement; }
   };
-  class FactorNode : public BinaryNode {
-  public:
+  class FactorNode : public BinaryNode
+  {
+  protected:
     using BinaryNode::BinaryNode;
+  public:
+    static bool classof(const Node* node) { return NodeKind::Mul <= node->kind && node->kind <= NodeKind::Mod; }
   };
   class MulNode : public FactorNode
   {
   public:
-    using FactorNode::FactorNode;
+    MulNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Mul; }
   };
   class DivNode : public FactorNode
   {
   public:
-    using FactorNode::FactorNode;
+    DivNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Div; }
   };
   class ModNode : public FactorNode
   {
   public:
-    using FactorNode::FactorNode;
+    ModNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Mod; }
   };
-  class TermNode : public BinaryNode {
-  public:
+  class TermNode : public BinaryNode
+  {
+  protected:
     using BinaryNode::BinaryNode;
+  public:
+    static bool classof(const Node* node) { return NodeKind::Add <= node->kind && node->kind <= NodeKind::Sub; }
   };
   class AddNode : public TermNode
   {
   public:
-    using TermNode::TermNode;
+    AddNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Add; }
   };
   class SubNode : public TermNode
   {
   public:
-    using TermNode::TermNode;
+    SubNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Sub; }
   };
-  class ComparisonNode : public BinaryNode {
-  public:
+  class ComparisonNode : public BinaryNode
+  {
+  protected:
     using BinaryNode::BinaryNode;
+  public:
+    static bool classof(const Node* node) { return NodeKind::Equal <= node->kind && node->kind <= NodeKind::LessThan; }
   };
   class EqualNode : public ComparisonNode
   {
   public:
-    using ComparisonNode::ComparisonNode;
+    EqualNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Equal; }
   };
   class NotEqualNode : public ComparisonNode
   {
   public:
-    using ComparisonNode::ComparisonNode;
+    NotEqualNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::NotEqual; }
   };
   class GreaterEqualNode : public ComparisonNode
   {
   public:
-    using ComparisonNode::ComparisonNode;
+    GreaterEqualNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::GreaterEqual; }
   };
   class GreaterThanNode : public ComparisonNode
   {
   public:
-    using ComparisonNode::ComparisonNode;
+    GreaterThanNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::GreaterThan; }
   };
   class LessEqualNode : public ComparisonNode
   {
   public:
-    using ComparisonNode::ComparisonNode;
+    LessEqualNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::LessEqual; }
   };
   class LessThanNode : public ComparisonNode
   {
   public:
-    using ComparisonNode::ComparisonNode;
+    LessThanNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::LessThan; }
   };
-  class AsignNode : public BinaryNode
+  class ShiftNode : public BinaryNode
+  {
+  protected:
+    using BinaryNode::BinaryNode;
+  public:
+    static bool classof(const Node* node) { return NodeKind::LShift <= node->kind && node->kind <= NodeKind::RShift; }
+  };
+  class LShiftNode : public ShiftNode
+  {
+  public:
+    LShiftNode(ExpressionNode* left, ExpressionNode* right);
+    virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::LShift; }
+  };
+  class RShiftNode : public ShiftNode
   {
   public:
+    RShiftNode(ExpressionNode* left, ExpressionNode* right);
+    virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::RShift; }
+  };
+  class BitwiseNode : public BinaryNode
+  {
+  protected:
     using BinaryNode::BinaryNode;
+  public:
+    static bool classof(const Node* node) { return NodeKind::BitAnd <= node->kind && node->kind <= NodeKind::BitXor; }
+  };
+  class BitAndNode : public BitwiseNode
+  {
+  public:
+    BitAndNode(ExpressionNode* left, ExpressionNode* right);
+    virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::BitAnd; }
+  };
+  class BitOrNode : public BitwiseNode
+  {
+  public:
+    BitOrNode(ExpressionNode* left, ExpressionNode* right);
+    virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::BitOr; }
+  };
+  class BitXorNode : public BitwiseNode
+  {
+  public:
+    BitXorNode(ExpressionNode* left, ExpressionNode* right);
+    virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::BitXor; }
+  };
+  class LogicalNode : public BinaryNode
+  {
+  protected:
+    using BinaryNode::BinaryNode;
+  public:
+    static bool classof(const Node* node) { return NodeKind::LogicalAnd <= node->kind && node->kind <= NodeKind::LogicalOr; }
+  };
+  class LogicalAndNode : public LogicalNode
+  {
+  public:
+    LogicalAndNode(ExpressionNode* left, ExpressionNode* right);
+    virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::LogicalAnd; }
+  };
+  class LogicalOrNode : public LogicalNode
+  {
+  public:
+    LogicalOrNode(ExpressionNode* left, ExpressionNode* right);
+    virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::LogicalOr; }
+  };
+  class AsignNode : public BinaryNode
+  {
+  protected:
+    AsignNode(NodeKind kind, ExpressionNode* left, ExpressionNode* right);
+  public:
+    AsignNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return NodeKind::Asign <= node->kind && node->kind <= NodeKind::RShiftAsign; }
   };
   class AddAsignNode : public AsignNode
   {
   public:
-    using AsignNode::AsignNode;
+    AddAsignNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::AddAsign; }
   };
   class SubAsignNode : public AsignNode
   {
   public:
-    using AsignNode::AsignNode;
+    SubAsignNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::SubAsign; }
   };
   class MulAsignNode : public AsignNode
   {
   public:
-    using AsignNode::AsignNode;
+    MulAsignNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::MulAsign; }
   };
   class DivAsignNode : public AsignNode
   {
   public:
-    using AsignNode::AsignNode;
+    DivAsignNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::DivAsign; }
   };
   class ModAsignNode : public AsignNode
   {
   public:
-    using AsignNode::AsignNode;
+    ModAsignNode(ExpressionNode* left, ExpressionNode* right);
+    virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ModAsign; }
+  };
+  class BitAndAsignNode : public AsignNode
+  {
+  public:
+    BitAndAsignNode(ExpressionNode* left, ExpressionNode* right);
+    virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::BitAndAsign; }
+  };
+  class BitOrAsignNode : public AsignNode
+  {
+  public:
+    BitOrAsignNode(ExpressionNode* left, ExpressionNode* right);
+    virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::BitOrAsign; }
+  };
+  class BitXorAsignNode : public AsignNode
+  {
+  public:
+    BitXorAsignNode(ExpressionNode* left, ExpressionNode* right);
+    virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::BitXorAsign; }
+  };
+  class LShiftAsignNode : public AsignNode
+  {
+  public:
+    LShiftAsignNode(ExpressionNode* left, ExpressionNode* right);
+    virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::LShiftAsign; }
+  };
+  class RShiftAsignNode : public AsignNode
+  {
+  public:
+    RShiftAsignNode(ExpressionNode* left, ExpressionNode* right);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::RShiftAsign; }
   };
   class ReturnNode : public Node
   {
@@ -510,6 +870,7 @@ namespace pickc::parser
   public:
     ReturnNode(ExpressionNode* value);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Return; }
   };
   class VariableDefineNode : public ExpressionNode
   {
@@ -520,7 +881,9 @@ namespace pickc::parser
     TypeNode* type;
     ExpressionNode* init;
   public:
+    VariableDefineNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::VariableDefine; }
   };
   class ArgumentDefineNode : public Node
   {
@@ -530,28 +893,41 @@ namespace pickc::parser
     TypeNode* type;
     ExpressionNode* init;
   public:
+    ArgumentDefineNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ArgumentDefine; }
   };
   class FunctionDefineNode : public ExpressionNode
   {
   public:
     bool isPub;
     VariableNode* name;
-    std::vector<ArgumentDefineNode*> args;
+    ArenaVector<ArgumentDefineNode*> args;
     TypeNode* retType;
     ExpressionNode* body;
+    // 本文の構文解析を後回しにしたときはtrueになり、bodyはnullptrのまま本文のトークンの範囲をbodySpanに持つ。
+    bool isBodyDeferred;
+    SourceSpan bodySpan;
+  protected:
+    FunctionDefineNode(NodeKind kind, Arena& arena);
   public:
+    FunctionDefineNode(Arena& arena);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return NodeKind::FunctionDefine <= node->kind && node->kind <= NodeKind::Extern; }
   };
   class ClassDefineNode : public Node
   {
   public:
+    ClassDefineNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ClassDefine; }
   };
   class AliasDefineNode : public Node
   {
   public:
+    AliasDefineNode();
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::AliasDefine; }
   };
   class ImportNode : public Node
   {
@@ -560,18 +936,23 @@ namespace pickc::parser
   public:
     ImportNode(VariableNode* name);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Import; }
   };
   class ExternNode : public FunctionDefineNode
   {
   public:
+    ExternNode(Arena& arena);
     virtual void dump(const std::string& indent, const std::string& indent2) const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Extern; }
   };
   class RootNode : public Node
   {
   public:
     std::vector<Node*> nodes;
   public:
+    RootNode();
     virtual void dump(const std::string& indent = "/", const std::string& indent2 = "   ") const override;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Root; }
   };
 }
 
@@ -2,30 +2,45 @@
 
 #include <iostream>
 #include <filesystem>
+#include <algorithm>
+#include <memory>
 
 #include "utils/result.h"
 #include "utils/string_utils.h"
 #include "utils/vector_utils.h"
+#include "utils/thread_pool.h"
+#include "utils/time_report.h"
 
 #include "ast.h"
+#include "ast_cache.h"
 
 namespace pickc::parser
 {
   namespace
   {
-    Option<std::vector<std::string>> createModuleTree(const std::string& dir, ModuleTree* parent)
+    struct ParseTask
+    {
+      std::string path;
+      ModuleTree* tree;
+    };
+    // ディレクトリを辿ってモジュールの木を作り、構文解析するファイルを集める。
+    // エントリは名前順に辿るので、ファイルの順番はファイルシステムによらない。
+    void createModuleTree(const std::string& dir, ModuleTree* parent, std::vector<ParseTask>& tasks)
     {
       std::error_code err;
-      std::vector<std::string> errors;
+      std::vector<std::filesystem::directory_entry> entries;
       for(std::filesystem::directory_iterator itr(dir), end; itr != end && !err; itr.increment(err)) {
-        const auto entry = *itr;
+        entries.push_back(*itr);
+      }
+      std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.path().filename() < b.path().filename(); });
+      for(const auto& entry : entries) {
         auto filename = entry.path().filename().string();
         if(std::filesystem::is_directory(entry)) {
           auto tree = new ModuleTree();
-          tree->name = parent->name + "::" + filename;
+          tree->name = Atom::join(parent->name, Atom::intern(filename));
           tree->parent = parent;
           parent->submodules[filename] = tree;
-          if(auto res = createModuleTree(entry.path().string(), tree)) errors += res.get();
+          createModuleTree(entry.path().string(), tree, tasks);
         }
         else if(endsWith(filename, ".pick")) {
           auto name = filename.substr(0, filename.rfind('.'));
@@ -33,36 +48,75 @@ namespace pickc::parser
           if(name == "index") tree = parent;
           else {
             tree = new ModuleTree();
-            tree->name = parent->name + "::" + name;
+            tree->name = Atom::join(parent->name, Atom::intern(name));
             tree->parent = parent;
             parent->submodules[name] = tree;
           }
-          if(auto res = Tokenizer(std::filesystem::absolute(entry).string()).tokenize()) {
-            tree->sequence = std::move(res.get());
-          }
-          else {
-            errors += res.err();
-            continue;
-          }
-          if(auto res = ASTGenerator(tree->sequence).generate()) {
-            tree->ast = std::move(res.get());
-          }
-          else {
-            errors += res.err();
-            continue;
-          }
+          tasks.push_back(ParseTask{ std::filesystem::absolute(entry).string(), tree });
+        }
+      }
+    }
+    // 1ファイルを字句解析、構文解析する。触るのはtask.treeだけなので、ファイルごとに並列に実行できる。
+    // cacheがあれば、内容の変わっていないファイルは保存しておいた結果を読み込むだけで済ませる。
+    std::vector<std::string> parseFile(const ParseTask& task, bool deferBodies, const ASTCache* cache)
+    {
+      auto tree = task.tree;
+      auto source = SourceFile::open(task.path);
+      if(!source) {
+        return { source.err() };
+      }
+      uint64_t key = 0;
+      if(cache) {
+        TimeReport::Scope scope("ast cache", tree->name.str());
+        key = cache->key(*source.get());
+        if(cache->load(key, source.get(), tree->sequence, tree->ast, tree->astArena)) return {};
+      }
+      {
+        TimeReport::Scope scope("tokenize", tree->name.str());
+        if(auto res = Tokenizer(source.get()).tokenize()) {
+          tree->sequence = std::move(res.get());
+        }
+        else {
+          return res.err();
         }
       }
-      if(errors.empty()) return none;
-      return some(errors);
+      {
+        TimeReport::Scope scope("ast", tree->name.str());
+        if(auto res = ASTGenerator(tree->sequence, tree->astArena, deferBodies).generate()) {
+          tree->ast = std::move(res.get());
+        }
+        else {
+          return res.err();
+        }
+      }
+      if(cache) {
+        TimeReport::Scope scope("ast cache", tree->name.str());
+        cache->store(key, tree->sequence, tree->ast);
+      }
+      return {};
     }
   }
   Parser::Parser() {}
   Result<ModuleTree*, std::vector<std::string>> Parser::parse(const CompilerOption& option)
   {
     auto root = new ModuleTree();
-    root->name = option.projectName;
-    if(auto res = createModuleTree(option.srcDir, root)) return error(res.get());
+    root->name = Atom::intern(option.projectName);
+    std::vector<ParseTask> tasks;
+    createModuleTree(option.srcDir, root, tasks);
+    // エラーはファイルごとに分けて持ち、最後にファイルの順番で並べる。
+    std::vector<std::vector<std::string>> taskErrors(tasks.size());
+    std::unique_ptr<ASTCache> cache;
+    if(!option.cacheDir.empty()) cache = std::make_unique<ASTCache>(option.cacheDir, option.lazy);
+    {
+      ThreadPool pool(std::min(option.numThreads, tasks.size()));
+      for(size_t i = 0; i < tasks.size(); ++i) {
+        pool.submit([&tasks, &taskErrors, &option, &cache, i] { taskErrors[i] = parseFile(tasks[i], option.lazy, cache.get()); });
+      }
+      pool.wait();
+    }
+    std::vector<std::string> errors;
+    for(auto& errs : taskErrors) errors += std::move(errs);
+    if(!errors.empty()) return error(std::move(errors));
     if(option.compilerDebug) {
       std::cout << "AST Dump" << std::endl;
       dump(root);
@@ -0,0 +1,326 @@
+#include "scan.h"
+
+#include <cstdint>
+#include <cassert>
+
+#if defined(__x86_64__) || defined(_M_X64)
+  #define PICKC_SCAN_X64
+  #ifdef _MSC_VER
+    #include <intrin.h>
+  #endif
+  #include <immintrin.h>
+#endif
+
+// GCC/Clangでは関数単位でAVX2の命令を許可する。MSVCは指定なしでAVX2の組み込み関数を使える。
+#if defined(PICKC_SCAN_X64) && defined(__GNUC__)
+  #define PICKC_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+  #define PICKC_TARGET_AVX2
+#endif
+
+namespace pickc::parser
+{
+  namespace
+  {
+    inline bool isSpace(char c)
+    {
+      return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+    inline bool isDigit(char c)
+    {
+      return c >= '0' && c <= '9';
+    }
+    inline bool isIdentifier(char c)
+    {
+      const auto lower = static_cast<char>(c | 0x20);
+      return (lower >= 'a' && lower <= 'z') || isDigit(c) || c == '_' || static_cast<uint8_t>(c) >= 0x80;
+    }
+
+    size_t scalarSkipSpace(const char* str, size_t i, size_t n)
+    {
+      while(i < n && isSpace(str[i])) ++i;
+      return i;
+    }
+    size_t scalarSkipIdentifier(const char* str, size_t i, size_t n)
+    {
+      while(i < n && isIdentifier(str[i])) ++i;
+      return i;
+    }
+    size_t scalarSkipDigits(const char* str, size_t i, size_t n)
+    {
+      while(i < n && isDigit(str[i])) ++i;
+      return i;
+    }
+    size_t scalarFindStringEnd(const char* str, size_t i, size_t n)
+    {
+      while(i < n && str[i] != '"' && str[i] != '\\' && str[i] != '\n') ++i;
+      return i;
+    }
+    size_t scalarFindLineEnd(const char* str, size_t i, size_t n)
+    {
+      while(i < n && str[i] != '\n') ++i;
+      return i;
+    }
+    constexpr ScanFunctions scalarFunctions = {
+      scalarSkipSpace,
+      scalarSkipIdentifier,
+      scalarSkipDigits,
+      scalarFindStringEnd,
+      scalarFindLineEnd,
+    };
+
+  #ifdef PICKC_SCAN_X64
+    inline size_t countTrailingZeros(uint32_t mask)
+    {
+      assert(mask != 0);
+    #ifdef _MSC_VER
+      unsigned long index;
+      _BitScanForward(&index, mask);
+      return index;
+    #else
+      return __builtin_ctz(mask);
+    #endif
+    }
+
+    // SSE2: 16バイトずつ比較し、movemaskで最初に条件が変わる位置を求める。
+    // 端数は16バイトを超えて読まないようにスカラー版で処理する。
+    size_t sse2SkipSpace(const char* str, size_t i, size_t n)
+    {
+      const auto space = _mm_set1_epi8(' ');
+      const auto low = _mm_set1_epi8('\t' - 1);
+      const auto high = _mm_set1_epi8('\r' + 1);
+      for(; i + 16 <= n; i += 16) {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+        const auto control = _mm_and_si128(_mm_cmpgt_epi8(v, low), _mm_cmpgt_epi8(high, v));
+        const auto match = _mm_or_si128(_mm_cmpeq_epi8(v, space), control);
+        const auto mask = ~static_cast<uint32_t>(_mm_movemask_epi8(match)) & 0xFFFF;
+        if(mask != 0) return i + countTrailingZeros(mask);
+      }
+      return scalarSkipSpace(str, i, n);
+    }
+    size_t sse2SkipIdentifier(const char* str, size_t i, size_t n)
+    {
+      const auto caseBit = _mm_set1_epi8(0x20);
+      const auto alphaLow = _mm_set1_epi8('a' - 1);
+      const auto alphaHigh = _mm_set1_epi8('z' + 1);
+      const auto digitLow = _mm_set1_epi8('0' - 1);
+      const auto digitHigh = _mm_set1_epi8('9' + 1);
+      const auto underscore = _mm_set1_epi8('_');
+      const auto zero = _mm_setzero_si128();
+      for(; i + 16 <= n; i += 16) {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+        const auto lower = _mm_or_si128(v, caseBit);
+        const auto alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, alphaLow), _mm_cmpgt_epi8(alphaHigh, lower));
+        const auto digit = _mm_and_si128(_mm_cmpgt_epi8(v, digitLow), _mm_cmpgt_epi8(digitHigh, v));
+        // 0x80以上のバイトは符号付きで負になる。
+        const auto nonAscii = _mm_cmpgt_epi8(zero, v);
+        const auto match = _mm_or_si128(_mm_or_si128(alpha, digit), _mm_or_si128(_mm_cmpeq_epi8(v, underscore), nonAscii));
+        const auto mask = ~static_cast<uint32_t>(_mm_movemask_epi8(match)) & 0xFFFF;
+        if(mask != 0) return i + countTrailingZeros(mask);
+      }
+      return scalarSkipIdentifier(str, i, n);
+    }
+    size_t sse2SkipDigits(const char* str, size_t i, size_t n)
+    {
+      const auto low = _mm_set1_epi8('0' - 1);
+      const auto high = _mm_set1_epi8('9' + 1);
+      for(; i + 16 <= n; i += 16) {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+        const auto match = _mm_and_si128(_mm_cmpgt_epi8(v, low), _mm_cmpgt_epi8(high, v));
+        const auto mask = ~static_cast<uint32_t>(_mm_movemask_epi8(match)) & 0xFFFF;
+        if(mask != 0) return i + countTrailingZeros(mask);
+      }
+      return scalarSkipDigits(str, i, n);
+    }
+    size_t sse2FindStringEnd(const char* str, size_t i, size_t n)
+    {
+      const auto quote = _mm_set1_epi8('"');
+      const auto backslash = _mm_set1_epi8('\\');
+      const auto newline = _mm_set1_epi8('\n');
+      for(; i + 16 <= n; i += 16) {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+        const auto match = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)), _mm_cmpeq_epi8(v, newline));
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(match));
+        if(mask != 0) return i + countTrailingZeros(mask);
+      }
+      return scalarFindStringEnd(str, i, n);
+    }
+    size_t sse2FindLineEnd(const char* str, size_t i, size_t n)
+    {
+      const auto newline = _mm_set1_epi8('\n');
+      for(; i + 16 <= n; i += 16) {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)));
+        if(mask != 0) return i + countTrailingZeros(mask);
+      }
+      return scalarFindLineEnd(str, i, n);
+    }
+    constexpr ScanFunctions sse2Functions = {
+      sse2SkipSpace,
+      sse2SkipIdentifier,
+      sse2SkipDigits,
+      sse2FindStringEnd,
+      sse2FindLineEnd,
+    };
+
+    // AVX2: SSE2版と同じ判定を32バイトずつ行う。端数はSSE2版に任せる。
+    PICKC_TARGET_AVX2 size_t avx2SkipSpace(const char* str, size_t i, size_t n)
+    {
+      const auto space = _mm256_set1_epi8(' ');
+      const auto low = _mm256_set1_epi8('\t' - 1);
+      const auto high = _mm256_set1_epi8('\r' + 1);
+      for(; i + 32 <= n; i += 32) {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i));
+        const auto control = _mm256_and_si256(_mm256_cmpgt_epi8(v, low), _mm256_cmpgt_epi8(high, v));
+        const auto match = _mm256_or_si256(_mm256_cmpeq_epi8(v, space), control);
+        const auto mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(match));
+        if(mask != 0) return i + countTrailingZeros(mask);
+      }
+      return sse2SkipSpace(str, i, n);
+    }
+    PICKC_TARGET_AVX2 size_t avx2SkipIdentifier(const char* str, size_t i, size_t n)
+    {
+      const auto caseBit = _mm256_set1_epi8(0x20);
+      const auto alphaLow = _mm256_set1_epi8('a' - 1);
+      const auto alphaHigh = _mm256_set1_epi8('z' + 1);
+      const auto digitLow = _mm256_set1_epi8('0' - 1);
+      const auto digitHigh = _mm256_set1_epi8('9' + 1);
+      const auto underscore = _mm256_set1_epi8('_');
+      const auto zero = _mm256_setzero_si256();
+      for(; i + 32 <= n; i += 32) {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i));
+        const auto lower = _mm256_or_si256(v, caseBit);
+        const auto alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, alphaLow), _mm256_cmpgt_epi8(alphaHigh, lower));
+        const auto digit = _mm256_and_si256(_mm256_cmpgt_epi8(v, digitLow), _mm256_cmpgt_epi8(digitHigh, v));
+        const auto nonAscii = _mm256_cmpgt_epi8(zero, v);
+        const auto match = _mm256_or_si256(_mm256_or_si256(alpha, digit), _mm256_or_si256(_mm256_cmpeq_epi8(v, underscore), nonAscii));
+        const auto mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(match));
+        if(mask != 0) return i + countTrailingZeros(mask);
+      }
+      return sse2SkipIdentifier(str, i, n);
+    }
+    PICKC_TARGET_AVX2 size_t avx2SkipDigits(const char* str, size_t i, size_t n)
+    {
+      const auto low = _mm256_set1_epi8('0' - 1);
+      const auto high = _mm256_set1_epi8('9' + 1);
+      for(; i + 32 <= n; i += 32) {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i));
+        const auto match = _mm256_and_si256(_mm256_cmpgt_epi8(v, low), _mm256_cmpgt_epi8(high, v));
+        const auto mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(match));
+        if(mask != 0) return i + countTrailingZeros(mask);
+      }
+      return sse2SkipDigits(str, i, n);
+    }
+    PICKC_TARGET_AVX2 size_t avx2FindStringEnd(const char* str, size_t i, size_t n)
+    {
+      const auto quote = _mm256_set1_epi8('"');
+      const auto backslash = _mm256_set1_epi8('\\');
+      const auto newline = _mm256_set1_epi8('\n');
+      for(; i + 32 <= n; i += 32) {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i));
+        const auto match = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)), _mm256_cmpeq_epi8(v, newline));
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(match));
+        if(mask != 0) return i + countTrailingZeros(mask);
+      }
+      return sse2FindStringEnd(str, i, n);
+    }
+    PICKC_TARGET_AVX2 size_t avx2FindLineEnd(const char* str, size_t i, size_t n)
+    {
+      const auto newline = _mm256_set1_epi8('\n');
+      for(; i + 32 <= n; i += 32) {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i));
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline)));
+        if(mask != 0) return i + countTrailingZeros(mask);
+      }
+      return sse2FindLineEnd(str, i, n);
+    }
+    constexpr ScanFunctions avx2Functions = {
+      avx2SkipSpace,
+      avx2SkipIdentifier,
+      avx2SkipDigits,
+      avx2FindStringEnd,
+      avx2FindLineEnd,
+    };
+
+    bool cpuSupportsAVX2()
+    {
+    #ifdef _MSC_VER
+      int info[4];
+      __cpuid(info, 0);
+      if(info[0] < 7) return false;
+      __cpuid(info, 1);
+      // OSXSAVEとAVX。OSがYMMレジスタを保存するかどうかはXGETBVで確認する。
+      if((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) return false;
+      if((_xgetbv(0) & 0x6) != 0x6) return false;
+      __cpuidex(info, 7, 0);
+      return (info[1] & (1 << 5)) != 0;
+    #else
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+    #endif
+    }
+  #endif
+
+    ScanKernel& selectedKernel()
+    {
+      static ScanKernel kernel = bestScanKernel();
+      return kernel;
+    }
+  }
+  bool isScanKernelSupported(ScanKernel kernel)
+  {
+    switch(kernel) {
+      case ScanKernel::Scalar:
+        return true;
+    #ifdef PICKC_SCAN_X64
+      case ScanKernel::SSE2:
+        // x64では常に使える。
+        return true;
+      case ScanKernel::AVX2: {
+        static const bool supported = cpuSupportsAVX2();
+        return supported;
+      }
+    #endif
+      default:
+        return false;
+    }
+  }
+  ScanKernel bestScanKernel()
+  {
+    if(isScanKernelSupported(ScanKernel::AVX2)) return ScanKernel::AVX2;
+    if(isScanKernelSupported(ScanKernel::SSE2)) return ScanKernel::SSE2;
+    return ScanKernel::Scalar;
+  }
+  const ScanFunctions& scanFunctions(ScanKernel kernel)
+  {
+    assert(isScanKernelSupported(kernel));
+    switch(kernel) {
+    #ifdef PICKC_SCAN_X64
+      case ScanKernel::SSE2:
+        return sse2Functions;
+      case ScanKernel::AVX2:
+        return avx2Functions;
+    #endif
+      default:
+        return scalarFunctions;
+    }
+  }
+  ScanKernel currentScanKernel()
+  {
+    return selectedKernel();
+  }
+  void setScanKernel(ScanKernel kernel)
+  {
+    assert(isScanKernelSupported(kernel));
+    selectedKernel() = kernel;
+  }
+  const char* scanKernelName(ScanKernel kernel)
+  {
+    switch(kernel) {
+      case ScanKernel::Scalar: return "scalar";
+      case ScanKernel::SSE2: return "sse2";
+      case ScanKernel::AVX2: return "avx2";
+      default: assert(false); return "";
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef PICKC_PARSER_SCAN_H_
+#define PICKC_PARSER_SCAN_H_
+
+#include <cstddef>
+
+namespace pickc::parser
+{
+  // 字句解析で長く続く同種の文字の並びを読み飛ばすカーネルの種類
+  enum struct ScanKernel
+  {
+    Scalar,
+    SSE2,
+    AVX2,
+  };
+  // 各関数はstr[i, n)を先頭から走査し、条件に当てはまる最初の位置を返す。
+  // 見つからなければnを返す。
+  struct ScanFunctions
+  {
+    // 空白文字(' ', \t, \n, \v, \f, \r)以外の文字
+    size_t (*skipSpace)(const char* str, size_t i, size_t n);
+    // 識別子に使えない文字。識別子に使える文字はa-z, A-Z, 0-9, _, 非ASCII文字。
+    size_t (*skipIdentifier)(const char* str, size_t i, size_t n);
+    // 0-9以外の文字
+    size_t (*skipDigits)(const char* str, size_t i, size_t n);
+    // 文字列リテラルの本文を終える文字(", \, \n)
+    size_t (*findStringEnd)(const char* str, size_t i, size_t n);
+    // \n
+    size_t (*findLineEnd)(const char* str, size_t i, size_t n);
+  };
+  bool isScanKernelSupported(ScanKernel kernel);
+  // 実行中のCPUで使える最も速いカーネル
+  ScanKernel bestScanKernel();
+  const ScanFunctions& scanFunctions(ScanKernel kernel);
+  // Tokenizerが使うカーネル。初期値はbestScanKernel()。
+  ScanKernel currentScanKernel();
+  void setScanKernel(ScanKernel kernel);
+  const char* scanKernelName(ScanKernel kernel);
+}
+
+#endif // PICKC_PARSER_SCAN_H_
\ No newline at end of file
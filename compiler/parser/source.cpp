@@ -0,0 +1,69 @@
+#include "source.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "scan.h"
+
+namespace pickc::parser
+{
+  SourceFile::SourceFile(const std::string& path, MappedFile&& file) : path(path), file(std::move(file)) {}
+  const std::vector<uint32_t>& SourceFile::getLineStarts() const
+  {
+    std::call_once(lineStartsFlag, [this]() {
+      const auto data = file.data();
+      const auto size = file.size();
+      const auto& scan = scanFunctions(currentScanKernel());
+      lineStarts.push_back(0);
+      for(size_t i = scan.findLineEnd(data, 0, size); i < size; i = scan.findLineEnd(data, i + 1, size)) {
+        lineStarts.push_back(static_cast<uint32_t>(i + 1));
+      }
+      // 末尾の改行の後ろは行として数えない。
+      if(size != 0 && lineStarts.back() == size) lineStarts.pop_back();
+    });
+    return lineStarts;
+  }
+  Result<std::shared_ptr<const SourceFile>, std::string> SourceFile::open(const std::string& path)
+  {
+    auto file = MappedFile::open(path);
+    if(!file) return error(std::move(file.err()));
+    if(file.get().size() > std::numeric_limits<uint32_t>::max()) {
+      return error("エラー: ファイル " + path + " が大きすぎます。");
+    }
+    return ok(std::shared_ptr<const SourceFile>(new SourceFile(path, std::move(file.get()))));
+  }
+  const std::string& SourceFile::getPath() const
+  {
+    return path;
+  }
+  std::string_view SourceFile::text() const
+  {
+    return file.view();
+  }
+  std::string_view SourceFile::text(uint32_t offset, uint32_t length) const
+  {
+    return file.view().substr(offset, length);
+  }
+  size_t SourceFile::numLines() const
+  {
+    return getLineStarts().size();
+  }
+  size_t SourceFile::lineOf(uint32_t offset) const
+  {
+    const auto& starts = getLineStarts();
+    return std::upper_bound(starts.begin(), starts.end(), offset) - starts.begin() - 1;
+  }
+  size_t SourceFile::letterOf(uint32_t offset) const
+  {
+    return offset - getLineStarts()[lineOf(offset)];
+  }
+  std::string_view SourceFile::line(size_t line) const
+  {
+    const auto& starts = getLineStarts();
+    const auto begin = starts[line];
+    auto end = line + 1 < starts.size() ? starts[line + 1] : static_cast<uint32_t>(file.size());
+    if(end > begin && file.data()[end - 1] == '\n') --end;
+    if(end > begin && file.data()[end - 1] == '\r') --end;
+    return file.view().substr(begin, end - begin);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef PICKC_PARSER_SOURCE_H_
+#define PICKC_PARSER_SOURCE_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+#include "utils/result.h"
+#include "utils/mapped_file.h"
+
+namespace pickc::parser
+{
+  // ソースファイル1つ分の内容と行頭オフセット表
+  // ファイルはマップしたまま保持し、トークンや行はすべてこのバッファへの参照として扱う。
+  class SourceFile
+  {
+    std::string path;
+    MappedFile file;
+    // 各行の先頭のオフセット。lineStarts[0]は常に0。
+    // 行番号はエラー表示などでしか使わないので、初めて必要になったときに作る。
+    mutable std::vector<uint32_t> lineStarts;
+    mutable std::once_flag lineStartsFlag;
+    SourceFile(const std::string& path, MappedFile&& file);
+    const std::vector<uint32_t>& getLineStarts() const;
+  public:
+    static Result<std::shared_ptr<const SourceFile>, std::string> open(const std::string& path);
+    const std::string& getPath() const;
+    std::string_view text() const;
+    std::string_view text(uint32_t offset, uint32_t length) const;
+    size_t numLines() const;
+    // offsetを含む行。0から数える。
+    size_t lineOf(uint32_t offset) const;
+    // offsetの行内での位置。0から数える。
+    size_t letterOf(uint32_t offset) const;
+    // 改行文字を含まない行の内容。lineは0から数える。
+    std::string_view line(size_t line) const;
+  };
+}
+
+#endif // PICKC_PARSER_SOURCE_H_
\ No newline at end of file
@@ -1,29 +1,238 @@
 #include "token.h"
 
 #include <cassert>
-#include <regex>
+#include <array>
+#include <cstdint>
+#include <string_view>
 
 namespace pickc::parser
 {
-  Tokenizer::Tokenizer(const std::string& path) : sequence{path, {}}, errors(), stream(), done(false) {}
-  Token::Token(TokenKind kind, const std::string& value, size_t line, size_t letter) : kind(kind), value(value), line(line), letter(letter) {}
-  Token::Token(const Token& token) : kind(token.kind), value(token.value), line(token.line), letter(token.letter) {}
-  Token::Token(Token&& token) : kind(token.kind), value(std::move(token.value)), line(token.line), letter(token.letter) {}
-  Token& Token::operator=(const Token& token)
+  namespace
   {
-    kind = token.kind;
-    value = token.value;
-    line = token.line;
-    letter = token.letter;
-    return *this;
+    // 1バイトごとの文字クラス
+    enum struct CharClass : uint8_t
+    {
+      Other,      // 識別子にも区切りにも使えない文字
+      Space,      // 空白文字
+      Punct,      // 記号。tokenize内のswitchで処理する。
+      Digit,      // 0-9
+      Ident,      // 識別子の先頭に使える文字。a-z, A-Z, _, 非ASCII文字
+    };
+    constexpr auto charClassTable = [] {
+      std::array<CharClass, 256> table{};
+      for(size_t c = 0; c < 256; ++c) {
+        if(c >= 0x80 || c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) table[c] = CharClass::Ident;
+        else if(c >= '0' && c <= '9') table[c] = CharClass::Digit;
+        else table[c] = CharClass::Other;
+      }
+      for(auto c : std::string_view(" \t\r\n\v\f")) table[static_cast<uint8_t>(c)] = CharClass::Space;
+      for(auto c : std::string_view("(){}[];,@+-*/%&|^~=<>!.:'\"")) table[static_cast<uint8_t>(c)] = CharClass::Punct;
+      return table;
+    }();
+    inline CharClass charClass(char c)
+    {
+      return charClassTable[static_cast<uint8_t>(c)];
+    }
+
+    struct Keyword
+    {
+      std::string_view word;
+      TokenKind kind;
+    };
+    constexpr Keyword keywords[] = {
+      { "fn", TokenKind::FnKeyword },
+      { "def", TokenKind::DefKeyword },
+      { "mut", TokenKind::MutKeyword },
+      { "extern", TokenKind::ExternKeyword },
+      { "import", TokenKind::ImportKeyword },
+      { "return", TokenKind::ReturnKeyword },
+      { "if", TokenKind::IfKeyword },
+      { "else", TokenKind::ElseKeyword },
+      { "for", TokenKind::ForKeyword },
+      { "while", TokenKind::WhileKeyword },
+      { "loop", TokenKind::LoopKeyword },
+      { "pub", TokenKind::PubKeyword },
+      { "pri", TokenKind::PriKeyword },
+      { "class", TokenKind::ClassKeyword },
+      { "construct", TokenKind::ConstructKeyword },
+      { "destruct", TokenKind::DestructKeyword },
+      { "type", TokenKind::TypeKeyword },
+      { "i8", TokenKind::I8Keyword },
+      { "i16", TokenKind::I16Keyword },
+      { "i32", TokenKind::I32Keyword },
+      { "i64", TokenKind::I64Keyword },
+      { "u8", TokenKind::U8Keyword },
+      { "u16", TokenKind::U16Keyword },
+      { "u32", TokenKind::U32Keyword },
+      { "u64", TokenKind::U64Keyword },
+      { "f32", TokenKind::F32Keyword },
+      { "f64", TokenKind::F64Keyword },
+      { "void", TokenKind::VoidKeyword },
+      { "bool", TokenKind::BoolKeyword },
+      { "char", TokenKind::CharKeyword },
+      { "ptr", TokenKind::PtrKeyword },
+      { "true", TokenKind::Bool },
+      { "false", TokenKind::Bool },
+      { "null", TokenKind::Null },
+      { "this", TokenKind::This },
+    };
+    constexpr size_t MAX_KEYWORD_LENGTH = 9;
+    constexpr size_t KEYWORD_BUCKET_SIZE = 4;
+    constexpr uint8_t EMPTY_KEYWORD = 0xFF;
+    // 予約語を(長さ, 先頭文字)で引くための表。
+    // 各バケットにはkeywordsの添字が最大KEYWORD_BUCKET_SIZE個入る。
+    constexpr auto keywordTable = [] {
+      std::array<std::array<uint8_t, KEYWORD_BUCKET_SIZE>, (MAX_KEYWORD_LENGTH + 1) * 26> table{};
+      for(auto& bucket : table) {
+        for(auto& index : bucket) index = EMPTY_KEYWORD;
+      }
+      for(size_t i = 0; i < std::size(keywords); ++i) {
+        auto& bucket = table[keywords[i].word.size() * 26 + (keywords[i].word[0] - 'a')];
+        size_t j = 0;
+        while(bucket[j] != EMPTY_KEYWORD) ++j;
+        bucket[j] = static_cast<uint8_t>(i);
+      }
+      return table;
+    }();
+    Option<TokenKind> findKeyword(std::string_view word)
+    {
+      if(word.size() > MAX_KEYWORD_LENGTH || word[0] < 'a' || word[0] > 'z') return none;
+      for(auto index : keywordTable[word.size() * 26 + (word[0] - 'a')]) {
+        if(index == EMPTY_KEYWORD) break;
+        if(keywords[index].word == word) return some(keywords[index].kind);
+      }
+      return none;
+    }
+
+    // 数値リテラルを受理するDFA
+    // [0-9]+ (\.[0-9]+)? (e[+-]?[0-9]+)?
+    enum struct NumberState : uint8_t
+    {
+      Start,
+      Integer,
+      Dot,
+      Fraction,
+      Exponent,
+      ExponentSign,
+      ExponentDigits,
+      Reject,
+    };
+    enum struct NumberInput : uint8_t
+    {
+      Digit,
+      Dot,
+      E,
+      Sign,
+      Other,
+    };
+    constexpr NumberState numberTransition[][5] = {
+      //                Digit                        Dot                  E                      Sign                       Other
+      /* Start */          { NumberState::Integer,        NumberState::Reject, NumberState::Reject,   NumberState::Reject,       NumberState::Reject },
+      /* Integer */        { NumberState::Integer,        NumberState::Dot,    NumberState::Exponent, NumberState::Reject,       NumberState::Reject },
+      /* Dot */            { NumberState::Fraction,       NumberState::Reject, NumberState::Reject,   NumberState::Reject,       NumberState::Reject },
+      /* Fraction */       { NumberState::Fraction,       NumberState::Reject, NumberState::Exponent, NumberState::Reject,       NumberState::Reject },
+      /* Exponent */       { NumberState::ExponentDigits, NumberState::Reject, NumberState::Reject,   NumberState::ExponentSign, NumberState::Reject },
+      /* ExponentSign */   { NumberState::ExponentDigits, NumberState::Reject, NumberState::Reject,   NumberState::Reject,       NumberState::Reject },
+      /* ExponentDigits */ { NumberState::ExponentDigits, NumberState::Reject, NumberState::Reject,   NumberState::Reject,       NumberState::Reject },
+    };
+    inline NumberInput numberInput(char c)
+    {
+      switch(c) {
+        case '.': return NumberInput::Dot;
+        case 'e': return NumberInput::E;
+        case '+':
+        case '-': return NumberInput::Sign;
+        default: return charClass(c) == CharClass::Digit ? NumberInput::Digit : NumberInput::Other;
+      }
+    }
+
+    struct Suffix
+    {
+      std::string_view suffix;
+      TokenKind kind;
+      // 整数部のみのリテラルにしか付けられない接尾辞ならtrue
+      bool integerOnly;
+    };
+    constexpr Suffix suffixes[] = {
+      { "i8", TokenKind::I8, true },
+      { "i16", TokenKind::I16, true },
+      { "i32", TokenKind::I32, true },
+      { "i64", TokenKind::I64, true },
+      { "u8", TokenKind::U8, true },
+      { "u16", TokenKind::U16, true },
+      { "u32", TokenKind::U32, true },
+      { "u64", TokenKind::U64, true },
+      { "f32", TokenKind::F32, false },
+      { "f64", TokenKind::F64, false },
+    };
+
+    // エスケープシーケンス\cが表す文字
+    Option<char> unescape(char c)
+    {
+      switch(c) {
+        case 'a': return some('\a');
+        case 'b': return some('\b');
+        case 'n': return some('\n');
+        case 'r': return some('\r');
+        case 'f': return some('\f');
+        case 't': return some('\t');
+        case 'v': return some('\v');
+        case '\\': return some('\\');
+        case '0': return some('\0');
+        case '"': return some('"');
+        case '\'': return some('\'');
+        default: return none;
+      }
+    }
+  }
+  Tokenizer::Tokenizer(const std::string& path) : sequence{path, nullptr, {}, {}, {}, {}}, errors(), scan(scanFunctions(currentScanKernel())), done(false) {}
+  Tokenizer::Tokenizer(std::shared_ptr<const SourceFile> source) : sequence{source->getPath(), source, {}, {}, {}, {}}, errors(), scan(scanFunctions(currentScanKernel())), done(false) {}
+  size_t TokenSequence::size() const
+  {
+    return kinds.size();
+  }
+  Token TokenSequence::operator[](size_t index) const
+  {
+    return Token{ kinds[index], offsets[index], lengths[index] };
   }
-  Token& Token::operator=(Token&& token)
+  void TokenSequence::push(TokenKind kind, uint32_t offset, uint32_t length)
   {
-    kind = token.kind;
-    value = std::move(token.value);
-    line = token.line;
-    letter = token.letter;
-    return *this;
+    kinds.push_back(kind);
+    offsets.push_back(offset);
+    lengths.push_back(length);
+  }
+  std::string_view TokenSequence::text(const Token& token) const
+  {
+    return source->text(token.offset, token.length);
+  }
+  std::string TokenSequence::value(const Token& token) const
+  {
+    const auto str = text(token);
+    if(token.kind != TokenKind::Char && token.kind != TokenKind::String) return std::string(str);
+    std::string res;
+    res.reserve(str.size());
+    // 前後の引用符を除いて展開する。
+    for(size_t i = 1; i + 1 < str.size(); ++i) {
+      if(str[i] == '\\') {
+        if(auto c = unescape(str[++i])) res += c.get();
+      }
+      else {
+        res += str[i];
+      }
+    }
+    return res;
+  }
+  size_t TokenSequence::line(const Token& token) const
+  {
+    return source->lineOf(token.offset) + 1;
+  }
+  size_t TokenSequence::letter(const Token& token) const
+  {
+    return source->letterOf(token.offset) + 1;
+  }
+  size_t TokenSequence::numLines() const
+  {
+    return source ? source->numLines() : 0;
   }
   std::string TokenSequence::toOutputString(size_t line) const
   {
@@ -31,392 +240,285 @@ namespace pickc::parser
     res += '|';
     res += std::to_string(line + 1);
     res += "| ";
-    res += rawFileData[line];
+    res += source->line(line);
     res += '\n';
     return res;
   }
+  void Tokenizer::pushToken(TokenKind kind, size_t offset, size_t length)
+  {
+    sequence.push(kind, static_cast<uint32_t>(offset), static_cast<uint32_t>(length));
+  }
+  void Tokenizer::pushError(const std::string& message, size_t offset)
+  {
+    const auto line = sequence.source->lineOf(static_cast<uint32_t>(offset));
+    const auto letter = sequence.source->letterOf(static_cast<uint32_t>(offset));
+    errors.push_back("エラー: " + message + "\n    at " + sequence.file + " " + std::to_string(line + 1) + "行目, " + std::to_string(letter + 1) + "文字目");
+  }
+  void Tokenizer::lexWord(std::string_view str, size_t& letter)
+  {
+    const auto len = str.size();
+    const auto begin = letter;
+    TokenKind kind = TokenKind::Identify;
+    bool valid = false;
+    size_t end = begin;
+    if(charClass(str[begin]) == CharClass::Digit) {
+      // 最長一致で受理できる位置まで数値リテラルを読む。
+      auto state = NumberState::Start;
+      size_t accept = begin;
+      bool isFloat = false;
+      for(size_t i = begin; i < len;) {
+        state = numberTransition[static_cast<size_t>(state)][static_cast<size_t>(numberInput(str[i++]))];
+        if(state == NumberState::Reject) break;
+        if(state == NumberState::Integer || state == NumberState::Fraction || state == NumberState::ExponentDigits) {
+          // 数字が続く間は同じ状態に留まるので、まとめて読み飛ばす。
+          i = scan.skipDigits(str.data(), i, len);
+          accept = i;
+          isFloat = state != NumberState::Integer;
+        }
+      }
+      end = accept;
+      while(end < len && charClass(str[end]) != CharClass::Space && charClass(str[end]) != CharClass::Punct) ++end;
+      const auto suffix = str.substr(accept, end - accept);
+      if(suffix.empty()) {
+        kind = isFloat ? TokenKind::Float : TokenKind::Integer;
+        valid = true;
+      }
+      else {
+        for(const auto& s : suffixes) {
+          if(s.suffix == suffix) {
+            kind = s.kind;
+            valid = !s.integerOnly || !isFloat;
+            break;
+          }
+        }
+      }
+    }
+    else {
+      valid = charClass(str[begin]) == CharClass::Ident;
+      while(true) {
+        end = scan.skipIdentifier(str.data(), end, len);
+        if(end >= len || charClass(str[end]) != CharClass::Other) break;
+        valid = false;
+        ++end;
+      }
+      if(valid) {
+        if(auto keyword = findKeyword(str.substr(begin, end - begin))) kind = keyword.get();
+      }
+    }
+    letter = end - 1;
+    if(!valid) {
+      pushError(std::string(str.substr(begin, end - begin)) + " は不正な文字です。", begin);
+      return;
+    }
+    pushToken(kind, begin, end - begin);
+  }
   Result<TokenSequence, std::vector<std::string>> Tokenizer::tokenize()
   {
     assert(!done);
-    stream.open(sequence.file);
-    if(!stream) {
-      return error(std::vector{"エラー: ファイル " + sequence.file + " が開けませんでした。"});
+    if(!sequence.source) {
+      auto source = SourceFile::open(sequence.file);
+      if(!source) {
+        return error(std::vector{ source.err() });
+      }
+      sequence.source = source.get();
     }
 
-    std::string str;
-    std::string buf;
-    size_t line, letter;
-    const auto clearBuf = [&]() {
-      if(buf.size() == 0) return;
-      TokenKind kind;
-      if (buf == "fn") kind = TokenKind::FnKeyword;
-      else if (buf == "def") kind = TokenKind::DefKeyword;
-      else if (buf == "mut") kind = TokenKind::MutKeyword;
-      else if (buf == "extern") kind = TokenKind::ExternKeyword;
-      else if (buf == "import") kind = TokenKind::ImportKeyword;
-      else if (buf == "return") kind = TokenKind::ReturnKeyword;
-      else if (buf == "if") kind = TokenKind::IfKeyword;
-      else if (buf == "else") kind = TokenKind::ElseKeyword;
-      else if (buf == "for") kind = TokenKind::ForKeyword;
-      else if (buf == "while") kind = TokenKind::WhileKeyword;
-      else if (buf == "loop") kind = TokenKind::LoopKeyword;
-      else if (buf == "pub") kind = TokenKind::PubKeyword;
-      else if (buf == "pri") kind = TokenKind::PriKeyword;
-      else if (buf == "class") kind = TokenKind::ClassKeyword;
-      else if (buf == "construct") kind = TokenKind::ConstructKeyword;
-      else if (buf == "destruct") kind = TokenKind::DestructKeyword;
-      else if (buf == "type") kind = TokenKind::TypeKeyword;
-      else if (buf == "i8") kind = TokenKind::I8Keyword;
-      else if (buf == "i16") kind = TokenKind::I16Keyword;
-      else if (buf == "i32") kind = TokenKind::I32Keyword;
-      else if (buf == "i64") kind = TokenKind::I64Keyword;
-      else if (buf == "u8") kind = TokenKind::U8Keyword;
-      else if (buf == "u16") kind = TokenKind::U16Keyword;
-      else if (buf == "u32") kind = TokenKind::U32Keyword;
-      else if (buf == "u64") kind = TokenKind::U64Keyword;
-      else if (buf == "f32") kind = TokenKind::F32Keyword;
-      else if (buf == "f64") kind = TokenKind::F64Keyword;
-      else if (buf == "void") kind = TokenKind::VoidKeyword;
-      else if (buf == "bool") kind = TokenKind::BoolKeyword;
-      else if (buf == "char") kind = TokenKind::CharKeyword;
-      else if (buf == "ptr") kind = TokenKind::PtrKeyword;
-      else if (buf == "true" || buf == "false") kind = TokenKind::Bool;
-      else if (buf == "null") kind = TokenKind::Null;
-      else if (buf == "this") kind = TokenKind::This;
-      else {
-        std::smatch match;
-        if (std::regex_match(buf, match, std::regex(R"(^\d+$)"))) kind = TokenKind::Integer;
-        else if (std::regex_match(buf, match, std::regex(R"(^\d+i8$)"))) kind = TokenKind::I8;
-        else if (std::regex_match(buf, match, std::regex(R"(^\d+i16$)"))) kind = TokenKind::I16;
-        else if (std::regex_match(buf, match, std::regex(R"(^\d+i32$)"))) kind = TokenKind::I32;
-        else if (std::regex_match(buf, match, std::regex(R"(^\d+i64$)"))) kind = TokenKind::I64;
-        else if (std::regex_match(buf, match, std::regex(R"(^\d+u8$)"))) kind = TokenKind::U8;
-        else if (std::regex_match(buf, match, std::regex(R"(^\d+u16$)"))) kind = TokenKind::U16;
-        else if (std::regex_match(buf, match, std::regex(R"(^\d+u32$)"))) kind = TokenKind::I32;
-        else if (std::regex_match(buf, match, std::regex(R"(^\d+u64$)"))) kind = TokenKind::U64;
-        else if (std::regex_match(buf, match, std::regex(R"(^\d+?\.?\d+(e[\-+]?\d+)?$)"))) kind = TokenKind::Float;
-        else if (std::regex_match(buf, match, std::regex(R"(^\d+?\.?\d+(e[\-+]?\d+)?f32$)"))) kind = TokenKind::F32;
-        else if (std::regex_match(buf, match, std::regex(R"(^\d+?\.?\d+(e[\-+]?\d+)?f64$)"))) kind = TokenKind::F64;
-        else if (std::regex_match(buf, match, std::regex(R"(^[^\s!-@\[-\^`\{-~][^\s!-/:-@\[-\^`\{-~]*$)"))) kind = TokenKind::Identify;
-        else {
-          errors.push_back("エラー: " + buf + " は不正な文字です。\n    at " + sequence.file + " " + std::to_string(line + 1) + "行目, " + std::to_string(letter - buf.size() + 1) + "文字目");
-          return;
-        }
-      }
-      sequence.tokens.push_back(Token(kind, buf, line + 1, letter - buf.size() + 1));
-      buf.clear();
+    const auto str = sequence.source->text();
+    const auto len = str.size();
+    size_t letter;
+    // 次の文字がcならtrue
+    const auto follows = [&](char c) {
+      return letter + 1 < len && str[letter + 1] == c;
     };
-    for(line = 0; std::getline(stream, str); ++line) {
-      sequence.rawFileData.push_back(str);
-      const auto len = str.size();
-      for(letter = 0; letter < len; ++letter) {
-        switch(str[letter]) {
-          // 空白文字はスキップ
-          case ' ':
-          case '\t':
-            clearBuf();
-            break;
-          case '(':
-            clearBuf();
-            sequence.tokens.push_back(Token(TokenKind::LParen, "(", line + 1, letter + 1));
-            break;
-          case ')':
-            clearBuf();
-            sequence.tokens.push_back(Token(TokenKind::RParen, ")", line + 1, letter + 1));
-            break;
-          case '{':
-            clearBuf();
-            sequence.tokens.push_back(Token(TokenKind::LBrace, "{", line + 1, letter + 1));
-            break;
-          case '}':
-            clearBuf();
-            sequence.tokens.push_back(Token(TokenKind::RBrase, "}", line + 1, letter + 1));
-            break;
-          case '[':
-            clearBuf();
-            sequence.tokens.push_back(Token(TokenKind::LBracket, "[", line + 1, letter + 1));
-            break;
-          case ']':
-            clearBuf();
-            sequence.tokens.push_back(Token(TokenKind::RBracket, "]", line + 1, letter + 1));
-            break;
-          case ';':
-            clearBuf();
-            sequence.tokens.push_back(Token(TokenKind::Semicolon, ";", line + 1, letter + 1));
-            break;
-          case ',':
-            clearBuf();
-            sequence.tokens.push_back(Token(TokenKind::Comma, ",", line + 1, letter + 1));
-            break;
-          case '@':
-            clearBuf();
-            sequence.tokens.push_back(Token(TokenKind::Copy, "@", line + 1, letter + 1));
-            break;
-          case '+':
-            clearBuf();
-            if(++letter >= len || (str[letter] != '+' && str[letter] != '=')) {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::Plus, "+", line + 1, letter + 1));
-            }
-            else if(str[letter] == '+') {
-              sequence.tokens.push_back(Token(TokenKind::Inc, "++", line + 1, letter));
-            }
-            else {
-              sequence.tokens.push_back(Token(TokenKind::AddAsign, "+=", line + 1, letter));
-            }
-            break;
-          case '-':
-            clearBuf();
-            if(++letter >= len || (str[letter] != '-' && str[letter] != '=')) {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::Minus, "-", line + 1, letter + 1));
-            }
-            else if(str[letter] == '-') {
-              sequence.tokens.push_back(Token(TokenKind::Dec, "--", line + 1, letter));
-            }
-            else {
-              sequence.tokens.push_back(Token(TokenKind::SubAsign, "-=", line + 1, letter));
-            }
-            break;
-          case '*':
-            clearBuf();
-            if(++letter >= len || str[letter] != '=') {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::Asterisk, "*", line + 1, letter + 1));
-            }
-            else {
-              sequence.tokens.push_back(Token(TokenKind::MulAsign, "*=", line + 1, letter));
-            }
-            break;
-          case '/':
-            clearBuf();
-            if(++letter >= len || (str[letter] != '=' && str[letter] != '/')) {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::Slash, "/", line + 1, letter + 1));
-            }
-            else if (str[letter] == '=') {
-              sequence.tokens.push_back(Token(TokenKind::DivAsign, "/=", line + 1, letter));
-            }
-            else {
-              sequence.tokens.push_back(Token(TokenKind::LineComment, str.substr(letter - 1), line + 1, letter));
-              letter = len;
-            }
-            break;
-          case '%':
-            clearBuf();
-            if(++letter >= len || str[letter] != '=') {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::Percent, "%", line + 1, letter + 1));
-            }
-            else {
-              sequence.tokens.push_back(Token(TokenKind::ModAsign, "%=", line + 1, letter));
-            }
-            break;
-          case '&':
-            clearBuf();
-            if(++letter >= len || (str[letter] != '&' && str[letter] != '=')) {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::BitAnd, "&", line + 1, letter + 1));
-            }
-            else if(str[letter] == '&') {
-              sequence.tokens.push_back(Token(TokenKind::LogicalAnd, "&&", line + 1, letter));
-            }
-            else {
-              sequence.tokens.push_back(Token(TokenKind::BitAndAsign, "&=", line + 1, letter));
-            }
-            break;
-          case '|':
-            clearBuf();
-            if(++letter >= len || (str[letter] != '|' && str[letter] != '=')) {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::BitOr, "|", line + 1, letter + 1));
-            }
-            else if(str[letter] == '|') {
-              sequence.tokens.push_back(Token(TokenKind::LogicalOr, "||", line + 1, letter));
-            }
-            else {
-              sequence.tokens.push_back(Token(TokenKind::BitOrAsign, "|=", line + 1, letter));
-            }
-            break;
-          case '^':
-            clearBuf();
-            if(++letter >= len || str[letter] != '=') {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::BitXor, "^", line + 1, letter + 1));
-            }
-            else {
-              sequence.tokens.push_back(Token(TokenKind::BitXorAsign, "^=", line + 1, letter));
-            }
-            break;
-          case '~':
-            clearBuf();
-            sequence.tokens.push_back(Token(TokenKind::BitNot, "~", line + 1, letter + 1));
-            break;
-          case '=':
-            clearBuf();
-            if(++letter >= len || str[letter] != '=') {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::Asign, "=", line + 1, letter + 1));
-            }
-            else {
-              sequence.tokens.push_back(Token(TokenKind::Equal, "==", line + 1, letter));
-            }
-            break;
-          case '<':
-            clearBuf();
-            if(++letter >= len || (str[letter] != '=' && str[letter] != '<')) {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::LessThan, "<", line + 1, letter + 1));
-            }
-            else if(str[letter] == '=') {
-              sequence.tokens.push_back(Token(TokenKind::LessEqual, "<=", line + 1, letter));
-            }
-            else if(++letter >= len || str[letter] != '=') {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::LShift, "<<", line + 1, letter));
-            }
-            else {
-              sequence.tokens.push_back(Token(TokenKind::LShiftAsign, "<<=", line + 1, letter - 1));
-            }
-            break;
-          case '>':
-            clearBuf();
-            if(++letter >= len || (str[letter] != '=' && str[letter] != '>')) {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::GreaterThan, ">", line + 1, letter + 1));
-            }
-            else if(str[letter] == '=') {
-              sequence.tokens.push_back(Token(TokenKind::GreaterEqual, ">=", line + 1, letter));
-            }
-            else if(++letter >= len || str[letter] != '=') {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::RShift, ">>", line + 1, letter));
-            }
-            else {
-              sequence.tokens.push_back(Token(TokenKind::RShiftAsign, ">>=", line + 1, letter - 1));
-            }
-            break;
-          case '!':
-            clearBuf();
-            if(++letter >= len || str[letter] != '=') {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::LogicalNot, "!", line + 1, letter + 1));
-            }
-            else {
-              sequence.tokens.push_back(Token(TokenKind::NotEqual, "!=", line + 1, letter));
-            }
-            break;
-          case '.':
-            clearBuf();
-            if(++letter >= len || str[letter] != '.') {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::Dot, ".", line + 1, letter + 1));
-            }
-            else {
-              sequence.tokens.push_back(Token(TokenKind::Range, "..", line + 1, letter));
-            }
+    // 行末または入力の終わりならtrue
+    const auto atLineEnd = [&]() {
+      return letter >= len || str[letter] == '\n';
+    };
+    for(letter = 0; letter < len; ++letter) {
+      switch(str[letter]) {
+        // 空白文字はスキップ
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+        case '\v':
+        case '\f':
+          // 単独の空白が大半なので、続くときだけカーネルで読み飛ばす。
+          if(letter + 1 < len && charClass(str[letter + 1]) == CharClass::Space) {
+            letter = scan.skipSpace(str.data(), letter + 2, len) - 1;
+          }
+          break;
+        case '(':
+          pushToken(TokenKind::LParen, letter, 1);
+          break;
+        case ')':
+          pushToken(TokenKind::RParen, letter, 1);
+          break;
+        case '{':
+          pushToken(TokenKind::LBrace, letter, 1);
+          break;
+        case '}':
+          pushToken(TokenKind::RBrase, letter, 1);
+          break;
+        case '[':
+          pushToken(TokenKind::LBracket, letter, 1);
+          break;
+        case ']':
+          pushToken(TokenKind::RBracket, letter, 1);
+          break;
+        case ';':
+          pushToken(TokenKind::Semicolon, letter, 1);
+          break;
+        case ',':
+          pushToken(TokenKind::Comma, letter, 1);
+          break;
+        case '@':
+          pushToken(TokenKind::Copy, letter, 1);
+          break;
+        case '~':
+          pushToken(TokenKind::BitNot, letter, 1);
+          break;
+        case '+':
+          if(follows('+')) pushToken(TokenKind::Inc, letter++, 2);
+          else if(follows('=')) pushToken(TokenKind::AddAsign, letter++, 2);
+          else pushToken(TokenKind::Plus, letter, 1);
+          break;
+        case '-':
+          if(follows('-')) pushToken(TokenKind::Dec, letter++, 2);
+          else if(follows('=')) pushToken(TokenKind::SubAsign, letter++, 2);
+          else pushToken(TokenKind::Minus, letter, 1);
+          break;
+        case '*':
+          if(follows('=')) pushToken(TokenKind::MulAsign, letter++, 2);
+          else pushToken(TokenKind::Asterisk, letter, 1);
+          break;
+        case '/':
+          if(follows('=')) pushToken(TokenKind::DivAsign, letter++, 2);
+          else if(follows('/')) {
+            // コメントは行末まで
+            const auto end = scan.findLineEnd(str.data(), letter + 2, len);
+            auto last = end;
+            if(last > letter && str[last - 1] == '\r') --last;
+            sequence.comments.push_back(Token{ TokenKind::LineComment, static_cast<uint32_t>(letter), static_cast<uint32_t>(last - letter) });
+            letter = end - 1;
+          }
+          else pushToken(TokenKind::Slash, letter, 1);
+          break;
+        case '%':
+          if(follows('=')) pushToken(TokenKind::ModAsign, letter++, 2);
+          else pushToken(TokenKind::Percent, letter, 1);
+          break;
+        case '&':
+          if(follows('&')) pushToken(TokenKind::LogicalAnd, letter++, 2);
+          else if(follows('=')) pushToken(TokenKind::BitAndAsign, letter++, 2);
+          else pushToken(TokenKind::BitAnd, letter, 1);
+          break;
+        case '|':
+          if(follows('|')) pushToken(TokenKind::LogicalOr, letter++, 2);
+          else if(follows('=')) pushToken(TokenKind::BitOrAsign, letter++, 2);
+          else pushToken(TokenKind::BitOr, letter, 1);
+          break;
+        case '^':
+          if(follows('=')) pushToken(TokenKind::BitXorAsign, letter++, 2);
+          else pushToken(TokenKind::BitXor, letter, 1);
+          break;
+        case '=':
+          if(follows('=')) pushToken(TokenKind::Equal, letter++, 2);
+          else pushToken(TokenKind::Asign, letter, 1);
+          break;
+        case '<':
+          if(follows('=')) pushToken(TokenKind::LessEqual, letter++, 2);
+          else if(follows('<')) {
+            if(letter + 2 < len && str[letter + 2] == '=') {
+              pushToken(TokenKind::LShiftAsign, letter, 3);
+              letter += 2;
+            }
+            else pushToken(TokenKind::LShift, letter++, 2);
+          }
+          else pushToken(TokenKind::LessThan, letter, 1);
+          break;
+        case '>':
+          if(follows('=')) pushToken(TokenKind::GreaterEqual, letter++, 2);
+          else if(follows('>')) {
+            if(letter + 2 < len && str[letter + 2] == '=') {
+              pushToken(TokenKind::RShiftAsign, letter, 3);
+              letter += 2;
+            }
+            else pushToken(TokenKind::RShift, letter++, 2);
+          }
+          else pushToken(TokenKind::GreaterThan, letter, 1);
+          break;
+        case '!':
+          if(follows('=')) pushToken(TokenKind::NotEqual, letter++, 2);
+          else pushToken(TokenKind::LogicalNot, letter, 1);
+          break;
+        case '.':
+          if(follows('.')) pushToken(TokenKind::Range, letter++, 2);
+          else pushToken(TokenKind::Dot, letter, 1);
+          break;
+        case ':':
+          if(follows(':')) pushToken(TokenKind::Scope, letter++, 2);
+          else pushToken(TokenKind::Colon, letter, 1);
+          break;
+        case '\'': {
+          // TODO: マルチバイト文字の対応
+          const auto begin = letter;
+          ++letter;
+          if(atLineEnd()) {
+            pushError("'が必要です。", begin);
             break;
-          case ':':
-            clearBuf();
-            if(++letter >= len || str[letter] != ':') {
-              --letter;
-              sequence.tokens.push_back(Token(TokenKind::Colon, ":", line + 1, letter + 1));
-            }
-            else {
-              sequence.tokens.push_back(Token(TokenKind::Scope, "::", line + 1, letter));
-            }
+          }
+          if(str[letter] == '\'') {
+            pushError("文字が必要です。", begin);
             break;
-          case '\'': {
-            // TODO: マルチバイト文字の対応
-            clearBuf();
-            auto let = letter;
-            if(++letter >= len) {
-              errors.push_back("エラー: 'が必要です。\n    at " + sequence.file + " " + std::to_string(line + 1) + "行目, " + std::to_string(let + 1) + "文字目");
-              break;
-            }
-            char c = str[letter];
-            if(c == '\'') {
-              errors.push_back("エラー: 文字が必要です。\n    at " + sequence.file + " " + std::to_string(line + 1) + "行目, " + std::to_string(let + 1) + "文字目");
-              break;
-            }
-            if(c == '\\') {
-              if(++letter >= len) {
-                errors.push_back("エラー: 文字が必要です。\n    at " + sequence.file + " " + std::to_string(line + 1) + "行目, " + std::to_string(let + 1) + "文字目");
-                break;
-              }
-              switch(str[letter]) {
-                case 'a': c = '\a'; break;
-                case 'b': c = '\b'; break;
-                case 'n': c = '\n'; break;
-                case 'r': c = '\r'; break;
-                case 'f': c = '\f'; break;
-                case 't': c = '\t'; break;
-                case 'v': c = '\v'; break;
-                case '\\': c = '\\'; break;
-                case '0': c = '\0'; break;
-                case '"': c = '"'; break;
-                case '\'': c = '\''; break;
-                default: errors.push_back(std::string("エラー: ") + str[letter] + " は不正なエスケープです。\n    at " + sequence.file + " " + std::to_string(line + 1) + "行目, " + std::to_string(let + 1) + "文字目");
-              }
-            }
-            if(++letter >= len) {
-              errors.push_back("エラー: 'が必要です。\n    at " + sequence.file + " " + std::to_string(line + 1) + "行目, " + std::to_string(let + 1) + "文字目");
+          }
+          if(str[letter] == '\\') {
+            ++letter;
+            if(atLineEnd()) {
+              pushError("文字が必要です。", begin);
               break;
             }
-            sequence.tokens.push_back(Token(TokenKind::Char, std::string() + c, line + 1, let + 1));
+            if(!unescape(str[letter])) pushError(std::string(1, str[letter]) + " は不正なエスケープです。", begin);
+          }
+          ++letter;
+          if(atLineEnd() || str[letter] != '\'') {
+            pushError("'が必要です。", begin);
+            --letter;
             break;
           }
-          case '"': {
-            // TODO: マルチバイト文字の対応
-            clearBuf();
-            std::string string;
-            bool correct = false;
-            bool esc = false;
-            auto let = letter;
-            for(++letter; letter < len; ++letter) {
-              if(str[letter] == '\\') {
-                esc = true;
-              }
-              else if(esc) {
-                esc = false;
-                switch(str[letter]) {
-                  case 'a': string += '\a'; break;
-                  case 'b': string += '\b'; break;
-                  case 'n': string += '\n'; break;
-                  case 'r': string += '\r'; break;
-                  case 'f': string += '\f'; break;
-                  case 't': string += '\t'; break;
-                  case 'v': string += '\v'; break;
-                  case '\\': string += '\\'; break;
-                  case '0': string += '\0'; break;
-                  case '"': string += '"'; break;
-                  case '\'': string += '\''; break;
-                  default: errors.push_back(std::string("エラー: ") + str[letter] + " は不正なエスケープです。\n    at " + sequence.file + " " + std::to_string(line + 1) + "行目, " + std::to_string(let + 1) + "文字目");
-                }
-              }
-              else if(str[letter] == '"') {
-                sequence.tokens.push_back(Token(TokenKind::String, string, line + 1, let + 1));
-                correct = true;
-                break;
-              }
-              else {
-                string += str[letter];
-              }
-            }
-            if(esc || !correct) {
-              errors.push_back("エラー: \"が必要です。\n    at " + sequence.file + " " + std::to_string(line + 1) + "行目, " + std::to_string(let + 1) + "文字目");
+          pushToken(TokenKind::Char, begin, letter - begin + 1);
+          break;
+        }
+        case '"': {
+          // TODO: マルチバイト文字の対応
+          const auto begin = letter;
+          bool correct = false;
+          for(++letter; !atLineEnd(); ++letter) {
+            letter = scan.findStringEnd(str.data(), letter, len);
+            if(atLineEnd()) break;
+            if(str[letter] == '\\') {
+              ++letter;
+              if(atLineEnd()) break;
+              if(!unescape(str[letter])) pushError(std::string(1, str[letter]) + " は不正なエスケープです。", begin);
+            }
+            else if(str[letter] == '"') {
+              pushToken(TokenKind::String, begin, letter - begin + 1);
+              correct = true;
+              break;
             }
-            break;
           }
-          default:
-            buf += str[letter];
+          if(!correct) {
+            pushError("\"が必要です。", begin);
+          }
+          break;
         }
+        default:
+          lexWord(str, letter);
       }
-      clearBuf();
     }
 
     done = true;
     if(errors.empty()) return ok(std::move(sequence));
-    return error(errors);
+    return error(std::move(errors));
   }
 }
\ No newline at end of file
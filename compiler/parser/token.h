@@ -3,14 +3,18 @@
 
 #include <vector>
 #include <string>
-#include <fstream>
+#include <string_view>
+#include <memory>
+#include <cstdint>
 
 #include "utils/result.h"
 #include "utils/option.h"
+#include "source.h"
+#include "scan.h"
 
 namespace pickc::parser
 {
-  enum struct TokenKind
+  enum struct TokenKind : uint8_t
   {
     DefKeyword,       // def
     MutKeyword,       // mut
@@ -91,7 +95,7 @@ namespace pickc::parser
     Scope,            // ::
     Comma,            // ,
     Copy,             // @
-    LineComment,      // //
+    LineComment,      // // (TokenSequence::commentsにのみ入る)
     Integer,          // [0-9]+
     I8,               // [0-9]+i8
     I16,              // [0-9]+i16
@@ -111,34 +115,56 @@ namespace pickc::parser
     This,             // this
     Identify,         // xxx
   };
+  // ソース上の範囲として表したトークン
+  // 文字列はTokenSequence::textまたはTokenSequence::valueで取り出す。
   struct Token
   {
     TokenKind kind;
-    std::string value;
-    size_t line;
-    size_t letter;
-    Token(TokenKind kind, const std::string& value, size_t line, size_t letter);
-    Token(const Token& token);
-    Token(Token&& token);
-    Token& operator=(const Token& token);
-    Token& operator=(Token&& token);
+    // ソースファイル先頭からのバイトオフセット
+    uint32_t offset;
+    // トークンのバイト数
+    uint32_t length;
   };
+  // トークン列
+  // 構文解析は種類だけを見て進むことが多いので、種類、オフセット、長さを別々の配列に詰めて持つ。
+  // コメントは構文解析の対象にならないので、commentsに分けて持つ。
   struct TokenSequence
   {
     std::string file;
-    std::vector<std::string> rawFileData;
-    std::vector<Token> tokens;
+    std::shared_ptr<const SourceFile> source;
+    std::vector<TokenKind> kinds;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> lengths;
+    std::vector<Token> comments;
+    size_t size() const;
+    Token operator[](size_t index) const;
+    void push(TokenKind kind, uint32_t offset, uint32_t length);
+    // 1トークンあたりのメモリ使用量。コメントは含まない。
+    static constexpr size_t bytesPerToken = sizeof(TokenKind) + sizeof(uint32_t) * 2;
+    // トークンのソース上の文字列
+    std::string_view text(const Token& token) const;
+    // トークンの値。文字と文字列のリテラルは引用符を外し、エスケープを展開する。
+    std::string value(const Token& token) const;
+    // トークンの行番号と行内の位置。1から数える。
+    size_t line(const Token& token) const;
+    size_t letter(const Token& token) const;
+    size_t numLines() const;
     std::string toOutputString(size_t line) const;
   };
   class Tokenizer
   {
     TokenSequence sequence;
     std::vector<std::string> errors;
-    std::ifstream stream;
+    const ScanFunctions& scan;
     bool done;
-    Result<Option<Token>, std::string> findToken(std::string& str, size_t& line, size_t& letter);
+    void pushToken(TokenKind kind, size_t offset, size_t length);
+    void pushError(const std::string& message, size_t offset);
+    // 識別子、予約語、数値リテラルを1つ読み取る。letterは読み取った最後の文字を指す。
+    void lexWord(std::string_view str, size_t& letter);
   public:
     Tokenizer(const std::string& path);
+    // 開いてあるソースファイルをそのまま字句解析する。
+    Tokenizer(std::shared_ptr<const SourceFile> source);
     Result<TokenSequence, std::vector<std::string>> tokenize();
   };
 }
@@ -6,34 +6,49 @@
 #include "utils/instanceof.h"
 #include "utils/dyn_cast.h"
 
+#include "parser/ast.h"
 #include "semantic_analyzer.h"
 
 namespace pickc::pcir
 {
-  ModuleAnalyzer::ModuleAnalyzer(SemanticAnalyzer* sa, ModuleTree* tree, const std::unordered_set<ModuleTree*>& trees) : sa(sa), tree(tree), trees(trees) {}
+  namespace
+  {
+    // a::b::cのような名前を完全修飾名にする。nodeは最後の要素で、childを辿ると1つ前の要素になる。
+    Atom qualifiedName(const parser::VariableNode* node)
+    {
+      if(!instanceof<parser::ScopedVariableNode>(node)) return node->atom;
+      return Atom::join(qualifiedName(dynCast<parser::ScopedVariableNode>(node)->child), node->atom);
+    }
+  }
+  ModuleAnalyzer::ModuleAnalyzer(SemanticAnalyzer* sa, ModuleTree* tree, const std::unordered_map<Atom, ModuleTree*>& trees) : sa(sa), tree(tree), trees(trees) {}
   std::string ModuleAnalyzer::createSemanticError(const parser::Node* node, const std::string& message)
   {
     // assert(false);
+    const auto& sequence = tree->sequence;
+    const auto first = sequence[node->span.first];
+    const auto last = sequence[node->span.last];
     std::string res;
     res += "エラー: ";
     res += message;
     res += "\nat ";
-    res += tree->sequence.file;
+    res += sequence.file;
     res += ' ';
-    res += std::to_string(node->tokens[0].line);
+    res += std::to_string(sequence.line(first));
     res += "行目 ";
-    res += std::to_string(node->tokens[0].letter);
+    res += std::to_string(sequence.letter(first));
     res += "文字目\n";
-    if(node->tokens[0].line > 1) res += tree->sequence.toOutputString(node->tokens[0].line - 2);
-    auto curLine = node->tokens[0].line;
-    auto beginLetter = node->tokens[0].letter - 1;
-    auto endLetter = beginLetter + node->tokens[0].value.size();
-    for(auto& token : node->tokens) {
-      if(token.line == curLine) {
-        endLetter = token.letter - 1 + token.value.size();
+    if(sequence.line(first) > 1) res += sequence.toOutputString(sequence.line(first) - 2);
+    auto curLine = sequence.line(first);
+    auto beginLetter = sequence.letter(first) - 1;
+    auto endLetter = beginLetter + first.length;
+    for(auto i = node->span.first; i <= node->span.last; ++i) {
+      const auto token = sequence[i];
+      const auto line = sequence.line(token);
+      if(line == curLine) {
+        endLetter = sequence.letter(token) - 1 + token.length;
       }
       else {
-        res += tree->sequence.toOutputString(curLine - 1);
+        res += sequence.toOutputString(curLine - 1);
         auto digit = 3 + beginLetter;
         {
           auto n = curLine - 1;
@@ -46,12 +61,12 @@ namespace pickc::pcir
         res.append(digit, ' ');
         res.append(endLetter - beginLetter, '^');
         res += '\n';
-        curLine = token.line;
-        beginLetter = token.letter - 1;
-        endLetter = beginLetter + token.value.size();
+        curLine = line;
+        beginLetter = sequence.letter(token) - 1;
+        endLetter = beginLetter + token.length;
       }
     }
-    res += tree->sequence.toOutputString(curLine - 1);
+    res += sequence.toOutputString(curLine - 1);
     auto digit = 3 + beginLetter;
     {
       auto n = curLine - 1;
@@ -64,7 +79,7 @@ namespace pickc::pcir
     res.append(digit, ' ');
     res.append(endLetter - beginLetter, '^');
     res += '\n';
-    if(node->tokens.back().line < tree->sequence.rawFileData.size()) res += tree->sequence.toOutputString(node->tokens.back().line);
+    if(sequence.line(last) < sequence.numLines()) res += sequence.toOutputString(sequence.line(last));
     return res;
   }
   Option<std::vector<std::string>> ModuleAnalyzer::declare()
@@ -72,162 +87,138 @@ namespace pickc::pcir
     using namespace parser;
     std::vector<std::string> errors;
     for(const auto& node : tree->ast.nodes) {
-      if(instanceof<FunctionDefineNode>(node)) {
-        auto fn = dynCast<FunctionDefineNode>(node);
-        if(fn->name == nullptr) continue;
-        if(tree->module.symbols.find(fn->name->name) == tree->module.symbols.end()) {
-          auto symbol = new Symbol();
-          symbol->name = fn->name->name;
-          symbol->fullyQualifiedName = tree->name + "::" + symbol->name;
-          TypeFunction tf{};
-          tf.retType = new Type(fn->retType);
-          for(const auto& arg : fn->args) tf.args.push_back(new Type(arg->type));
-          symbol->type = tf;
-          symbol->scope = fn->isPub ? Scope::Public : Scope::Private;
-          symbol->mut = Mutability::Immutable;
-          symbol->expr = fn;
-          tree->module.symbols[fn->name->name] = symbol;
-          sa->texts.insert(symbol->fullyQualifiedName);
-        }
-        else errors.push_back(createSemanticError(fn->name, "既にシンボル " + fn->name->name + " は存在します。"));
-      }
-      else if(instanceof<VariableDefineNode>(node)) {
-        auto var = dynCast<VariableDefineNode>(node);
-        if(tree->module.symbols.find(var->name->name) == tree->module.symbols.end()) {
-          auto symbol = new Symbol();
-          symbol->name = var->name->name;
-          symbol->fullyQualifiedName = tree->name + "::" + symbol->name;
-          symbol->type = var->type;
-          symbol->scope = var->isPub ? Scope::Public : Scope::Private;
-          symbol->mut = var->isMut ? Mutability::Mutable : Mutability::Immutable;
-          symbol->expr = var->init;
-          tree->module.symbols[var->name->name] = symbol;
-          sa->texts.insert(symbol->fullyQualifiedName);
-        }
-        else errors.push_back(createSemanticError(var->name, "既にシンボル " + var->name->name + " は存在します。"));
-      }
-      else if(instanceof<ClassDefineNode>(node)) {
-        // TODO
-        assert(false);
-      }
-      else if(instanceof<AliasDefineNode>(node)) {
-        // TODO
-        assert(false);
-      }
-      else if(instanceof<ImportNode>(node)) {
-        auto imp = dynCast<ImportNode>(node);
-        std::vector<std::string> module;
-        auto curMod = imp->name;
-        module.insert(module.begin(), curMod->name);
-        while(instanceof<ScopedVariableNode>(curMod)) {
-          curMod = dynCast<ScopedVariableNode>(curMod)->child;
-          module.insert(module.begin(), curMod->name);
+      switch(node->kind) {
+        case NodeKind::FunctionDefine: {
+          auto fn = dynCast<FunctionDefineNode>(node);
+          if(fn->name == nullptr) continue;
+          if(tree->module.symbols.find(fn->name->name) == tree->module.symbols.end()) {
+            auto symbol = tree->irArena.make<Symbol>();
+            symbol->name = fn->name->atom;
+            symbol->fullyQualifiedName = Atom::join(tree->name, symbol->name);
+            std::vector<Type> args;
+            for(const auto& arg : fn->args) args.push_back(Type(arg->type));
+            symbol->type = Type::fn(Type(fn->retType), std::move(args));
+            symbol->scope = fn->isPub ? Scope::Public : Scope::Private;
+            symbol->mut = Mutability::Immutable;
+            symbol->expr = fn;
+            tree->module.symbols[fn->name->name] = symbol;
+          }
+          else errors.push_back(createSemanticError(fn->name, "既にシンボル " + fn->name->name + " は存在します。"));
+          break;
         }
-        bool found = false;
-        for(const auto& t : trees) {
-          if(t->name == module[0]) {
-            auto curTree = t;
-            for(size_t i = 1, l = module.size(); i < l; ++i) {
-              if(keyExists(curTree->submodules, module[i])) {
-                curTree = curTree->submodules[module[i]];
-              }
-              else {
-                curTree = nullptr;
-                break;
-              }
-            }
-            if(curTree != nullptr) {
-              tree->module.importModules.insert(curTree);
-              found = true;
-            }
+        case NodeKind::VariableDefine: {
+          auto var = dynCast<VariableDefineNode>(node);
+          if(tree->module.symbols.find(var->name->name) == tree->module.symbols.end()) {
+            auto symbol = tree->irArena.make<Symbol>();
+            symbol->name = var->name->atom;
+            symbol->fullyQualifiedName = Atom::join(tree->name, symbol->name);
+            symbol->type = var->type;
+            symbol->scope = var->isPub ? Scope::Public : Scope::Private;
+            symbol->mut = var->isMut ? Mutability::Mutable : Mutability::Immutable;
+            symbol->expr = var->init;
+            tree->module.symbols[var->name->name] = symbol;
           }
-          if(found) break;
+          else errors.push_back(createSemanticError(var->name, "既にシンボル " + var->name->name + " は存在します。"));
+          break;
         }
-        if(!found) {
-          std::string moduleName = module[0];
-          for(size_t i = 1, l = module.size(); i < l; ++i) moduleName += "::" + module[i];
-          errors.push_back(createSemanticError(imp, "モジュール " + moduleName + " が見つかりません。"));
+        case NodeKind::ClassDefine:
+          // TODO
+          assert(false);
+          break;
+        case NodeKind::AliasDefine:
+          // TODO
+          assert(false);
+          break;
+        case NodeKind::Import: {
+          auto imp = dynCast<ImportNode>(node);
+          const auto moduleName = qualifiedName(imp->name);
+          if(auto found = trees.find(moduleName); found != trees.end()) tree->module.importModules.insert(found->second);
+          else errors.push_back(createSemanticError(imp, "モジュール " + moduleName.str() + " が見つかりません。"));
+          break;
         }
-      }
-      else if(instanceof<ExternNode>(node)) {
-        auto ext = dynCast<ExternNode>(node);
-        if(tree->module.symbols.find(ext->name->name) == tree->module.symbols.end()) {
-          auto symbol = new Symbol();
-          symbol->name = ext->name->name;
-          symbol->fullyQualifiedName = tree->name + "::" + symbol->name;
-          TypeFunction tf{};
-          tf.retType = new Type(ext->retType);
-          for(const auto& arg : ext->args) tf.args.push_back(new Type(arg->type));
-          symbol->type = tf;
-          symbol->scope = ext->isPub ? Scope::Public : Scope::Private;
-          symbol->mut = Mutability::Immutable;
-          symbol->expr = ext;
-          tree->module.symbols[ext->name->name] = symbol;
-          sa->texts.insert(symbol->fullyQualifiedName);
+        case NodeKind::Extern: {
+          auto ext = dynCast<ExternNode>(node);
+          if(tree->module.symbols.find(ext->name->name) == tree->module.symbols.end()) {
+            auto symbol = tree->irArena.make<Symbol>();
+            symbol->name = ext->name->atom;
+            symbol->fullyQualifiedName = Atom::join(tree->name, symbol->name);
+            std::vector<Type> args;
+            for(const auto& arg : ext->args) args.push_back(Type(arg->type));
+            symbol->type = Type::fn(Type(ext->retType), std::move(args));
+            symbol->scope = ext->isPub ? Scope::Public : Scope::Private;
+            symbol->mut = Mutability::Immutable;
+            symbol->expr = ext;
+            tree->module.symbols[ext->name->name] = symbol;
+          }
+          else errors.push_back(createSemanticError(ext->name, "既にシンボル " + ext->name->name + " は存在します。"));
+          break;
         }
-        else errors.push_back(createSemanticError(ext->name, "既にシンボル " + ext->name->name + " は存在します。"));
-      }
-      else {
-        assert(false);
+        default:
+          assert(false);
       }
     }
     if(errors.empty()) return none;
-    return some(errors);
+    return some(std::move(errors));
   }
   Option<std::vector<std::string>> ModuleAnalyzer::analyze()
   {
     std::vector<std::string> errors;
     for(auto& symbol : tree->module.symbols) {
-      if(!symbol.second->init) {
-        symbol.second->init = new Function();
-        auto curFlow = symbol.second->init->entryFlow;
-        if(auto init = exprAnalyze(symbol.second->expr, &curFlow)) {
-          assert(symbol.second->init->flows.size() == 1);
-          if(init.get()) {
-            symbol.second->init->result = init.get();
-            if(!Type::castable(symbol.second->type, init.get()->type)) {
-              errors.push_back(createSemanticError(symbol.second->expr, "変数の型は " + symbol.second->type.toString() + " ですが、" + init.get()->type.toString() + "が代入されました。"));
-            }
-            else {
-              symbol.second->type = Type::merge(Mov, symbol.second->type, init.get()->type);
-              TypeFunction tf{};
-              tf.retType = new Type(init.get()->type);
-              symbol.second->init->type = tf;
-              curFlow->type = FlowType::EndPoint;
-              curFlow->retReg = init.get();
-            }
-            tree->module.functions.push_back(symbol.second->init);
-          }
-          else {
-            errors.push_back(createSemanticError(symbol.second->expr, "シンボル " + symbol.second->name + " は正しく初期化されません。"));
-          }
+      if(auto errs = symbolAnalyze(symbol.second)) errors += errs.get();
+    }
+    if(errors.empty()) return none;
+    return some(std::move(errors));
+  }
+  Option<std::vector<std::string>> ModuleAnalyzer::symbolAnalyze(Symbol* symbol)
+  {
+    using namespace parser;
+    if(symbol->init) return none;
+    if(instanceof<FunctionDefineNode>(symbol->expr)) {
+      auto fnDef = dynCast<FunctionDefineNode>(symbol->expr);
+      if(fnDef->isBodyDeferred) {
+        if(auto errs = ASTGenerator(tree->sequence, tree->astArena).deferredBodyGenerate(fnDef)) return errs;
+      }
+    }
+    std::vector<std::string> errors;
+    symbol->init = tree->irArena.make<Function>(tree->irArena);
+    auto curFlow = symbol->init->entryFlow;
+    if(auto init = exprAnalyze(symbol->expr, &curFlow)) {
+      assert(symbol->init->flows.size() == 1);
+      if(init.get()) {
+        symbol->init->result = init.get();
+        if(!Type::castable(symbol->type, init.get()->type)) {
+          errors.push_back(createSemanticError(symbol->expr, "変数の型は " + symbol->type.toString() + " ですが、" + init.get()->type.toString() + "が代入されました。"));
         }
-        else errors += init.err();
+        else {
+          symbol->type = Type::merge(Mov, symbol->type, init.get()->type);
+          symbol->init->type = Type::fn(init.get()->type, {});
+          curFlow->type = FlowType::EndPoint;
+          curFlow->retReg = init.get();
+        }
+        tree->module.functions.push_back(symbol->init);
+      }
+      else {
+        errors.push_back(createSemanticError(symbol->expr, "シンボル " + symbol->name.str() + " は正しく初期化されません。"));
       }
     }
+    else errors += init.err();
     if(errors.empty()) return none;
-    return some(errors);
+    return some(std::move(errors));
   }
   Result<Symbol*, std::vector<std::string>> ModuleAnalyzer::findGlobalVar(const parser::VariableNode* var)
   {
     using namespace parser;
     if(instanceof<ScopedVariableNode>(var)) {
-      std::vector<std::string> module;
-      auto cur = var;
-      while(instanceof<ScopedVariableNode>(cur)) {
-        cur = dynCast<ScopedVariableNode>(cur)->child;
-        module.insert(module.begin(), cur->name);
-      }
-      std::string name = module[0];
-      for(size_t i = 1, l = module.size(); i < l; ++i) name += "::" + module[i];
+      const auto name = qualifiedName(dynCast<ScopedVariableNode>(var)->child);
       for(const auto& mod : tree->module.importModules) {
         if(mod->name == name) {
           if(keyExists(mod->module.symbols, var->name)) {
             if(mod->module.symbols[var->name]->scope == Scope::Public) {
+              sa->require(mod, mod->module.symbols[var->name]);
               return ok(mod->module.symbols[var->name]);
             }
             else {
-              return error(std::vector{ createSemanticError(var, "変数 " + name + "::" + var->name + " にアクセスできません。変数はプライベートです。") });
+              return error(std::vector{ createSemanticError(var, "変数 " + name.str() + "::" + var->name + " にアクセスできません。変数はプライベートです。") });
             }
           }
         }
@@ -235,6 +226,7 @@ namespace pickc::pcir
     }
     else {
       if(keyExists(tree->module.symbols, var->name)) {
+        sa->require(tree, tree->module.symbols[var->name]);
         return ok(tree->module.symbols[var->name]);
       }
     }
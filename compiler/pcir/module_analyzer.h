@@ -1,7 +1,7 @@
 #ifndef PICKC_PCIR_MODULE_ANALYZER_H_
 #define PICKC_PCIR_MODULE_ANALYZER_H_
 
-#include <unordered_set>
+#include <unordered_map>
 
 #include "pickc/module_tree.h"
 #include "utils/option.h"
@@ -13,7 +13,8 @@ namespace pickc::pcir
   {
     SemanticAnalyzer* sa;
     ModuleTree* tree;
-    std::unordered_set<ModuleTree*> trees;
+    // 完全修飾名からモジュールの木を引く表
+    const std::unordered_map<Atom, ModuleTree*>& trees;
     std::string createSemanticError(const parser::Node* node, const std::string& message);
     // void型を返す時はnullptrを返す。
     Result<Register*, std::vector<std::string>> exprAnalyze(const parser::ExpressionNode* expr, FlowNode** flow);
@@ -29,9 +30,11 @@ namespace pickc::pcir
     Result<Symbol*, std::vector<std::string>> findGlobalVar(const parser::VariableNode* var);
     Result<Register*, std::vector<std::string>> whileAnalyze(const parser::WhileNode* whileNode, FlowNode** flow);
   public:
-    ModuleAnalyzer(SemanticAnalyzer* sa, ModuleTree* tree, const std::unordered_set<ModuleTree*>& trees);
+    ModuleAnalyzer(SemanticAnalyzer* sa, ModuleTree* tree, const std::unordered_map<Atom, ModuleTree*>& trees);
     Option<std::vector<std::string>> declare();
     Option<std::vector<std::string>> analyze();
+    // 解析済みなら何もしない。本文の構文解析を後回しにした関数はここで構文解析する。
+    Option<std::vector<std::string>> symbolAnalyze(Symbol* symbol);
   };
 }
 
@@ -37,10 +37,10 @@ namespace pickc::pcir
           }
         }
 
-        reg = new Register();
+        reg = tree->irArena.make<Register>();
         reg->type = Type::merge(code, left.get()->type, right.get()->type);
         (*flow)->addReg(reg);
-        auto inst = new BinaryInstruction();
+        auto inst = tree->irArena.make<BinaryInstruction>();
         inst->dist = reg;
         inst->left = left.get();
         inst->right = right.get();
@@ -60,7 +60,7 @@ namespace pickc::pcir
         errors.push_back(createSemanticError(binary, "右辺値に値は代入できません。"));
       }
       else if(left.get()->curVar != nullptr && left.get()->curVar->mut == Mutability::Immutable) {
-        errors.push_back(createSemanticError(binary, "変数 " + left.get()->curVar->name + " はイミュータブルです。"));
+        errors.push_back(createSemanticError(binary, "変数 " + left.get()->curVar->name.str() + " はイミュータブルです。"));
       }
       else if(left.get()->curVar != nullptr && left.get()->curVar->status == VariableStatus::Uninited) {
         errors.push_back(createSemanticError(binary->left, "初期化されていない変数です。"));
@@ -78,9 +78,9 @@ namespace pickc::pcir
       }
 
       if(errors.empty()) {
-        reg = new Register();
+        reg = tree->irArena.make<Register>();
         reg->type = Type::merge(code, left.get()->type, right.get()->type);
-        auto inst = new BinaryInstruction();
+        auto inst = tree->irArena.make<BinaryInstruction>();
         inst->dist = reg;
         inst->left = left.get();
         inst->right = right.get();
@@ -92,106 +92,123 @@ namespace pickc::pcir
           left.get()->curVar->reg = reg;
         }
         else {
-          auto inst = new AllocInstruction();
+          auto inst = tree->irArena.make<AllocInstruction>();
           inst->dist = left.get();
           inst->src = right.get();
           (*flow)->insts.push_back(inst);
         }
       }
     };
-    if(instanceof<MulNode>(binary)) {
-      binaryInst(Mul, BinaryInstructions::Mul);
-    }
-    else if(instanceof<DivNode>(binary)) {
-      binaryInst(Div, BinaryInstructions::Div);
-    }
-    else if(instanceof<ModNode>(binary)) {
-      binaryInst(Mod, BinaryInstructions::Mod);
-    }
-    else if(instanceof<AddNode>(binary)) {
-      binaryInst(Add, BinaryInstructions::Add);
-    }
-    else if(instanceof<SubNode>(binary)) {
-      binaryInst(Sub, BinaryInstructions::Sub);
-    }
-    else if(instanceof<EqualNode>(binary)) {
-      binaryInst(EQ, BinaryInstructions::EQ);
-    }
-    else if(instanceof<NotEqualNode>(binary)) {
-      binaryInst(NEQ, BinaryInstructions::NEQ);
-    }
-    else if(instanceof<GreaterThanNode>(binary)) {
-      binaryInst(GT, BinaryInstructions::GT);
-    }
-    else if(instanceof<GreaterEqualNode>(binary)) {
-      binaryInst(GE, BinaryInstructions::GE);
-    }
-    else if(instanceof<LessThanNode>(binary)) {
-      binaryInst(LT, BinaryInstructions::LT);
-    }
-    else if(instanceof<LessEqualNode>(binary)) {
-      binaryInst(LE, BinaryInstructions::LE);
-    }
-    else if(instanceof<AddAsignNode>(binary)) {
-      asignInst(Add, BinaryInstructions::Add);
-    }
-    else if(instanceof<SubAsignNode>(binary)) {
-      asignInst(Sub, BinaryInstructions::Sub);
-    }
-    else if(instanceof<MulAsignNode>(binary)) {
-      asignInst(Mul, BinaryInstructions::Mul);
-    }
-    else if(instanceof<DivAsignNode>(binary)) {
-      asignInst(Div, BinaryInstructions::Div);
-    }
-    else if(instanceof<ModAsignNode>(binary)) {
-      asignInst(Mod, BinaryInstructions::Mod);
-    }
-    else if(instanceof<AsignNode>(binary)) {
-      auto asign = dynCast<AsignNode>(binary);
-      auto left = exprAnalyze(asign->left, flow);
-      auto right = exprAnalyze(asign->right, flow);
-      if(!left) errors += left.err();
-      else if(!right) errors += right.err();
-      else if(!Type::castable(left.get()->type, right.get()->type)) {
-        errors.push_back(createSemanticError(binary, "型 " + left.get()->type.toString() + " に型 " + right.get()->type.toString() + " は代入できません。"));
-      }
-      else if(left.get()->curVar == nullptr && left.get()->vType == ValueType::RValue) {
-        errors.push_back(createSemanticError(asign, "右辺値に値は代入できません。"));
-      }
-      else if(left.get()->curVar != nullptr && left.get()->curVar->mut == Mutability::Immutable) {
-        errors.push_back(createSemanticError(asign, "変数 " + left.get()->curVar->name + " はイミュータブルです。"));
-      }
-      else if(right.get()->curVar != nullptr) {
-        if(right.get()->curVar->status == VariableStatus::Uninited) {
-          errors.push_back(createSemanticError(asign->right, "初期化されていない変数です。"));
+    switch(binary->kind) {
+      case NodeKind::Mul:
+        binaryInst(Mul, BinaryInstructions::Mul);
+        break;
+      case NodeKind::Div:
+        binaryInst(Div, BinaryInstructions::Div);
+        break;
+      case NodeKind::Mod:
+        binaryInst(Mod, BinaryInstructions::Mod);
+        break;
+      case NodeKind::Add:
+        binaryInst(Add, BinaryInstructions::Add);
+        break;
+      case NodeKind::Sub:
+        binaryInst(Sub, BinaryInstructions::Sub);
+        break;
+      case NodeKind::Equal:
+        binaryInst(EQ, BinaryInstructions::EQ);
+        break;
+      case NodeKind::NotEqual:
+        binaryInst(NEQ, BinaryInstructions::NEQ);
+        break;
+      case NodeKind::GreaterThan:
+        binaryInst(GT, BinaryInstructions::GT);
+        break;
+      case NodeKind::GreaterEqual:
+        binaryInst(GE, BinaryInstructions::GE);
+        break;
+      case NodeKind::LessThan:
+        binaryInst(LT, BinaryInstructions::LT);
+        break;
+      case NodeKind::LessEqual:
+        binaryInst(LE, BinaryInstructions::LE);
+        break;
+      case NodeKind::AddAsign:
+        asignInst(Add, BinaryInstructions::Add);
+        break;
+      case NodeKind::SubAsign:
+        asignInst(Sub, BinaryInstructions::Sub);
+        break;
+      case NodeKind::MulAsign:
+        asignInst(Mul, BinaryInstructions::Mul);
+        break;
+      case NodeKind::DivAsign:
+        asignInst(Div, BinaryInstructions::Div);
+        break;
+      case NodeKind::ModAsign:
+        asignInst(Mod, BinaryInstructions::Mod);
+        break;
+      case NodeKind::LShift:
+      case NodeKind::RShift:
+      case NodeKind::BitAnd:
+      case NodeKind::BitOr:
+      case NodeKind::BitXor:
+      case NodeKind::LogicalAnd:
+      case NodeKind::LogicalOr:
+      case NodeKind::BitAndAsign:
+      case NodeKind::BitOrAsign:
+      case NodeKind::BitXorAsign:
+      case NodeKind::LShiftAsign:
+      case NodeKind::RShiftAsign:
+        // PCIRに対応する命令がまだない。
+        errors.push_back(createSemanticError(binary, "この演算子はまだサポートされていません。"));
+        break;
+      case NodeKind::Asign: {
+        auto asign = dynCast<AsignNode>(binary);
+        auto left = exprAnalyze(asign->left, flow);
+        auto right = exprAnalyze(asign->right, flow);
+        if(!left) errors += left.err();
+        else if(!right) errors += right.err();
+        else if(!Type::castable(left.get()->type, right.get()->type)) {
+          errors.push_back(createSemanticError(binary, "型 " + left.get()->type.toString() + " に型 " + right.get()->type.toString() + " は代入できません。"));
         }
-        else if(right.get()->curVar->status == VariableStatus::Moved) {
-          errors.push_back(createSemanticError(asign->right, "既に移動された変数です。"));
+        else if(left.get()->curVar == nullptr && left.get()->vType == ValueType::RValue) {
+          errors.push_back(createSemanticError(asign, "右辺値に値は代入できません。"));
         }
-        else {
-          right.get()->curVar->status = VariableStatus::Moved;
+        else if(left.get()->curVar != nullptr && left.get()->curVar->mut == Mutability::Immutable) {
+          errors.push_back(createSemanticError(asign, "変数 " + left.get()->curVar->name.str() + " はイミュータブルです。"));
         }
-      }
-
-      if(errors.empty()) {
-        if(left.get()->curVar != nullptr) {
-          left.get()->curVar->status = VariableStatus::InUse;
-          left.get()->curVar->reg = right.get();
+        else if(right.get()->curVar != nullptr) {
+          if(right.get()->curVar->status == VariableStatus::Uninited) {
+            errors.push_back(createSemanticError(asign->right, "初期化されていない変数です。"));
+          }
+          else if(right.get()->curVar->status == VariableStatus::Moved) {
+            errors.push_back(createSemanticError(asign->right, "既に移動された変数です。"));
+          }
+          else {
+            right.get()->curVar->status = VariableStatus::Moved;
+          }
         }
-        else {
-          auto inst = new AllocInstruction();
-          inst->dist = left.get();
-          inst->src = right.get();
-          (*flow)->insts.push_back(inst);
+
+        if(errors.empty()) {
+          if(left.get()->curVar != nullptr) {
+            left.get()->curVar->status = VariableStatus::InUse;
+            left.get()->curVar->reg = right.get();
+          }
+          else {
+            auto inst = tree->irArena.make<AllocInstruction>();
+            inst->dist = left.get();
+            inst->src = right.get();
+            (*flow)->insts.push_back(inst);
+          }
+          reg = left.get();
         }
-        reg = left.get();
+        break;
       }
-    }
-    else {
-      assert(false);
+      default:
+        assert(false);
     }
     if(errors.empty()) return ok(reg);
-    return error(errors);
+    return error(std::move(errors));
   }
 }
\ No newline at end of file
@@ -12,11 +12,11 @@ namespace pickc::pcir
 
     (*flow)->type = FlowType::Normal;
 
-    auto child = new FlowNode();
+    auto child = tree->irArena.make<FlowNode>();
     child->type = FlowType::Undecided;
     child->parentFlow = *flow;
     child->belong = (*flow)->belong;
-    child->belong->flows.push_back(child);
+    child->belong->addFlow(child);
 
     (*flow)->nextFlow = child;
 
@@ -55,11 +55,11 @@ namespace pickc::pcir
         }
         child->type = FlowType::EndPoint;
         // デッドコードも解析だけはする。
-        auto deadFlow = new FlowNode();
+        auto deadFlow = tree->irArena.make<FlowNode>();
         deadFlow->type = FlowType::Undecided;
         deadFlow->parentFlow = child;
         deadFlow->belong = child->belong;
-        deadFlow->belong->flows.push_back(deadFlow);
+        deadFlow->belong->addFlow(deadFlow);
         child = deadFlow;
       }
       else {
@@ -68,17 +68,17 @@ namespace pickc::pcir
     }
 
     if(child->type == FlowType::Undecided) {
-      auto next = new FlowNode();
+      auto next = tree->irArena.make<FlowNode>();
       next->type = FlowType::Undecided;
       next->parentFlow = *flow;
       next->belong = (*flow)->belong;
-      next->belong->flows.push_back(next);
+      next->belong->addFlow(next);
       child->type = FlowType::Normal;
       child->nextFlow = next;
       *flow = next;
     }
 
     if(errors.empty()) return ok(child->result);
-    return error(errors);
+    return error(std::move(errors));
   }
 }
\ No newline at end of file
@@ -10,66 +10,62 @@ namespace pickc::pcir
     using namespace parser;
     std::vector<std::string> errors;
 
-    if(fnDef->name && (*flow)->findVar(fnDef->name->name)) return error(std::vector{ createSemanticError(fnDef->name, "既に変数 " + fnDef->name->name + " は定義されています。") });
+    if(fnDef->name && (*flow)->findVar(fnDef->name->atom)) return error(std::vector{ createSemanticError(fnDef->name, "既に変数 " + fnDef->name->name + " は定義されています。") });
 
-    auto fn = new Function();
+    auto fn = tree->irArena.make<Function>(tree->irArena);
     fn->belong = *flow;
-    TypeFunction type;
-    type.retType = new Type(fnDef->retType);
+    std::vector<Type> argTypes;
 
     for(uint32_t index = 0, l = fnDef->args.size(); index < l; ++index) {
       auto argDef = fnDef->args[index];
-      type.args.push_back(new Type(argDef->type));
-      if(std::find(fn->args.begin(), fn->args.end(), argDef->name->name) != fn->args.end()) {
+      argTypes.push_back(Type(argDef->type));
+      if(std::find(fn->args.begin(), fn->args.end(), argDef->name->atom) != fn->args.end()) {
         errors.push_back(createSemanticError(argDef, "引数名 " + argDef->name->name + " が重複しています。"));
       }
-      auto arg = new Register();
+      auto arg = tree->irArena.make<Register>();
       arg->type = Type(argDef->type);
-      fn->args.push_back(argDef->name->name);
-      fn->regs.push_back(arg);
-      auto var = new Variable{
-        argDef->name->name,
+      fn->args.push_back(argDef->name->atom);
+      fn->addReg(arg);
+      auto var = tree->irArena.make<Variable>(Variable{
+        argDef->name->atom,
         argDef->isMut ? Mutability::Mutable : Mutability::Immutable,
         VariableStatus::InUse,
         arg->type,
         arg
-      };
+      });
       arg->curVar = var;
       fn->entryFlow->vars.insert(var);
       if(argDef->init) {
-        fn->defaultArgs[argDef->name->name].flow = new FlowNode();
-        fn->defaultArgs[argDef->name->name].flow->belong = fn;
-        if(auto defaultArg = exprAnalyze(argDef->init, &fn->defaultArgs[argDef->name->name].flow)) {
-          fn->defaultArgs[argDef->name->name].reg = defaultArg.get();
+        fn->defaultArgs[argDef->name->atom].flow = tree->irArena.make<FlowNode>();
+        fn->defaultArgs[argDef->name->atom].flow->belong = fn;
+        if(auto defaultArg = exprAnalyze(argDef->init, &fn->defaultArgs[argDef->name->atom].flow)) {
+          fn->defaultArgs[argDef->name->atom].reg = defaultArg.get();
         }
         else errors += defaultArg.err();
       }
 
-      auto loadArg = new LoadArgInstruction();
+      auto loadArg = tree->irArena.make<LoadArgInstruction>();
       loadArg->reg = arg;
       loadArg->indexOfArg = index;
       fn->entryFlow->insts.push_back(loadArg);
     }
-    if(!errors.empty()) {
-      delete fn;
-      return error(errors);
-    }
+    if(!errors.empty()) return error(std::move(errors));
 
-    fn->type = type;
+    fn->type = Type::fn(Type(fnDef->retType), std::move(argTypes));
     if(instanceof<parser::ExternNode>(fnDef)) {
       fn->fType = FunctionType::Extern;
-      fn->externName = fnDef->name->name;
+      fn->externName = fnDef->name->atom;
     }
     else {
       fn->fType = FunctionType::Function;
       auto curFlow = fn->entryFlow;
       if(auto body = exprAnalyze(fnDef->body, &curFlow)) {
         if(body.get()) {
-          if(!Type::castable(*fn->type.fn.retType, body.get()->type)) {
-            errors.push_back(createSemanticError(fnDef, "関数は " + fn->type.fn.retType->toString() + " を返しますが、" + body.get()->type.toString() + " が返されました。"));
+          if(!Type::castable(fn->type.retType(), body.get()->type)) {
+            errors.push_back(createSemanticError(fnDef, "関数は " + fn->type.retType().toString() + " を返しますが、" + body.get()->type.toString() + " が返されました。"));
           }
           else {
-            *fn->type.fn.retType = Type::merge(Mov, *fn->type.fn.retType, body.get()->type);
+            fn->type = Type::fn(Type::merge(Mov, fn->type.retType(), body.get()->type), fn->type.args());
             curFlow->type = FlowType::EndPoint;
             curFlow->retReg = body.get();
           }
@@ -82,26 +78,25 @@ namespace pickc::pcir
     }
     
     if(errors.empty()) {
-      auto reg = new Register();
+      auto reg = tree->irArena.make<Register>();
       reg->type = fn->type;
       if(fnDef->name) {
-        (*flow)->vars.insert(new Variable{
-          fnDef->name->name,
+        (*flow)->vars.insert(tree->irArena.make<Variable>(Variable{
+          fnDef->name->atom,
           Mutability::Immutable,
           VariableStatus::InUse,
           reg->type,
           reg
-        });
+        }));
       }
       (*flow)->addReg(reg);
-      auto inst = new LoadFnInstruction();
+      auto inst = tree->irArena.make<LoadFnInstruction>();
       inst->reg = reg;
       inst->fn = fn;
       (*flow)->insts.push_back(inst);
       tree->module.functions.push_back(fn);
       return ok(reg);
     }
-    delete fn;
-    return error(errors);
+    return error(std::move(errors));
   }
 }
\ No newline at end of file
@@ -8,19 +8,19 @@ namespace pickc::pcir
   {
     using namespace parser;
 
-    auto result = new Register();
+    auto result = tree->irArena.make<Register>();
     result->type = Type(Types::Void);
-    (*flow)->belong->regs.push_back(result);
+    (*flow)->addReg(result);
 
     std::vector<std::string> errors;
 
     (*flow)->type = FlowType::Normal;
 
-    auto ifFlow = new FlowNode();
+    auto ifFlow = tree->irArena.make<FlowNode>();
     ifFlow->type = FlowType::ConditionalBranch;
     ifFlow->parentFlow = *flow;
     ifFlow->belong = (*flow)->belong;
-    ifFlow->belong->flows.push_back(ifFlow);
+    ifFlow->belong->addFlow(ifFlow);
 
     (*flow)->nextFlow = ifFlow;
 
@@ -29,17 +29,17 @@ namespace pickc::pcir
 
     auto begin = (*flow)->currentVars();
 
-    auto next = new FlowNode();
+    auto next = tree->irArena.make<FlowNode>();
     next->type = FlowType::Undecided;
     next->parentFlow = *flow;
     next->belong = (*flow)->belong;
-    next->belong->flows.push_back(next);
+    next->belong->addFlow(next);
     
-    auto thenFlow = new FlowNode();
+    auto thenFlow = tree->irArena.make<FlowNode>();
     thenFlow->type = FlowType::Undecided;
     thenFlow->parentFlow = *flow;
     thenFlow->belong = (*flow)->belong;
-    thenFlow->belong->flows.push_back(thenFlow);
+    thenFlow->belong->addFlow(thenFlow);
     ifFlow->thenFlow = thenFlow;
     auto thenRes = exprAnalyze(ifNode->thenExpr, &thenFlow);
     if(thenRes) {
@@ -59,11 +59,11 @@ namespace pickc::pcir
     else errors += thenRes.err();
 
     if(ifNode->elseExpr) {
-      auto elseFlow = new FlowNode();
+      auto elseFlow = tree->irArena.make<FlowNode>();
       elseFlow->type = FlowType::Undecided;
       elseFlow->parentFlow = *flow;
       elseFlow->belong = (*flow)->belong;
-      elseFlow->belong->flows.push_back(elseFlow);
+      elseFlow->belong->addFlow(elseFlow);
       ifFlow->elseFlow = elseFlow;
       if(auto elseRes = exprAnalyze(ifNode->elseExpr, &elseFlow)) {
         if(elseFlow->type == FlowType::Undecided) {
@@ -83,7 +83,7 @@ namespace pickc::pcir
         if(thenRes && elseRes && thenRes.get() && elseRes.get()) {
           result->type = Type::merge(Mov, thenRes.get()->type, elseRes.get()->type);
 
-          auto phi = new PhiInstruction();
+          auto phi = tree->irArena.make<PhiInstruction>();
           phi->dist = result;
           phi->r1 = thenRes.get();
           phi->r2 = elseRes.get();
@@ -100,8 +100,8 @@ namespace pickc::pcir
 
     for(auto& var : begin) {
       if(end[var.first] != var.second) {
-        auto phi = new PhiInstruction();
-        phi->dist = new Register();
+        auto phi = tree->irArena.make<PhiInstruction>();
+        phi->dist = tree->irArena.make<Register>();
         phi->r1 = var.second;
         phi->r2 = end[var.first];
         phi->dist->type = var.second->type;
@@ -115,6 +115,6 @@ namespace pickc::pcir
     *flow = next;
 
     if(errors.empty()) return ok(result);
-    return error(errors);
+    return error(std::move(errors));
   }
 }
\ No newline at end of file
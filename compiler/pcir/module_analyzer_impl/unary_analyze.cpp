@@ -32,11 +32,11 @@ namespace pickc::pcir
           Register* baseReg;
           Register* distReg;
           reg = baseReg = base.get();
-          distReg = new Register();
+          distReg = tree->irArena.make<Register>();
           distReg->type = baseReg->type;
           base.get()->curVar->reg = distReg;
           (*flow)->addReg(distReg);
-          auto inst = new UnaryInstruction();
+          auto inst = tree->irArena.make<UnaryInstruction>();
           inst->inst = uinst;
           inst->reg = baseReg;
           inst->dist = distReg;
@@ -53,7 +53,7 @@ namespace pickc::pcir
           errors.push_back(createSemanticError(unary, "不正な型です。"));
         }
         else {
-          reg = new Register();
+          reg = tree->irArena.make<Register>();
           reg->type = base.get()->type;
           (*flow)->addReg(reg);
           if(base.get()->curVar != nullptr) {
@@ -64,7 +64,7 @@ namespace pickc::pcir
               errors.push_back(createSemanticError(unary, "既に移動されている変数です。"));
             }
           }
-          auto inst = new UnaryInstruction();
+          auto inst = tree->irArena.make<UnaryInstruction>();
           inst->inst = uinst;
           inst->dist = reg;
           inst->reg = base.get();
@@ -75,128 +75,135 @@ namespace pickc::pcir
         errors += base.err();
       }
     };
-    if(instanceof<BackIncrementNode>(unary)) {
-      incdec(Inc, UnaryInstructions::Inc, false);
-    }
-    else if(instanceof<BackDecrementNode>(unary)) {
-      incdec(Dec, UnaryInstructions::Dec, false);
-    }
-    else if(instanceof<FrontIncrementNode>(unary)) {
-      incdec(Inc, UnaryInstructions::Inc, true);
-    }
-    else if(instanceof<FrontDecrementNode>(unary)) {
-      incdec(Dec, UnaryInstructions::Dec, true);
-    }
-    else if(instanceof<PlusNode>(unary)) {
-      posneg(Pos, UnaryInstructions::Pos);
-    }
-    else if(instanceof<MinusNode>(unary)) {
-      posneg(Neg, UnaryInstructions::Neg);
-    }
-    else if(instanceof<MemberAccessNode>(unary)) {
-      // TODO
-      assert(false);
-    }
-    else if(instanceof<ArrayAccessNode>(unary)) {
-      auto ac = dynCast<ArrayAccessNode>(unary);
-      if(auto array = exprAnalyze(ac->base, flow)) {
-        if(array.get()->curVar != nullptr) {
-          if(array.get()->curVar->status == VariableStatus::Uninited) {
-            errors.push_back(createSemanticError(ac->base, "初期化されていない変数です。"));
-          }
-          else if(array.get()->curVar->status == VariableStatus::Moved) {
-            errors.push_back(createSemanticError(ac->base, "既に移動された変数です。"));
-          }
-        }
-        if(!array.get()->type.isArray() && !array.get()->type.isPtr()) {
-          errors.push_back(createSemanticError(ac, "[]でアクセスできるのは配列型かポインタ型のみです。"));
-        }
-        if(auto suffix = exprAnalyze(ac->suffix, flow)) {
-          if(suffix.get()->curVar != nullptr) {
-            if(suffix.get()->curVar->status == VariableStatus::Uninited) {
-              errors.push_back(createSemanticError(ac->suffix, "初期化されていない変数です。"));
+    switch(unary->kind) {
+      case NodeKind::BackIncrement:
+        incdec(Inc, UnaryInstructions::Inc, false);
+        break;
+      case NodeKind::BackDecrement:
+        incdec(Dec, UnaryInstructions::Dec, false);
+        break;
+      case NodeKind::FrontIncrement:
+        incdec(Inc, UnaryInstructions::Inc, true);
+        break;
+      case NodeKind::FrontDecrement:
+        incdec(Dec, UnaryInstructions::Dec, true);
+        break;
+      case NodeKind::Plus:
+        posneg(Pos, UnaryInstructions::Pos);
+        break;
+      case NodeKind::Minus:
+        posneg(Neg, UnaryInstructions::Neg);
+        break;
+      case NodeKind::BitNot:
+      case NodeKind::LogicalNot:
+      case NodeKind::Copy:
+        // PCIRに対応する命令がまだない。
+        errors.push_back(createSemanticError(unary, "この演算子はまだサポートされていません。"));
+        break;
+      case NodeKind::MemberAccess:
+        // TODO
+        assert(false);
+        break;
+      case NodeKind::ArrayAccess: {
+        auto ac = dynCast<ArrayAccessNode>(unary);
+        if(auto array = exprAnalyze(ac->base, flow)) {
+          if(array.get()->curVar != nullptr) {
+            if(array.get()->curVar->status == VariableStatus::Uninited) {
+              errors.push_back(createSemanticError(ac->base, "初期化されていない変数です。"));
             }
-            else if(suffix.get()->curVar->status == VariableStatus::Moved) {
-              errors.push_back(createSemanticError(ac->suffix, "既に移動された変数です。"));
+            else if(array.get()->curVar->status == VariableStatus::Moved) {
+              errors.push_back(createSemanticError(ac->base, "既に移動された変数です。"));
             }
           }
-          if(!suffix.get()->type.isInt()) {
-            errors.push_back(createSemanticError(ac, "インデックスに使用できる方は整数型のみです。"));
+          if(!array.get()->type.isArray() && !array.get()->type.isPtr()) {
+            errors.push_back(createSemanticError(ac, "[]でアクセスできるのは配列型かポインタ型のみです。"));
           }
-          if(errors.empty()) {
-            reg = new Register();
-            reg->vType = ValueType::LValue;
-            if(array.get()->type.isArray()) {
-              reg->type = *array.get()->type.array.elem;
+          if(auto suffix = exprAnalyze(ac->suffix, flow)) {
+            if(suffix.get()->curVar != nullptr) {
+              if(suffix.get()->curVar->status == VariableStatus::Uninited) {
+                errors.push_back(createSemanticError(ac->suffix, "初期化されていない変数です。"));
+              }
+              else if(suffix.get()->curVar->status == VariableStatus::Moved) {
+                errors.push_back(createSemanticError(ac->suffix, "既に移動された変数です。"));
+              }
+            }
+            if(!suffix.get()->type.isInt()) {
+              errors.push_back(createSemanticError(ac, "インデックスに使用できる方は整数型のみです。"));
             }
-            else {
-              reg->type = *array.get()->type.ptr.elem;
+            if(errors.empty()) {
+              reg = tree->irArena.make<Register>();
+              reg->vType = ValueType::LValue;
+              reg->type = array.get()->type.elem();
+              (*flow)->addReg(reg);
+              auto inst = tree->irArena.make<LoadElemInstruction>();
+              inst->dist = reg;
+              inst->array = array.get();
+              inst->index = suffix.get();
+              (*flow)->insts.push_back(inst);
             }
-            (*flow)->addReg(reg);
-            auto inst = new LoadElemInstruction();
-            inst->dist = reg;
-            inst->array = array.get();
-            inst->index = suffix.get();
-            (*flow)->insts.push_back(inst);
+          }
+          else {
+            errors += suffix.err();
           }
         }
         else {
-          errors += suffix.err();
+          errors += array.err();
         }
+        break;
       }
-      else {
-        errors += array.err();
-      }
-    }
-    else if(instanceof<CallNode>(unary)) {
-      auto call = dynCast<CallNode>(unary);
-      if(auto fn = exprAnalyze(call->base, flow)) {
-        if(fn.get()->curVar != nullptr) {
-          if(fn.get()->curVar->status == VariableStatus::Uninited) {
-            errors.push_back(createSemanticError(call->base, "初期化されていない変数です。"));
+      case NodeKind::Call: {
+        auto call = dynCast<CallNode>(unary);
+        if(auto fn = exprAnalyze(call->base, flow)) {
+          if(fn.get()->curVar != nullptr) {
+            if(fn.get()->curVar->status == VariableStatus::Uninited) {
+              errors.push_back(createSemanticError(call->base, "初期化されていない変数です。"));
+            }
+            else if(fn.get()->curVar->status == VariableStatus::Moved) {
+              errors.push_back(createSemanticError(call->base, "既に移動された変数です。"));
+            }
           }
-          else if(fn.get()->curVar->status == VariableStatus::Moved) {
-            errors.push_back(createSemanticError(call->base, "既に移動された変数です。"));
+          if(!fn.get()->type.isFn()) {
+            errors.push_back(createSemanticError(call->base, "関数ではありません。"));
           }
-        }
-        if(!fn.get()->type.isFn()) {
-          errors.push_back(createSemanticError(call->base, "関数ではありません。"));
-        }
-        else if(fn.get()->type.fn.args.size() != call->args.size()) {
-          errors.push_back(createSemanticError(call, "関数の呼び出しが不正です。関数の引数の数は" + std::to_string(fn.get()->type.fn.args.size()) + "個ですが、引数が" + std::to_string(call->args.size()) + "個でした。"));
-        }
-        else {
-          std::vector<Register*> args;
-          for(size_t i = 0, l = call->args.size(); i < l; ++i) {
-            if(auto arg = exprAnalyze(call->args[i], flow)) {
-              if(Type::castable(*fn.get()->type.fn.args[i], arg.get()->type)) {
-                args.push_back(arg.get());
+          else if(fn.get()->type.args().size() != call->args.size()) {
+            errors.push_back(createSemanticError(call, "関数の呼び出しが不正です。関数の引数の数は" + std::to_string(fn.get()->type.args().size()) + "個ですが、引数が" + std::to_string(call->args.size()) + "個でした。"));
+          }
+          else {
+            std::vector<Register*> args;
+            for(size_t i = 0, l = call->args.size(); i < l; ++i) {
+              if(auto arg = exprAnalyze(call->args[i], flow)) {
+                if(Type::castable(fn.get()->type.args()[i], arg.get()->type)) {
+                  args.push_back(arg.get());
+                }
+                else {
+                  errors.push_back(createSemanticError(call->args[i], "関数の呼び出しが不正です。引数の型は " + fn.get()->type.args()[i].toString() + " ですが、" + arg.get()->type.toString() + " が指定されました。"));
+                }
               }
               else {
-                errors.push_back(createSemanticError(call->args[i], "関数の呼び出しが不正です。引数の型は " + fn.get()->type.fn.args[i]->toString() + " ですが、" + arg.get()->type.toString() + " が指定されました。"));
+                errors += arg.err();
               }
             }
-            else {
-              errors += arg.err();
+            if(errors.empty()) {
+              reg = tree->irArena.make<Register>();
+              reg->type = fn.get()->type.retType();
+              (*flow)->addReg(reg);
+              auto inst = tree->irArena.make<CallInstruction>();
+              inst->fn = fn.get();
+              inst->args = std::move(args);
+              inst->dist = reg;
+              (*flow)->insts.push_back(inst);
             }
           }
-          if(errors.empty()) {
-            reg = new Register();
-            reg->type = *fn.get()->type.fn.retType;
-            (*flow)->addReg(reg);
-            auto inst = new CallInstruction();
-            inst->fn = fn.get();
-            inst->args = std::move(args);
-            inst->dist = reg;
-            (*flow)->insts.push_back(inst);
-          }
         }
+        else {
+          errors += fn.err();
+        }
+        break;
       }
-      else {
-        errors += fn.err();
-      }
+      default:
+        assert(false);
     }
     if(errors.empty()) return ok(reg);
-    return error(errors);
+    return error(std::move(errors));
   }
 }
\ No newline at end of file
@@ -9,18 +9,18 @@ namespace pickc::pcir
     using namespace parser;
     Variable* flowVar = nullptr;
     Register* reg = nullptr;
-    if(instanceof<ScopedVariableNode>(var) || !(flowVar = (*flow)->findVar(var->name))) {
+    if(instanceof<ScopedVariableNode>(var) || !(flowVar = (*flow)->findVar(var->atom))) {
       if(auto symbol = findGlobalVar(var)) {
-        reg = new Register();
+        reg = tree->irArena.make<Register>();
         reg->type = symbol.get()->type;
-        auto loadSymbol = new LoadSymbolInstruction();
+        auto loadSymbol = tree->irArena.make<LoadSymbolInstruction>();
         loadSymbol->reg = reg;
         loadSymbol->name = symbol.get()->fullyQualifiedName;
         (*flow)->addReg(reg);
         (*flow)->insts.push_back(loadSymbol);
       }
       else {
-        return error(symbol.err());
+        return error(std::move(symbol.err()));
       }
     }
     else {
@@ -10,7 +10,7 @@ namespace pickc::pcir
     Register* reg = nullptr;
     std::vector<std::string> errors;
     Type expectedType(varDef->type);
-    if((*flow)->findVar(varDef->name->name)) errors.push_back(createSemanticError(varDef->name, "既に変数 " + varDef->name->name + " は定義されています。"));
+    if((*flow)->findVar(varDef->name->atom)) errors.push_back(createSemanticError(varDef->name, "既に変数 " + varDef->name->name + " は定義されています。"));
     else if(varDef->init) {
       if(auto res = exprAnalyze(varDef->init, flow)) {
         if(!Type::castable(expectedType, res.get()->type)) {
@@ -32,21 +32,21 @@ namespace pickc::pcir
       }
     }
     else {
-      reg = new Register();
+      reg = tree->irArena.make<Register>();
       reg->type = expectedType;
     }
     if(errors.empty()) {
-      reg->curVar = new Variable{
-        varDef->name->name,
+      reg->curVar = tree->irArena.make<Variable>(Variable{
+        varDef->name->atom,
         varDef->isMut ? Mutability::Mutable : Mutability::Immutable,
         VariableStatus::InUse,
         expectedType,
         reg
-      };
+      });
       (*flow)->vars.insert(reg->curVar);
       return ok(reg);
     }
     
-    return error(errors);
+    return error(std::move(errors));
   }
 }
\ No newline at end of file
@@ -6,51 +6,51 @@ namespace pickc::pcir
 {
   Result<Register*, std::vector<std::string>> ModuleAnalyzer::whileAnalyze(const parser::WhileNode* whileNode, FlowNode** flow)
   {
-    auto result = new Register();
+    auto result = tree->irArena.make<Register>();
     result->type = Type(Types::Void);
-    (*flow)->belong->regs.push_back(result);
+    (*flow)->addReg(result);
 
     std::vector<std::string> errors;
 
     (*flow)->type = FlowType::Normal;
 
-    auto whileFlow = new FlowNode();
+    auto whileFlow = tree->irArena.make<FlowNode>();
     whileFlow->type = FlowType::ConditionalBranch;
     whileFlow->parentFlow = *flow;
     whileFlow->belong = (*flow)->belong;
-    whileFlow->belong->flows.push_back(whileFlow);
+    whileFlow->belong->addFlow(whileFlow);
 
     (*flow)->nextFlow = whileFlow;
 
-    auto bodyFlow = new FlowNode();
+    auto bodyFlow = tree->irArena.make<FlowNode>();
     bodyFlow->type = FlowType::Undecided;
     bodyFlow->parentFlow = *flow;
     bodyFlow->belong = (*flow)->belong;
-    bodyFlow->belong->flows.push_back(bodyFlow);
+    bodyFlow->belong->addFlow(bodyFlow);
     auto begin = bodyFlow->currentVars();
 
     if(auto cond = exprAnalyze(whileNode->comp, &whileFlow)) whileFlow->cond = cond.get();
     else errors += cond.err();
 
-    auto next = new FlowNode();
+    auto next = tree->irArena.make<FlowNode>();
     next->type = FlowType::Undecided;
     next->parentFlow = *flow;
     next->belong = (*flow)->belong;
-    next->belong->flows.push_back(next);
+    next->belong->addFlow(next);
 
     whileFlow->thenFlow = bodyFlow;
     whileFlow->elseFlow = next;
     auto thenRes = exprAnalyze(whileNode->body, &bodyFlow);
     if(!thenRes) errors += thenRes.err();
     
-    if(!errors.empty()) return error(errors);
+    if(!errors.empty()) return error(std::move(errors));
 
     auto end = bodyFlow->currentVars();
 
     for(auto& var : begin) {
       if(end[var.first] != var.second) {
-        auto phi = new PhiInstruction();
-        phi->dist = new Register();
+        auto phi = tree->irArena.make<PhiInstruction>();
+        phi->dist = tree->irArena.make<Register>();
         phi->r1 = var.second;
         phi->r2 = end[var.first];
         phi->dist->type = var.second->type;
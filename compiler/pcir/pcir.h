@@ -6,7 +6,10 @@
 #include <unordered_set>
 
 #include "parser/ast_node.h"
+#include "utils/arena.h"
+#include "utils/interner.h"
 #include "pcir_code.h"
+#include "type.h"
 
 namespace pickc
 {
@@ -25,103 +28,6 @@ namespace pickc::pcir
     Immutable,
     Mutable,
   };
-  enum struct Types
-  {
-    _UNDEFINED,
-    // 未初期化変数などの、型が定まっていない状態
-    Any,
-    // IntegerLiteralの型。状況によってさまざまな型に変換される。
-    Integer,
-    // FloatLiteralの型。状況によってF32, F64のいずれかに変換される。
-    Float,
-    // NullLiteralの型。状況によってptr<T>のTが異なる型に変換される。
-    Null,
-    I8,
-    I16,
-    I32,
-    I64,
-    U8,
-    U16,
-    U32,
-    U64,
-    F32,
-    F64,
-    Array,
-    Void,
-    Ptr,
-    Bool,
-    Char,
-    Function,
-    UserDefine,
-    Generics,
-  };
-  struct Type;
-  struct TypeArray
-  {
-    Type* elem;
-    uint32_t length;
-  };
-  struct TypePtr
-  {
-    Type* elem;
-  };
-  struct TypeFunction
-  {
-    Type* retType;
-    std::vector<Type*> args;
-  };
-  struct TypeUserDefine
-  {
-
-  };
-  struct TypeGenerics
-  {
-
-  };
-  struct Type
-  {
-    Types type;
-    union {
-      TypeArray array;
-      TypePtr ptr;
-      TypeFunction fn;
-      TypeUserDefine user;
-      TypeGenerics gen;
-    };
-    Type();
-    Type(Types type);
-    Type(const TypeArray& array);
-    Type(const TypePtr& ptr);
-    Type(const TypeFunction& fn);
-    Type(const TypeUserDefine& user);
-    Type(const TypeGenerics& gen);
-    Type(parser::TypeNode* typeNode);
-    Type(const Type& type);
-    ~Type();
-    Type& operator=(const Type& type);
-    // setのinsert用
-    bool operator<(const Type& type) const;
-    static bool castable(const Type& to, const Type& from);
-    static bool computable(uint8_t inst, const Type* left, const Type* right = nullptr);
-    static Type merge(uint8_t inst, const Type& t1, const Type& t2);
-    bool isAny() const;
-    bool isInt() const;
-    bool isSignedInt() const;
-    bool isUnsignedInt() const;
-    bool isFloat() const;
-    bool isArray() const;
-    bool isVoid() const;
-    bool isBool() const;
-    bool isNull() const;
-    bool isChar() const;
-    bool isPtr() const;
-    bool isFn() const;
-    bool isUserDef() const;
-    bool isGenerics() const;
-    uint32_t size() const;
-    std::string toString() const;
-  };
-
   enum struct RegisterStatus
   {
     Uninited,
@@ -145,6 +51,8 @@ namespace pickc::pcir
     Type type;
     Variable* curVar;
     ValueType vType = ValueType::LValue;
+    // 所属する関数のregsでの位置。Function::addRegで付け、PCIRのレジスタ番号にそのまま使う。
+    uint32_t id = 0;
   };
   // struct RegisterX
   // {
@@ -158,8 +66,28 @@ namespace pickc::pcir
   struct FlowNode;
   struct Function;
 
+  // 命令の種類。compileFunctionなどはdynamic_castの連鎖ではなく、これでswitchする。
+  enum struct InstructionKind : uint8_t
+  {
+    Binary,
+    Unary,
+    ImmMove,
+    Call,
+    LoadFn,
+    LoadArg,
+    LoadSymbol,
+    LoadString,
+    LoadElem,
+    Alloc,
+    Mov,
+    Phi,
+  };
   struct Instruction
   {
+    const InstructionKind kind;
+  protected:
+    Instruction(InstructionKind kind) : kind(kind) {}
+  public:
     virtual ~Instruction() = 0;
   };
   enum struct BinaryInstructions
@@ -178,10 +106,12 @@ namespace pickc::pcir
   };
   struct BinaryInstruction : public Instruction
   {
-    BinaryInstructions inst;
-    Register* dist;
-    Register* left;
-    Register* right;
+    BinaryInstructions inst{};
+    Register* dist = nullptr;
+    Register* left = nullptr;
+    Register* right = nullptr;
+    BinaryInstruction() : Instruction(InstructionKind::Binary) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Binary; }
   };
   enum struct UnaryInstructions
   {
@@ -192,9 +122,11 @@ namespace pickc::pcir
   };
   struct UnaryInstruction : public Instruction
   {
-    UnaryInstructions inst;
-    Register* dist;
-    Register* reg;
+    UnaryInstructions inst{};
+    Register* dist = nullptr;
+    Register* reg = nullptr;
+    UnaryInstruction() : Instruction(InstructionKind::Unary) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Unary; }
   };
   union Immediate {
     int8_t i8;
@@ -213,58 +145,79 @@ namespace pickc::pcir
   };
   struct ImmMove : public Instruction
   {
-    Register* dist;
-    Type type;
+    Register* dist = nullptr;
+    Type type{};
     Immediate imm;
+    ImmMove() : Instruction(InstructionKind::ImmMove) { imm.u64 = 0; }
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::ImmMove; }
   };
   struct CallInstruction : public Instruction
   {
-    Register* dist;
-    Register* fn;
+    Register* dist = nullptr;
+    Register* fn = nullptr;
     std::vector<Register*> args;
+    CallInstruction() : Instruction(InstructionKind::Call) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Call; }
   };
   struct LoadFnInstruction : public Instruction
   {
-    Register* reg;
-    Function* fn;
+    Register* reg = nullptr;
+    Function* fn = nullptr;
+    LoadFnInstruction() : Instruction(InstructionKind::LoadFn) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::LoadFn; }
   };
   struct LoadArgInstruction : public Instruction
   {
-    Register* reg;
-    uint32_t indexOfArg;
+    Register* reg = nullptr;
+    uint32_t indexOfArg = 0;
+    LoadArgInstruction() : Instruction(InstructionKind::LoadArg) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::LoadArg; }
   };
   struct LoadSymbolInstruction : public Instruction
   {
-    Register* reg;
-    std::string name;
+    Register* reg = nullptr;
+    // シンボルの完全修飾名
+    Atom name;
+    LoadSymbolInstruction() : Instruction(InstructionKind::LoadSymbol) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::LoadSymbol; }
   };
   struct LoadStringInstruction : public Instruction
   {
-    Register* reg;
-    std::string value;
+    Register* reg = nullptr;
+    Atom value;
+    LoadStringInstruction() : Instruction(InstructionKind::LoadString) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::LoadString; }
   };
   struct LoadElemInstruction : public Instruction
   {
-    Register* dist;
-    Register* array;
-    Register* index;
+    Register* dist = nullptr;
+    Register* array = nullptr;
+    Register* index = nullptr;
+    LoadElemInstruction() : Instruction(InstructionKind::LoadElem) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::LoadElem; }
   };
   struct AllocInstruction : public Instruction
   {
-    Register* dist;
-    Register* src;
+    Register* dist = nullptr;
+    Register* src = nullptr;
+    AllocInstruction() : Instruction(InstructionKind::Alloc) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Alloc; }
   };
 
   struct MovInstruction : public Instruction
   {
-    Register* dist;
-    Register* src;
+    Register* dist = nullptr;
+    Register* src = nullptr;
+    MovInstruction() : Instruction(InstructionKind::Mov) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Mov; }
   };
   struct PhiInstruction : public Instruction
   {
-    Register* dist;
-    Register* r1;
-    Register* r2;
+    Register* dist = nullptr;
+    Register* r1 = nullptr;
+    Register* r2 = nullptr;
+    PhiInstruction() : Instruction(InstructionKind::Phi) {}
+    static bool classof(const Instruction* inst) { return inst->kind == InstructionKind::Phi; }
   };
 
   enum struct FunctionType
@@ -282,7 +235,7 @@ namespace pickc::pcir
   };
   struct Variable
   {
-    std::string name;
+    Atom name;
     Mutability mut;
     VariableStatus status;
     Type type;
@@ -308,15 +261,17 @@ namespace pickc::pcir
     FlowNode* elseFlow;
     Register* retReg;
     Register* result;
-    Variable* findVar(const std::string& name) const;
+    Variable* findVar(Atom name) const;
     std::unordered_map<Variable*, Register*> currentVars() const;
     Option<std::string> retNotice(const Type& t) const;
     void addReg(Register* reg);
+    // 所属する関数のflowsでの位置。Function::addFlowで付け、PCIRのフロー番号にそのまま使う。
+    uint32_t id = 0;
   };
   struct Function
   {
     FunctionType fType;
-    std::string externName;
+    Atom externName;
     struct DefaultArgument
     {
       FlowNode* flow;
@@ -327,18 +282,22 @@ namespace pickc::pcir
     std::vector<FlowNode*> flows;
     std::vector<Register*> regs;
     Register* result;
-    std::vector<std::string> args;
-    std::unordered_map<std::string, DefaultArgument> defaultArgs;
+    std::vector<Atom> args;
+    std::unordered_map<Atom, DefaultArgument> defaultArgs;
     FlowNode* belong;
-    Option<std::string> retNotice(const Type& t) const;
+    // 戻り値の型をtと合わせる。typeは作り直す。
+    Option<std::string> retNotice(const Type& t);
+    // regsとflowsにはこれらを通して追加する。追加した位置をidに記録する。
     void addReg(Register* reg);
-    Function();
+    void addFlow(FlowNode* flow);
+    // entryFlowはarenaに確保する。
+    explicit Function(Arena& arena);
   };
 
   struct Symbol
   {
-    std::string name;
-    std::string fullyQualifiedName;
+    Atom name;
+    Atom fullyQualifiedName;
     Type type;
     Scope scope;
     Mutability mut;
@@ -0,0 +1,173 @@
+#include "pcir_cache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <sstream>
+#include <thread>
+
+#include "pickc/config.h"
+#include "utils/hash.h"
+#include "utils/mapped_file.h"
+#include "utils/resident_cache.h"
+
+namespace pickc::pcir
+{
+  namespace
+  {
+    // エントリはHeader、モジュール名、importしたモジュールの名前とハッシュ、PCIRの順に書く。
+    // 文字列は長さ(4バイト)の後に本体を書く。
+    constexpr uint32_t FORMAT_VERSION = 3;
+    constexpr char MAGIC[4] = { 'P', 'M', 'O', 'D' };
+    struct Header
+    {
+      char magic[4];
+      uint32_t formatVersion;
+      uint64_t seed;
+      uint64_t sourceHash;
+      uint32_t numImports;
+      uint32_t sizeOfPCIR;
+    };
+    static_assert(sizeof(Header) == 32);
+
+    class Reader
+    {
+      const char* cur;
+      const char* end;
+    public:
+      bool failed;
+      Reader(const char* begin, const char* end) : cur(begin), end(end), failed(false) {}
+      template<typename T>
+      T read()
+      {
+        T value{};
+        if(static_cast<size_t>(end - cur) < sizeof(T)) {
+          failed = true;
+          return value;
+        }
+        std::memcpy(&value, cur, sizeof(T));
+        cur += sizeof(T);
+        return value;
+      }
+      std::string_view readBytes(size_t size)
+      {
+        if(static_cast<size_t>(end - cur) < size) {
+          failed = true;
+          return {};
+        }
+        std::string_view bytes(cur, size);
+        cur += size;
+        return bytes;
+      }
+      std::string_view readString()
+      {
+        return readBytes(read<uint32_t>());
+      }
+      bool atEnd() const
+      {
+        return cur == end;
+      }
+    };
+    template<typename T>
+    void write(std::string& out, const T& value)
+    {
+      out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    void writeString(std::string& out, const std::string& str)
+    {
+      write(out, static_cast<uint32_t>(str.size()));
+      out.append(str);
+    }
+  }
+  PCIRCache::PCIRCache(const std::string& dir, uint32_t encoding) :
+    dir((std::filesystem::path(dir) / "pcir").string()),
+    seed(hashBytes(std::string_view(VERSION), FORMAT_VERSION | static_cast<uint64_t>(encoding) << 32))
+  {
+    // 作れなければstoreが失敗するだけなので、エラーは無視する。
+    std::error_code err;
+    std::filesystem::create_directories(this->dir, err);
+  }
+  std::string PCIRCache::entryPath(const std::string& module) const
+  {
+    // モジュール名には::が含まれるので、ファイル名にはハッシュを使う。
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hashBytes(module, seed)));
+    return (std::filesystem::path(dir) / (std::string(name) + ".pcir")).string();
+  }
+  uint64_t PCIRCache::sourceHash(std::string_view source) const
+  {
+    return hashBytes(source, seed);
+  }
+  Option<BinaryVec> PCIRCache::load(const std::string& module, uint64_t sourceHash, const Imports& imports) const
+  {
+    const auto path = entryPath(module);
+    if(auto entry = ResidentCache::get(path)) return decode(*entry, module, sourceHash, imports);
+    auto file = MappedFile::open(path);
+    if(!file) return none;
+    auto pcir = decode(file.get().view(), module, sourceHash, imports);
+    if(pcir && ResidentCache::enabled()) ResidentCache::put(path, std::string(file.get().view()));
+    return pcir;
+  }
+  Option<BinaryVec> PCIRCache::decode(std::string_view entry, const std::string& module, uint64_t sourceHash, const Imports& imports) const
+  {
+    Reader reader(entry.data(), entry.data() + entry.size());
+    const auto header = reader.read<Header>();
+    if(reader.failed
+      || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+      || header.formatVersion != FORMAT_VERSION
+      || header.seed != seed
+      || header.sourceHash != sourceHash
+      || header.numImports != imports.size()
+      || reader.readString() != module) {
+      return none;
+    }
+    for(const auto& imp : imports) {
+      const auto name = reader.readString();
+      const auto hash = reader.read<uint64_t>();
+      if(reader.failed || name != imp.first || hash != imp.second) return none;
+    }
+    const auto pcir = reader.readBytes(header.sizeOfPCIR);
+    if(reader.failed || !reader.atEnd()) return none;
+    return Option<BinaryVec>(BinaryVec(pcir.begin(), pcir.end()));
+  }
+  void PCIRCache::store(const std::string& module, uint64_t sourceHash, const Imports& imports, const BinaryVec& pcir) const
+  {
+    std::string out;
+    out.reserve(sizeof(Header) + module.size() + pcir.size() + 64);
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.seed = seed;
+    header.sourceHash = sourceHash;
+    header.numImports = static_cast<uint32_t>(imports.size());
+    header.sizeOfPCIR = static_cast<uint32_t>(pcir.size());
+    write(out, header);
+    writeString(out, module);
+    for(const auto& imp : imports) {
+      writeString(out, imp.first);
+      write(out, imp.second);
+    }
+    out.append(reinterpret_cast<const char*>(pcir.data()), pcir.size());
+
+    // 書きかけのファイルを読まれないよう、一時ファイルに書いてから置き換える。
+    std::error_code err;
+    const auto path = entryPath(module);
+    std::ostringstream tmp;
+    tmp << path << '.' << std::this_thread::get_id() << '.' << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+    {
+      std::ofstream file(tmp.str(), std::ios::binary | std::ios::trunc);
+      if(!file) return;
+      file.write(out.data(), out.size());
+      if(!file) {
+        file.close();
+        std::filesystem::remove(tmp.str(), err);
+        return;
+      }
+    }
+    std::filesystem::rename(tmp.str(), path, err);
+    if(err) std::filesystem::remove(tmp.str(), err);
+    else ResidentCache::put(path, std::move(out));
+  }
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef PICKC_PCIR_PCIR_CACHE_H_
+#define PICKC_PCIR_PCIR_CACHE_H_
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <string_view>
+#include <cstdint>
+
+#include "utils/option.h"
+#include "utils/binary_vec.h"
+
+namespace pickc::pcir
+{
+  // モジュールごとのPCIRをディレクトリに保存し、再コンパイルで意味解析を省略する。
+  // エントリはモジュールの完全修飾名ごとに1つで、ソースの内容のハッシュと、
+  // importしたモジュールの公開インターフェースのハッシュが変わっていなければ再利用できる。
+  // ASTCacheと同じく、エントリは書き込み後にrenameで置き、ResidentCacheが有効ならメモリからも読む。
+  class PCIRCache
+  {
+  public:
+    // importしたモジュールの完全修飾名と公開インターフェースのハッシュ。名前順に並べる。
+    using Imports = std::vector<std::pair<std::string, uint64_t>>;
+  private:
+    std::string dir;
+    uint64_t seed;
+    std::string entryPath(const std::string& module) const;
+    Option<BinaryVec> decode(std::string_view entry, const std::string& module, uint64_t sourceHash, const Imports& imports) const;
+  public:
+    // encodingはPCIR_ENCODING_*。符号化ごとに別のエントリにする。
+    PCIRCache(const std::string& dir, uint32_t encoding);
+    uint64_t sourceHash(std::string_view source) const;
+    // moduleのエントリがsourceHashとimportsで作られたものならPCIRを返す。
+    Option<BinaryVec> load(const std::string& module, uint64_t sourceHash, const Imports& imports) const;
+    // 書き込めなくてもコンパイルには影響しないので、失敗は無視する。
+    void store(const std::string& module, uint64_t sourceHash, const Imports& imports, const BinaryVec& pcir) const;
+  };
+}
+
+#endif // PICKC_PCIR_PCIR_CACHE_H_
\ No newline at end of file
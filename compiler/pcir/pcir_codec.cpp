@@ -0,0 +1,360 @@
+#include "pcir_codec.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "pcir_code.h"
+#include "pcir_format.h"
+#include "utils/lz.h"
+
+namespace pickc::pcir
+{
+  namespace
+  {
+    // 即値のバイト数。SemanticAnalyzer::compileFunctionがImmに書く大きさと合わせる。
+    size_t immSize(Type type)
+    {
+      switch(type.type) {
+        case Types::I8:
+        case Types::U8:
+        case Types::Char:
+          return 1;
+        case Types::I16:
+        case Types::U16:
+          return 2;
+        case Types::Integer:
+        case Types::I32:
+        case Types::U32:
+          return 4;
+        case Types::I64:
+        case Types::U64:
+          return 8;
+        default:
+          return 0;
+      }
+    }
+    // 読み込みは範囲外になったらfailedを立てて0を返す。書き込みと同じ名前の関数を持たせ、transcodeで組み合わせる。
+    class FixedReader
+    {
+      BinaryView data;
+      size_t pos;
+    public:
+      bool failed;
+      FixedReader(BinaryView data) : data(data), pos(0), failed(false) {}
+      size_t remaining() const { return data.size() - pos; }
+      bool atEnd() const { return pos == data.size(); }
+      const uint8_t* raw(size_t n)
+      {
+        if(n > remaining()) {
+          pos = data.size();
+          failed = true;
+          return nullptr;
+        }
+        auto head = data.data() + pos;
+        pos += n;
+        return head;
+      }
+      uint8_t byte()
+      {
+        auto p = raw(1);
+        return p ? *p : 0;
+      }
+      uint32_t value()
+      {
+        uint32_t v = 0;
+        if(auto p = raw(4)) std::memcpy(&v, p, 4);
+        return v;
+      }
+      uint32_t optional() { return value(); }
+      uint32_t reg(uint32_t& prev) { return prev = value(); }
+      FixedReader sub(size_t n)
+      {
+        auto head = raw(n);
+        return FixedReader(head ? BinaryView(head, n) : BinaryView());
+      }
+    };
+    // 書く大きさを見積もって先に確保し、push_backせずにポインタで書く。
+    class FixedWriter
+    {
+      BinaryVec out;
+      size_t pos;
+    public:
+      FixedWriter(size_t capacity) : out(capacity), pos(0) {}
+      void raw(const uint8_t* p, size_t n)
+      {
+        if(n > out.size() - pos) out.resize(std::max(out.size() * 2, pos + n));
+        std::memcpy(out.data() + pos, p, n);
+        pos += n;
+      }
+      void byte(uint8_t b) { raw(&b, 1); }
+      void value(uint32_t v) { raw(reinterpret_cast<const uint8_t*>(&v), 4); }
+      void optional(uint32_t v) { value(v); }
+      void reg(uint32_t v, uint32_t& prev) { value(prev = v); }
+      // 命令列の大きさは書き終えてから埋める。
+      size_t beginCode()
+      {
+        value(0);
+        return pos;
+      }
+      void endCode(size_t mark)
+      {
+        const auto size = static_cast<uint32_t>(pos - mark);
+        std::memcpy(out.data() + mark - 4, &size, 4);
+      }
+      BinaryVec finish()
+      {
+        out.resize(pos);
+        return std::move(out);
+      }
+    };
+    class VarintReader
+    {
+      BinaryView data;
+      size_t pos;
+      uint64_t uleb(size_t maxBytes)
+      {
+        // ほとんどの番号は1バイトに収まる。
+        if(pos < data.size() && data[pos] < 0x80) return data[pos++];
+        uint64_t v = 0;
+        for(size_t i = 0; i < maxBytes; ++i) {
+          const auto b = byte();
+          if(failed) return 0;
+          v |= static_cast<uint64_t>(b & 0x7F) << (7 * i);
+          if((b & 0x80) == 0) return v;
+        }
+        failed = true;
+        return 0;
+      }
+    public:
+      bool failed;
+      VarintReader(BinaryView data) : data(data), pos(0), failed(false) {}
+      size_t remaining() const { return data.size() - pos; }
+      bool atEnd() const { return pos == data.size(); }
+      const uint8_t* raw(size_t n)
+      {
+        if(n > remaining()) {
+          pos = data.size();
+          failed = true;
+          return nullptr;
+        }
+        auto head = data.data() + pos;
+        pos += n;
+        return head;
+      }
+      uint8_t byte()
+      {
+        auto p = raw(1);
+        return p ? *p : 0;
+      }
+      uint32_t value()
+      {
+        const auto v = uleb(5);
+        if(v > UINT32_MAX) failed = true;
+        return static_cast<uint32_t>(v);
+      }
+      uint32_t optional() { return value() - 1; }
+      uint32_t reg(uint32_t& prev)
+      {
+        const auto zigzag = uleb(10);
+        const auto delta = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+        const auto v = static_cast<int64_t>(prev) + delta;
+        if(v < 0 || v > UINT32_MAX) {
+          failed = true;
+          return 0;
+        }
+        return prev = static_cast<uint32_t>(v);
+      }
+      VarintReader sub(size_t n)
+      {
+        auto head = raw(n);
+        return VarintReader(head ? BinaryView(head, n) : BinaryView());
+      }
+    };
+    class VarintWriter
+    {
+      void uleb(uint64_t v)
+      {
+        for(; v >= 0x80; v >>= 7) out.push_back(static_cast<uint8_t>(v | 0x80));
+        out.push_back(static_cast<uint8_t>(v));
+      }
+    public:
+      BinaryVec out;
+      void raw(const uint8_t* p, size_t n) { out.insert(out.end(), p, p + n); }
+      void byte(uint8_t b) { out.push_back(b); }
+      void value(uint32_t v) { uleb(v); }
+      // -1は0になる。
+      void optional(uint32_t v) { uleb(static_cast<uint32_t>(v + 1)); }
+      // 多くの命令は直前に作ったレジスタを使うので、差は小さい。
+      void reg(uint32_t v, uint32_t& prev)
+      {
+        const auto delta = static_cast<int64_t>(v) - static_cast<int64_t>(prev);
+        uleb(static_cast<uint64_t>(delta) << 1 ^ static_cast<uint64_t>(delta >> 63));
+        prev = v;
+      }
+      // 命令列の大きさは可変長なので、書き終えてから命令列の前に差し込む。
+      size_t beginCode() { return out.size(); }
+      void endCode(size_t mark)
+      {
+        VarintWriter size;
+        size.value(static_cast<uint32_t>(out.size() - mark));
+        out.insert(out.begin() + mark, size.out.begin(), size.out.end());
+      }
+    };
+    // 何も書かない。読むだけで命令列を検査するのに使う。
+    class NullWriter
+    {
+    public:
+      void raw(const uint8_t*, size_t) {}
+      void byte(uint8_t) {}
+      void value(uint32_t) {}
+      void reg(uint32_t, uint32_t&) {}
+    };
+
+    // レジスタの番号はregTypesの大きさ、関数と文字列の番号はnumOfFnsとnumOfTextsを超えていれば失敗する。
+    template<typename In, typename Out>
+    bool transcodeCode(In& in, Out& out, const std::vector<uint32_t>& regTypes, const std::vector<Type>& types, size_t numOfFns, size_t numOfTexts)
+    {
+      uint32_t inPrev = 0;
+      uint32_t outPrev = 0;
+      bool outOfRange = false;
+      const auto reg = [&] {
+        const auto r = in.reg(inPrev);
+        if(r >= regTypes.size()) outOfRange = true;
+        out.reg(r, outPrev);
+        return r;
+      };
+      const auto typeOf = [&](uint32_t r, Type& type) {
+        if(r >= regTypes.size() || regTypes[r] >= types.size()) return false;
+        type = types[regTypes[r]];
+        return true;
+      };
+      while(!in.atEnd() && !in.failed && !outOfRange) {
+        const auto op = in.byte();
+        out.byte(op);
+        switch(op) {
+          case Add: case Sub: case Mul: case Div: case Mod:
+          case EQ: case NEQ: case GT: case GE: case LT: case LE:
+          case LoadElem: case Phi:
+            reg();
+            reg();
+            reg();
+            break;
+          case Inc: case Dec: case Pos: case Neg:
+          case Alloc: case Mov:
+            reg();
+            reg();
+            break;
+          case Imm: {
+            Type type;
+            if(!typeOf(reg(), type)) return false;
+            const auto n = immSize(type);
+            if(auto imm = in.raw(n)) out.raw(imm, n);
+            break;
+          }
+          case Call: {
+            reg();
+            Type type;
+            if(!typeOf(reg(), type) || !type.isFn()) return false;
+            for(size_t i = 0; i < type.args().size() && !in.failed; ++i) reg();
+            break;
+          }
+          case LoadFn: case LoadArg: case LoadSymbol: case LoadString: {
+            reg();
+            const auto index = in.value();
+            if(op == LoadFn && index >= numOfFns) return false;
+            if((op == LoadSymbol || op == LoadString) && index >= numOfTexts) return false;
+            out.value(index);
+            break;
+          }
+          default:
+            return false;
+        }
+      }
+      return !in.failed && !outOfRange;
+    }
+    // PCIRNormalFunctionとPCIRVarintFunctionは同じ並びなので、読み書きの組を変えるだけで両方向に変換できる。
+    template<typename In, typename Out>
+    bool transcode(In& in, Out& out, const std::vector<Type>& types)
+    {
+      const auto numOfRegs = in.value();
+      // レジスタは少なくとも1バイトある。
+      if(numOfRegs > in.remaining()) return false;
+      out.value(numOfRegs);
+      std::vector<uint32_t> regTypes(numOfRegs);
+      for(auto& type : regTypes) {
+        type = in.value();
+        out.value(type);
+      }
+      const auto numOfFlows = in.value();
+      out.value(numOfFlows);
+      out.value(in.value());
+      for(uint32_t i = 0; i < numOfFlows && !in.failed; ++i) {
+        const auto flowType = in.value();
+        out.value(flowType);
+        out.optional(in.optional());
+        if(flowType & FLOW_TYPE_NORMAL) {
+          out.optional(in.optional());
+        }
+        else if(flowType & FLOW_TYPE_COND_BRANCH) {
+          out.value(in.value());
+          out.value(in.value());
+          out.value(in.value());
+        }
+        else if(flowType & FLOW_TYPE_END_POINT) {
+          out.optional(in.optional());
+        }
+        else {
+          return false;
+        }
+        auto codeIn = in.sub(in.value());
+        const auto mark = out.beginCode();
+        // 関数と文字列の番号は、戻した本体をPCIRLoader::readBodyが検査する。
+        if(!transcodeCode(codeIn, out, regTypes, types, SIZE_MAX, SIZE_MAX)) return false;
+        out.endCode(mark);
+      }
+      return !in.failed && in.atEnd();
+    }
+  }
+  Option<BinaryVec> encodeBody(BinaryView body, const std::vector<Type>& types, uint32_t encoding)
+  {
+    FixedReader in(body);
+    VarintWriter out;
+    // 自分で作った本体だが、compileFunctionと型の表が食い違っていれば変換できない。
+    if(!transcode(in, out, types)) return none;
+    const auto sizeOfVarint = static_cast<uint32_t>(out.out.size());
+    BinaryVec result;
+    if(encoding & PCIR_ENCODING_LZ) {
+      const auto compressed = compressLZ(out.out);
+      result << static_cast<uint32_t>(compressed.size()) << sizeOfVarint << compressed;
+    }
+    else {
+      result << sizeOfVarint << sizeOfVarint << out.out;
+    }
+    return some(std::move(result));
+  }
+  Option<BinaryVec> decodeBody(BinaryView body, size_t sizeOfVarint, const std::vector<Type>& types, uint32_t encoding)
+  {
+    BinaryVec decompressed;
+    if(encoding & PCIR_ENCODING_LZ) {
+      auto res = decompressLZ(body, sizeOfVarint);
+      if(!res) return none;
+      decompressed = std::move(res.get());
+      body = decompressed;
+    }
+    else if(body.size() != sizeOfVarint) {
+      return none;
+    }
+    // 番号は1バイト以上から4バイトになり、命令コードと即値は大きさが変わらないので、固定長は4倍を超えない。
+    VarintReader in(body);
+    FixedWriter out(body.size() * 4);
+    if(!transcode(in, out, types)) return none;
+    return some(out.finish());
+  }
+  bool validateCode(BinaryView code, const std::vector<uint32_t>& regTypes, const std::vector<Type>& types, size_t numOfFns, size_t numOfTexts)
+  {
+    FixedReader in(code);
+    NullWriter out;
+    return transcodeCode(in, out, regTypes, types, numOfFns, numOfTexts);
+  }
+}
\ No newline at end of file
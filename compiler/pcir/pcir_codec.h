@@ -0,0 +1,29 @@
+#ifndef PICKC_PCIR_PCIR_CODEC_H_
+#define PICKC_PCIR_PCIR_CODEC_H_
+
+/**
+ * 関数の本体の符号化。形式はpcir_format.hのPCIREncodedFunctionとPCIRVarintFunctionを参照。
+ * SemanticAnalyzerは固定長の本体を作ってから符号化し、PCIRLoaderは固定長に戻してから読む。
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "type.h"
+#include "utils/binary_vec.h"
+#include "utils/option.h"
+
+namespace pickc::pcir
+{
+  // typesは型の表の番号の順に並べた型。即値の大きさとCallの引数の数を知るのに使う。
+  // 固定長の本体(PCIRNormalFunction)を、encoding(PCIR_ENCODING_*)のPCIREncodedFunctionにする。変換できなければnoneを返す。
+  Option<BinaryVec> encodeBody(BinaryView body, const std::vector<Type>& types, uint32_t encoding);
+  // PCIREncodedFunctionのbodyを固定長の本体に戻す。壊れていればnoneを返す。
+  Option<BinaryVec> decodeBody(BinaryView body, size_t sizeOfVarint, const std::vector<Type>& types, uint32_t encoding);
+  // 固定長のフローの命令列codeを読み、命令コードと即値の大きさ、レジスタと関数と文字列の番号を検査する。
+  // regTypesはレジスタの型の番号。番号が表の大きさを超えていればfalseを返す。
+  bool validateCode(BinaryView code, const std::vector<uint32_t>& regTypes, const std::vector<Type>& types, size_t numOfFns, size_t numOfTexts);
+}
+
+#endif // PICKC_PCIR_PCIR_CODEC_H_
\ No newline at end of file
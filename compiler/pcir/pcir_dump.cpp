@@ -9,12 +9,154 @@
 
 namespace pickc::pcir
 {
-  void dump(const std::string& path)
+  static void dumpSymbol(const PCIRFile& pcir, size_t i)
   {
-    auto res = PCIRLoader().load(path);
-    if(!res) return;
-    auto pcir = res.get();
+    auto symbol = pcir.symbolSection[i];
+    std::cout << "Symbol #" << i << std::endl;
+    std::cout << "    Name:                         " << symbol->name->text.text() << std::endl;
+    std::cout << "    Scope:                        " << (symbol->scope == Scope::Public ? "public" : "private") << std::endl;
+    std::cout << "    Mutability:                   " << (symbol->mut == Mutability::Mutable ? "mutable" : "immutable") << std::endl;
+    std::cout << "    Type:                         " << symbol->type->type.toString() << std::endl;
+    std::cout << "    Init:                         Function #" << indexOf(pcir.fnSection, symbol->init) << std::endl;
+  }
+  // 本体を読めなければ何も表示せずにエラーを返す。
+  static Result<_, std::vector<std::string>> dumpFunction(const PCIRFile& pcir, size_t i)
+  {
+    auto fn = pcir.fnSection[i];
+    std::cout << "Function #" << i << std::endl;
+    std::cout << "    Type:                         " << fn->type->type.toString() << std::endl;
+    std::cout << "    Function Type:                " << (fn->fnType == FN_TYPE_FUNCTION ? "function" : "extern") << std::endl;
+    if(fn->fnType == FN_TYPE_FUNCTION) {
+      // 命令列の番号はloadBodyが表の大きさと照らし合わせてあるので、ここでは調べずに引く。
+      auto body = PCIRLoader::loadBody(pcir, fn);
+      if(!body) return body;
+      std::cout << "    Entry Flow:                   Flow #" << indexOf(fn->flows, fn->entryFlow) << std::endl;
+      std::cout << "    Registers:" << std::endl;
+      for(size_t j = 0, jl = fn->regs.size(); j < jl; ++j) {
+        std::cout << "        Register #" << j << std::endl;
+        std::cout << "            Type:                 " << fn->regs[j]->type->type.toString() << std::endl;
+      }
+      std::cout << "    Flows:" << std::endl;
+      for(size_t j = 0, jl = fn->flows.size(); j < jl; ++j) {
+        auto flow = fn->flows[j];
+        std::cout << "        Flow #" << j << std::endl;
+        std::cout << "            Parent:               ";
+        if(flow->parent == nullptr) std::cout << "none" << std::endl;
+        else std::cout << "Flow #" << indexOf(fn->flows, flow->parent) << std::endl;
+        std::cout << "            Flow Type:            ";
+        if(flow->flowType & FLOW_TYPE_NORMAL) {
+          std::cout << "NORMAL" << std::endl;
+          std::cout << "            Next Flow:            ";
+          if(flow->next == nullptr) std::cout << "none" << std::endl;
+          else std::cout << "Flow #" << indexOf(fn->flows, flow->next) << std::endl;
+        }
+        else if(flow->flowType & FLOW_TYPE_COND_BRANCH) {
+          std::cout << "COND_BRANCH" << std::endl;
+          std::cout << "            Cond:                 Register #" << indexOf(fn->regs, flow->cond) << std::endl;
+          std::cout << "            Then Flow:            Flow #" << indexOf(fn->flows, flow->thenFlow) << std::endl;
+          std::cout << "            Else Flow:            Flow #" << indexOf(fn->flows, flow->elseFlow) << std::endl;
+        }
+        else if(flow->flowType & FLOW_TYPE_END_POINT) {
+          std::cout << "END_POINT" << std::endl;
+          std::cout << "            Return Register:      ";
+          if(flow->retReg != nullptr) std::cout << "#" << indexOf(fn->regs, flow->retReg) << std::endl;
+          else std::cout << "void" << std::endl;
+        }
 
+        std::cout << "            Code:" << std::endl;
+        for(size_t k = 0, kl = flow->code.size(); k < kl; ++k) {
+          const auto binary = [&](const std::string& inst) {
+            std::cout << inst << " #" << get32(flow->code, k) << " #" << get32(flow->code, k) << " #" << get32(flow->code, k) << std::endl;
+          };
+          const auto unary = [&](const std::string& inst) {
+            std::cout << inst << " #" << get32(flow->code, k) << " #" << get32(flow->code, k) << std::endl;
+          };
+          std::cout << "                ";
+          switch(flow->code[k]) {
+            case Add: binary("ADD"); break;
+            case Sub: binary("SUB"); break;
+            case Mul: binary("MUL"); break;
+            case Div: binary("DIV"); break;
+            case Mod: binary("MOD"); break;
+            case Inc: unary("INC"); break;
+            case Dec: unary("DEC"); break;
+            case Pos: unary("POS"); break;
+            case Neg: unary("NEG"); break;
+            case EQ: binary("EQ"); break;
+            case NEQ: binary("NEQ"); break;
+            case GT: binary("GT"); break;
+            case GE: binary("GE"); break;
+            case LT: binary("LT"); break;
+            case LE: binary("LE"); break;
+            case Imm: {
+              auto dist = get32(flow->code, k);
+              std::cout << "IMM #" << dist << " ";
+              switch(fn->regs[dist]->type->types) {
+                case Types::I8:
+                case Types::U8:
+                  std::cout << (int)get8(flow->code, k) << std::endl;
+                  break;
+                case Types::I16:
+                case Types::U16:
+                  std::cout << get16(flow->code, k) << std::endl;
+                  break;
+                case Types::Integer:
+                case Types::I32:
+                case Types::U32:
+                  std::cout << get32(flow->code, k) << std::endl;
+                  break;
+                case Types::I64:
+                case Types::U64:
+                  std::cout << get64(flow->code, k) << std::endl;
+                  break;
+                case Types::Null:
+                  std::cout << "null" << std::endl;
+                  break;
+                case Types::Char:
+                  std::cout << get8(flow->code, k) << std::endl;
+                  break;
+                default:
+                  // 即値を持たない型
+                  std::cout << std::endl;
+                  break;
+              }
+              break;
+            }
+            case Call: {
+              std::cout << "CALL #" << get32(flow->code, k) << " #";
+              auto call = get32(flow->code, k);
+              std::cout << call << " (";
+              auto type = fn->regs[call]->type;
+              assert(type->types == Types::Function);
+              for(size_t arg = 0; arg < type->numOfArgs; ++arg) {
+                std::cout << "#" << get32(flow->code, k);
+                if(arg + 1 < type->numOfArgs) std::cout << " ";
+              }
+              std::cout << ")" << std::endl;
+              break;
+            }
+            case LoadFn: std::cout << "LOADFN Register #" << get32(flow->code, k) << " Function #" << get32(flow->code, k) << std::endl; break;
+            case LoadArg: std::cout << "LOADARG Register #" << get32(flow->code, k) << " Arg #" << get32(flow->code, k) << std::endl; break;
+            case LoadSymbol: std::cout << "LOADSYMBOL Register #" << get32(flow->code, k) << " Symbol " << pcir.textSection[get32(flow->code, k)]->text.text() << std::endl; break;
+            case LoadString: std::cout << "LOADSTRING Register #" << get32(flow->code, k) << " Text #" << get32(flow->code, k) << std::endl; break;
+            case LoadElem: std::cout << "LOADELEM #" << get32(flow->code, k) << " #" << get32(flow->code, k) << "[#" << get32(flow->code, k) << "]" << std::endl; break;
+            case Alloc: std::cout << "ALLOC #" << get32(flow->code, k) << " #" << get32(flow->code, k) << std::endl; break;
+            case Mov: std::cout << "MOV #" << get32(flow->code, k) << " #" << get32(flow->code, k) << std::endl; break;
+            case Phi: std::cout << "Phi #" << get32(flow->code, k) << " #" << get32(flow->code, k) << " #" << get32(flow->code, k) << std::endl; break;
+            default:
+              std::cout << std::hex << std::setw(2) << std::setfill('0') << (int)flow->code[k] << std::endl;
+              break;
+          }
+        }
+      }
+    }
+    else {
+      std::cout << "    Extern Name:                  Text #" << indexOf(pcir.textSection, fn->externName) << std::endl;
+    }
+    return ok();
+  }
+  static Result<_, std::vector<std::string>> dump(const std::string& path, const PCIRFile& pcir)
+  {
     std::cout << "PCIR Dump" << std::endl;
     std::cout << "Dump of file " << path << std::endl;
 
@@ -32,6 +174,13 @@ namespace pickc::pcir
     std::cout << "Pointer to type table header:     " << std::hex << std::setw(8) << std::setfill('0') << pcir.ptrToTypeTableHeader << std::endl;
     std::cout << "Pointer to symbol table header:   " << std::hex << std::setw(8) << std::setfill('0') << pcir.ptrToSymbolTableHeader << std::endl;
     std::cout << "Pointer to function table header: " << std::hex << std::setw(8) << std::setfill('0') << pcir.ptrToFunctionTableHeader << std::endl;
+    if(pcir.minorVersion >= 1) {
+      std::cout << "Pointer to function index header: " << std::hex << std::setw(8) << std::setfill('0') << pcir.ptrToFunctionIndexHeader << std::endl;
+      std::cout << "Pointer to symbol index header:   " << std::hex << std::setw(8) << std::setfill('0') << pcir.ptrToSymbolIndexHeader << std::endl;
+    }
+    if(pcir.minorVersion >= 2) {
+      std::cout << "Encoding:                         " << std::hex << std::setw(8) << std::setfill('0') << pcir.encoding << std::endl;
+    }
     std::cout << '\n';
 
     std::cout << "PCIR TEXT SECTION" << std::endl;
@@ -42,7 +191,7 @@ namespace pickc::pcir
       outStr += std::to_string(i);
       outStr += ":";
       outStr.append(34 - outStr.size(), ' ');
-      std::cout << outStr << pcir.textSection[i]->text << std::endl;
+      std::cout << outStr << pcir.textSection[i]->text.text() << std::endl;
     }
     std::cout << '\n';
 
@@ -51,7 +200,7 @@ namespace pickc::pcir
     for(size_t i = 0, l = pcir.moduleSection.size(); i < l; ++i) {
       auto module = pcir.moduleSection[i];
       std::cout << "Module #" << i << std::endl;
-      std::cout << "    Name:                         " << module->name->text << std::endl;
+      std::cout << "    Name:                         " << module->name->text.text() << std::endl;
       std::cout << "    Symbols:" << std::endl;
       for(size_t j = 0, jl = module->symbols.size(); j < jl; ++j) {
         std::cout << "        Symbol #" << indexOf(pcir.symbolSection, module->symbols[j]) << std::endl;
@@ -69,146 +218,53 @@ namespace pickc::pcir
 
     std::cout << "PCIR SYMBOL SECTION" << std::endl;
     std::cout << "Number of symbols:                " << std::hex << std::setw(8) << std::setfill('0') << pcir.symbolSection.size() << std::endl;
-    for(size_t i = 0, l = pcir.symbolSection.size(); i < l; ++i) {
-      auto symbol = pcir.symbolSection[i];
-      std::cout << "Symbol #" << i << std::endl;
-      std::cout << "    Name:                         " << symbol->name->text << std::endl;
-      std::cout << "    Scope:                        " << (symbol->scope == Scope::Public ? "public" : "private") << std::endl;
-      std::cout << "    Mutability:                   " << (symbol->mut == Mutability::Mutable ? "mutable" : "immutable") << std::endl;
-      std::cout << "    Type:                         " << symbol->type->type.toString() << std::endl;
-      std::cout << "    Init:                         Function #" << indexOf(pcir.fnSection, symbol->init) << std::endl;
-    }
+    for(size_t i = 0, l = pcir.symbolSection.size(); i < l; ++i) dumpSymbol(pcir, i);
     std::cout << '\n';
 
     std::cout << "PCIR FUNCTION SECTION" << std::endl;
     std::cout << "Number of functions:              " << std::hex << std::setw(8) << std::setfill('0') << pcir.fnSection.size() << std::endl;
     for(size_t i = 0, l = pcir.fnSection.size(); i < l; ++i) {
-      auto fn = pcir.fnSection[i];
-      std::cout << "Function #" << i << std::endl;
-      std::cout << "    Type:                         " << fn->type->type.toString() << std::endl;
-      std::cout << "    Function Type:                " << (fn->fnType == FN_TYPE_FUNCTION ? "function" : "extern") << std::endl;
-      if(fn->fnType == FN_TYPE_FUNCTION) {
-        std::cout << "    Entry Flow:                   Flow #" << indexOf(fn->flows, fn->entryFlow) << std::endl;
-        std::cout << "    Registers:" << std::endl;
-        for(size_t j = 0, jl = fn->regs.size(); j < jl; ++j) {
-          std::cout << "        Register #" << j << std::endl;
-          std::cout << "            Type:                 " << fn->regs[j]->type->type.toString() << std::endl;
-        }
-        std::cout << "    Flows:" << std::endl;
-        for(size_t j = 0, jl = fn->flows.size(); j < jl; ++j) {
-          auto flow = fn->flows[j];
-          std::cout << "        Flow #" << j << std::endl;
-          std::cout << "            Parent:               ";
-          if(flow->parent == nullptr) std::cout << "none" << std::endl;
-          else std::cout << "Flow #" << indexOf(fn->flows, flow->parent) << std::endl;
-          std::cout << "            Flow Type:            ";
-          if(flow->flowType & FLOW_TYPE_NORMAL) {
-            std::cout << "NORMAL" << std::endl;
-            std::cout << "            Next Flow:            ";
-            if(flow->next == nullptr) std::cout << "none" << std::endl;
-            else std::cout << "Flow #" << indexOf(fn->flows, flow->next) << std::endl;
-          }
-          else if(flow->flowType & FLOW_TYPE_COND_BRANCH) {
-            std::cout << "COND_BRANCH" << std::endl;
-            std::cout << "            Cond:                 Register #" << indexOf(fn->regs, flow->cond) << std::endl;
-            std::cout << "            Then Flow:            Flow #" << indexOf(fn->flows, flow->thenFlow) << std::endl;
-            std::cout << "            Else Flow:            Flow #" << indexOf(fn->flows, flow->elseFlow) << std::endl;
-          }
-          else if(flow->flowType & FLOW_TYPE_END_POINT) {
-            std::cout << "END_POINT" << std::endl;
-            std::cout << "            Return Register:      ";
-            if(flow->retReg != nullptr) std::cout << "#" << indexOf(fn->regs, flow->retReg) << std::endl;
-            else std::cout << "void" << std::endl;
-          }
-
-          std::cout << "            Code:" << std::endl;
-          for(size_t k = 0, kl = flow->code.size(); k < kl; ++k) {
-            const auto binary = [&](const std::string& inst) {
-              std::cout << inst << " #" << get32(flow->code, k) << " #" << get32(flow->code, k) << " #" << get32(flow->code, k) << std::endl;
-            };
-            const auto unary = [&](const std::string& inst) {
-              std::cout << inst << " #" << get32(flow->code, k) << " #" << get32(flow->code, k) << std::endl;
-            };
-            std::cout << "                ";
-            switch(flow->code[k]) {
-              case Add: binary("ADD"); break;
-              case Sub: binary("SUB"); break;
-              case Mul: binary("MUL"); break;
-              case Div: binary("DIV"); break;
-              case Mod: binary("MOD"); break;
-              case Inc: unary("INC"); break;
-              case Dec: unary("DEC"); break;
-              case Pos: unary("POS"); break;
-              case Neg: unary("NEG"); break;
-              case EQ: binary("EQ"); break;
-              case NEQ: binary("NEQ"); break;
-              case GT: binary("GT"); break;
-              case GE: binary("GE"); break;
-              case LT: binary("LT"); break;
-              case LE: binary("LE"); break;
-              case Imm: {
-                auto dist = get32(flow->code, k);
-                std::cout << "IMM #" << dist << " ";
-                switch(fn->regs[dist]->type->types) {
-                  case Types::I8:
-                  case Types::U8:
-                    std::cout << (int)get8(flow->code, k) << std::endl;
-                    break;
-                  case Types::I16:
-                  case Types::U16:
-                    std::cout << get16(flow->code, k) << std::endl;
-                    break;
-                  case Types::I32:
-                  case Types::U32:
-                    std::cout << get32(flow->code, k) << std::endl;
-                    break;
-                  case Types::I64:
-                  case Types::U64:
-                    std::cout << get64(flow->code, k) << std::endl;
-                    break;
-                  case Types::Null:
-                    std::cout << "null" << std::endl;
-                    break;
-                  case Types::Char:
-                    std::cout << get8(flow->code, k) << std::endl;
-                    break;
-                  default:
-                    assert(false);
-                }
-                break;
-              }
-              case Call: {
-                std::cout << "CALL #" << get32(flow->code, k) << " #";
-                auto call = get32(flow->code, k);
-                std::cout << call << " (";
-                auto type = fn->regs[call]->type;
-                assert(type->types == Types::Function);
-                for(size_t arg = 0; arg < type->numOfArgs; ++arg) {
-                  std::cout << "#" << get32(flow->code, k);
-                  if(arg + 1 < type->numOfArgs) std::cout << " ";
-                }
-                std::cout << ")" << std::endl;
-                break;
-              }
-              case LoadFn: std::cout << "LOADFN Register #" << get32(flow->code, k) << " Function #" << get32(flow->code, k) << std::endl; break;
-              case LoadArg: std::cout << "LOADARG Register #" << get32(flow->code, k) << " Arg #" << get32(flow->code, k) << std::endl; break;
-              case LoadSymbol: std::cout << "LOADSYMBOL Register #" << get32(flow->code, k) << " Symbol " << pcir.textSection[get32(flow->code, k)]->text << std::endl; break;
-              case LoadString: std::cout << "LOADSTRING Register #" << get32(flow->code, k) << " Text #" << get32(flow->code, k) << std::endl; break;
-              case LoadElem: std::cout << "LOADELEM #" << get32(flow->code, k) << " #" << get32(flow->code, k) << "[#" << get32(flow->code, k) << "]" << std::endl; break;
-              case Alloc: std::cout << "ALLOC #" << get32(flow->code, k) << " #" << get32(flow->code, k) << std::endl; break;
-              case Mov: std::cout << "MOV #" << get32(flow->code, k) << " #" << get32(flow->code, k) << std::endl; break;
-              case Phi: std::cout << "Phi #" << get32(flow->code, k) << " #" << get32(flow->code, k) << " #" << get32(flow->code, k) << std::endl; break;
-              default:
-                assert(false);
-                std::cout << std::hex << std::setw(2) << std::setfill('0') << (int)flow->code[k] << std::endl;
-                break;
-            }
-          }
-        }
-      }
-      else {
-        std::cout << "    Extern Name:                  Text #" << indexOf(pcir.textSection, fn->externName) << std::endl;
+      auto res = dumpFunction(pcir, i);
+      if(!res) return res;
+    }
+    return ok();
+  }
+  Option<std::vector<std::string>> dump(const std::string& path)
+  {
+    auto res = PCIRLoader().load(path);
+    if(!res) return some(std::move(res.err()));
+    auto dumped = dump(path, res.get());
+    if(!dumped) return some(std::move(dumped.err()));
+    return none;
+  }
+  void dump(const std::string& path, const BinaryVec& pcir)
+  {
+    auto res = PCIRLoader().load(path, pcir);
+    if(!res) return;
+    dump(path, res.get());
+  }
+  Option<std::vector<std::string>> dumpSymbol(const std::string& path, const std::string& name)
+  {
+    auto res = PCIRLoader().load(path);
+    if(!res) return some(std::move(res.err()));
+    const auto& pcir = res.get();
+    auto symbol = PCIRLoader::findSymbol(pcir, name);
+    if(symbol == nullptr) return some(std::vector{ path + "にシンボル" + name + "はありません。" });
+    std::cout << "PCIR Dump of symbol " << name << " in " << path << std::endl;
+    dumpSymbol(pcir, indexOf(pcir.symbolSection, symbol));
+    auto dumped = dumpFunction(pcir, indexOf(pcir.fnSection, symbol->init));
+    if(!dumped) return some(std::move(dumped.err()));
+    // 関数のシンボルの初期化関数は本体をLoadFnするだけなので、本体も表示する。
+    const auto init = symbol->init;
+    if(init->entryFlow != nullptr && init->entryFlow->code.size() >= 9 && init->entryFlow->code[0] == LoadFn) {
+      size_t i = 0;
+      get32(init->entryFlow->code, i);
+      const auto fn = get32(init->entryFlow->code, i);
+      if(fn < pcir.fnSection.size()) {
+        auto body = dumpFunction(pcir, fn);
+        if(!body) return some(std::move(body.err()));
       }
     }
+    return none;
   }
 }
\ No newline at end of file
@@ -2,10 +2,18 @@
 #define PICKC_PCIR_PCIR_DUMP_H_
 
 #include <string>
+#include <vector>
+
+#include "utils/binary_vec.h"
+#include "utils/option.h"
 
 namespace pickc::pcir
 {
-  void dump(const std::string& path);
+  Option<std::vector<std::string>> dump(const std::string& path);
+  // ファイルに書き出していないPCIRをダンプする。pathは表示にだけ使う。
+  void dump(const std::string& path, const BinaryVec& pcir);
+  // pathのPCIRから完全修飾名がnameのシンボルと、その関数だけをダンプする。ほかの関数の本体は読まない。
+  Option<std::vector<std::string>> dumpSymbol(const std::string& path, const std::string& name);
 }
 
 #endif // PICKC_PCIR_PCIR_DUMP_H_
\ No newline at end of file
@@ -5,6 +5,20 @@
 
 namespace pickc::pcir
 {
+  // PCIRの形式の版。pickcの版とは別に、形式を変えたときに上げる。
+  // 0.0: 索引のない最初の形式
+  // 0.1: 関数の位置の表とシンボル名のハッシュ索引を追加。ヘッダに2つのポインタが増える。
+  // 0.2: 関数の本体の符号化を選べるようにした。ヘッダにencodingが増える。
+  constexpr uint16_t PCIR_MAJOR_VERSION = 0;
+  constexpr uint16_t PCIR_MINOR_VERSION = 2;
+
+  // 関数の本体の番号をLEB128の可変長で書く。PCIRVarintFunctionを参照。
+  constexpr uint32_t PCIR_ENCODING_VARINT = 0x00000001;
+  // 可変長で書いた本体を、さらに関数ごとにLZで圧縮する。PCIR_ENCODING_VARINTと併用する。
+  constexpr uint32_t PCIR_ENCODING_LZ = 0x00000002;
+  // シンボルの索引の空のバケットのindexOfSymbol
+  constexpr uint32_t PCIR_NO_SYMBOL = 0xFFFFFFFF;
+
   constexpr uint32_t ACCESS_PUBLIC    = 0x00000001;
   constexpr uint32_t ACCESS_MUTABLE   = 0x00000002;
   // 符号付き整数型を表す。i8, i16, i32, i64
@@ -55,6 +69,9 @@ namespace pickc::pcir
     uint32_t ptrToTypeTableHeader;        // Pointer to type table header.
     uint32_t ptrToSymbolTableHeader;      // Pointer to symbol table header.
     uint32_t ptrToFunctionTableHeader;    // Pointer to function table header.
+    uint32_t ptrToFunctionIndexHeader;    // Pointer to function index header. Only if minorVersion >= 1.
+    uint32_t ptrToSymbolIndexHeader;      // Pointer to symbol index header. Only if minorVersion >= 1.
+    uint32_t encoding;                    // Encoding of function bodies. PCIR_ENCODING_*. Only if minorVersion >= 2.
   };
   struct PCIRTextHeader
   {
@@ -208,7 +225,8 @@ namespace pickc::pcir
   {
     uint32_t type;                        // Index of type in type section.
     uint32_t fnType;                      // FN_TYPE_*
-    // PCIRNomalFunction nFn;             // fnType == FN_TYPE_FUNCTION
+    // PCIRNomalFunction nFn;             // fnType == FN_TYPE_FUNCTION && encoding == 0
+    // PCIREncodedFunction enFn;          // fnType == FN_TYPE_FUNCTION && encoding != 0
     // PCIRExternFunction eFn;            // fnType == FN_TYPE_EXTERN
   };
   struct PCIRNormalFunction
@@ -223,6 +241,48 @@ namespace pickc::pcir
   {
     uint32_t indexOfName;                 // Index of name in text section.
   };
+  // 符号化した本体。大きさがあるので、ローダーは中身を読まずに次の関数へ進める。
+  struct PCIREncodedFunction
+  {
+    uint32_t sizeOfBody;                  // Size of body.
+    uint32_t sizeOfVarint;                // Size of PCIRVarintFunction. Same as sizeOfBody if not PCIR_ENCODING_LZ.
+    // uint8_t body[sizeOfBody];          // PCIRVarintFunction, compressed if PCIR_ENCODING_LZ.
+  };
+  // PCIRNormalFunctionと同じ並びで、u32の代わりに次のように書く。
+  // - 数、型の番号、フローの番号、フローの種類、命令の関数・引数・テキストの番号はULEB128。
+  // - 親、次のフロー、戻り値のレジスタの番号は-1を0にするために1を足したULEB128。
+  // - sizeOfCodesは可変長にした後の命令列の大きさ。
+  // - 命令のレジスタの番号は、同じフローで直前に書いたレジスタの番号(最初は0)との差をzigzagにしたULEB128。
+  // - 命令コードと即値はそのまま。即値の大きさはPCIRNormalFunctionと同じく書き込み先のレジスタの型で決まる。
+  // LZは、LZ4のブロックと同じく、トークン、リテラル、2バイトのオフセット、一致長を並べたもの。utils/lz.hを参照。
+  struct PCIRVarintFunction
+  {
+    // varuint numOfRegisters;
+    // varuint regs[numOfRegisters];
+    // varuint numOfFlows;
+    // varuint indexOfEntryFlow;
+    // flows[numOfFlows];                 // Same order as PCIRFlow.
+  };
+  // 関数の表は可変長なので、N番目の関数を読むには前の関数をすべて読み飛ばす必要がある。
+  // この表で関数の位置を直接引けるようにする。
+  struct PCIRFunctionIndexHeader
+  {
+    uint32_t numOfFunctions;              // Same as PCIRFunctionTableHeader::numOfFunctions.
+    // uint32_t ptrToFunctions[numOfFunctions]; // Pointer to each PCIRFunction.
+  };
+  // シンボルの完全修飾名(module::name)で引くハッシュ表。線形探査で、numOfBucketsは2の冪。
+  // ハッシュはutils/hash.hのhashBytes(完全修飾名, 0)の下位32bit。
+  struct PCIRSymbolIndexHeader
+  {
+    uint32_t numOfBuckets;                // Number of buckets. 0 if there are no symbols.
+    // PCIRSymbolIndexEntry buckets[numOfBuckets];
+  };
+  struct PCIRSymbolIndexEntry
+  {
+    uint32_t hash;                        // Hash of the qualified name.
+    uint32_t indexOfModule;               // Index of module in module section.
+    uint32_t indexOfSymbol;               // Index of symbol in symbol section. If empty, set it to PCIR_NO_SYMBOL.
+  };
 }
 
 #endif // PICKC_PCIR_PCIR_FORMAT_H_
\ No newline at end of file
@@ -1,51 +1,141 @@
 #include "pcir_struct.h"
 
-#include <fstream>
+#include <cstring>
+#include <functional>
 
 #include "pcir_format.h"
+#include "pcir_codec.h"
+#include "utils/hash.h"
 
 namespace pickc::pcir
 {
-  PCIRLoader::PCIRLoader() {}
+  namespace
+  {
+    // nameがAtom::join(module, symbol)と同じ文字列か。探すたびにInternerに登録しないように、文字列のまま比べる。
+    bool isQualifiedName(std::string_view name, Atom module, Atom symbol)
+    {
+      const auto scope = module.text();
+      const auto local = symbol.text();
+      return name.size() == scope.size() + 2 + local.size()
+        && name.compare(0, scope.size(), scope) == 0
+        && name.compare(scope.size(), 2, "::") == 0
+        && name.compare(scope.size() + 2, local.size(), local) == 0;
+    }
+  }
+  PCIRLoader::PCIRLoader() : data(nullptr), size(0), cursor(0), overrun(false), outOfRange(false) {}
+  void PCIRLoader::read(void* dst, size_t n)
+  {
+    if(cursor + n > size) {
+      std::memset(dst, 0, n);
+      cursor = size;
+      overrun = true;
+      return;
+    }
+    std::memcpy(dst, data + cursor, n);
+    cursor += n;
+  }
+  void PCIRLoader::seek(size_t pos)
+  {
+    if(pos > size) {
+      cursor = size;
+      overrun = true;
+    }
+    else cursor = pos;
+  }
+  const uint8_t* PCIRLoader::skip(size_t n)
+  {
+    if(n > size - cursor) {
+      cursor = size;
+      overrun = true;
+      return nullptr;
+    }
+    auto head = data + cursor;
+    cursor += n;
+    return head;
+  }
+  template<typename T>
+  T* PCIRLoader::at(const std::vector<T*>& table, uint32_t index)
+  {
+    if(index >= table.size()) {
+      outOfRange = true;
+      return nullptr;
+    }
+    return table[index];
+  }
   Result<PCIRFile, std::vector<std::string>> PCIRLoader::load(const std::string& path)
   {
-    std::ifstream stream(path, std::ios::binary);
-    if(!stream) return error(std::vector{ "ファイル " + path + " が開けません。" });
+    auto mapped = MappedFile::open(path);
+    if(!mapped) return error(std::vector{ "ファイル " + path + " が開けません。" });
+    file.mapped = std::make_shared<MappedFile>(std::move(mapped.get()));
+    return load(path, reinterpret_cast<const uint8_t*>(file.mapped->data()), file.mapped->size());
+  }
+  Result<PCIRFile, std::vector<std::string>> PCIRLoader::load(const std::string& path, const BinaryVec& pcir)
+  {
+    return load(path, pcir.data(), pcir.size());
+  }
+  Result<PCIRFile, std::vector<std::string>> PCIRLoader::load(const std::string& path, const uint8_t* pcir, size_t length)
+  {
+    data = pcir;
+    size = length;
+    cursor = 0;
+    overrun = false;
+    outOfRange = false;
+    file.data = pcir;
+    file.size = length;
+    file.path = path;
 
-    stream.read(file.magic, 4);
+    read(file.magic, 4);
     if(file.magic[0] != 'P' || file.magic[1] != 'C' || file.magic[2] != 'I' || file.magic[3] != 'R') {
       return error(std::vector{ path + "はPCIRファイルではありません。" });
     }
 
-    stream.read((char*)&file.timeStamp, 8);
-    stream.read((char*)&file.majorVersion, 2);
-    stream.read((char*)&file.minorVersion, 2);
+    read(&file.timeStamp, 8);
+    read(&file.majorVersion, 2);
+    read(&file.minorVersion, 2);
 
-    stream.read((char*)&file.ptrToTextHeader, 4);
-    stream.read((char*)&file.ptrToModuleHeader, 4);
-    stream.read((char*)&file.ptrToTypeTableHeader, 4);
-    stream.read((char*)&file.ptrToSymbolTableHeader, 4);
-    stream.read((char*)&file.ptrToFunctionTableHeader, 4);
+    read(&file.ptrToTextHeader, 4);
+    read(&file.ptrToModuleHeader, 4);
+    read(&file.ptrToTypeTableHeader, 4);
+    read(&file.ptrToSymbolTableHeader, 4);
+    read(&file.ptrToFunctionTableHeader, 4);
+    if(file.majorVersion > PCIR_MAJOR_VERSION) {
+      return error(std::vector{ path + "は対応していない版のPCIRファイルです。" });
+    }
+    file.ptrToFunctionIndexHeader = 0;
+    file.ptrToSymbolIndexHeader = 0;
+    file.encoding = 0;
+    if(file.minorVersion >= 1) {
+      read(&file.ptrToFunctionIndexHeader, 4);
+      read(&file.ptrToSymbolIndexHeader, 4);
+    }
+    if(file.minorVersion >= 2) read(&file.encoding, 4);
+    if(file.encoding != 0 && file.encoding != PCIR_ENCODING_VARINT && file.encoding != (PCIR_ENCODING_VARINT | PCIR_ENCODING_LZ)) {
+      return error(std::vector{ path + "は対応していない符号化のPCIRファイルです。" });
+    }
 
-    stream.seekg(file.ptrToTextHeader, std::ios::beg);
+    seek(file.ptrToTextHeader);
     uint32_t numOfTexts;
-    stream.read((char*)&numOfTexts, 4);
+    read(&numOfTexts, 4);
+    // テキストはバイト列を指したままInternerに登録する。TextSectionは1度にまとめて確保する。
+    if(numOfTexts > (size - cursor) / 4) return error(std::vector{ path + "は適切なPCIRファイルではありません。ファイルが途中で終わっています。" });
+    auto texts = new TextSection[numOfTexts];
+    file.textSection.reserve(numOfTexts);
     for(uint32_t i = 0; i < numOfTexts; ++i) {
       uint32_t sizeOfText;
-      stream.read((char*)&sizeOfText, 4);
-      auto text = new char[sizeOfText];
-      stream.read(text, sizeOfText);
-      file.textSection.push_back(new TextSection{ std::string(text, sizeOfText) });
-      delete text;
+      read(&sizeOfText, 4);
+      auto text = skip(sizeOfText);
+      if(text == nullptr) break;
+      texts[i].text = Atom::intern(std::string_view(reinterpret_cast<const char*>(text), sizeOfText));
+      file.textSection.push_back(&texts[i]);
     }
 
-    stream.seekg(file.ptrToTypeTableHeader, std::ios::beg);
+    seek(file.ptrToTypeTableHeader);
     uint32_t numOfTypes;
-    stream.read((char*)&numOfTypes, 4);
-    for(uint32_t i = 0; i < numOfTypes; ++i) {
+    read(&numOfTypes, 4);
+    for(uint32_t i = 0; i < numOfTypes && !overrun; ++i) {
       uint32_t flag, sizeOfType;
-      stream.read((char*)&flag, 4);
-      stream.read((char*)&sizeOfType, 4);
+      read(&flag, 4);
+      read(&sizeOfType, 4);
       if(flag == TYPE_SIGNED_INTEGER) {
         Types type;
         switch(sizeOfType) {
@@ -91,144 +181,107 @@ namespace pickc::pcir
       }
       else if(flag == TYPE_ARRAY) {
         auto array = new TypeSection{ Types::Array };
-        stream.read((char*)&array->indexOfElem, 4);
-        stream.read((char*)&array->elemLength, 4);
+        read(&array->indexOfElem, 4);
+        read(&array->elemLength, 4);
         file.typeSection.push_back(array);
       }
       else if(flag == TYPE_PTR) {
         auto ptr = new TypeSection{ Types::Ptr };
-        stream.read((char*)&ptr->indexOfElem, 4);
+        read(&ptr->indexOfElem, 4);
         file.typeSection.push_back(ptr);
       }
       else if(flag == TYPE_FUNCTION) {
         auto fn = new TypeSection{ Types::Function };
-        stream.read((char*)&fn->indexOfRet, 4);
-        stream.read((char*)&fn->numOfArgs, 4);
-        for(uint32_t j = 0; j < fn->numOfArgs; ++j) {
+        read(&fn->indexOfRet, 4);
+        read(&fn->numOfArgs, 4);
+        for(uint32_t j = 0; j < fn->numOfArgs && !overrun; ++j) {
           uint32_t indexOfArgType;
-          stream.read((char*)&indexOfArgType, 4);
+          read(&indexOfArgType, 4);
           fn->indexOfArgs.push_back(indexOfArgType);
         }
         file.typeSection.push_back(fn);
       }
       else {
-        assert(false);
+        return error(std::vector{ path + "は適切なPCIRファイルではありません。型の種類が予期しないものでした。" });
       }
     }
-    for(auto& type : file.typeSection) {
+    // 型は文字列の順に並んでいるので、要素の型が後ろにあることもある。要素の型から先にTypeContextに登録する。
+    std::vector<bool> resolved(file.typeSection.size(), false);
+    bool invalidType = false;
+    std::function<Type(uint32_t)> resolve = [&](uint32_t index) {
+      if(index >= file.typeSection.size()) {
+        invalidType = true;
+        return Type(Types::Void);
+      }
+      auto type = file.typeSection[index];
+      if(resolved[index]) return type->type;
+      // 自分自身を要素に持つ不正な型で止まらないように、先に印を付けておく。
+      resolved[index] = true;
       switch(type->types) {
-        case Types::Array: {
-          TypeArray array;
-          array.elem = &file.typeSection[type->indexOfElem]->type;
-          array.length = type->elemLength;
-          type->type = Type(array);
+        case Types::Array:
+          type->type = Type::array(resolve(type->indexOfElem), type->elemLength);
           break;
-        }
-        case Types::Ptr: {
-          TypePtr ptr;
-          ptr.elem = &file.typeSection[type->indexOfElem]->type;
-          type->type = Type(ptr);
+        case Types::Ptr:
+          type->type = Type::ptr(resolve(type->indexOfElem));
           break;
-        }
         case Types::Function: {
-          TypeFunction fn;
-          fn.retType = &file.typeSection[type->indexOfRet]->type;
-          for(auto arg : type->indexOfArgs) {
-            fn.args.push_back(&file.typeSection[arg]->type);
-          }
-          type->type = Type(fn);
+          std::vector<Type> args;
+          for(auto arg : type->indexOfArgs) args.push_back(resolve(arg));
+          type->type = Type::fn(resolve(type->indexOfRet), std::move(args));
           break;
         }
+        default:
+          break;
       }
-    }
+      return type->type;
+    };
+    for(uint32_t i = 0; i < file.typeSection.size(); ++i) resolve(i);
+    if(invalidType) return error(std::vector{ path + "は適切なPCIRファイルではありません。型の番号が型の数を超えています。" });
+    file.types.reserve(file.typeSection.size());
+    for(auto type : file.typeSection) file.types.push_back(type->type);
 
-    stream.seekg(file.ptrToFunctionTableHeader, std::ios::beg);
+    seek(file.ptrToFunctionTableHeader);
     uint32_t numOfFunctions;
-    stream.read((char*)&numOfFunctions, 4);
-    for(uint32_t i = 0; i < numOfFunctions; ++i) {
+    read(&numOfFunctions, 4);
+    // 関数の位置の表があれば、前の関数を読み飛ばさずに各関数の先頭へ移る。
+    size_t ptrToFunctions = 0;
+    if(file.ptrToFunctionIndexHeader != 0) {
+      seek(file.ptrToFunctionIndexHeader);
+      uint32_t numOfIndices;
+      read(&numOfIndices, 4);
+      if(numOfIndices != numOfFunctions) {
+        return error(std::vector{ path + "は適切なPCIRファイルではありません。関数の位置の表が関数の表と一致しません。" });
+      }
+      ptrToFunctions = cursor;
+      if(skip(static_cast<size_t>(numOfIndices) * 4) == nullptr) {
+        return error(std::vector{ path + "は適切なPCIRファイルではありません。ファイルが途中で終わっています。" });
+      }
+    }
+    for(uint32_t i = 0; i < numOfFunctions && !overrun; ++i) {
+      if(ptrToFunctions != 0) {
+        seek(ptrToFunctions + static_cast<size_t>(i) * 4);
+        uint32_t ptrToFunction;
+        read(&ptrToFunction, 4);
+        seek(ptrToFunction);
+      }
       auto fn = new FunctionSection();
       uint32_t type;
-      stream.read((char*)&type, 4);
-      fn->type = file.typeSection[type];
+      read(&type, 4);
+      fn->type = at(file.typeSection, type);
       uint32_t fnType;
-      stream.read((char*)&fnType, 4);
+      read(&fnType, 4);
       fn->fnType = fnType;
       if(fn->fnType == FN_TYPE_FUNCTION) {
-        uint32_t numOfRegs;
-        stream.read((char*)&numOfRegs, 4);
-        fn->regs.reserve(numOfRegs);
-        for(uint32_t j = 0; j < numOfRegs; ++j) {
-          uint32_t type;
-          stream.read((char*)&type, 4);
-          fn->regs.push_back(new RegisterStruct{ file.typeSection[type] });
-        }
-        uint32_t numFlows;
-        stream.read((char*)&numFlows, 4);
-        uint32_t entryFlow;
-        stream.read((char*)&entryFlow, 4);
-        fn->flows.reserve(numFlows);
-        for(uint32_t j = 0; j < numFlows; ++j) {
-          fn->flows.push_back(new FlowStruct());
-        }
-        for(auto& flow : fn->flows) {
-          stream.read((char*)&flow->flowType, 4);
-          uint32_t indexOfParentFlow;
-          stream.read((char*)&indexOfParentFlow, 4);
-          if(indexOfParentFlow == -1) {
-            flow->parent = nullptr;
-          }
-          else {
-            flow->parent = fn->flows[indexOfParentFlow];
-          }
-          if(flow->flowType & FLOW_TYPE_NORMAL) {
-            uint32_t indexOfNextFlow;
-            stream.read((char*)&indexOfNextFlow, 4);
-            if(indexOfNextFlow == -1) {
-              flow->next = nullptr;
-            }
-            else {
-              flow->next = fn->flows[indexOfNextFlow];
-            }
-          }
-          else if(flow->flowType & FLOW_TYPE_COND_BRANCH) {
-            uint32_t indexOfComp;
-            stream.read((char*)&indexOfComp, 4);
-            uint32_t indexOfThenFlow;
-            stream.read((char*)&indexOfThenFlow, 4);
-            uint32_t indexOfElseFlow;
-            stream.read((char*)&indexOfElseFlow, 4);
-            flow->cond = fn->regs[indexOfComp];
-            flow->thenFlow = fn->flows[indexOfThenFlow];
-            flow->elseFlow = fn->flows[indexOfElseFlow];
-          }
-          else if(flow->flowType & FLOW_TYPE_END_POINT) {
-            uint32_t indexOfRetReg;
-            stream.read((char*)&indexOfRetReg, 4);
-            if(indexOfRetReg == -1) {
-              flow->retReg = nullptr;
-            }
-            else {
-              flow->retReg = fn->regs[indexOfRetReg];
-            }
-          }
-          else {
-            assert(false);
-            return error(std::vector{ path + "は適切なPCIRファイルではありません。FLOW_TYPEが予期しないものでした。" });
-          }
-          uint32_t sizeOfCodes;
-          stream.read((char*)&sizeOfCodes, 4);
-          auto code = new uint8_t[sizeOfCodes];
-          stream.read((char*)code, sizeOfCodes);
-          flow->code.reserve(sizeOfCodes);
-          flow->code.insert(flow->code.end(), code, code + sizeOfCodes);
-          delete[] code;
+        // 本体はloadBodyで読むので、ここでは位置だけを覚える。位置の表がなければ次の関数まで読み飛ばす。
+        fn->ptrToBody = static_cast<uint32_t>(cursor);
+        if(ptrToFunctions == 0 && !skipBody()) {
+          return error(std::vector{ path + "は適切なPCIRファイルではありません。FLOW_TYPEが予期しないものでした。" });
         }
-        fn->entryFlow = fn->flows[entryFlow];
       }
       else if(fn->fnType == FN_TYPE_EXTERN) {
         uint32_t name;
-        stream.read((char*)&name, 4);
-        fn->externName = file.textSection[name];
+        read(&name, 4);
+        fn->externName = at(file.textSection, name);
       }
       else {
         return error(std::vector{ path + "は適切なPCIRファイルではありません。FN_TYPEが予期しないものでした。" });
@@ -236,38 +289,238 @@ namespace pickc::pcir
       file.fnSection.push_back(fn);
     }
 
-    stream.seekg(file.ptrToSymbolTableHeader, std::ios::beg);
+    seek(file.ptrToSymbolTableHeader);
     uint32_t numOfSymbols;
-    stream.read((char*)&numOfSymbols, 4);
-    for(uint32_t i = 0; i < numOfSymbols; ++i) {
+    read(&numOfSymbols, 4);
+    for(uint32_t i = 0; i < numOfSymbols && !overrun; ++i) {
       PCIRSymbol symbol;
-      stream.read((char*)&symbol, sizeof(PCIRSymbol));
+      read(&symbol, sizeof(PCIRSymbol));
       file.symbolSection.push_back(new SymbolSection{
-        file.textSection[symbol.name],
+        at(file.textSection, symbol.name),
         (symbol.access & ACCESS_PUBLIC) ? Scope::Public : Scope::Private,
         (symbol.access & ACCESS_MUTABLE) ? Mutability::Mutable : Mutability::Immutable,
-        file.typeSection[symbol.type],
-        file.fnSection[symbol.init],
+        at(file.typeSection, symbol.type),
+        at(file.fnSection, symbol.init),
       });
     }
 
-    stream.seekg(file.ptrToModuleHeader, std::ios::beg);
+    seek(file.ptrToModuleHeader);
     uint32_t numOfModules;
-    stream.read((char*)&numOfModules, 4);
-    for(uint32_t i = 0; i < numOfModules; ++i) {
+    read(&numOfModules, 4);
+    for(uint32_t i = 0; i < numOfModules && !overrun; ++i) {
       auto module = new ModuleSection();
       uint32_t indexOfName, numOfModuleSymbols;
-      stream.read((char*)&indexOfName, 4);
-      stream.read((char*)&numOfModuleSymbols, 4);
-      module->name = file.textSection[indexOfName];
-      for(uint32_t j = 0; j < numOfModuleSymbols; ++j) {
+      read(&indexOfName, 4);
+      read(&numOfModuleSymbols, 4);
+      module->name = at(file.textSection, indexOfName);
+      for(uint32_t j = 0; j < numOfModuleSymbols && !overrun; ++j) {
         uint32_t indexOfSymbol;
-        stream.read((char*)&indexOfSymbol, 4);
-        module->symbols.push_back(file.symbolSection[indexOfSymbol]);
+        read(&indexOfSymbol, 4);
+        module->symbols.push_back(at(file.symbolSection, indexOfSymbol));
       }
       file.moduleSection.push_back(module);
     }
 
-    return ok(file);
+    if(overrun) return error(std::vector{ path + "は適切なPCIRファイルではありません。ファイルが途中で終わっています。" });
+    if(outOfRange) return error(std::vector{ path + "は適切なPCIRファイルではありません。番号が表の大きさを超えています。" });
+    return ok(std::move(file));
+  }
+  bool PCIRLoader::skipBody()
+  {
+    if(file.encoding != 0) {
+      uint32_t sizeOfBody;
+      read(&sizeOfBody, 4);
+      skip(4);
+      skip(sizeOfBody);
+      return true;
+    }
+    uint32_t numOfRegs;
+    read(&numOfRegs, 4);
+    skip(static_cast<size_t>(numOfRegs) * 4);
+    uint32_t numFlows;
+    read(&numFlows, 4);
+    skip(4);
+    for(uint32_t i = 0; i < numFlows && !overrun; ++i) {
+      uint32_t flowType;
+      read(&flowType, 4);
+      skip(4);
+      if(flowType & FLOW_TYPE_NORMAL) skip(4);
+      else if(flowType & FLOW_TYPE_COND_BRANCH) skip(12);
+      else if(flowType & FLOW_TYPE_END_POINT) skip(4);
+      else return false;
+      uint32_t sizeOfCodes;
+      read(&sizeOfCodes, 4);
+      skip(sizeOfCodes);
+    }
+    return true;
+  }
+  Result<_, std::vector<std::string>> PCIRLoader::loadBody(const PCIRFile& file, FunctionSection* fn)
+  {
+    if(fn->fnType != FN_TYPE_FUNCTION || fn->bodyLoaded) return ok();
+    PCIRLoader loader;
+    loader.data = file.data;
+    loader.size = file.size;
+    if(file.encoding == 0) return loader.readBody(file, fn, fn->ptrToBody);
+    // 符号化した本体は固定長に戻し、その上で固定長と同じように読む。
+    loader.seek(fn->ptrToBody);
+    uint32_t sizeOfBody, sizeOfVarint;
+    loader.read(&sizeOfBody, 4);
+    loader.read(&sizeOfVarint, 4);
+    auto body = loader.skip(sizeOfBody);
+    if(body == nullptr) return error(std::vector{ file.path + "は適切なPCIRファイルではありません。ファイルが途中で終わっています。" });
+    auto decoded = decodeBody(BinaryView(body, sizeOfBody), sizeOfVarint, file.types, file.encoding);
+    if(!decoded) return error(std::vector{ file.path + "は適切なPCIRファイルではありません。関数の本体を復号できません。" });
+    fn->decodedBody = std::move(decoded.get());
+    PCIRLoader decodedLoader;
+    decodedLoader.data = fn->decodedBody.data();
+    decodedLoader.size = fn->decodedBody.size();
+    return decodedLoader.readBody(file, fn, 0);
+  }
+  SymbolSection* PCIRLoader::findSymbol(const PCIRFile& file, std::string_view name)
+  {
+    if(file.ptrToSymbolIndexHeader == 0) {
+      for(auto module : file.moduleSection) {
+        for(auto symbol : module->symbols) {
+          if(isQualifiedName(name, module->name->text, symbol->name->text)) return symbol;
+        }
+      }
+      return nullptr;
+    }
+    PCIRLoader loader;
+    loader.data = file.data;
+    loader.size = file.size;
+    loader.seek(file.ptrToSymbolIndexHeader);
+    uint32_t numOfBuckets;
+    loader.read(&numOfBuckets, 4);
+    if(numOfBuckets == 0 || (numOfBuckets & (numOfBuckets - 1)) != 0) return nullptr;
+    const auto ptrToBuckets = loader.cursor;
+    const auto hash = static_cast<uint32_t>(hashBytes(name));
+    for(uint32_t probe = 0; probe < numOfBuckets && !loader.overrun; ++probe) {
+      loader.seek(ptrToBuckets + static_cast<size_t>((hash + probe) & (numOfBuckets - 1)) * sizeof(PCIRSymbolIndexEntry));
+      PCIRSymbolIndexEntry entry;
+      loader.read(&entry, sizeof(PCIRSymbolIndexEntry));
+      if(entry.indexOfSymbol == PCIR_NO_SYMBOL) return nullptr;
+      if(entry.hash != hash) continue;
+      auto module = loader.at(file.moduleSection, entry.indexOfModule);
+      auto symbol = loader.at(file.symbolSection, entry.indexOfSymbol);
+      if(module != nullptr && symbol != nullptr && isQualifiedName(name, module->name->text, symbol->name->text)) return symbol;
+    }
+    return nullptr;
+  }
+  Result<_, std::vector<std::string>> PCIRLoader::readBody(const PCIRFile& file, FunctionSection* fn, size_t pos)
+  {
+    seek(pos);
+    uint32_t numOfRegs;
+    read(&numOfRegs, 4);
+    if(numOfRegs > (size - cursor) / 4) {
+      return error(std::vector{ file.path + "は適切なPCIRファイルではありません。ファイルが途中で終わっています。" });
+    }
+    fn->regs.reserve(numOfRegs);
+    std::vector<uint32_t> regTypes(numOfRegs);
+    for(auto& type : regTypes) {
+      read(&type, 4);
+      fn->regs.push_back(new RegisterStruct{ at(file.typeSection, type) });
+    }
+    uint32_t numFlows;
+    read(&numFlows, 4);
+    uint32_t entryFlow;
+    read(&entryFlow, 4);
+    // フローは少なくとも16バイトある。
+    if(numFlows > (size - cursor) / 16) {
+      fn->releaseBody();
+      return error(std::vector{ file.path + "は適切なPCIRファイルではありません。ファイルが途中で終わっています。" });
+    }
+    fn->flows.reserve(numFlows);
+    for(uint32_t j = 0; j < numFlows; ++j) {
+      fn->flows.push_back(new FlowStruct());
+    }
+    for(auto& flow : fn->flows) {
+      read(&flow->flowType, 4);
+      uint32_t indexOfParentFlow;
+      read(&indexOfParentFlow, 4);
+      if(indexOfParentFlow == -1) {
+        flow->parent = nullptr;
+      }
+      else {
+        flow->parent = at(fn->flows, indexOfParentFlow);
+      }
+      if(flow->flowType & FLOW_TYPE_NORMAL) {
+        uint32_t indexOfNextFlow;
+        read(&indexOfNextFlow, 4);
+        if(indexOfNextFlow == -1) {
+          flow->next = nullptr;
+        }
+        else {
+          flow->next = at(fn->flows, indexOfNextFlow);
+        }
+      }
+      else if(flow->flowType & FLOW_TYPE_COND_BRANCH) {
+        uint32_t indexOfComp;
+        read(&indexOfComp, 4);
+        uint32_t indexOfThenFlow;
+        read(&indexOfThenFlow, 4);
+        uint32_t indexOfElseFlow;
+        read(&indexOfElseFlow, 4);
+        flow->cond = at(fn->regs, indexOfComp);
+        flow->thenFlow = at(fn->flows, indexOfThenFlow);
+        flow->elseFlow = at(fn->flows, indexOfElseFlow);
+      }
+      else if(flow->flowType & FLOW_TYPE_END_POINT) {
+        uint32_t indexOfRetReg;
+        read(&indexOfRetReg, 4);
+        if(indexOfRetReg == -1) {
+          flow->retReg = nullptr;
+        }
+        else {
+          flow->retReg = at(fn->regs, indexOfRetReg);
+        }
+      }
+      else {
+        fn->releaseBody();
+        return error(std::vector{ file.path + "は適切なPCIRファイルではありません。FLOW_TYPEが予期しないものでした。" });
+      }
+      uint32_t sizeOfCodes;
+      read(&sizeOfCodes, 4);
+      // 命令列はコピーせず、バイト列を指す。
+      if(auto code = skip(sizeOfCodes)) flow->code = BinaryView(code, sizeOfCodes);
+    }
+    fn->entryFlow = at(fn->flows, entryFlow);
+    if(overrun || outOfRange) {
+      fn->releaseBody();
+      if(overrun) return error(std::vector{ file.path + "は適切なPCIRファイルではありません。ファイルが途中で終わっています。" });
+      return error(std::vector{ file.path + "は適切なPCIRファイルではありません。番号が表の大きさを超えています。" });
+    }
+    // 命令列の番号はダンプとバンドラが検査せずに使うので、ここで一度読んで確かめる。
+    for(auto flow : fn->flows) {
+      if(!validateCode(flow->code, regTypes, file.types, file.fnSection.size(), file.textSection.size())) {
+        fn->releaseBody();
+        return error(std::vector{ file.path + "は適切なPCIRファイルではありません。命令列が壊れています。" });
+      }
+    }
+    fn->bodyLoaded = true;
+    return ok();
+  }
+  void FunctionSection::releaseBody()
+  {
+    for(auto reg : regs) delete reg;
+    for(auto flow : flows) delete flow;
+    regs = std::vector<RegisterStruct*>();
+    flows = std::vector<FlowStruct*>();
+    entryFlow = nullptr;
+    decodedBody = BinaryVec();
+    bodyLoaded = false;
+  }
+  std::string PCIRUnit::fileName(const std::string& out) const
+  {
+    if(name.empty()) return out + ".pcir";
+    std::string res = out + '.';
+    for(size_t i = 0; i < name.size(); ++i) {
+      if(name.compare(i, 2, "::") == 0) {
+        res += '.';
+        ++i;
+      }
+      else res += name[i];
+    }
+    return res + ".pcir";
   }
 }
\ No newline at end of file
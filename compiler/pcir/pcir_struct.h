@@ -8,16 +8,20 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include <memory>
 
 #include "pcir.h"
 #include "utils/result.h"
 #include "utils/binary_vec.h"
+#include "utils/mapped_file.h"
 
 namespace pickc::pcir
 {
   struct TextSection
   {
-    std::string text;
+    // 読み込むときにInternerに登録する。
+    Atom text;
   };
   struct TypeSection
   {
@@ -42,16 +46,25 @@ namespace pickc::pcir
     FlowStruct* thenFlow;
     FlowStruct* elseFlow;
     RegisterStruct* retReg;
-    BinaryVec code;
+    // PCIRFileのバイト列の中の命令列を指す。本体を符号化したPCIRでは、FunctionSection::decodedBodyの中を指す。
+    BinaryView code;
   };
   struct FunctionSection
   {
     TypeSection* type;
     uint32_t fnType;
     TextSection* externName;
+    // 本体のレジスタとフローは、PCIRLoader::loadBodyで読み込むまで空。
     std::vector<RegisterStruct*> regs;
     std::vector<FlowStruct*> flows;
     FlowStruct* entryFlow;
+    // PCIRファイルの中での本体の位置
+    uint32_t ptrToBody;
+    bool bodyLoaded;
+    // 本体を符号化したPCIRで、loadBodyが固定長に戻した本体。
+    BinaryVec decodedBody;
+    // 本体のレジスタとフローを解放する。バンドラが命令列に変換した後は参照しない。
+    void releaseBody();
   };
   struct SymbolSection
   {
@@ -77,18 +90,67 @@ namespace pickc::pcir
     uint32_t ptrToTypeTableHeader;
     uint32_t ptrToSymbolTableHeader;
     uint32_t ptrToFunctionTableHeader;
+    // 0.1以降の形式にだけある。古い形式では0。
+    uint32_t ptrToFunctionIndexHeader;
+    uint32_t ptrToSymbolIndexHeader;
+    // 0.2以降の形式にだけある。古い形式では0。PCIR_ENCODING_*
+    uint32_t encoding;
     std::vector<TextSection*> textSection;
     std::vector<TypeSection*> typeSection;
     std::vector<SymbolSection*> symbolSection;
     std::vector<FunctionSection*> fnSection;
     std::vector<ModuleSection*> moduleSection;
+    // typeSectionの型を番号の順に並べたもの。符号化した本体を戻すのに使う。
+    std::vector<Type> types;
+    // 読み込んだPCIRのバイト列。関数の本体はここから必要になったときに読む。
+    // ファイルから読み込んだときはマップしたファイルを持つ。メモリ上のバイト列から読み込んだときは、呼び出し側がバイト列を持ち続けること。
+    std::shared_ptr<MappedFile> mapped;
+    const uint8_t* data;
+    size_t size;
+    std::string path;
+  };
+  // SemanticAnalyzerが作ったPCIRのバイト列。
+  // nameはモジュールごとに作ったときはモジュールの完全修飾名、プログラム全体を1つにまとめたときは空。
+  struct PCIRUnit
+  {
+    std::string name;
+    BinaryVec binary;
+    // --emit-pcirで書き出すときのファイル名。モジュールごとなら<out>.<モジュール名>.pcirとし、::は.に置き換える。
+    std::string fileName(const std::string& out) const;
   };
   class PCIRLoader
   {
     PCIRFile file;
+    // 読み込み中のPCIRのバイト列。範囲外を読もうとしたときはoverrunを立てて0を返す。
+    const uint8_t* data;
+    size_t size;
+    size_t cursor;
+    bool overrun;
+    // 番号が表の大きさを超えていたときに立てる。
+    bool outOfRange;
+    void read(void* dst, size_t n);
+    void seek(size_t pos);
+    // nバイトを読み飛ばし、その先頭を返す。範囲外ならoverrunを立ててnullptrを返す。
+    const uint8_t* skip(size_t n);
+    // 範囲外ならoutOfRangeを立ててnullptrを返す。
+    template<typename T>
+    T* at(const std::vector<T*>& table, uint32_t index);
+    // 関数の本体を、中身を作らずに読み飛ばす。
+    bool skipBody();
+    // posから固定長の本体を読む。
+    Result<_, std::vector<std::string>> readBody(const PCIRFile& file, FunctionSection* fn, size_t pos);
+    Result<PCIRFile, std::vector<std::string>> load(const std::string& path, const uint8_t* pcir, size_t length);
   public:
     PCIRLoader();
+    // ファイルをメモリにマップして読み込む。
     Result<PCIRFile, std::vector<std::string>> load(const std::string& path);
+    // SemanticAnalyzerがメモリ上に作ったPCIRを読み込む。pathはエラーメッセージにだけ使う。
+    Result<PCIRFile, std::vector<std::string>> load(const std::string& path, const BinaryVec& pcir);
+    // loadはテキスト、型、シンボル、モジュールと関数の型だけを読む。
+    // 関数の本体は、使う側が初めて必要になったときにこれで読み込む。読み込み済みなら何もしない。
+    static Result<_, std::vector<std::string>> loadBody(const PCIRFile& file, FunctionSection* fn);
+    // 完全修飾名(module::name)でシンボルを探す。索引があればハッシュで引き、なければモジュールを順に探す。
+    static SymbolSection* findSymbol(const PCIRFile& file, std::string_view name);
   };
 }
 
@@ -5,49 +5,334 @@
 #include <fstream>
 #include <filesystem>
 #include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <functional>
 
 #include "pickc/config.h"
 #include "utils/vector_utils.h"
-#include "utils/set_utils.h"
-#include "utils/map_utils.h"
 #include "utils/binary_vec.h"
 #include "utils/instanceof.h"
 #include "utils/dyn_cast.h"
+#include "utils/time_report.h"
+#include "utils/hash.h"
+#include "utils/thread_pool.h"
 #include "module_analyzer.h"
 #include "pcir_format.h"
 #include "pcir_dump.h"
+#include "pcir_cache.h"
+#include "pcir_codec.h"
 
 namespace pickc::pcir
 {
-  SemanticAnalyzer::SemanticAnalyzer(ModuleTree* rootTree) : rootTree(rootTree) {}
-  Option<std::vector<std::string>> SemanticAnalyzer::declare(ModuleTree* tree)
+  namespace
   {
+    // 根から深さ優先でモジュールを並べる。エラーやPCIRのモジュールはこの順番に並べる。
+    void collectTrees(ModuleTree* tree, std::vector<ModuleTree*>& trees)
+    {
+      trees.push_back(tree);
+      for(auto& sub : tree->submodules) collectTrees(sub.second, trees);
+    }
+    // 宣言に型を書いていないところがあれば、型は意味解析で初期化式から決まる。
+    bool isInferred(const Type& type)
+    {
+      if(type.isAny()) return true;
+      if(type.isArray() || type.isPtr()) return isInferred(type.elem());
+      if(type.isFn()) {
+        if(isInferred(type.retType())) return true;
+        for(const auto arg : type.args()) if(isInferred(arg)) return true;
+      }
+      return false;
+    }
+    std::string_view declarationText(const ModuleTree* tree, const parser::Node* node)
+    {
+      const auto& sequence = tree->sequence;
+      if(sequence.source == nullptr || node == nullptr) return {};
+      const auto first = sequence[node->span.first];
+      const auto last = sequence[node->span.last];
+      return sequence.source->text().substr(first.offset, last.offset + last.length - first.offset);
+    }
+    // targetsの間のimportを強連結成分にまとめたもの。添字はtargetsの添字。
+    struct ImportGraph
+    {
+      // 成分の中はtargetsの順番に並べる。
+      std::vector<std::vector<size_t>> components;
+      // 成分ごとに、その成分のモジュールをimportしている成分
+      std::vector<std::vector<size_t>> dependents;
+      // 成分ごとに、その成分がimportしている成分への辺の数
+      std::vector<size_t> numDependencies;
+    };
+    ImportGraph importGraph(const std::vector<ModuleTree*>& targets)
+    {
+      constexpr auto NONE = static_cast<size_t>(-1);
+      const auto n = targets.size();
+      std::unordered_map<const ModuleTree*, size_t> indices;
+      for(size_t i = 0; i < n; ++i) indices[targets[i]] = i;
+      std::vector<std::vector<size_t>> edges(n);
+      for(size_t i = 0; i < n; ++i) {
+        for(auto imp : targets[i]->module.importModules) {
+          if(auto itr = indices.find(imp); itr != indices.end() && itr->second != i) edges[i].push_back(itr->second);
+        }
+        std::sort(edges[i].begin(), edges[i].end());
+      }
+      // Tarjanのアルゴリズム。importの連鎖が長くてもスタックが溢れないよう、再帰せずに書く。
+      ImportGraph graph;
+      std::vector<size_t> order(n, NONE), low(n), componentOf(n, NONE);
+      std::vector<size_t> stack;
+      std::vector<std::pair<size_t, size_t>> path;
+      size_t counter = 0;
+      for(size_t root = 0; root < n; ++root) {
+        if(order[root] != NONE) continue;
+        order[root] = low[root] = counter++;
+        stack.push_back(root);
+        path.emplace_back(root, 0);
+        while(!path.empty()) {
+          const auto v = path.back().first;
+          auto& next = path.back().second;
+          if(next < edges[v].size()) {
+            const auto w = edges[v][next++];
+            if(order[w] == NONE) {
+              order[w] = low[w] = counter++;
+              stack.push_back(w);
+              path.emplace_back(w, 0);
+            }
+            else if(componentOf[w] == NONE) low[v] = std::min(low[v], order[w]);
+            continue;
+          }
+          path.pop_back();
+          if(!path.empty()) low[path.back().first] = std::min(low[path.back().first], low[v]);
+          if(low[v] != order[v]) continue;
+          std::vector<size_t> component;
+          size_t w;
+          do {
+            w = stack.back();
+            stack.pop_back();
+            componentOf[w] = graph.components.size();
+            component.push_back(w);
+          } while(w != v);
+          std::sort(component.begin(), component.end());
+          graph.components.push_back(std::move(component));
+        }
+      }
+      graph.dependents.resize(graph.components.size());
+      graph.numDependencies.resize(graph.components.size());
+      for(size_t i = 0; i < n; ++i) {
+        for(auto j : edges[i]) {
+          if(componentOf[i] == componentOf[j]) continue;
+          graph.dependents[componentOf[j]].push_back(componentOf[i]);
+          ++graph.numDependencies[componentOf[i]];
+        }
+      }
+      return graph;
+    }
+    struct Interface
+    {
+      uint64_t hash;
+      // 型が推論される公開シンボルを持つか
+      bool inferred;
+    };
+    // 公開シンボルの名前、可変性、宣言した型から作るハッシュ。importしたモジュールの解析結果はこれにしか依存しない。
+    // ただし型が推論されるシンボルは、宣言の字面とimportしたモジュールのハッシュも混ぜる。declareの後、ASTを解放する前に呼ぶ。
+    const Interface& interfaceOf(ModuleTree* tree, std::unordered_map<ModuleTree*, Interface>& interfaces)
+    {
+      if(auto itr = interfaces.find(tree); itr != interfaces.end()) return itr->second;
+      // importが循環していても止まるよう、先に仮の値を入れておく。
+      interfaces[tree] = Interface{ 0, false };
+      std::string signature;
+      bool inferred = false;
+      for(const auto& [name, symbol] : tree->module.symbols) {
+        if(symbol->scope != Scope::Public) continue;
+        signature += name;
+        signature += symbol->mut == Mutability::Mutable ? " mut " : " ";
+        signature += symbol->type.toString();
+        signature += '\n';
+        if(isInferred(symbol->type)) {
+          inferred = true;
+          signature += declarationText(tree, symbol->expr);
+          signature += '\n';
+        }
+      }
+      auto hash = hashBytes(signature);
+      if(inferred) {
+        std::vector<ModuleTree*> imports(tree->module.importModules.begin(), tree->module.importModules.end());
+        std::sort(imports.begin(), imports.end(), [](auto a, auto b) { return a->name.text() < b->name.text(); });
+        for(auto imp : imports) {
+          const auto importHash = interfaceOf(imp, interfaces).hash;
+          hash = hashBytes(&importHash, sizeof(importHash), hash);
+        }
+      }
+      return interfaces[tree] = Interface{ hash, inferred };
+    }
+  }
+  SemanticAnalyzer::SemanticAnalyzer(ModuleTree* rootTree) : rootTree(rootTree), lazy(false), encoding(0) {}
+  Option<std::vector<std::string>> SemanticAnalyzer::declare(const std::vector<ModuleTree*>& order, size_t numThreads)
+  {
+    // 宣言はモジュールごとのシンボル表にだけ書き込むので、すべて並列に行える。
+    std::vector<std::vector<std::string>> moduleErrors(order.size());
+    {
+      ThreadPool pool(std::min(numThreads, order.size()));
+      for(size_t i = 0; i < order.size(); ++i) {
+        pool.submit([this, &order, &moduleErrors, i] {
+          if(auto errs = ModuleAnalyzer(this, order[i], trees).declare()) moduleErrors[i] = std::move(errs.get());
+        });
+      }
+      pool.wait();
+    }
     std::vector<std::string> errors;
-    if(auto errs = ModuleAnalyzer(this, tree, trees).declare()) errors += errs.get();
-    for(auto sub : tree->submodules) if(auto errs = declare(sub.second)) errors += errs.get();
+    for(size_t i = 0; i < order.size(); ++i) {
+      for(const auto& symbol : order[i]->module.symbols) texts.insert(symbol.second->fullyQualifiedName);
+      errors += std::move(moduleErrors[i]);
+    }
     if(errors.empty()) return none;
-    return some(errors);
+    return some(std::move(errors));
   }
-  Option<std::vector<std::string>> SemanticAnalyzer::analyze(ModuleTree* tree)
+  Option<std::vector<std::string>> SemanticAnalyzer::analyze(const std::vector<ModuleTree*>& targets, size_t numThreads)
   {
+    // 解析はimportしたモジュールのシンボルの型を読むので、import先の成分が終わってから始める。
+    auto graph = importGraph(targets);
+    std::vector<std::atomic<size_t>> remaining(graph.components.size());
+    for(size_t c = 0; c < graph.components.size(); ++c) remaining[c] = graph.numDependencies[c];
+    std::vector<std::vector<std::string>> moduleErrors(targets.size());
+    {
+      ThreadPool pool(std::min(numThreads, graph.components.size()));
+      std::function<void(size_t)> run = [&](size_t c) {
+        for(auto i : graph.components[c]) {
+          TimeReport::Scope scope("analyze", targets[i]->name.str());
+          if(auto errs = ModuleAnalyzer(this, targets[i], trees).analyze()) moduleErrors[i] = std::move(errs.get());
+          // 以降このモジュールのASTは参照しない。
+          targets[i]->releaseSyntax();
+        }
+        for(auto d : graph.dependents[c]) {
+          if(--remaining[d] == 0) pool.submit([&run, d] { run(d); });
+        }
+      };
+      for(size_t c = 0; c < graph.components.size(); ++c) {
+        if(graph.numDependencies[c] == 0) pool.submit([&run, c] { run(c); });
+      }
+      pool.wait();
+    }
     std::vector<std::string> errors;
-    if(auto errs = ModuleAnalyzer(this, tree, trees).analyze()) errors += errs.get();
-    for(auto sub : tree->submodules) if(auto errs = analyze(sub.second)) errors += errs.get();
+    for(auto& errs : moduleErrors) errors += std::move(errs);
     if(errors.empty()) return none;
-    return some(errors);
+    return some(std::move(errors));
+  }
+  void SemanticAnalyzer::require(ModuleTree* tree, Symbol* symbol)
+  {
+    if(lazy && requiredSymbols.insert(symbol).second) pendingSymbols.emplace_back(tree, symbol);
+  }
+  Option<std::vector<std::string>> SemanticAnalyzer::analyzeRequired(const std::string& mainModule)
+  {
+    std::vector<ModuleTree*> stack{ rootTree };
+    const auto mainName = Atom::intern(mainModule);
+    ModuleTree* mainTree = nullptr;
+    while(!stack.empty() && mainTree == nullptr) {
+      auto tree = stack.back();
+      stack.pop_back();
+      if(tree->name == mainName) mainTree = tree;
+      for(auto& sub : tree->submodules) stack.push_back(sub.second);
+    }
+    if(mainTree == nullptr) return some(std::vector{ "エラー: メインモジュール " + mainModule + " が見つかりません。" });
+    // メインモジュールのシンボルから始めて、解析中に参照されたシンボルを順に解析する。
+    for(auto& symbol : mainTree->module.symbols) require(mainTree, symbol.second);
+    std::vector<std::string> errors;
+    while(!pendingSymbols.empty()) {
+      auto [tree, symbol] = pendingSymbols.back();
+      pendingSymbols.pop_back();
+      if(auto errs = ModuleAnalyzer(this, tree, trees).symbolAnalyze(symbol)) errors += errs.get();
+    }
+    removeUnrequired(rootTree);
+    if(errors.empty()) return none;
+    return some(std::move(errors));
+  }
+  void SemanticAnalyzer::removeUnrequired(ModuleTree* tree)
+  {
+    for(auto itr = tree->module.symbols.begin(); itr != tree->module.symbols.end();) {
+      if(requiredSymbols.count(itr->second)) ++itr;
+      else itr = tree->module.symbols.erase(itr);
+    }
+    tree->releaseSyntax();
+    for(auto& sub : tree->submodules) removeUnrequired(sub.second);
+  }
+  Result<std::vector<PCIRUnit>, std::vector<std::string>> SemanticAnalyzer::compileModules(const CompilerOption& option)
+  {
+    const PCIRCache cache(option.cacheDir, encoding);
+    std::vector<ModuleTree*> order;
+    collectTrees(rootTree, order);
+    std::vector<PCIRUnit> units(order.size());
+    std::vector<uint64_t> sourceHashes(order.size());
+    std::vector<PCIRCache::Imports> imports(order.size());
+    std::unordered_set<ModuleTree*> stale;
+    {
+      TimeReport::Scope scope("pcir cache");
+      std::unordered_map<ModuleTree*, Interface> interfaces;
+      for(auto tree : order) interfaceOf(tree, interfaces);
+      for(size_t i = 0; i < order.size(); ++i) {
+        const auto tree = order[i];
+        units[i].name = tree->name.str();
+        sourceHashes[i] = cache.sourceHash(tree->sequence.source ? tree->sequence.source->text() : std::string_view());
+        for(auto imp : tree->module.importModules) imports[i].emplace_back(imp->name.str(), interfaces[imp].hash);
+        std::sort(imports[i].begin(), imports[i].end());
+        if(auto pcir = cache.load(units[i].name, sourceHashes[i], imports[i])) units[i].binary = std::move(pcir.get());
+        else stale.insert(tree);
+      }
+      // 解析し直すモジュールがimportした、型が推論されるシンボルは型が決まっていなければならないので、そのモジュールも解析し直す。
+      std::vector<ModuleTree*> pending(stale.begin(), stale.end());
+      while(!pending.empty()) {
+        const auto tree = pending.back();
+        pending.pop_back();
+        for(auto imp : tree->module.importModules) {
+          if(interfaces[imp].inferred && stale.insert(imp).second) pending.push_back(imp);
+        }
+      }
+    }
+    {
+      TimeReport::Scope scope("analyze");
+      std::vector<ModuleTree*> targets;
+      for(auto tree : order) {
+        if(stale.count(tree)) targets.push_back(tree);
+        else tree->releaseSyntax();
+      }
+      if(auto errs = analyze(targets, option.numThreads)) return error(std::move(errs.get()));
+    }
+    {
+      TimeReport::Scope scope("pcir encode");
+      for(size_t i = 0; i < order.size(); ++i) {
+        if(!stale.count(order[i])) continue;
+        texts.clear();
+        textIndices.clear();
+        types.clear();
+        typeIndices.clear();
+        modules.clear();
+        symbols.clear();
+        symbolIndices.clear();
+        functions.clear();
+        functionIndices.clear();
+        auto binary = encode({ order[i] });
+        if(!binary) return error(std::move(binary.err()));
+        units[i].binary = std::move(binary.get());
+      }
+    }
+    {
+      TimeReport::Scope scope("pcir cache");
+      for(size_t i = 0; i < order.size(); ++i) {
+        if(stale.count(order[i])) cache.store(units[i].name, sourceHashes[i], imports[i], units[i].binary);
+      }
+    }
+    return ok(std::move(units));
   }
   void SemanticAnalyzer::findModules(ModuleTree* mod)
   {
     texts.insert(mod->name);
-    modules[mod->name] = &mod->module;
+    modules[mod->name.text()] = mod;
     for(auto& sym : mod->module.symbols) {
-      texts.insert(sym.first);
+      texts.insert(sym.second->name);
       insertType(sym.second->type);
       if(sym.second->init) {
         for(const auto& reg : sym.second->init->regs) {
           insertType(reg->type);
         }
       }
+      symbolIndices.emplace(sym.second, static_cast<uint32_t>(symbols.size()));
       symbols.push_back(sym.second);
     }
     for(auto& fn : mod->module.functions) {
@@ -60,144 +345,162 @@ namespace pickc::pcir
           if(instanceof<LoadStringInstruction>(inst)) {
             texts.insert(dynCast<LoadStringInstruction>(inst)->value);
           }
+          else if(instanceof<LoadSymbolInstruction>(inst)) {
+            texts.insert(dynCast<LoadSymbolInstruction>(inst)->name);
+          }
         }
       }
-      functions[fn];
-    }
-    for(auto& sub : mod->submodules) {
-      findModules(sub.second);
+      functionIndices.emplace(fn, static_cast<uint32_t>(functions.size()));
+      functions.push_back(fn);
     }
   }
-  void SemanticAnalyzer::insertType(const Type& type)
+  void SemanticAnalyzer::insertType(Type type)
   {
-    types.insert(type);
-    if(type.isArray()) insertType(*type.array.elem);
-    else if(type.isPtr()) insertType(*type.ptr.elem);
+    // 登録済みの型の要素は登録済みなので、辿らなくてよい。
+    if(!types.insert(type).second) return;
+    if(type.isArray() || type.isPtr()) insertType(type.elem());
     else if(type.isFn()) {
-      insertType(*type.fn.retType);
-      for(const auto arg : type.fn.args) {
-        insertType(*arg);
+      insertType(type.retType());
+      for(const auto arg : type.args()) {
+        insertType(arg);
       }
     }
   }
+  uint32_t SemanticAnalyzer::typeIndex(Type type) const
+  {
+    return typeIndices.at(type);
+  }
   BinaryVec SemanticAnalyzer::compileFunction(const Function* fn)
   {
     BinaryVec result;
-    result << static_cast<uint32_t>(indexOf(types, fn->type));
+    result << typeIndex(fn->type);
 
     if(fn->fType == FunctionType::Function) {
       std::vector<BinaryVec> flows;
       for(const auto& flow : fn->flows) {
         BinaryVec code;
         for(const auto inst : flow->insts) {
-          if(instanceof<BinaryInstruction>(inst)) {
-            auto bin = dynCast<BinaryInstruction>(inst);
-            switch(bin->inst) {
-              case BinaryInstructions::Add: code << Add; break;
-              case BinaryInstructions::Sub: code << Sub; break;
-              case BinaryInstructions::Mul: code << Mul; break;
-              case BinaryInstructions::Div: code << Div; break;
-              case BinaryInstructions::Mod: code << Mod; break;
-              case BinaryInstructions::EQ: code << EQ; break;
-              case BinaryInstructions::NEQ: code << NEQ; break;
-              case BinaryInstructions::GT: code << GT; break;
-              case BinaryInstructions::GE: code << GE; break;
-              case BinaryInstructions::LT: code << LT; break;
-              case BinaryInstructions::LE: code << LE; break;
-              default: assert(false);
+          switch(inst->kind) {
+            case InstructionKind::Binary: {
+              auto bin = dynCast<BinaryInstruction>(inst);
+              switch(bin->inst) {
+                case BinaryInstructions::Add: code << Add; break;
+                case BinaryInstructions::Sub: code << Sub; break;
+                case BinaryInstructions::Mul: code << Mul; break;
+                case BinaryInstructions::Div: code << Div; break;
+                case BinaryInstructions::Mod: code << Mod; break;
+                case BinaryInstructions::EQ: code << EQ; break;
+                case BinaryInstructions::NEQ: code << NEQ; break;
+                case BinaryInstructions::GT: code << GT; break;
+                case BinaryInstructions::GE: code << GE; break;
+                case BinaryInstructions::LT: code << LT; break;
+                case BinaryInstructions::LE: code << LE; break;
+                default: assert(false);
+              }
+              code << bin->dist->id;
+              code << bin->left->id;
+              code << bin->right->id;
+              break;
             }
-            code << static_cast<uint32_t>(indexOf(fn->regs, bin->dist));
-            code << static_cast<uint32_t>(indexOf(fn->regs, bin->left));
-            code << static_cast<uint32_t>(indexOf(fn->regs, bin->right));
-          }
-          else if(instanceof<UnaryInstruction>(inst)) {
-            auto uni = dynCast<UnaryInstruction>(inst);
-            switch(uni->inst) {
-              case UnaryInstructions::Inc: code << Inc; break;
-              case UnaryInstructions::Dec: code << Dec; break;
-              case UnaryInstructions::Pos: code << Pos; break;
-              case UnaryInstructions::Neg: code << Neg; break;
-              default: assert(false);
+            case InstructionKind::Unary: {
+              auto uni = dynCast<UnaryInstruction>(inst);
+              switch(uni->inst) {
+                case UnaryInstructions::Inc: code << Inc; break;
+                case UnaryInstructions::Dec: code << Dec; break;
+                case UnaryInstructions::Pos: code << Pos; break;
+                case UnaryInstructions::Neg: code << Neg; break;
+                default: assert(false);
+              }
+              code << uni->dist->id;
+              code << uni->reg->id;
+              break;
             }
-            code << static_cast<uint32_t>(indexOf(fn->regs, uni->dist));
-            code << static_cast<uint32_t>(indexOf(fn->regs, uni->reg));
-          }
-          else if(instanceof<ImmMove>(inst)) {
-            auto imm = dynCast<ImmMove>(inst);
-            code << Imm;
-            code << static_cast<uint32_t>(indexOf(fn->regs, imm->dist));
-            switch(imm->dist->type.type) {
-              case Types::I8: code << imm->imm.i8; break;
-              case Types::I16: code << imm->imm.i16; break;
-              case Types::I32: code << imm->imm.i32; break;
-              case Types::I64: code << imm->imm.i64; break;
-              case Types::Integer: code << imm->imm.i32; break;
-              case Types::Null: break;
-              case Types::Char: code << imm->imm.c; break;
-              default: assert(false);
+            case InstructionKind::ImmMove: {
+              auto imm = dynCast<ImmMove>(inst);
+              code << Imm;
+              code << imm->dist->id;
+              switch(imm->dist->type.type) {
+                case Types::I8: code << imm->imm.i8; break;
+                case Types::I16: code << imm->imm.i16; break;
+                case Types::I32: code << imm->imm.i32; break;
+                case Types::I64: code << imm->imm.i64; break;
+                case Types::Integer: code << imm->imm.i32; break;
+                case Types::Null: break;
+                case Types::Char: code << imm->imm.c; break;
+                default: assert(false);
+              }
+              break;
             }
-          }
-          else if(instanceof<CallInstruction>(inst)) {
-            auto call = dynCast<CallInstruction>(inst);
-            code << Call;
-            code << static_cast<uint32_t>(indexOf(fn->regs, call->dist));
-            code << static_cast<uint32_t>(indexOf(fn->regs, call->fn));
-            for(auto& arg : call->args) {
-              code << static_cast<uint32_t>(indexOf(fn->regs, arg));
+            case InstructionKind::Call: {
+              auto call = dynCast<CallInstruction>(inst);
+              code << Call;
+              code << call->dist->id;
+              code << call->fn->id;
+              for(auto& arg : call->args) {
+                code << arg->id;
+              }
+              break;
             }
-          }
-          else if(instanceof<LoadFnInstruction>(inst)) {
-            auto loadFn = dynCast<LoadFnInstruction>(inst);
-            code << LoadFn;
-            code << static_cast<uint32_t>(indexOf(fn->regs, loadFn->reg));
-            code << static_cast<uint32_t>(indexOf(functions, loadFn->fn));
-          }
-          else if(instanceof<LoadArgInstruction>(inst)) {
-            auto loadArg = dynCast<LoadArgInstruction>(inst);
-            code << LoadArg;
-            code << static_cast<uint32_t>(indexOf(fn->regs, loadArg->reg));
-            code << loadArg->indexOfArg;
-          }
-          else if(instanceof<LoadSymbolInstruction>(inst)) {
-            auto loadSymbol = dynCast<LoadSymbolInstruction>(inst);
-            code << LoadSymbol;
-            code << static_cast<uint32_t>(indexOf(fn->regs, loadSymbol->reg));
-            code << static_cast<uint32_t>(indexOf(texts, loadSymbol->name));
-          }
-          else if(instanceof<LoadStringInstruction>(inst)) {
-            auto loadString = dynCast<LoadStringInstruction>(inst);
-            code << LoadString;
-            code << static_cast<uint32_t>(indexOf(fn->regs, loadString->reg));
-            code << static_cast<uint32_t>(indexOf(texts, loadString->value));
-          }
-          else if(instanceof<LoadElemInstruction>(inst)) {
-            auto loadElem = dynCast<LoadElemInstruction>(inst);
-            code << LoadElem;
-            code << static_cast<uint32_t>(indexOf(fn->regs, loadElem->dist));
-            code << static_cast<uint32_t>(indexOf(fn->regs, loadElem->array));
-            code << static_cast<uint32_t>(indexOf(fn->regs, loadElem->index));
-          }
-          else if(instanceof<AllocInstruction>(inst)) {
-            auto alloc = dynCast<AllocInstruction>(inst);
-            code << Alloc;
-            code << static_cast<uint32_t>(indexOf(fn->regs, alloc->dist));
-            code << static_cast<uint32_t>(indexOf(fn->regs, alloc->src));
-          }
-          else if(instanceof<MovInstruction>(inst)) {
-            auto mov = dynCast<MovInstruction>(inst);
-            code << Mov;
-            code << static_cast<uint32_t>(indexOf(fn->regs, mov->dist));
-            code << static_cast<uint32_t>(indexOf(fn->regs, mov->src));
-          }
-          else if(instanceof<PhiInstruction>(inst)) {
-            auto phi = dynCast<PhiInstruction>(inst);
-            code << Phi;
-            code << static_cast<uint32_t>(indexOf(fn->regs, phi->dist));
-            code << static_cast<uint32_t>(indexOf(fn->regs, phi->r1));
-            code << static_cast<uint32_t>(indexOf(fn->regs, phi->r2));
-          }
-          else {
-            assert(false);
+            case InstructionKind::LoadFn: {
+              auto loadFn = dynCast<LoadFnInstruction>(inst);
+              code << LoadFn;
+              code << loadFn->reg->id;
+              code << functionIndices.at(loadFn->fn);
+              break;
+            }
+            case InstructionKind::LoadArg: {
+              auto loadArg = dynCast<LoadArgInstruction>(inst);
+              code << LoadArg;
+              code << loadArg->reg->id;
+              code << loadArg->indexOfArg;
+              break;
+            }
+            case InstructionKind::LoadSymbol: {
+              auto loadSymbol = dynCast<LoadSymbolInstruction>(inst);
+              code << LoadSymbol;
+              code << loadSymbol->reg->id;
+              code << textIndices.at(loadSymbol->name);
+              break;
+            }
+            case InstructionKind::LoadString: {
+              auto loadString = dynCast<LoadStringInstruction>(inst);
+              code << LoadString;
+              code << loadString->reg->id;
+              code << textIndices.at(loadString->value);
+              break;
+            }
+            case InstructionKind::LoadElem: {
+              auto loadElem = dynCast<LoadElemInstruction>(inst);
+              code << LoadElem;
+              code << loadElem->dist->id;
+              code << loadElem->array->id;
+              code << loadElem->index->id;
+              break;
+            }
+            case InstructionKind::Alloc: {
+              auto alloc = dynCast<AllocInstruction>(inst);
+              code << Alloc;
+              code << alloc->dist->id;
+              code << alloc->src->id;
+              break;
+            }
+            case InstructionKind::Mov: {
+              auto mov = dynCast<MovInstruction>(inst);
+              code << Mov;
+              code << mov->dist->id;
+              code << mov->src->id;
+              break;
+            }
+            case InstructionKind::Phi: {
+              auto phi = dynCast<PhiInstruction>(inst);
+              code << Phi;
+              code << phi->dist->id;
+              code << phi->r1->id;
+              code << phi->r2->id;
+              break;
+            }
+            default:
+              assert(false);
           }
         }
 
@@ -217,23 +520,23 @@ namespace pickc::pcir
             assert(false);
         }
         flowVec << typeFlag;
-        if(includes(fn->flows, flow->parentFlow)) {
-          flowVec << static_cast<uint32_t>(indexOf(fn->flows, flow->parentFlow));
+        if(flow->parentFlow != nullptr && flow->parentFlow->belong == fn) {
+          flowVec << flow->parentFlow->id;
         }
         else {
           flowVec << static_cast<uint32_t>(-1);
         }
         if(typeFlag & FLOW_TYPE_NORMAL) {
-          flowVec << static_cast<uint32_t>(indexOf(fn->flows, flow->nextFlow));
+          flowVec << flow->nextFlow->id;
         }
         else if(typeFlag & FLOW_TYPE_COND_BRANCH) {
-          flowVec << static_cast<uint32_t>(indexOf(fn->regs, flow->cond));
-          flowVec << static_cast<uint32_t>(indexOf(fn->flows, flow->thenFlow));
-          flowVec << static_cast<uint32_t>(indexOf(fn->flows, flow->elseFlow));
+          flowVec << flow->cond->id;
+          flowVec << flow->thenFlow->id;
+          flowVec << flow->elseFlow->id;
         }
         else if(typeFlag & FLOW_TYPE_END_POINT) {
           if(flow->retReg != nullptr) {
-            flowVec << static_cast<uint32_t>(indexOf(fn->regs, flow->retReg));
+            flowVec << flow->retReg->id;
           }
           else {
             flowVec << static_cast<uint32_t>(-1);
@@ -247,7 +550,7 @@ namespace pickc::pcir
       result << FN_TYPE_FUNCTION;
       result << static_cast<uint32_t>(fn->regs.size());
       for(const auto& reg : fn->regs) {
-        result << static_cast<uint32_t>(indexOf(types, reg->type));
+        result << typeIndex(reg->type);
       }
       result << static_cast<uint32_t>(flows.size());
       result << static_cast<uint32_t>(0);
@@ -257,7 +560,7 @@ namespace pickc::pcir
     }
     else if(fn->fType == FunctionType::Extern) {
       result << FN_TYPE_EXTERN;
-      result << static_cast<uint32_t>(indexOf(texts, fn->externName));
+      result << textIndices.at(fn->externName);
     }
     else {
       assert(false);
@@ -265,42 +568,94 @@ namespace pickc::pcir
     
     return result;
   }
-  Option<std::vector<std::string>> SemanticAnalyzer::write(const CompilerOption& option)
+  Result<std::vector<PCIRUnit>, std::vector<std::string>> SemanticAnalyzer::compile(const CompilerOption& option)
   {
-    trees.insert(rootTree);
     // TODO: load pcirs
 
-    if(auto err = declare(rootTree)) return some(err.get());
-    if(auto err = analyze(rootTree)) return some(err.get());
+    lazy = option.lazy;
+    switch(option.pcirEncoding) {
+      case PCIREncoding::Fixed: encoding = 0; break;
+      case PCIREncoding::Varint: encoding = PCIR_ENCODING_VARINT; break;
+      case PCIREncoding::VarintLZ: encoding = PCIR_ENCODING_VARINT | PCIR_ENCODING_LZ; break;
+      default: assert(false);
+    }
+    std::vector<ModuleTree*> order;
+    collectTrees(rootTree, order);
+    for(auto tree : order) trees.emplace(tree->name, tree);
+    {
+      TimeReport::Scope scope("declare");
+      if(auto err = declare(order, option.numThreads)) return error(std::move(err.get()));
+    }
 
-    findModules(rootTree);
-    for(auto& fn : functions) fn.second = compileFunction(fn.first);
+    std::vector<PCIRUnit> units;
+    if(!lazy && !option.cacheDir.empty()) {
+      auto res = compileModules(option);
+      if(!res) return error(std::move(res.err()));
+      units = std::move(res.get());
+    }
+    else {
+      {
+        TimeReport::Scope scope("analyze");
+        if(lazy) {
+          if(auto err = analyzeRequired(option.mainModule)) return error(std::move(err.get()));
+        }
+        else if(auto err = analyze(order, option.numThreads)) return error(std::move(err.get()));
+      }
+      TimeReport::Scope scope("pcir encode");
+      auto binary = encode(order);
+      if(!binary) return error(std::move(binary.err()));
+      units.push_back(PCIRUnit{ "", std::move(binary.get()) });
+    }
+
+    if(option.compilerDebug) {
+      for(const auto& unit : units) {
+        dump((std::filesystem::path(option.outDir) / unit.fileName(option.out)).string(), unit.binary);
+      }
+    }
+
+    return ok(std::move(units));
+  }
+  Result<BinaryVec, std::vector<std::string>> SemanticAnalyzer::encode(const std::vector<ModuleTree*>& units)
+  {
+    for(auto tree : units) findModules(tree);
+    // テキストは文字列の順に並べる。Atomの番号の順にすると、同じソースでもプロセスごとに出力が変わってしまう。
+    std::vector<Atom> sortedTexts(texts.begin(), texts.end());
+    std::sort(sortedTexts.begin(), sortedTexts.end(), [](Atom a, Atom b) { return a.text() < b.text(); });
+    for(size_t i = 0; i < sortedTexts.size(); ++i) textIndices.emplace(sortedTexts[i], static_cast<uint32_t>(i));
+    // 型も文字列の順に並べ、IntegerとI32のように文字列が同じ型は1つにまとめる。
+    std::vector<Type> sortedTypes(types.begin(), types.end());
+    std::sort(sortedTypes.begin(), sortedTypes.end(), [](Type a, Type b) { return a.toString() < b.toString(); });
+    std::vector<Type> uniqueTypes;
+    for(const auto type : sortedTypes) {
+      if(uniqueTypes.empty() || uniqueTypes.back().toString() != type.toString()) uniqueTypes.push_back(type);
+      typeIndices.emplace(type, static_cast<uint32_t>(uniqueTypes.size() - 1));
+    }
 
     BinaryVec pcir;
     pcir << "PCIR";
     pcir << static_cast<uint64_t>(std::time(nullptr));
-    pcir << MAJOR_VERSION;
-    pcir << MINOR_VERSION;
+    pcir << PCIR_MAJOR_VERSION;
+    pcir << PCIR_MINOR_VERSION;
     
     BinaryVec textSection;
-    textSection << static_cast<uint32_t>(texts.size());
-    for(auto& text : texts) {
-      textSection << static_cast<uint32_t>(text.size()) << text;
+    textSection << static_cast<uint32_t>(sortedTexts.size());
+    for(auto text : sortedTexts) {
+      textSection << static_cast<uint32_t>(text.text().size()) << text.str();
     }
 
     BinaryVec moduleSection;
     moduleSection << static_cast<uint32_t>(modules.size());
     for(const auto& mod : modules) {
-      moduleSection << static_cast<uint32_t>(indexOf(texts, mod.first));
-      moduleSection << static_cast<uint32_t>(mod.second->symbols.size());
-      for(const auto& sym : mod.second->symbols) {
-        moduleSection << static_cast<uint32_t>(indexOf(symbols, sym.second));
+      moduleSection << textIndices.at(mod.second->name);
+      moduleSection << static_cast<uint32_t>(mod.second->module.symbols.size());
+      for(const auto& sym : mod.second->module.symbols) {
+        moduleSection << symbolIndices.at(sym.second);
       }
     }
 
     BinaryVec typeSection;
-    typeSection << static_cast<uint32_t>(types.size());
-    for(const auto& type : types) {
+    typeSection << static_cast<uint32_t>(uniqueTypes.size());
+    for(const auto type : uniqueTypes) {
       if(type.isSignedInt() || type.type == Types::Integer) typeSection << TYPE_SIGNED_INTEGER << type.size();
       else if(type.isUnsignedInt()) typeSection << TYPE_UNSIGNED_INTEGER << type.size();
       else if(type.isFloat()) typeSection << TYPE_FLOAT << type.size();
@@ -310,17 +665,17 @@ namespace pickc::pcir
       else if(type.isChar()) typeSection << TYPE_CHAR << type.size();
       else if(type.isArray())
         typeSection << TYPE_ARRAY << type.size()
-                    << static_cast<uint32_t>(indexOf(types, *type.array.elem))
-                    << type.array.length;
+                    << typeIndex(type.elem())
+                    << type.length();
       else if(type.isPtr())
         typeSection << TYPE_PTR << type.size()
-                    << static_cast<uint32_t>(indexOf(types, *type.ptr.elem));
+                    << typeIndex(type.elem());
       else if(type.isFn()) {
         typeSection << TYPE_FUNCTION << type.size()
-                    << static_cast<uint32_t>(indexOf(types, *type.fn.retType))
-                    << static_cast<uint32_t>(type.fn.args.size());
-        for(const auto& arg : type.fn.args) {
-          typeSection << static_cast<uint32_t>(indexOf(types, *arg));
+                    << typeIndex(type.retType())
+                    << static_cast<uint32_t>(type.args().size());
+        for(const auto arg : type.args()) {
+          typeSection << typeIndex(arg);
         }
       }
       else {
@@ -331,45 +686,93 @@ namespace pickc::pcir
     BinaryVec symbolSection;
     symbolSection << static_cast<uint32_t>(symbols.size());
     for(const auto& sym : symbols) {
-      symbolSection << static_cast<uint32_t>(indexOf(texts, sym->name));
+      symbolSection << textIndices.at(sym->name);
       uint32_t access = 0;
       if(sym->scope == Scope::Public) access |= ACCESS_PUBLIC;
       if(sym->mut == Mutability::Mutable) access |= ACCESS_MUTABLE;
       symbolSection << access;
-      symbolSection << static_cast<uint32_t>(indexOf(types, sym->init->result->type));
-      symbolSection << static_cast<uint32_t>(indexOf(functions, sym->init));
+      symbolSection << typeIndex(sym->init->result->type);
+      symbolSection << functionIndices.at(sym->init);
     }
 
     BinaryVec fnSection;
+    std::vector<uint32_t> fnOffsets;
+    fnOffsets.reserve(functions.size());
     fnSection << static_cast<uint32_t>(functions.size());
-    for(const auto& fn : functions) {
-      fnSection << fn.second;
+    for(const auto fn : functions) {
+      fnOffsets.push_back(static_cast<uint32_t>(fnSection.size()));
+      if(encoding == 0 || fn->fType != FunctionType::Function) {
+        fnSection << compileFunction(fn);
+        continue;
+      }
+      // 型とFN_TYPEの後ろが本体。固定長で作ってから符号化する。
+      const auto binary = compileFunction(fn);
+      fnSection.insert(fnSection.end(), binary.begin(), binary.begin() + 8);
+      auto body = encodeBody(BinaryView(binary.data() + 8, binary.size() - 8), uniqueTypes, encoding);
+      if(!body) return error(std::vector<std::string>{ "関数" + std::to_string(fnOffsets.size() - 1) + "の本体を符号化できませんでした。" });
+      fnSection << body.get();
     }
 
-    uint32_t ptrToText = 36;
+    // シンボルの索引は完全修飾名のハッシュで引く。modulesの順に入れるので、ハッシュが衝突しても出力は変わらない。
+    uint32_t numOfBuckets = 0;
+    if(!symbols.empty()) {
+      numOfBuckets = 1;
+      while(numOfBuckets < symbols.size() * 2) numOfBuckets <<= 1;
+    }
+    std::vector<PCIRSymbolIndexEntry> buckets(numOfBuckets, PCIRSymbolIndexEntry{ 0, 0, PCIR_NO_SYMBOL });
+    uint32_t indexOfModule = 0;
+    for(const auto& mod : modules) {
+      for(const auto& sym : mod.second->module.symbols) {
+        const auto hash = static_cast<uint32_t>(hashBytes(sym.second->fullyQualifiedName.text()));
+        auto bucket = hash & (numOfBuckets - 1);
+        while(buckets[bucket].indexOfSymbol != PCIR_NO_SYMBOL) bucket = (bucket + 1) & (numOfBuckets - 1);
+        buckets[bucket] = PCIRSymbolIndexEntry{ hash, indexOfModule, symbolIndices.at(sym.second) };
+      }
+      ++indexOfModule;
+    }
+    BinaryVec symbolIndex;
+    symbolIndex << numOfBuckets;
+    for(const auto& bucket : buckets) symbolIndex << bucket.hash << bucket.indexOfModule << bucket.indexOfSymbol;
+
+    uint32_t ptrToText = 48;
     uint32_t ptrToModule = ptrToText + static_cast<uint32_t>(textSection.size());
     uint32_t ptrToType = ptrToModule + static_cast<uint32_t>(moduleSection.size());
     uint32_t ptrToSym = ptrToType + static_cast<uint32_t>(typeSection.size());
     uint32_t ptrToFn = ptrToSym + static_cast<uint32_t>(symbolSection.size());
+    uint32_t ptrToFnIndex = ptrToFn + static_cast<uint32_t>(fnSection.size());
+    uint32_t ptrToSymIndex = ptrToFnIndex + 4 + static_cast<uint32_t>(fnOffsets.size()) * 4;
+
+    BinaryVec fnIndex;
+    fnIndex << static_cast<uint32_t>(fnOffsets.size());
+    for(const auto offset : fnOffsets) fnIndex << ptrToFn + offset;
 
-    pcir << ptrToText << ptrToModule << ptrToType << ptrToSym << ptrToFn;
+    pcir << ptrToText << ptrToModule << ptrToType << ptrToSym << ptrToFn << ptrToFnIndex << ptrToSymIndex << encoding;
     pcir << textSection;
     pcir << moduleSection;
     pcir << typeSection;
     pcir << symbolSection;
     pcir << fnSection;
-
-    auto path = std::filesystem::path(option.outDir) / (option.out + ".pcir");
+    pcir << fnIndex;
+    pcir << symbolIndex;
+    return ok(std::move(pcir));
+  }
+  Option<std::vector<std::string>> SemanticAnalyzer::write(const CompilerOption& option)
+  {
+    auto units = compile(option);
+    if(!units) return some(std::move(units.err()));
+    return write(option, units.get());
+  }
+  Option<std::vector<std::string>> SemanticAnalyzer::write(const CompilerOption& option, const std::vector<PCIRUnit>& units)
+  {
     std::filesystem::create_directories(option.outDir);
-    std::ofstream stream(path, std::ios::binary);
-    if(!stream) return some(std::vector{ "ファイル " + path.string() + " が開けません。" });
-    stream.write((char*)pcir.data(), pcir.size());
-    stream.close();
-
-    if(option.compilerDebug) {
-      dump(path.string());
+    for(const auto& unit : units) {
+      auto path = std::filesystem::path(option.outDir) / unit.fileName(option.out);
+      TimeReport::Scope scope("write", path.filename().string());
+      std::ofstream stream(path, std::ios::binary);
+      if(!stream) return some(std::vector{ "ファイル " + path.string() + " が開けません。" });
+      stream.write((char*)unit.binary.data(), unit.binary.size());
+      stream.close();
     }
-
     return none;
   }
 }
\ No newline at end of file
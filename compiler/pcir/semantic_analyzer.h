@@ -4,14 +4,16 @@
 #include <string>
 #include <vector>
 #include <map>
-#include <set>
 #include <unordered_set>
+#include <unordered_map>
 
 #include "pickc/module_tree.h"
 #include "pickc/compiler_option.h"
 #include "utils/option.h"
+#include "utils/result.h"
 #include "utils/binary_vec.h"
 #include "pcir.h"
+#include "pcir_struct.h"
 
 namespace pickc::pcir
 {
@@ -19,20 +21,53 @@ namespace pickc::pcir
   {
     friend class ModuleAnalyzer;
     ModuleTree* rootTree;
-    std::unordered_set<ModuleTree*> trees;
-    std::set<std::string> texts;
-    std::set<Type> types;
-    std::map<std::string, Module*> modules;
+    // 完全修飾名からモジュールの木を引く表。importの解決に使う。
+    std::unordered_map<Atom, ModuleTree*> trees;
+    // PCIRに書き出す文字列。encodeで文字列の順に並べ、textIndicesに番号を付ける。
+    std::unordered_set<Atom> texts;
+    std::unordered_map<Atom, uint32_t> textIndices;
+    // PCIRに書き出す型。encodeで文字列の順に並べ、typeIndicesに番号を付ける。
+    std::unordered_set<Type> types;
+    std::unordered_map<Type, uint32_t> typeIndices;
+    // モジュールの完全修飾名の順に並べる。
+    std::map<std::string_view, ModuleTree*> modules;
     std::vector<Symbol*> symbols;
-    std::map<Function*, BinaryVec> functions;
-    Option<std::vector<std::string>> declare(ModuleTree* tree);
-    Option<std::vector<std::string>> analyze(ModuleTree* tree);
+    std::unordered_map<const Symbol*, uint32_t> symbolIndices;
+    // findModulesで見つけた順番に並べる。アドレスの順にすると、並列に解析したときに出力が変わってしまう。
+    std::vector<Function*> functions;
+    std::unordered_map<const Function*, uint32_t> functionIndices;
+    // --lazyのとき、メインモジュールから参照を辿って見つかったシンボルと、まだ解析していないシンボル
+    bool lazy;
+    std::unordered_set<Symbol*> requiredSymbols;
+    std::vector<std::pair<ModuleTree*, Symbol*>> pendingSymbols;
+    // 関数の本体の符号化。PCIR_ENCODING_*。0なら固定長のまま書く。
+    uint32_t encoding;
+    // モジュールごとに並列に宣言する。エラーはorderの順番に並べる。
+    Option<std::vector<std::string>> declare(const std::vector<ModuleTree*>& order, size_t numThreads);
+    // targetsを並列に解析する。importしたモジュールの解析が済んでから解析するので、結果はスレッドの数によらない。
+    // importが循環しているモジュールはまとめてtargetsの順番に解析する。解析したモジュールのASTは解放する。
+    Option<std::vector<std::string>> analyze(const std::vector<ModuleTree*>& targets, size_t numThreads);
+    // シンボルが参照されたことを記録する。--lazyでなければ何もしない。
+    void require(ModuleTree* tree, Symbol* symbol);
+    Option<std::vector<std::string>> analyzeRequired(const std::string& mainModule);
+    void removeUnrequired(ModuleTree* tree);
+    // --cache-dirのとき、モジュールごとにPCIRを作る。
+    // ソースもimportしたモジュールの公開インターフェースも変わっていないモジュールは、解析せずにキャッシュのPCIRを使う。
+    Result<std::vector<PCIRUnit>, std::vector<std::string>> compileModules(const CompilerOption& option);
     void findModules(ModuleTree* mod);
-    void insertType(const Type& type);
+    void insertType(Type type);
+    uint32_t typeIndex(Type type) const;
     BinaryVec compileFunction(const Function* fn);
+    // 解析の済んだモジュールをまとめて1つのPCIRのバイト列にする。
+    Result<BinaryVec, std::vector<std::string>> encode(const std::vector<ModuleTree*>& units);
   public:
     SemanticAnalyzer(ModuleTree* rootTree);
+    // 意味解析をしてPCIRをメモリ上に作る。ファイルには書き出さない。
+    // --cache-dirを指定したときはモジュールごとに、そうでなければプログラム全体で1つのPCIRを作る。
+    Result<std::vector<PCIRUnit>, std::vector<std::string>> compile(const CompilerOption& option);
+    // compileしたPCIRを<outDir>に書き出す。ファイル名はPCIRUnit::fileNameを参照。
     Option<std::vector<std::string>> write(const CompilerOption& option);
+    static Option<std::vector<std::string>> write(const CompilerOption& option, const std::vector<PCIRUnit>& units);
   };
 }
 
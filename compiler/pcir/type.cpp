@@ -0,0 +1,460 @@
+#include "type.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <cassert>
+
+#include "parser/ast_node.h"
+#include "utils/dyn_cast.h"
+#include "utils/sharded_table.h"
+#include "pcir_code.h"
+
+namespace pickc::pcir
+{
+  namespace
+  {
+    // 要素を持たない型はTypesの値をそのまま番号にするので、登録した型の番号はここから付ける。
+    constexpr TypeId NUM_KINDS = static_cast<TypeId>(Types::Generics) + 1;
+
+    uint64_t mix(uint64_t hash, uint64_t value)
+    {
+      hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+      return hash;
+    }
+    uint64_t hashOf(const TypeInfo& info)
+    {
+      auto hash = mix(0, static_cast<uint64_t>(info.type));
+      hash = mix(hash, (static_cast<uint64_t>(info.elem.id) << 32) | info.length);
+      hash = mix(hash, info.retType.id);
+      for(const auto arg : info.args) hash = mix(hash, arg.id);
+      hash ^= hash >> 33;
+      hash *= 0xFF51AFD7ED558CCDull;
+      hash ^= hash >> 33;
+      return hash;
+    }
+    struct InfoHash
+    {
+      size_t operator()(const TypeInfo* info) const { return static_cast<size_t>(hashOf(*info)); }
+    };
+    struct InfoEqual
+    {
+      bool operator()(const TypeInfo* a, const TypeInfo* b) const
+      {
+        return a->type == b->type && a->elem == b->elem && a->length == b->length && a->retType == b->retType && a->args == b->args;
+      }
+    };
+    const char* kindName(Types type)
+    {
+      switch(type) {
+        case Types::Any: return "any";
+        case Types::Integer: return "i32";
+        case Types::Float: return "f64";
+        case Types::I8: return "i8";
+        case Types::I16: return "i16";
+        case Types::I32: return "i32";
+        case Types::I64: return "i64";
+        case Types::U8: return "u8";
+        case Types::U16: return "u16";
+        case Types::U32: return "u32";
+        case Types::U64: return "u64";
+        case Types::F32: return "f32";
+        case Types::F64: return "f64";
+        case Types::Void: return "void";
+        case Types::Bool: return "bool";
+        case Types::Null: return "null";
+        case Types::Char: return "char";
+        default: return "";
+      }
+    }
+    uint32_t kindSize(Types type)
+    {
+      switch(type) {
+        case Types::Integer: return 32;
+        case Types::Float: return 64;
+        case Types::I8: return 8;
+        case Types::I16: return 16;
+        case Types::I32: return 32;
+        case Types::I64: return 64;
+        case Types::U8: return 8;
+        case Types::U16: return 16;
+        case Types::U32: return 32;
+        case Types::U64: return 64;
+        case Types::F32: return 32;
+        case Types::F64: return 64;
+        case Types::Void: return 0;
+        case Types::Bool: return 1;
+        case Types::Char: return 8;
+        case Types::Ptr: return 0;
+        case Types::Null: return 0;
+        case Types::Function: return 0;
+        default: return static_cast<uint32_t>(-1);
+      }
+    }
+    struct Shard
+    {
+      std::mutex mutex;
+      // キーは登録した節を指す。
+      std::unordered_map<const TypeInfo*, TypeId, InfoHash, InfoEqual> ids;
+    };
+    struct Table : ShardedTable<Shard, const TypeInfo*, 10>
+    {
+      Table() : ShardedTable(NUM_KINDS)
+      {
+        for(TypeId id = 0; id < NUM_KINDS; ++id) {
+          const auto type = static_cast<Types>(id);
+          set(id, new TypeInfo{ type, Type(), 0, Type(), {}, kindSize(type), kindName(type) });
+        }
+      }
+    };
+    // 他の静的オブジェクトのデストラクタから使われても困らないように、解放しない。
+    Table& table()
+    {
+      static auto instance = new Table();
+      return *instance;
+    }
+  }
+  Type TypeContext::intern(TypeInfo info)
+  {
+    if(info.type != Types::Array && info.type != Types::Ptr && info.type != Types::Function) return Type(info.type);
+    auto& t = table();
+    auto& shard = t.shard(hashOf(info));
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto itr = shard.ids.find(&info);
+    if(itr != shard.ids.end()) return Type(info.type, itr->second);
+    switch(info.type) {
+      case Types::Array: {
+        const auto& elem = *t.get(info.elem.id);
+        info.size = elem.size == static_cast<uint32_t>(-1) ? elem.size : elem.size * info.length;
+        info.name = "[" + elem.name + " x " + std::to_string(info.length) + "]";
+        break;
+      }
+      case Types::Ptr:
+        info.size = kindSize(Types::Ptr);
+        info.name = "ptr<" + t.get(info.elem.id)->name + ">";
+        break;
+      default:
+        info.size = kindSize(Types::Function);
+        info.name = "fn(";
+        for(size_t i = 0, l = info.args.size(); i < l; ++i) {
+          if(i != 0) info.name += ',';
+          info.name += t.get(info.args[i].id)->name;
+        }
+        info.name += "):";
+        info.name += t.get(info.retType.id)->name;
+        break;
+    }
+    const auto id = t.allocate();
+    const auto stored = new TypeInfo(std::move(info));
+    // 番号を他のスレッドに渡す前に表に書き込んでおく。
+    t.set(id, stored);
+    shard.ids.emplace(stored, id);
+    return Type(stored->type, id);
+  }
+  const TypeInfo& TypeContext::get(TypeId id)
+  {
+    return *table().get(id);
+  }
+  size_t TypeContext::size()
+  {
+    return table().size();
+  }
+
+  Type::Type() : type(Types::_UNDEFINED), id(static_cast<TypeId>(Types::_UNDEFINED)) {}
+  Type::Type(Types type) : type(type), id(static_cast<TypeId>(type))
+  {
+    assert(
+      type != Types::Array &&
+      type != Types::Ptr &&
+      type != Types::Function &&
+      type != Types::UserDefine &&
+      type != Types::Generics
+    );
+  }
+  Type::Type(parser::TypeNode* typeNode)
+  {
+    using namespace parser;
+    if(typeNode == nullptr) {
+      *this = Type(Types::Any);
+      return;
+    }
+    switch(typeNode->kind) {
+      case NodeKind::I8Type: *this = Type(Types::I8); break;
+      case NodeKind::I16Type: *this = Type(Types::I16); break;
+      case NodeKind::I32Type: *this = Type(Types::I32); break;
+      case NodeKind::I64Type: *this = Type(Types::I64); break;
+      case NodeKind::U8Type: *this = Type(Types::U8); break;
+      case NodeKind::U16Type: *this = Type(Types::U16); break;
+      case NodeKind::U32Type: *this = Type(Types::U32); break;
+      case NodeKind::U64Type: *this = Type(Types::U64); break;
+      case NodeKind::F32Type: *this = Type(Types::F32); break;
+      case NodeKind::F64Type: *this = Type(Types::F64); break;
+      case NodeKind::VoidType: *this = Type(Types::Void); break;
+      case NodeKind::BoolType: *this = Type(Types::Bool); break;
+      case NodeKind::CharType: *this = Type(Types::Char); break;
+      case NodeKind::ArrayType: {
+        auto arrayNode = dynCast<ArrayTypeNode>(typeNode);
+        *this = array(Type(arrayNode->elemType), static_cast<uint32_t>(arrayNode->length));
+        break;
+      }
+      case NodeKind::PtrType: {
+        auto ptrNode = dynCast<PtrTypeNode>(typeNode);
+        *this = ptr(Type(ptrNode->base));
+        break;
+      }
+      case NodeKind::FnType: {
+        auto fnNode = dynCast<FnTypeNode>(typeNode);
+        std::vector<Type> args;
+        args.reserve(fnNode->args.size());
+        for(auto arg : fnNode->args) {
+          args.push_back(Type(arg));
+        }
+        *this = fn(Type(fnNode->ret), std::move(args));
+        break;
+      }
+      case NodeKind::UserDefineType:
+        type = Types::UserDefine;
+        id = static_cast<TypeId>(type);
+        // TODO
+        assert(false);
+        break;
+      case NodeKind::GenericsType:
+        type = Types::Generics;
+        id = static_cast<TypeId>(type);
+        // TODO
+        assert(false);
+        break;
+      default:
+        assert(false);
+    }
+  }
+  Type Type::array(Type elem, uint32_t length)
+  {
+    TypeInfo info;
+    info.type = Types::Array;
+    info.elem = elem;
+    info.length = length;
+    return TypeContext::intern(std::move(info));
+  }
+  Type Type::ptr(Type elem)
+  {
+    TypeInfo info;
+    info.type = Types::Ptr;
+    info.elem = elem;
+    return TypeContext::intern(std::move(info));
+  }
+  Type Type::fn(Type retType, std::vector<Type> args)
+  {
+    TypeInfo info;
+    info.type = Types::Function;
+    info.retType = retType;
+    info.args = std::move(args);
+    return TypeContext::intern(std::move(info));
+  }
+  Type Type::elem() const
+  {
+    assert(isArray() || isPtr());
+    return TypeContext::get(id).elem;
+  }
+  uint32_t Type::length() const
+  {
+    assert(isArray());
+    return TypeContext::get(id).length;
+  }
+  Type Type::retType() const
+  {
+    assert(isFn());
+    return TypeContext::get(id).retType;
+  }
+  const std::vector<Type>& Type::args() const
+  {
+    assert(isFn());
+    return TypeContext::get(id).args;
+  }
+  bool Type::castable(Type to, Type from)
+  {
+    // TODO
+    assert(to.type != Types::_UNDEFINED && from.type != Types::_UNDEFINED);
+    // 同じ番号なら構造も同じ
+    if(to == from) return true;
+    if(to.type == from.type) {
+      if(to.type == Types::Function) {
+        const auto& toFn = TypeContext::get(to.id);
+        const auto& fromFn = TypeContext::get(from.id);
+        if(toFn.args.size() != fromFn.args.size()) return false;
+        if(!castable(toFn.retType, fromFn.retType)) return false;
+        for(size_t i = 0, l = toFn.args.size(); i < l; ++i) {
+          if(!castable(toFn.args[i], fromFn.args[i])) return false;
+        }
+        return true;
+      }
+    }
+    return
+      (to.isInt() && from.isInt()) ||
+      to.type == from.type ||
+      to.type == Types::Any ||
+      (from.type == Types::Integer && to.isInt()) ||
+      (from.type == Types::Null && to.type == Types::Ptr);
+  }
+  bool Type::computable(uint8_t inst, const Type* left, const Type* right)
+  {
+    assert(left != nullptr);
+    // TODO ユーザー定義型
+    switch(inst) {
+      case Add:
+      case Sub:
+      case Mul:
+      case Div:
+      case Mod:
+        assert(right != nullptr);
+        if(left->isInt() && right->isInt()) return true;
+        return left->type == right->type && (left->isInt() || left->isFloat())
+        && (right->isInt() || right->isFloat());
+      case EQ:
+      case NEQ:
+      case GT:
+      case GE:
+      case LT:
+      case LE:
+        assert(right != nullptr);
+        if((left->isInt() || left->isFloat()) && (right->isInt() || right->isFloat())) {
+          return true;
+        }
+        return false;
+      case Inc:
+      case Dec:
+      case Pos:
+      case Neg:
+        assert(right == nullptr);
+        return left->isInt() || left->isFloat();
+      default:
+        assert(false);
+        return false;
+    }
+  }
+  Type Type::merge(uint8_t inst, Type t1, Type t2)
+  {
+    if(t1.type == Types::Any) return t2;
+    switch(inst) {
+      case Add:
+      case Sub:
+      case Mul:
+      case Div:
+      case Mod:
+        if((t1.isFloat() || t2.isFloat()) && (t1.isFloat() || t1.isInt() || t2.isFloat() || t2.isInt())) {
+          if(t1.type == Types::F64 || t2.type == Types::F64) {
+            return Type(Types::F64);
+          }
+          else if(t1.type == Types::F32 || t2.type == Types::F32) {
+            return Type(Types::F32);
+          }
+          return Type(Types::Float);
+        }
+        if(t1.type == Types::Integer && t2.type == Types::Integer) return Type(Types::Integer);
+        if(t1.isInt() && t2.isInt()) {
+          if(t1.size() == t2.size()) {
+            if(t1.isUnsignedInt()) return t1;
+            if(t2.isUnsignedInt()) return t2;
+            return t1;
+          }
+          return t1.size() > t2.size() ? t1 : t2;
+        }
+        assert(false);
+        break;
+      case EQ:
+      case NEQ:
+      case GT:
+      case GE:
+      case LT:
+      case LE:
+        if((t1.isInt() || t1.isFloat()) && (t2.isInt() || t2.isFloat())) {
+          return Type(Types::Bool);
+        }
+        assert(false);
+        break;
+      case Mov:
+        assert(castable(t1, t2));
+        if(t1.type == Types::Function && t1 != t2) {
+          const auto& fn1 = TypeContext::get(t1.id);
+          const auto& fn2 = TypeContext::get(t2.id);
+          std::vector<Type> args;
+          args.reserve(fn1.args.size());
+          for(size_t i = 0, l = fn1.args.size(); i < l; ++i) {
+            args.push_back(Type::merge(Mov, fn1.args[i], fn2.args[i]));
+          }
+          return fn(Type::merge(Mov, fn1.retType, fn2.retType), std::move(args));
+        }
+        return t1;
+      default:
+        assert(false);
+    }
+    return Type();
+  }
+  bool Type::isAny() const
+  {
+    return type == Types::Any;
+  }
+  bool Type::isInt() const
+  {
+    return type == Types::Integer || isSignedInt() || isUnsignedInt();
+  }
+  bool Type::isSignedInt() const
+  {
+    return type == Types::I8 || type == Types::I16 || type == Types::I32 || type == Types::I64;
+  }
+  bool Type::isUnsignedInt() const
+  {
+    return type == Types::U8 || type == Types::U16 || type == Types::U32 || type == Types::U64;
+  }
+  bool Type::isFloat() const
+  {
+    return type == Types::Float || type == Types::F32 || type == Types::F64;
+  }
+  bool Type::isArray() const
+  {
+    return type == Types::Array;
+  }
+  bool Type::isVoid() const
+  {
+    return type == Types::Void;
+  }
+  bool Type::isBool() const
+  {
+    return type == Types::Bool;
+  }
+  bool Type::isNull() const
+  {
+    return type == Types::Null;
+  }
+  bool Type::isChar() const
+  {
+    return type == Types::Char;
+  }
+  bool Type::isPtr() const
+  {
+    return type == Types::Ptr;
+  }
+  bool Type::isFn() const
+  {
+    return type == Types::Function;
+  }
+  bool Type::isUserDef() const
+  {
+    return type == Types::UserDefine;
+  }
+  bool Type::isGenerics() const
+  {
+    return type == Types::Generics;
+  }
+  uint32_t Type::size() const
+  {
+    // TODO UserDefine, Generics
+    assert(type != Types::_UNDEFINED && type != Types::Any && type != Types::UserDefine && type != Types::Generics);
+    return TypeContext::get(id).size;
+  }
+  const std::string& Type::toString() const
+  {
+    // TODO UserDefine, Generics
+    assert(type != Types::_UNDEFINED && type != Types::UserDefine && type != Types::Generics);
+    return TypeContext::get(id).name;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#ifndef PICKC_PCIR_TYPE_H_
+#define PICKC_PCIR_TYPE_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace pickc::parser
+{
+  class TypeNode;
+}
+
+namespace pickc::pcir
+{
+  enum struct Types
+  {
+    _UNDEFINED,
+    // 未初期化変数などの、型が定まっていない状態
+    Any,
+    // IntegerLiteralの型。状況によってさまざまな型に変換される。
+    Integer,
+    // FloatLiteralの型。状況によってF32, F64のいずれかに変換される。
+    Float,
+    // NullLiteralの型。状況によってptr<T>のTが異なる型に変換される。
+    Null,
+    I8,
+    I16,
+    I32,
+    I64,
+    U8,
+    U16,
+    U32,
+    U64,
+    F32,
+    F64,
+    Array,
+    Void,
+    Ptr,
+    Bool,
+    Char,
+    Function,
+    UserDefine,
+    Generics,
+  };
+  // TypeContextに登録した型の番号。構造が同じ型には同じ番号が付く。
+  // 要素を持たない型の番号はTypesの値と同じ。それ以外は登録した順に付くので、プロセスごと、ビルドごとに変わりうる。出力の順番には使わないこと。
+  using TypeId = uint32_t;
+  struct TypeInfo;
+  // TypeContextに登録した型を指す。種類だけはよく使うので、ここにも持っておく。
+  // 要素の型などは変更できない共有の節にあるので、コピーは8バイトで済み、比較は番号の比較で済む。
+  struct Type
+  {
+    Types type;
+    TypeId id;
+    Type();
+    Type(Types type);
+    Type(parser::TypeNode* typeNode);
+    static Type array(Type elem, uint32_t length);
+    static Type ptr(Type elem);
+    static Type fn(Type retType, std::vector<Type> args);
+    // ArrayとPtrの要素の型
+    Type elem() const;
+    uint32_t length() const;
+    Type retType() const;
+    const std::vector<Type>& args() const;
+    bool operator==(Type t) const { return id == t.id; }
+    bool operator!=(Type t) const { return id != t.id; }
+    static bool castable(Type to, Type from);
+    static bool computable(uint8_t inst, const Type* left, const Type* right = nullptr);
+    static Type merge(uint8_t inst, Type t1, Type t2);
+    bool isAny() const;
+    bool isInt() const;
+    bool isSignedInt() const;
+    bool isUnsignedInt() const;
+    bool isFloat() const;
+    bool isArray() const;
+    bool isVoid() const;
+    bool isBool() const;
+    bool isNull() const;
+    bool isChar() const;
+    bool isPtr() const;
+    bool isFn() const;
+    bool isUserDef() const;
+    bool isGenerics() const;
+    uint32_t size() const;
+    // 登録したときに作っておいた文字列。IntegerとI32のように、別の型が同じ文字列になることがある。
+    const std::string& toString() const;
+  private:
+    friend class TypeContext;
+    Type(Types type, TypeId id) : type(type), id(id) {}
+  };
+  struct TypeInfo
+  {
+    Types type = Types::_UNDEFINED;
+    // ArrayとPtrの要素の型、Arrayの長さ
+    Type elem;
+    uint32_t length = 0;
+    // Functionの戻り値と引数の型
+    Type retType;
+    std::vector<Type> args;
+    // 以下はTypeContext::internが埋める。
+    uint32_t size = 0;
+    std::string name;
+  };
+  // 構造が同じ型を1つの節にまとめて番号を付ける、プロセス全体の型の表。
+  // 登録した節はプロセスの終わりまで解放も変更もしないので、getの返す参照はずっと有効。
+  // どのスレッドから呼んでもよい。internは構造のハッシュで選んだ区画だけをロックし、getはロックしない。
+  class TypeContext
+  {
+  public:
+    // type, elem, length, retType, argsが同じ型を既に登録していればその型を返す。
+    static Type intern(TypeInfo info);
+    static const TypeInfo& get(TypeId id);
+    // 登録した型の数
+    static size_t size();
+  };
+}
+
+namespace std
+{
+  template<>
+  struct hash<pickc::pcir::Type>
+  {
+    size_t operator()(pickc::pcir::Type type) const { return std::hash<uint32_t>()(type.id); }
+  };
+}
+
+#endif // PICKC_PCIR_TYPE_H_
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "config.h"
 #include "utils/string_utils.h"
+#include "utils/thread_pool.h"
 
 namespace pickc
 {
@@ -26,7 +27,23 @@ namespace pickc
         "    --main -m <NAME>      メイン関数の存在するモジュールを指定します。指定しない場合はプロジェクトの名前と同じになります。\n"
         "    --out, -o <NAME>      出力ファイルの名前を指定します。指定しない場合はプロジェクトの名前と同じになります。拡張子は自動で付与されます。\n"
         "    --out-dir, -d <PATH>  出力先のディレクトリを指定します。指定しない場合は現在の位置に出力します。\n"
-        "    --library, -l <PATH>  リンクするライブラリを指定します。"
+        "    --library, -l <PATH>  リンクするライブラリを指定します。\n"
+        "    --jobs, -j <N>        並列に処理するスレッドの数を指定します。指定しない場合は論理コア数になります。\n"
+        "    --lazy                メインモジュールから使われる関数だけを解析します。使われない関数のエラーは報告されません。\n"
+        "    --cache-dir <PATH>    構文解析とモジュールごとのPCIRをキャッシュするディレクトリを指定します。内容の変わっていないファイルは構文解析を、\n"
+        "                          ソースもimportしたモジュールの公開インターフェースも変わっていないモジュールは意味解析を省略します。\n"
+        "    --emit-pcir           中間表現(PCIR)を出力先のディレクトリに<OUT>.pcirとして書き出します。--cache-dirと併用した場合はモジュールごとに<OUT>.<MODULE>.pcirとします。\n"
+        "    --pcir-encoding <ENC> PCIRの関数の本体の符号化を指定します。使用可能な符号化: [fixed, varint, lz] 指定しない場合はfixedです。\n"
+        "                          varintは番号を可変長で書き、lzはさらに関数ごとに圧縮します。PCIRを読む側はどれでも読めます。\n"
+        "    --time-report <FMT>   フェーズごとの時間とメモリの使用量を出力します。使用可能なフォーマット: [table, json]\n"
+        "    --mem-report          フェーズが終わった時点のピークRSSとRSSを出力します。どのフェーズでメモリ使用量の最大値が決まるかが分かります。\n"
+        "    --server <SOCKET>     コンパイルサーバーとして<SOCKET>で待ち受けます。キャッシュはメモリにも保持し、要求をまたいで再利用します。\n"
+        "                          要求に--cache-dirがない場合は、このオプションと併用した--cache-dir、なければ<SOCKET>.cacheを使います。\n"
+        "    --connect <SOCKET>    <SOCKET>で待ち受けるサーバーにコンパイルを任せます。接続できない場合はこのプロセスでコンパイルします。\n"
+        "    --watch               <INPUT_DIR>を監視し、.pickファイルが変わるたびにビルドし直します。構文解析とPCIRのキャッシュはメモリにも保持し、\n"
+        "                          変わったファイルだけを構文解析し、影響を受けるモジュールだけを意味解析します。--cache-dirがない場合はユーザーのキャッシュディレクトリ(~/.cache/pickc)を使います。\n"
+        "    --dump-pcir <PATH>    コンパイルせずに、PCIRファイル<PATH>の内容を出力します。\n"
+        "    --dump-symbol <NAME>  --dump-pcirと併用し、完全修飾名が<NAME>のシンボルとその関数だけを出力します。索引のあるPCIRではほかの関数を読みません。"
         << std::endl;
     }
   }
@@ -44,7 +61,19 @@ namespace pickc
     out(""),
     outDir("./"),
     libraries(),
-    srcDir("./")
+    srcDir("./"),
+    numThreads(ThreadPool::hardwareThreads()),
+    lazy(false),
+    cacheDir(""),
+    emitPCIR(false),
+    pcirEncoding(PCIREncoding::Fixed),
+    timeReport(TimeReportFormat::None),
+    memReport(false),
+    server(""),
+    connect(""),
+    watch(false),
+    dumpPCIR(""),
+    dumpSymbol("")
   {}
   Result<CompilerOption, std::string> CompilerOption::create(int argc, char* argv[])
   {
@@ -121,6 +150,93 @@ namespace pickc
           return error("--library, -lには引数が必要です。");
         }
       }
+      else if(str == "--jobs" || str == "-j") {
+        if(++i < argc && !startsWith(argv[i], "-")) {
+          std::string jobs(argv[i]);
+          if(jobs.empty() || jobs.size() > 4 || jobs.find_first_not_of("0123456789") != std::string::npos || std::stoul(jobs) == 0) {
+            return error("--jobs, -jには1以上の整数を指定してください。");
+          }
+          option.numThreads = std::stoul(jobs);
+        }
+        else {
+          return error("--jobs, -jには引数が必要です。");
+        }
+      }
+      else if(str == "--lazy") {
+        option.lazy = true;
+      }
+      else if(str == "--cache-dir") {
+        if(++i < argc && !startsWith(argv[i], "-")) {
+          option.cacheDir = argv[i];
+        }
+        else {
+          return error("--cache-dirには引数が必要です。");
+        }
+      }
+      else if(str == "--emit-pcir") {
+        option.emitPCIR = true;
+      }
+      else if(str == "--pcir-encoding") {
+        if(++i < argc && !startsWith(argv[i], "-")) {
+          std::string encoding(argv[i]);
+          if(encoding == "fixed") option.pcirEncoding = PCIREncoding::Fixed;
+          else if(encoding == "varint") option.pcirEncoding = PCIREncoding::Varint;
+          else if(encoding == "lz") option.pcirEncoding = PCIREncoding::VarintLZ;
+          else return error(encoding + "は無効な符号化です。--pcir-encodingにはfixed、varintまたはlzを指定してください。");
+        }
+        else {
+          return error("--pcir-encodingには引数が必要です。");
+        }
+      }
+      else if(str == "--time-report") {
+        if(++i < argc && !startsWith(argv[i], "-")) {
+          std::string format(argv[i]);
+          if(format == "table") option.timeReport = TimeReportFormat::Table;
+          else if(format == "json") option.timeReport = TimeReportFormat::JSON;
+          else return error(format + "は無効なフォーマットです。--time-reportにはtableまたはjsonを指定してください。");
+        }
+        else {
+          return error("--time-reportには引数が必要です。");
+        }
+      }
+      else if(str == "--mem-report") {
+        option.memReport = true;
+      }
+      else if(str == "--server") {
+        if(++i < argc && !startsWith(argv[i], "-")) {
+          option.server = argv[i];
+        }
+        else {
+          return error("--serverには引数が必要です。");
+        }
+      }
+      else if(str == "--connect") {
+        if(++i < argc && !startsWith(argv[i], "-")) {
+          option.connect = argv[i];
+        }
+        else {
+          return error("--connectには引数が必要です。");
+        }
+      }
+      else if(str == "--watch") {
+        option.watch = true;
+      }
+      else if(str == "--dump-pcir") {
+        if(++i < argc && !startsWith(argv[i], "-")) {
+          option.dumpPCIR = argv[i];
+        }
+        else {
+          return error("--dump-pcirには引数が必要です。");
+        }
+      }
+      else if(str == "--dump-symbol") {
+        if(++i < argc && !startsWith(argv[i], "-")) {
+          option.dumpSymbol = argv[i];
+        }
+        else {
+          return error("--dump-symbolには引数が必要です。");
+        }
+      }
       else if(!startsWith(argv[i], "-")) {
         option.srcDir = argv[i];
       }
@@ -128,6 +244,13 @@ namespace pickc
         return error(std::string(argv[i]) + "は無効なオプションです。");
       }
     }
+    if(!option.server.empty() && !option.connect.empty()) return error("--serverと--connectは同時に指定できません。");
+    if(option.watch && (!option.server.empty() || !option.connect.empty())) return error("--watchは--server、--connectと同時に指定できません。");
+    if(!option.dumpSymbol.empty() && option.dumpPCIR.empty()) return error("--dump-symbolは--dump-pcirと併用してください。");
+    // サーバーは要求ごとにオプションを受け取るので、プロジェクト名は要らない。
+    if(!option.server.empty()) return ok(option);
+    // ダンプはコンパイルしないので、プロジェクト名は要らない。
+    if(!option.dumpPCIR.empty()) return ok(option);
     if(option.projectName.empty()) return error("プロジェクト名が指定されていません。--projectオプションは必須です。");
     if(option.out.empty()) option.out = option.projectName;
     if(option.mainModule.empty()) option.mainModule = option.projectName;
@@ -146,6 +269,30 @@ namespace pickc
     std::cout << "Output Name:     " << out << std::endl;
     std::cout << "Output Dir:      " << outDir << std::endl;
     std::cout << "Source Dir:      " << srcDir << std::endl;
+    std::cout << "Threads:         " << numThreads << std::endl;
+    std::cout << "Lazy:            " << (lazy ? "true" : "false") << std::endl;
+    std::cout << "Cache Dir:       " << (cacheDir.empty() ? "(none)" : cacheDir) << std::endl;
+    std::cout << "Emit PCIR:       " << (emitPCIR ? "true" : "false") << std::endl;
+    std::string encodingString;
+    switch(pcirEncoding) {
+      case PCIREncoding::Fixed: encodingString = "fixed"; break;
+      case PCIREncoding::Varint: encodingString = "varint"; break;
+      case PCIREncoding::VarintLZ: encodingString = "lz"; break;
+      default: assert(false);
+    }
+    std::cout << "PCIR Encoding:   " << encodingString << std::endl;
+    std::string timeReportString;
+    switch(timeReport) {
+      case TimeReportFormat::None: timeReportString = "(none)"; break;
+      case TimeReportFormat::Table: timeReportString = "table"; break;
+      case TimeReportFormat::JSON: timeReportString = "json"; break;
+      default: assert(false);
+    }
+    std::cout << "Time Report:     " << timeReportString << std::endl;
+    std::cout << "Memory Report:   " << (memReport ? "true" : "false") << std::endl;
+    std::cout << "Server:          " << (server.empty() ? "(none)" : server) << std::endl;
+    std::cout << "Connect:         " << (connect.empty() ? "(none)" : connect) << std::endl;
+    std::cout << "Watch:           " << (watch ? "true" : "false") << std::endl;
     std::cout << "Libraries:       [";
     for(const auto& lib : libraries) {
       std::cout << "\n    " << lib;
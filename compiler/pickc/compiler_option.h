@@ -12,6 +12,19 @@ namespace pickc
   {
     WindowsX64
   };
+  enum struct TimeReportFormat
+  {
+    None,
+    Table,
+    JSON
+  };
+  // PCIRの関数の本体の符号化。pcir_format.hのPCIR_ENCODING_*を参照。
+  enum struct PCIREncoding
+  {
+    Fixed,
+    Varint,
+    VarintLZ
+  };
   struct CompilerOption
   {
     TargetPlatforms target;
@@ -22,6 +35,30 @@ namespace pickc
     std::string outDir;
     std::vector<std::string> libraries;
     std::string srcDir;
+    // 構文解析などに使うスレッドの数
+    size_t numThreads;
+    // mainModuleから使われる関数だけを、使われたときに構文解析、意味解析する。
+    bool lazy;
+    // 空でなければ、字句解析と構文解析の結果をここに保存し、内容の変わっていないファイルでは再利用する。
+    std::string cacheDir;
+    // 中間表現を<outDir>/<out>.pcirに書き出す。書き出さなくてもバンドラはメモリ上のPCIRを使う。
+    bool emitPCIR;
+    // Fixedでなければ、関数の本体を可変長(とLZ圧縮)で書き出す。読み込む側はどの形式でも読める。
+    PCIREncoding pcirEncoding;
+    // Noneでなければ、フェーズごとの時間とメモリの計測結果を最後に出力する。
+    TimeReportFormat timeReport;
+    // フェーズが終わった時点のピークRSSとRSSを最後に出力する。
+    bool memReport;
+    // 空でなければ、このパスのソケットで待ち受けるコンパイルサーバーとして動く。
+    std::string server;
+    // 空でなければ、このパスのソケットで待ち受けるサーバーにコンパイルを任せる。
+    std::string connect;
+    // srcDirを監視し、.pickファイルが変わるたびにビルドし直す。
+    bool watch;
+    // 空でなければ、コンパイルせずにこのPCIRファイルをダンプする。
+    std::string dumpPCIR;
+    // 空でなければ、dumpPCIRのうちこの完全修飾名のシンボルとその関数だけをダンプする。
+    std::string dumpSymbol;
 
     CompilerOption();
     static Result<CompilerOption, std::string> create(int argc, char* argv[]);
@@ -16,6 +16,16 @@ namespace pickc
   constexpr auto STATUS_BUNDLER_ERROR             = 0x00000008;
   constexpr auto STATUS_WINDOWS_X64_ERROR         = 0x00000010;
   constexpr auto STATUS_WINDOWS_X64_LINKER_ERROR  = 0x00000020;
+  constexpr auto STATUS_SERVER_ERROR              = 0x00000040;
+  constexpr auto STATUS_WATCH_ERROR               = 0x00000080;
+
+  // --serverと--watchで、ビルドの後にピークRSSがこれを超えていたらプロセスを終了する。
+  // 意味解析以降の構造はビルドごとに解放しきれないので、常駐し続けると使用量が増えていく。
+  constexpr uint64_t MAX_RESIDENT_PEAK_RSS = 4ull * 1024 * 1024 * 1024;
+  // --serverが1つの要求で受け付ける引数の数と、作業ディレクトリや引数1つの長さの上限。
+  // 長さはソケットから読むので、確保する前に確かめる。
+  constexpr uint32_t MAX_SERVER_ARGS = 4096;
+  constexpr uint32_t MAX_SERVER_STRING_SIZE = 4 * 1024 * 1024;
 
   constexpr auto CONSOLE_BG_BLACK   = "\x1b[40m";
   constexpr auto CONSOLE_BG_RED     = "\x1b[41m";
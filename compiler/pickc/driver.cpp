@@ -0,0 +1,159 @@
+#include "driver.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <filesystem>
+
+#include "config.h"
+#include "parser/parser.h"
+#include "pcir/semantic_analyzer.h"
+#include "pcir/pcir_dump.h"
+#include "bundler/bundler.h"
+#include "windows_x64/compiler.h"
+#include "windows_x64/linker.h"
+#include "utils/time_report.h"
+#include "utils/resident_cache.h"
+#include "utils/hash.h"
+
+namespace pickc
+{
+  namespace
+  {
+    void deleteTree(ModuleTree* tree)
+    {
+      for(auto& sub : tree->submodules) deleteTree(sub.second);
+      delete tree;
+    }
+    struct TreeDeleter
+    {
+      void operator()(ModuleTree* tree) const
+      {
+        deleteTree(tree);
+      }
+    };
+    // ファイルの大きさと更新日時。なければ空文字列。
+    std::string fileStamp(const std::string& path)
+    {
+      std::error_code err;
+      const auto size = std::filesystem::file_size(path, err);
+      if(err) return "";
+      const auto time = std::filesystem::last_write_time(path, err);
+      if(err) return "";
+      return std::to_string(size) + ':' + std::to_string(time.time_since_epoch().count());
+    }
+    // 出力を決める入力をまとめたもの。PCIRとオプション、リンクするライブラリから作る。
+    std::string inputStamp(const CompilerOption& option, const std::vector<pcir::PCIRUnit>& units)
+    {
+      auto hash = hashBytes(std::string_view(VERSION));
+      hash = hashBytes(&option.target, sizeof(option.target), hash);
+      hash = hashBytes(option.mainModule, hash);
+      for(const auto& unit : units) {
+        hash = hashBytes(unit.name, hash);
+        hash = hashBytes(unit.binary.data(), unit.binary.size(), hash);
+      }
+      for(const auto& lib : option.libraries) {
+        hash = hashBytes(lib, hash);
+        hash = hashBytes(fileStamp(lib), hash);
+      }
+      return std::to_string(hash) + '/';
+    }
+    int compile(const CompilerOption& option)
+    {
+      auto moduleTree = parser::Parser().parse(option);
+      if(!moduleTree) {
+        for(const auto& err : moduleTree.err()) {
+          std::cout << CONSOLE_FG_RED << err << CONSOLE_DEFAULT << std::endl;
+        }
+        return STATUS_PARSER_ERROR;
+      }
+      // トークン列、AST、意味解析の中間表現は木が持つ。PCIRを作り終えたら、バンドルより前に解放する。
+      std::unique_ptr<ModuleTree, TreeDeleter> tree(moduleTree.get());
+      auto pcirUnits = pcir::SemanticAnalyzer(tree.get()).compile(option);
+      tree.reset();
+      if(!pcirUnits) {
+        for(const auto& err : pcirUnits.err()) {
+          std::cout << CONSOLE_FG_RED << err << CONSOLE_DEFAULT << std::endl;
+        }
+        return STATUS_PCIR_ERROR;
+      }
+      if(option.emitPCIR) {
+        if(auto errs = pcir::SemanticAnalyzer::write(option, pcirUnits.get())) {
+          for(const auto& err : errs.get()) {
+            std::cout << CONSOLE_FG_RED << err << CONSOLE_DEFAULT << std::endl;
+          }
+          return STATUS_PCIR_ERROR;
+        }
+      }
+      // --serverでは、前回と同じ入力から作った実行ファイルに手が加えられていなければ、バンドル以降を省く。
+      const auto outputPath = std::filesystem::absolute(std::filesystem::path(option.outDir) / (option.out + ".exe")).string();
+      const auto outputKey = "output:" + outputPath;
+      std::string stamp;
+      if(ResidentCache::enabled()) {
+        stamp = inputStamp(option, pcirUnits.get());
+        const auto prev = ResidentCache::get(outputKey);
+        if(prev && *prev == stamp + fileStamp(outputPath)) return STATUS_SUCCESS;
+      }
+      auto bundle = bundler::Bundler().bundle(option, pcirUnits.get());
+      // バンドラは関数の本体をPCIRのバイト列から直接読むが、命令列に変換した後は参照しない。
+      pcirUnits.get() = std::vector<pcir::PCIRUnit>();
+      if(!bundle) {
+        for(const auto& err : bundle.err()) {
+          std::cout << CONSOLE_FG_RED << err << CONSOLE_DEFAULT << std::endl;
+        }
+        return STATUS_BUNDLER_ERROR;
+      }
+      switch(option.target) {
+        case TargetPlatforms::WindowsX64: {
+          auto x64 = windows::x64::Compiler(std::move(bundle.get())).compile(option);
+          if(!x64) {
+            for(const auto& err : x64.err()) {
+              std::cout << CONSOLE_FG_RED << err << CONSOLE_DEFAULT << std::endl;
+            }
+            return STATUS_WINDOWS_X64_ERROR;
+          }
+          auto res = windows::x64::Linker(std::move(x64.get())).link(option);
+          if(!res) {
+            for(const auto& err : res.err()) {
+              std::cout << CONSOLE_FG_RED << err << CONSOLE_DEFAULT << std::endl;
+            }
+            return STATUS_WINDOWS_X64_LINKER_ERROR;
+          }
+          if(ResidentCache::enabled()) ResidentCache::put(outputKey, stamp + fileStamp(outputPath));
+          break;
+        }
+        default:
+          assert(false);
+      }
+      return STATUS_SUCCESS;
+    }
+  }
+  int runCompiler(const CompilerOption& option)
+  {
+    if(option.compilerDebug) {
+      std::cout << VERSION << " Debug Mode\n" << std::endl;
+      option.dump();
+      std::cout << std::endl;
+    }
+    TimeReport::reset();
+    if(option.timeReport != TimeReportFormat::None || option.memReport) TimeReport::enable();
+    const auto status = compile(option);
+    switch(option.timeReport) {
+      case TimeReportFormat::None: break;
+      case TimeReportFormat::Table: TimeReport::printTable(std::cout); break;
+      case TimeReportFormat::JSON: TimeReport::printJSON(std::cout); break;
+      default: assert(false);
+    }
+    if(option.memReport) TimeReport::printMemory(std::cout);
+    return status;
+  }
+  int dumpPCIR(const CompilerOption& option)
+  {
+    auto errs = option.dumpSymbol.empty() ? pcir::dump(option.dumpPCIR) : pcir::dumpSymbol(option.dumpPCIR, option.dumpSymbol);
+    if(!errs) return STATUS_SUCCESS;
+    for(const auto& err : errs.get()) {
+      std::cout << CONSOLE_FG_RED << err << CONSOLE_DEFAULT << std::endl;
+    }
+    return STATUS_PCIR_ERROR;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+#ifndef PICKC_PICKC_DRIVER_H_
+#define PICKC_PICKC_DRIVER_H_
+
+#include "compiler_option.h"
+
+namespace pickc
+{
+  // 構文解析からリンクまでを実行し、終了コードを返す。エラーと--time-report、--mem-reportの結果は標準出力に出す。
+  // --serverでは1つのプロセスの中で要求ごとに呼ぶので、要求をまたいで状態を残さない。
+  int runCompiler(const CompilerOption& option);
+  // --dump-pcirで指定したPCIRファイルの内容を出力し、終了コードを返す。
+  int dumpPCIR(const CompilerOption& option);
+}
+
+#endif // PICKC_PICKC_DRIVER_H_
\ No newline at end of file
@@ -1,12 +1,12 @@
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "config.h"
 #include "compiler_option.h"
-#include "parser/parser.h"
-#include "pcir/semantic_analyzer.h"
-#include "bundler/bundler.h"
-#include "windows_x64/compiler.h"
-#include "windows_x64/linker.h"
+#include "driver.h"
+#include "server.h"
+#include "watch.h"
 
 int main(char argc, char* argv[])
 {
@@ -16,51 +16,25 @@ int main(char argc, char* argv[])
     std::cout << CONSOLE_FG_RED << option.err() << CONSOLE_DEFAULT << std::endl;
     return STATUS_INVALID_OPTION;
   }
-  if(option.get().compilerDebug) {
-    std::cout << VERSION << " Debug Mode\n" << std::endl;
-    option.get().dump();
-    std::cout << std::endl;
-  }
-  auto moduleTree = parser::Parser().parse(option.get());
-  if(!moduleTree) {
-    for(const auto& err : moduleTree.err()) {
-      std::cout << CONSOLE_FG_RED << err << CONSOLE_DEFAULT << std::endl;
-    }
-    return STATUS_PARSER_ERROR;
-  }
-  if(auto errs = pcir::SemanticAnalyzer(moduleTree.get()).write(option.get())) {
-    for(const auto& err : errs.get()) {
-      std::cout << CONSOLE_FG_RED << err << CONSOLE_DEFAULT << std::endl;
-    }
-    return STATUS_PCIR_ERROR;
-  }
-  auto bundle = bundler::Bundler().bundle(option.get());
-  if(!bundle) {
-    for(const auto& err : bundle.err()) {
-      std::cout << CONSOLE_FG_RED << err << CONSOLE_DEFAULT << std::endl;
+  if(!option.get().dumpPCIR.empty()) return dumpPCIR(option.get());
+  if(!option.get().server.empty()) {
+    auto server = Server::open(option.get());
+    if(!server) {
+      std::cout << CONSOLE_FG_RED << server.err() << CONSOLE_DEFAULT << std::endl;
+      return STATUS_SERVER_ERROR;
     }
-    return STATUS_BUNDLER_ERROR;
+    return server.get().run();
   }
-  switch(option.get().target) {
-    case TargetPlatforms::WindowsX64: {
-      auto x64 = windows::x64::Compiler(bundle.get()).compile(option.get());
-      if(!x64) {
-        for(const auto& err : x64.err()) {
-          std::cout << CONSOLE_FG_RED << err << CONSOLE_DEFAULT << std::endl;
-        }
-        return STATUS_WINDOWS_X64_ERROR;
-      }
-      auto res = windows::x64::Linker(x64.get()).link(option.get());
-      if(!res) {
-        for(const auto& err : res.err()) {
-          std::cout << CONSOLE_FG_RED << err << CONSOLE_DEFAULT << std::endl;
-        }
-        return STATUS_WINDOWS_X64_LINKER_ERROR;
-      }
-      break;
+  if(option.get().watch) return watch(option.get());
+  if(!option.get().connect.empty()) {
+    // --connectとその引数を除いて、残りをそのままサーバーに渡す。
+    std::vector<std::string> args;
+    for(int i = 0; i < argc; ++i) {
+      if(std::string(argv[i]) == "--connect") ++i;
+      else args.push_back(argv[i]);
     }
-    default:
-      assert(false);
+    if(auto status = forwardToServer(option.get().connect, args)) return status.get();
+    std::cout << "警告: サーバー" << option.get().connect << "に接続できないため、このプロセスでコンパイルします。" << std::endl;
   }
-  return STATUS_SUCCESS;
+  return runCompiler(option.get());
 }
\ No newline at end of file
@@ -10,4 +10,15 @@ namespace pickc
     }
     return count;
   }
+  void ModuleTree::releaseSyntax()
+  {
+    for(auto& symbol : module.symbols) symbol.second->expr = nullptr;
+    ast.nodes.clear();
+    ast.nodes.shrink_to_fit();
+    astArena.release();
+    // エラーメッセージに使うファイル名だけを残す。
+    auto file = std::move(sequence.file);
+    sequence = parser::TokenSequence();
+    sequence.file = std::move(file);
+  }
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 
 #include "parser/token.h"
 #include "parser/ast_node.h"
+#include "utils/arena.h"
+#include "utils/interner.h"
 // #include "ir1/ir1.h"
 #include "pcir/pcir.h"
 
@@ -13,16 +15,23 @@ namespace pickc
 {
   struct ModuleTree
   {
-    // モジュールの完全修飾名
-    std::string name;
+    // モジュールの完全修飾名。親の名前とAtom::joinで作る。
+    Atom name;
     ModuleTree* parent;
     // key = モジュール名。完全修飾名ではない。
     std::unordered_map<std::string, ModuleTree*> submodules;
     parser::TokenSequence sequence;
+    // astのノードはすべてastArenaに確保する。
+    Arena astArena;
     parser::RootNode ast;
+    // 意味解析で作るシンボル、関数、フロー、レジスタ、命令はすべてirArenaに確保する。
+    // PCIRに書き出した後は参照しないので、木と一緒に解放する。
+    Arena irArena;
     // ir1::IR1Module ir1Module;
     pcir::Module module;
     size_t countModules() const;
+    // PCIRを生成し終えたモジュールのトークン列とASTをまとめて解放する。
+    void releaseSyntax();
   };
 }
 
@@ -0,0 +1,156 @@
+#include "server.h"
+
+#include <iostream>
+#include <sstream>
+#include <filesystem>
+#include <cstdint>
+
+#include "config.h"
+#include "driver.h"
+#include "utils/resident_cache.h"
+#include "utils/time_report.h"
+
+namespace pickc
+{
+  namespace
+  {
+    // その場でプロセスを終了させるオプションと、サーバーの中では意味のないオプション。
+    bool isRejected(const std::string& arg)
+    {
+      return arg == "--help" || arg == "-h" || arg == "-?"
+        || arg == "--version" || arg == "-v"
+        || arg == "--server" || arg == "--connect" || arg == "--watch";
+    }
+    // 要求を処理せずに、エラーを応答する。クライアントが先に切断していてもかまわない。
+    void reject(LocalSocket& socket, const std::string& message)
+    {
+      const int32_t status = STATUS_INVALID_OPTION;
+      if(socket.send(&status, sizeof(status))) socket.sendString(std::string(CONSOLE_FG_RED) + message + CONSOLE_DEFAULT + "\n");
+    }
+    // std::coutへの出力を、破棄されるまでoutに付け替える。
+    class CaptureOutput
+    {
+      std::streambuf* prev;
+    public:
+      CaptureOutput(std::ostringstream& out) : prev(std::cout.rdbuf(out.rdbuf())) {}
+      ~CaptureOutput()
+      {
+        std::cout.flush();
+        std::cout.rdbuf(prev);
+      }
+    };
+  }
+  Server::Server(LocalSocket&& listener, const std::string& cacheDir) :
+    listener(std::move(listener)),
+    cacheDir(cacheDir)
+  {}
+  Result<Server, std::string> Server::open(const CompilerOption& option)
+  {
+    // 要求ごとにクライアントの作業ディレクトリへ移るので、パスは絶対パスにしておく。
+    std::error_code err;
+    const auto socketPath = std::filesystem::absolute(option.server, err);
+    if(err) return error("エラー: " + option.server + "を絶対パスにできません。");
+    const auto cacheDir = std::filesystem::absolute(option.cacheDir.empty() ? socketPath.string() + ".cache" : option.cacheDir, err);
+    if(err) return error("エラー: " + option.cacheDir + "を絶対パスにできません。");
+    auto listener = LocalSocket::listen(socketPath.string());
+    if(!listener) return error(std::move(listener.err()));
+    ResidentCache::enable();
+    return Result<Server, std::string>(Server(std::move(listener.get()), cacheDir.string()));
+  }
+  int Server::handle(const std::string& cwd, std::vector<std::string>& args)
+  {
+    std::error_code err;
+    std::filesystem::current_path(cwd, err);
+    if(err) {
+      std::cout << CONSOLE_FG_RED << "エラー: 作業ディレクトリ" << cwd << "に移動できません。" << CONSOLE_DEFAULT << std::endl;
+      return STATUS_INVALID_OPTION;
+    }
+    for(const auto& arg : args) {
+      if(isRejected(arg)) {
+        std::cout << CONSOLE_FG_RED << "エラー: " << arg << "はサーバーでは使えません。" << CONSOLE_DEFAULT << std::endl;
+        return STATUS_INVALID_OPTION;
+      }
+    }
+    // 引数がなければCompilerOption::createが使用方法を出して終了してしまうので、先に弾く。
+    if(args.size() <= 1) {
+      std::cout << CONSOLE_FG_RED << "エラー: 引数がありません。" << CONSOLE_DEFAULT << std::endl;
+      return STATUS_INVALID_OPTION;
+    }
+    std::vector<char*> argv;
+    for(auto& arg : args) argv.push_back(arg.data());
+    auto option = CompilerOption::create(static_cast<int>(argv.size()), argv.data());
+    if(!option) {
+      std::cout << CONSOLE_FG_RED << option.err() << CONSOLE_DEFAULT << std::endl;
+      return STATUS_INVALID_OPTION;
+    }
+    if(option.get().cacheDir.empty()) option.get().cacheDir = cacheDir;
+    return runCompiler(option.get());
+  }
+  bool Server::serveOne()
+  {
+    auto connection = listener.accept();
+    if(!connection) {
+      std::cout << CONSOLE_FG_RED << connection.err() << CONSOLE_DEFAULT << std::endl;
+      return false;
+    }
+    auto& socket = connection.get();
+    // 要求はサーバーの所有者の権限でファイルを読み書きするので、他のユーザーからは受け付けない。
+    if(!socket.fromSameUser()) {
+      reject(socket, "エラー: サーバーを起動したユーザー以外からの要求は受け付けません。");
+      return true;
+    }
+    // 長さと数はクライアントが送ってきたものなので、上限を超えていたら確保せずに断る。
+    std::string cwd;
+    uint32_t argc;
+    if(!socket.receiveString(cwd, MAX_SERVER_STRING_SIZE) || !socket.receive(&argc, sizeof(argc)) || argc > MAX_SERVER_ARGS) {
+      reject(socket, "エラー: 要求が大きすぎるか、途中で切れています。");
+      return true;
+    }
+    std::vector<std::string> args(argc);
+    for(auto& arg : args) {
+      if(!socket.receiveString(arg, MAX_SERVER_STRING_SIZE)) {
+        reject(socket, "エラー: 要求が大きすぎるか、途中で切れています。");
+        return true;
+      }
+    }
+    std::ostringstream out;
+    int32_t status;
+    {
+      CaptureOutput capture(out);
+      status = handle(cwd, args);
+    }
+    // クライアントが先に切断していても、次の要求は受け付ける。
+    if(socket.send(&status, sizeof(status))) socket.sendString(out.str());
+    if(TimeReport::processPeakRSS() > MAX_RESIDENT_PEAK_RSS) {
+      std::cout << "pickc: メモリの使用量が上限を超えたので、サーバーを終了します。" << std::endl;
+      return false;
+    }
+    return true;
+  }
+  int Server::run()
+  {
+    std::cout << "pickc: サーバーを起動しました。キャッシュ: " << cacheDir << std::endl;
+    while(serveOne());
+    return STATUS_SERVER_ERROR;
+  }
+  Option<int> forwardToServer(const std::string& socketPath, const std::vector<std::string>& args)
+  {
+    auto connection = LocalSocket::connect(socketPath);
+    if(!connection) return none;
+    auto& socket = connection.get();
+    std::error_code err;
+    const auto cwd = std::filesystem::current_path(err).string();
+    bool sent = socket.sendString(cwd);
+    const auto argc = static_cast<uint32_t>(args.size());
+    sent = sent && socket.send(&argc, sizeof(argc));
+    for(const auto& arg : args) sent = sent && socket.sendString(arg);
+    int32_t status;
+    std::string output;
+    if(!sent || !socket.receive(&status, sizeof(status)) || !socket.receiveString(output)) {
+      std::cout << CONSOLE_FG_RED << "エラー: サーバーとの通信が途中で切れました。" << CONSOLE_DEFAULT << std::endl;
+      return some(STATUS_SERVER_ERROR);
+    }
+    std::cout << output << std::flush;
+    return some(static_cast<int>(status));
+  }
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef PICKC_PICKC_SERVER_H_
+#define PICKC_PICKC_SERVER_H_
+
+#include <string>
+#include <vector>
+
+#include "compiler_option.h"
+#include "utils/local_socket.h"
+#include "utils/option.h"
+#include "utils/result.h"
+
+namespace pickc
+{
+  // --serverのコンパイルサーバー。1つの接続で1つの要求を受け付け、要求は届いた順に1つずつ処理する。
+  // 要求はクライアントの作業ディレクトリとコマンドライン引数で、応答は終了コードと標準出力に出すはずだった内容。
+  // 構文解析とモジュールごとのPCIRのキャッシュ、ライブラリの記号表はプロセスに常駐させ、要求をまたいで再利用する。
+  class Server
+  {
+    LocalSocket listener;
+    // 要求に--cache-dirがなければこれを使う。
+    std::string cacheDir;
+    Server(LocalSocket&& listener, const std::string& cacheDir);
+    int handle(const std::string& cwd, std::vector<std::string>& args);
+  public:
+    static Result<Server, std::string> open(const CompilerOption& option);
+    // 接続を1つ受け付けて処理する。受け付けられないか、メモリの使用量が上限を超えたらfalseを返す。
+    bool serveOne();
+    // serveOneがfalseを返すまで処理を続ける。
+    int run();
+  };
+  // --connect。argsをsocketPathのサーバーに送ってコンパイルさせ、出力を標準出力に出して終了コードを返す。
+  // サーバーに接続できなければnoneを返す。
+  Option<int> forwardToServer(const std::string& socketPath, const std::vector<std::string>& args);
+}
+
+#endif // PICKC_PICKC_SERVER_H_
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "watch.h"
+
+#include <iostream>
+#include <filesystem>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "config.h"
+#include "driver.h"
+#include "utils/file_watcher.h"
+#include "utils/resident_cache.h"
+#include "utils/time_report.h"
+#include "utils/hash.h"
+#include "utils/option.h"
+
+namespace pickc
+{
+  namespace
+  {
+    // ユーザーごとのキャッシュディレクトリ。環境変数がなければ空。
+    std::filesystem::path userCacheDir()
+    {
+    #ifdef _WIN32
+      if(const auto local = std::getenv("LOCALAPPDATA"); local && *local) return std::filesystem::path(local) / "pickc";
+    #else
+      if(const auto xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) return std::filesystem::path(xdg) / "pickc";
+      if(const auto home = std::getenv("HOME"); home && *home) return std::filesystem::path(home) / ".cache" / "pickc";
+    #endif
+      return std::filesystem::path();
+    }
+    // --cache-dirがなければ、ユーザーごとのキャッシュディレクトリの下に、ソースディレクトリごとのディレクトリを作って使う。
+    // ソースディレクトリの中に作ると、モジュールとして構文解析されてしまう。
+    // 共有の一時ディレクトリに決まった名前で作ると、他のユーザーに先に作られて中身をすり替えられる。
+    // 作れなければnoneを返す。
+    Option<std::string> defaultCacheDir(const std::string& srcDir)
+    {
+      const auto base = userCacheDir();
+      if(base.empty()) return none;
+      std::error_code err;
+      const auto dir = std::filesystem::absolute(srcDir, err).lexically_normal().string();
+      char name[23];
+      std::snprintf(name, sizeof(name), "watch-%016llx", static_cast<unsigned long long>(hashBytes(dir)));
+      const auto cacheDir = base / name;
+      std::filesystem::create_directories(cacheDir, err);
+      if(err) return none;
+      // 所有者だけが読み書きできるようにする。
+      for(const auto& path : { base, cacheDir }) {
+        std::filesystem::permissions(path, std::filesystem::perms::owner_all, std::filesystem::perm_options::replace, err);
+        if(err) return none;
+      }
+      return some(cacheDir.string());
+    }
+    double milliseconds(std::chrono::steady_clock::duration duration)
+    {
+      return std::chrono::duration<double, std::milli>(duration).count();
+    }
+    // ビルドして結果を出す。firstは最初の変更を受け取った時刻。
+    void build(const CompilerOption& option, std::chrono::steady_clock::time_point first)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      const auto status = runCompiler(option);
+      const auto end = std::chrono::steady_clock::now();
+      if(status == STATUS_SUCCESS) {
+        std::cout << CONSOLE_FG_GREEN << "pickc: ビルドしました。";
+      }
+      else {
+        std::cout << CONSOLE_FG_RED << "pickc: ビルドに失敗しました(終了コード " << status << ")。";
+      }
+      std::cout << "変更から " << milliseconds(end - first) << " ms、コンパイル " << milliseconds(end - start) << " ms" << CONSOLE_DEFAULT << std::endl;
+    }
+  }
+  int watch(CompilerOption option)
+  {
+    auto watcher = FileWatcher::open(option.srcDir);
+    if(!watcher) {
+      std::cout << CONSOLE_FG_RED << watcher.err() << CONSOLE_DEFAULT << std::endl;
+      return STATUS_WATCH_ERROR;
+    }
+    if(option.cacheDir.empty()) {
+      const auto cacheDir = defaultCacheDir(option.srcDir);
+      if(!cacheDir) {
+        std::cout << CONSOLE_FG_RED << "エラー: キャッシュのディレクトリを作れません。--cache-dirを指定してください。" << CONSOLE_DEFAULT << std::endl;
+        return STATUS_WATCH_ERROR;
+      }
+      option.cacheDir = cacheDir.get();
+    }
+    ResidentCache::enable();
+    std::cout << "pickc: " << option.srcDir << "を監視しています。キャッシュ: " << option.cacheDir << std::endl;
+    build(option, std::chrono::steady_clock::now());
+    while(true) {
+      auto changes = watcher.get().wait();
+      if(!changes) {
+        std::cout << CONSOLE_FG_RED << changes.err() << CONSOLE_DEFAULT << std::endl;
+        return STATUS_WATCH_ERROR;
+      }
+      for(const auto& path : changes.get().paths) std::cout << "pickc: 変更 " << path << std::endl;
+      build(option, changes.get().first);
+      if(TimeReport::processPeakRSS() > MAX_RESIDENT_PEAK_RSS) {
+        std::cout << "pickc: メモリの使用量が上限を超えたので、監視を終了します。" << std::endl;
+        return STATUS_WATCH_ERROR;
+      }
+    }
+  }
+}
\ No newline at end of file
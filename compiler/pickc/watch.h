@@ -0,0 +1,15 @@
+#ifndef PICKC_PICKC_WATCH_H_
+#define PICKC_PICKC_WATCH_H_
+
+#include "compiler_option.h"
+
+namespace pickc
+{
+  // --watch。ビルドした後、option.srcDirの.pickファイルが変わるたびにビルドし直し、変更から出力までの時間を出す。
+  // 構文解析の結果とモジュールごとのPCIRはResidentCacheに常駐させるので、構文解析し直すのは変わったファイルだけで、
+  // 意味解析し直すのはPCIRCacheの判定で古くなったモジュールだけになる。
+  // 監視を続けられなくなったときだけ戻る。
+  int watch(CompilerOption option);
+}
+
+#endif // PICKC_PICKC_WATCH_H_
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "arena.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace pickc
+{
+  namespace
+  {
+    // 1ブロックの大きさ。これより大きい確保には専用のブロックを割り当てる。
+    constexpr size_t chunkSize = 64 * 1024;
+  }
+  Arena::Arena() :
+    chunks(nullptr),
+    cur(nullptr),
+    end(nullptr),
+    destructors(nullptr),
+    numAllocations(0),
+    numBytes(0),
+    numChunks(0)
+  {}
+  Arena::~Arena()
+  {
+    release();
+  }
+  void* Arena::allocateSlow(size_t size, size_t align)
+  {
+    const auto header = (sizeof(Chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    const auto capacity = std::max(chunkSize, header + size + align);
+    auto chunk = static_cast<Chunk*>(std::malloc(capacity));
+    if(chunk == nullptr) throw std::bad_alloc();
+    chunk->next = chunks;
+    chunk->size = capacity;
+    chunks = chunk;
+    ++numChunks;
+    cur = reinterpret_cast<char*>(chunk) + header;
+    end = reinterpret_cast<char*>(chunk) + capacity;
+    const auto p = (reinterpret_cast<uintptr_t>(cur) + align - 1) & ~static_cast<uintptr_t>(align - 1);
+    cur = reinterpret_cast<char*>(p + size);
+    return reinterpret_cast<void*>(p);
+  }
+  void Arena::release()
+  {
+    for(auto destructor = destructors; destructor != nullptr; destructor = destructor->next) {
+      destructor->destroy(destructor->object);
+    }
+    destructors = nullptr;
+    while(chunks != nullptr) {
+      auto next = chunks->next;
+      std::free(chunks);
+      chunks = next;
+    }
+    cur = nullptr;
+    end = nullptr;
+  }
+  size_t Arena::allocationCount() const
+  {
+    return numAllocations;
+  }
+  size_t Arena::allocatedBytes() const
+  {
+    return numBytes;
+  }
+  size_t Arena::chunkCount() const
+  {
+    return numChunks;
+  }
+}
\ No newline at end of file
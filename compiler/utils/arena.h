@@ -0,0 +1,103 @@
+#ifndef PICKC_UTILS_ARENA_H_
+#define PICKC_UTILS_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+#include <type_traits>
+
+namespace pickc
+{
+  // ポインタを進めるだけで確保し、releaseでまとめて解放するアロケータ。
+  // デストラクタが必要なオブジェクトは確保時に登録しておき、解放時に確保と逆順で呼び出す。
+  class Arena
+  {
+    struct Chunk
+    {
+      Chunk* next;
+      size_t size;
+    };
+    struct Destructor
+    {
+      void (*destroy)(void* object);
+      void* object;
+      Destructor* next;
+    };
+    Chunk* chunks;
+    char* cur;
+    char* end;
+    Destructor* destructors;
+    size_t numAllocations;
+    size_t numBytes;
+    size_t numChunks;
+    void* allocateSlow(size_t size, size_t align);
+  public:
+    Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena();
+    void* allocate(size_t size, size_t align)
+    {
+      ++numAllocations;
+      numBytes += size;
+      const auto p = (reinterpret_cast<uintptr_t>(cur) + align - 1) & ~static_cast<uintptr_t>(align - 1);
+      if(cur != nullptr && p + size <= reinterpret_cast<uintptr_t>(end)) {
+        cur = reinterpret_cast<char*>(p + size);
+        return reinterpret_cast<void*>(p);
+      }
+      return allocateSlow(size, align);
+    }
+    template<typename T, typename... Args>
+    T* make(Args&&... args)
+    {
+      auto object = new(allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+      if constexpr(!std::is_trivially_destructible_v<T>) {
+        auto destructor = static_cast<Destructor*>(allocate(sizeof(Destructor), alignof(Destructor)));
+        destructor->destroy = [](void* p) { static_cast<T*>(p)->~T(); };
+        destructor->object = object;
+        destructor->next = destructors;
+        destructors = destructor;
+      }
+      return object;
+    }
+    // 確保したものをすべて解放する。解放後も続けて使える。
+    void release();
+    // これまでの確保の回数とバイト数、OSから取得したブロックの数。releaseでは戻らない。
+    size_t allocationCount() const;
+    size_t allocatedBytes() const;
+    size_t chunkCount() const;
+  };
+  // Arenaから確保するSTLアロケータ。解放は何もせず、Arena::releaseでまとめて解放する。
+  template<typename T>
+  class ArenaAllocator
+  {
+    template<typename U> friend class ArenaAllocator;
+    Arena* arena;
+  public:
+    using value_type = T;
+    ArenaAllocator(Arena& arena) : arena(&arena) {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& allocator) : arena(allocator.arena) {}
+    T* allocate(size_t n)
+    {
+      return static_cast<T*>(arena->allocate(sizeof(T) * n, alignof(T)));
+    }
+    void deallocate(T*, size_t) {}
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& allocator) const
+    {
+      return arena == allocator.arena;
+    }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& allocator) const
+    {
+      return arena != allocator.arena;
+    }
+  };
+  template<typename T>
+  using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}
+
+#endif // PICKC_UTILS_ARENA_H_
\ No newline at end of file
@@ -5,29 +5,27 @@ namespace pickc
   template<>
   BinaryVec& operator<<(BinaryVec& vec, const BinaryVec& value)
   {
-    vec.reserve(vec.size() + value.size());
     vec.insert(vec.end(), value.begin(), value.end());
     return vec;
   }
   template<>
   BinaryVec& operator<<(BinaryVec& vec, const std::string& value)
   {
-    vec.reserve(vec.size() + value.size());
     vec.insert(vec.end(), value.begin(), value.end());
     return vec;
   }
-  uint8_t get8(const BinaryVec& vec, size_t& i)
+  uint8_t get8(BinaryView vec, size_t& i)
   {
     return vec[++i];
   }
-  uint16_t get16(const BinaryVec& vec, size_t& i)
+  uint16_t get16(BinaryView vec, size_t& i)
   {
     uint16_t u16 = 0;
     u16 |= (vec[++i] << 0);
     u16 |= (vec[++i] << 8);
     return u16;
   }
-  uint32_t get32(const BinaryVec& vec, size_t& i)
+  uint32_t get32(BinaryView vec, size_t& i)
   {
     uint32_t u32 = 0;
     u32 |= (vec[++i] << 0);
@@ -36,7 +34,7 @@ namespace pickc
     u32 |= (vec[++i] << 24);
     return u32;
   }
-  uint64_t get64(const BinaryVec& vec, size_t& i)
+  uint64_t get64(BinaryView vec, size_t& i)
   {
     uint64_t u64 = 0;
     u64 |= (static_cast<uint64_t>(vec[++i]) << 0);
@@ -49,15 +47,15 @@ namespace pickc
     u64 |= (static_cast<uint64_t>(vec[++i]) << 56);
     return u64;
   }
-  float getF32(const BinaryVec& vec, size_t& i)
+  float getF32(BinaryView vec, size_t& i)
   {
     return *reinterpret_cast<float*>(&subVec(vec, i, 4)[0]);
   }
-  double getF64(const BinaryVec& vec, size_t& i)
+  double getF64(BinaryView vec, size_t& i)
   {
     return *reinterpret_cast<double*>(&subVec(vec, i, 8)[0]);
   }
-  BinaryVec subVec(const BinaryVec& vec, size_t& i, size_t len)
+  BinaryVec subVec(BinaryView vec, size_t& i, size_t len)
   {
     BinaryVec result;
     result.reserve(len);
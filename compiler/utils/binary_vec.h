@@ -7,10 +7,10 @@
 namespace pickc
 {
   using BinaryVec = std::vector<uint8_t>;
+  // 追記する側でreserveしない。ちょうどの大きさにreserveすると、追記のたびに全体を確保し直すことになる。
   template<typename T>
   BinaryVec& operator<<(BinaryVec& vec, const T& value)
   {
-    vec.reserve(vec.size() + sizeof(T));
     for(int i = 0; i < sizeof(T); ++i) {
       vec.push_back(*(((uint8_t*)&value) + i));
     }
@@ -23,17 +23,32 @@ namespace pickc
   template<size_t N>
   BinaryVec& operator<<(BinaryVec& vec, const char (&value)[N])
   {
-    vec.reserve(vec.size() + N - 1);
     vec.insert(vec.end(), std::begin(value), std::end(value) - 1);
     return vec;
   }
-  uint8_t get8(const BinaryVec& vec, size_t& i);
-  uint16_t get16(const BinaryVec& vec, size_t& i);
-  uint32_t get32(const BinaryVec& vec, size_t& i);
-  uint64_t get64(const BinaryVec& vec, size_t& i);
-  float getF32(const BinaryVec& vec, size_t& i);
-  double getF64(const BinaryVec& vec, size_t& i);
-  BinaryVec subVec(const BinaryVec& vec, size_t& i, size_t len);
+  // ほかが持っているバイト列を指す。指す先を持たないので、指す先より長く使わないこと。
+  class BinaryView
+  {
+    const uint8_t* head;
+    size_t length;
+  public:
+    BinaryView() : head(nullptr), length(0) {}
+    BinaryView(const uint8_t* head, size_t length) : head(head), length(length) {}
+    BinaryView(const BinaryVec& vec) : head(vec.data()), length(vec.size()) {}
+    const uint8_t* data() const { return head; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    uint8_t operator[](size_t i) const { return head[i]; }
+    const uint8_t* begin() const { return head; }
+    const uint8_t* end() const { return head + length; }
+  };
+  uint8_t get8(BinaryView vec, size_t& i);
+  uint16_t get16(BinaryView vec, size_t& i);
+  uint32_t get32(BinaryView vec, size_t& i);
+  uint64_t get64(BinaryView vec, size_t& i);
+  float getF32(BinaryView vec, size_t& i);
+  double getF64(BinaryView vec, size_t& i);
+  BinaryVec subVec(BinaryView vec, size_t& i, size_t len);
 }
 
 #endif // PICKC_UTILS_BINARY_VEC_H_
\ No newline at end of file
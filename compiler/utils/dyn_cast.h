@@ -3,19 +3,33 @@
 
 #include <cassert>
 
+#include "instanceof.h"
+
 namespace pickc
 {
   template<typename To, typename From>
   inline To* dynCast(From* from)
   {
-    assert(dynamic_cast<To*>(from));
-    return dynamic_cast<To*>(from);
+    if constexpr(HasClassof<To, From*>::value) {
+      assert(instanceof<To>(from));
+      return static_cast<To*>(from);
+    }
+    else {
+      assert(dynamic_cast<To*>(from));
+      return dynamic_cast<To*>(from);
+    }
   }
   template<typename To, typename From>
   inline const To* dynCast(const From* from)
   {
-    assert(dynamic_cast<const To*>(from));
-    return dynamic_cast<const To*>(from);
+    if constexpr(HasClassof<To, const From*>::value) {
+      assert(instanceof<To>(from));
+      return static_cast<const To*>(from);
+    }
+    else {
+      assert(dynamic_cast<const To*>(from));
+      return dynamic_cast<const To*>(from);
+    }
   }
 }
 
@@ -0,0 +1,180 @@
+#include "file_watcher.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+
+#include "string_utils.h"
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <sys/inotify.h>
+  #include <poll.h>
+  #include <unistd.h>
+  #include <cerrno>
+#endif
+
+namespace pickc
+{
+#ifdef _WIN32
+  struct FileWatcher::State
+  {
+    std::string root;
+    HANDLE dir = INVALID_HANDLE_VALUE;
+    HANDLE event = nullptr;
+    OVERLAPPED overlapped{};
+    // FILE_NOTIFY_INFORMATIONはDWORD境界に置かれる。
+    std::vector<DWORD> buffer = std::vector<DWORD>(16 * 1024);
+    ~State()
+    {
+      if(dir != INVALID_HANDLE_VALUE) {
+        CancelIo(dir);
+        CloseHandle(dir);
+      }
+      if(event != nullptr) CloseHandle(event);
+    }
+    bool startRead()
+    {
+      ResetEvent(event);
+      overlapped = OVERLAPPED{};
+      overlapped.hEvent = event;
+      const DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+      return ReadDirectoryChangesW(dir, buffer.data(), static_cast<DWORD>(buffer.size() * sizeof(DWORD)), TRUE, filter, nullptr, &overlapped, nullptr) != 0;
+    }
+  };
+#else
+  struct FileWatcher::State
+  {
+    std::string root;
+    int fd = -1;
+    // inotifyのwatch descriptorと監視しているディレクトリ。
+    std::unordered_map<int, std::string> dirs;
+    ~State()
+    {
+      if(fd >= 0) ::close(fd);
+    }
+    // inotifyはサブディレクトリを監視しないので、dir以下のディレクトリをすべて登録する。
+    void addWatches(const std::string& dir)
+    {
+      constexpr uint32_t mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+      const auto wd = inotify_add_watch(fd, dir.c_str(), mask);
+      if(wd < 0) return;
+      dirs[wd] = dir;
+      std::error_code err;
+      for(std::filesystem::directory_iterator itr(dir, err), end; itr != end && !err; itr.increment(err)) {
+        if(itr->is_directory(err)) addWatches(itr->path().string());
+      }
+    }
+  };
+#endif
+  FileWatcher::FileWatcher(std::unique_ptr<State> state) : state(std::move(state)) {}
+  FileWatcher::FileWatcher(FileWatcher&& watcher) = default;
+  FileWatcher& FileWatcher::operator=(FileWatcher&& watcher) = default;
+  FileWatcher::~FileWatcher() = default;
+  Result<FileWatcher, std::string> FileWatcher::open(const std::string& dir)
+  {
+    std::error_code err;
+    if(!std::filesystem::is_directory(dir, err)) return error("エラー: " + dir + "はディレクトリではありません。");
+    auto state = std::make_unique<State>();
+    state->root = dir;
+  #ifdef _WIN32
+    state->dir = CreateFileW(std::filesystem::path(dir).wstring().c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+      nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    if(state->dir == INVALID_HANDLE_VALUE) return error("エラー: " + dir + "を監視できません。");
+    state->event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if(state->event == nullptr || !state->startRead()) return error("エラー: " + dir + "を監視できません。");
+  #else
+    state->fd = inotify_init1(IN_CLOEXEC);
+    if(state->fd < 0) return error("エラー: inotifyを初期化できません。");
+    state->addWatches(dir);
+    if(state->dirs.empty()) return error("エラー: " + dir + "を監視できません。");
+  #endif
+    return Result<FileWatcher, std::string>(FileWatcher(std::move(state)));
+  }
+  bool FileWatcher::poll(std::chrono::milliseconds timeout)
+  {
+  #ifdef _WIN32
+    return WaitForSingleObject(state->event, timeout.count() < 0 ? INFINITE : static_cast<DWORD>(timeout.count())) != WAIT_TIMEOUT;
+  #else
+    pollfd fd{ state->fd, POLLIN, 0 };
+    while(true) {
+      const auto n = ::poll(&fd, 1, timeout.count() < 0 ? -1 : static_cast<int>(timeout.count()));
+      if(n < 0 && errno == EINTR) continue;
+      return n != 0;
+    }
+  #endif
+  }
+  bool FileWatcher::read(std::vector<std::string>& paths)
+  {
+  #ifdef _WIN32
+    DWORD size;
+    if(!GetOverlappedResult(state->dir, &state->overlapped, &size, FALSE)) return false;
+    // バッファに収まらなかったときは何が変わったか分からないので、全体が変わったことにする。
+    if(size == 0) paths.push_back(state->root);
+    for(auto cur = reinterpret_cast<const char*>(state->buffer.data()); size != 0;) {
+      const auto info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(cur);
+      const auto path = std::filesystem::path(state->root) / std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR));
+      std::error_code err;
+      const auto removed = info->Action == FILE_ACTION_REMOVED || info->Action == FILE_ACTION_RENAMED_OLD_NAME;
+      // 消されたものはディレクトリだったか分からないので、拡張子がなければディレクトリとみなす。
+      if(path.extension() == ".pick" || std::filesystem::is_directory(path, err) || (removed && !path.has_extension())) {
+        paths.push_back(path.string());
+      }
+      if(info->NextEntryOffset == 0) break;
+      cur += info->NextEntryOffset;
+    }
+    return state->startRead();
+  #else
+    alignas(inotify_event) char buffer[16 * 1024];
+    ssize_t size;
+    do {
+      size = ::read(state->fd, buffer, sizeof(buffer));
+    } while(size < 0 && errno == EINTR);
+    if(size <= 0) return false;
+    for(auto cur = buffer; cur < buffer + size;) {
+      const auto event = reinterpret_cast<const inotify_event*>(cur);
+      cur += sizeof(inotify_event) + event->len;
+      // 溢れたときは何が変わったか分からないので、全体が変わったことにする。
+      if(event->mask & IN_Q_OVERFLOW) {
+        paths.push_back(state->root);
+        continue;
+      }
+      // 監視していたディレクトリが消された。
+      if(event->mask & IN_IGNORED) {
+        state->dirs.erase(event->wd);
+        continue;
+      }
+      const auto dir = state->dirs.find(event->wd);
+      if(dir == state->dirs.end() || event->len == 0) continue;
+      const std::string name(event->name);
+      const auto path = (std::filesystem::path(dir->second) / name).string();
+      if(event->mask & IN_ISDIR) {
+        // 新しいディレクトリは、中にファイルが作られる前に監視を始める。
+        if(event->mask & (IN_CREATE | IN_MOVED_TO)) state->addWatches(path);
+        paths.push_back(path);
+      }
+      else if(endsWith(name, ".pick")) paths.push_back(path);
+    }
+    return true;
+  #endif
+  }
+  Result<FileWatcher::Changes, std::string> FileWatcher::wait()
+  {
+    Changes changes;
+    while(changes.paths.empty()) {
+      poll(std::chrono::milliseconds(-1));
+      if(!read(changes.paths)) return error("エラー: " + state->root + "の変更を受け取れなくなりました。");
+      changes.first = std::chrono::steady_clock::now();
+    }
+    while(poll(QUIET_PERIOD)) {
+      if(!read(changes.paths)) return error("エラー: " + state->root + "の変更を受け取れなくなりました。");
+    }
+    std::sort(changes.paths.begin(), changes.paths.end());
+    changes.paths.erase(std::unique(changes.paths.begin(), changes.paths.end()), changes.paths.end());
+    return ok(changes);
+  }
+}
\ No newline at end of file
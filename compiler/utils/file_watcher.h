@@ -0,0 +1,50 @@
+#ifndef PICKC_UTILS_FILE_WATCHER_H_
+#define PICKC_UTILS_FILE_WATCHER_H_
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <memory>
+
+#include "result.h"
+
+namespace pickc
+{
+  // ディレクトリ以下の.pickファイルの変更を待つ。Linuxではinotifyでディレクトリを1つずつ監視し、
+  // WindowsではReadDirectoryChangesWでサブツリーごと監視する。
+  // ムーブのみ可能で、破棄時に監視をやめる。
+  class FileWatcher
+  {
+  public:
+    // 最後の変更からこれだけ変更がなければ、一連の変更が終わったとみなす。
+    // エディタの保存やgit checkoutでは複数の変更がまとめて届くので、1回の再ビルドで済ませる。
+    static constexpr std::chrono::milliseconds QUIET_PERIOD{ 50 };
+    struct Changes
+    {
+      // 変更された.pickファイルと、作られたり消されたりしたディレクトリのパス。名前順で重複はない。
+      std::vector<std::string> paths;
+      // 最初の変更を受け取った時刻。
+      std::chrono::steady_clock::time_point first;
+    };
+  private:
+    // プラットフォームごとのハンドルと受信用のバッファ。
+    struct State;
+    std::unique_ptr<State> state;
+    FileWatcher(std::unique_ptr<State> state);
+    // 届いている変更をpathsに加える。受け取れなくなったらfalseを返す。
+    bool read(std::vector<std::string>& paths);
+    // 変更が届くまで最大timeoutだけ待つ。timeoutが負なら届くまで待つ。届いているか、待てなくなったらtrueを返す。
+    bool poll(std::chrono::milliseconds timeout);
+  public:
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher(FileWatcher&& watcher);
+    FileWatcher& operator=(const FileWatcher&) = delete;
+    FileWatcher& operator=(FileWatcher&& watcher);
+    ~FileWatcher();
+    static Result<FileWatcher, std::string> open(const std::string& dir);
+    // .pickファイルかディレクトリの変更が届き、その後QUIET_PERIODだけ変更がなくなるまで待つ。
+    Result<Changes, std::string> wait();
+  };
+}
+
+#endif // PICKC_UTILS_FILE_WATCHER_H_
\ No newline at end of file
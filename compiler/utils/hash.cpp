@@ -0,0 +1,62 @@
+#include "hash.h"
+
+#include <cstring>
+
+namespace pickc
+{
+  namespace
+  {
+    constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t PRIME3 = 0x165667B19E3779F9ull;
+    constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ull;
+    inline uint64_t rotl(uint64_t x, int r)
+    {
+      return (x << r) | (x >> (64 - r));
+    }
+    inline uint64_t read64(const uint8_t* p)
+    {
+      uint64_t value;
+      std::memcpy(&value, p, sizeof(value));
+      return value;
+    }
+    inline uint64_t round(uint64_t acc, uint64_t input)
+    {
+      acc += input * PRIME2;
+      acc = rotl(acc, 31);
+      return acc * PRIME1;
+    }
+    inline uint64_t merge(uint64_t acc, uint64_t lane)
+    {
+      acc ^= round(0, lane);
+      return acc * PRIME1 + PRIME4;
+    }
+  }
+  uint64_t hashBytes(const void* data, size_t size, uint64_t seed)
+  {
+    auto p = static_cast<const uint8_t*>(data);
+    const auto end = p + size;
+    uint64_t h;
+    if(size >= 32) {
+      uint64_t lanes[4] = { seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1 };
+      for(; p + 32 <= end; p += 32) {
+        for(int i = 0; i < 4; ++i) lanes[i] = round(lanes[i], read64(p + i * 8));
+      }
+      h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+      for(auto lane : lanes) h = merge(h, lane);
+    }
+    else {
+      h = seed + PRIME3;
+    }
+    h += size;
+    for(; p + 8 <= end; p += 8) h = rotl(h ^ round(0, read64(p)), 27) * PRIME1 + PRIME4;
+    for(; p < end; ++p) h = rotl(h ^ (*p * PRIME3), 11) * PRIME1;
+    // 最後に全ビットを混ぜる。
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    h *= PRIME3;
+    h ^= h >> 32;
+    return h;
+  }
+}
\ No newline at end of file
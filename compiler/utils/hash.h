@@ -0,0 +1,19 @@
+#ifndef PICKC_UTILS_HASH_H_
+#define PICKC_UTILS_HASH_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+namespace pickc
+{
+  // 暗号学的な強度を持たない高速な64bitハッシュ。キャッシュのキーなど、内容の同一性の判定に使う。
+  // 8バイトずつ4系統に分けて混ぜるので、長い入力でも1バイトあたり数命令で済む。
+  uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0);
+  inline uint64_t hashBytes(std::string_view str, uint64_t seed = 0)
+  {
+    return hashBytes(str.data(), str.size(), seed);
+  }
+}
+
+#endif // PICKC_UTILS_HASH_H_
\ No newline at end of file
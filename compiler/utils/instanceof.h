@@ -1,12 +1,26 @@
 #ifndef PICKC_UTILS_INSTANCEOF_H_
 #define PICKC_UTILS_INSTANCEOF_H_
 
+#include <type_traits>
+#include <utility>
+
 namespace pickc
 {
+  // Ofがstatic bool classof(const Base*)を持つクラス階層では、種類のタグで判定する。
+  template <typename Of, typename What, typename = void>
+  struct HasClassof : std::false_type {};
+  template <typename Of, typename What>
+  struct HasClassof<Of, What, std::void_t<decltype(Of::classof(std::declval<What>()))>> : std::true_type {};
+
   template <typename Of, typename What>
   inline bool instanceof(const What w)
   {
-    return dynamic_cast<const Of*>(w) != nullptr;
+    if constexpr(HasClassof<Of, What>::value) {
+      return w != nullptr && Of::classof(w);
+    }
+    else {
+      return dynamic_cast<const Of*>(w) != nullptr;
+    }
   }
 }
 
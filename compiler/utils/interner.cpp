@@ -0,0 +1,97 @@
+#include "interner.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <cstring>
+
+#include "arena.h"
+#include "hash.h"
+#include "sharded_table.h"
+
+namespace pickc
+{
+  namespace
+  {
+    struct TextHash
+    {
+      size_t operator()(std::string_view text) const { return static_cast<size_t>(hashBytes(text)); }
+    };
+    struct Shard
+    {
+      std::mutex mutex;
+      std::unordered_map<std::string_view, uint32_t, TextHash> ids;
+      // key = (scope << 32) | name
+      std::unordered_map<uint64_t, uint32_t> joined;
+      // 文字列の本体。キーのstring_viewもここを指す。
+      Arena storage;
+    };
+    struct Table : ShardedTable<Shard, std::string_view, 12>
+    {
+      std::atomic<size_t> bytes;
+      Table() : ShardedTable(1), bytes(0)
+      {
+        set(0, std::string_view());
+      }
+    };
+    // 他の静的オブジェクトのデストラクタから使われても困らないように、解放しない。
+    Table& table()
+    {
+      static auto instance = new Table();
+      return *instance;
+    }
+  }
+  Atom Interner::intern(std::string_view text)
+  {
+    if(text.empty()) return Atom{};
+    auto& t = table();
+    auto& shard = t.shard(hashBytes(text));
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto itr = shard.ids.find(text);
+    if(itr != shard.ids.end()) return Atom{ itr->second };
+    const auto id = t.allocate();
+    auto data = static_cast<char*>(shard.storage.allocate(text.size(), 1));
+    std::memcpy(data, text.data(), text.size());
+    const std::string_view stored(data, text.size());
+    // 番号を他のスレッドに渡す前に表に書き込んでおく。
+    t.set(id, stored);
+    shard.ids.emplace(stored, id);
+    t.bytes.fetch_add(text.size(), std::memory_order_relaxed);
+    return Atom{ id };
+  }
+  Atom Interner::join(Atom scope, Atom name)
+  {
+    if(scope.empty()) return name;
+    auto& t = table();
+    const auto key = (static_cast<uint64_t>(scope.id) << 32) | name.id;
+    auto& shard = t.shard(key * 0x9E3779B97F4A7C15ull);
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto itr = shard.joined.find(key);
+      if(itr != shard.joined.end()) return Atom{ itr->second };
+    }
+    const auto scopeText = text(scope);
+    const auto nameText = text(name);
+    std::string qualified;
+    qualified.reserve(scopeText.size() + 2 + nameText.size());
+    qualified += scopeText;
+    qualified += "::";
+    qualified += nameText;
+    const auto atom = intern(qualified);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.joined.emplace(key, atom.id);
+    return atom;
+  }
+  std::string_view Interner::text(Atom atom)
+  {
+    return table().get(atom.id);
+  }
+  size_t Interner::size()
+  {
+    return table().size();
+  }
+  size_t Interner::bytes()
+  {
+    return table().bytes.load(std::memory_order_relaxed);
+  }
+}
\ No newline at end of file
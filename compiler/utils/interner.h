@@ -0,0 +1,57 @@
+#ifndef PICKC_UTILS_INTERNER_H_
+#define PICKC_UTILS_INTERNER_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <functional>
+
+namespace pickc
+{
+  // Internerに登録した文字列を表す32bitの番号。同じ文字列には同じ番号が付くので、比較とハッシュは整数で済む。
+  // 番号は登録した順に付くので、プロセスごと、ビルドごとに変わりうる。出力の順番には使わないこと。
+  struct Atom
+  {
+    // 0は空文字列
+    uint32_t id = 0;
+    static Atom intern(std::string_view text);
+    // scope::nameの完全修飾名
+    static Atom join(Atom scope, Atom name);
+    std::string_view text() const;
+    std::string str() const { return std::string(text()); }
+    bool empty() const { return id == 0; }
+    bool operator==(Atom atom) const { return id == atom.id; }
+    bool operator!=(Atom atom) const { return id != atom.id; }
+    bool operator<(Atom atom) const { return id < atom.id; }
+  };
+  // 字句解析からリンクまでで共有する、プロセス全体の文字列表。
+  // 登録した文字列はプロセスの終わりまで解放しないので、textの返す文字列はずっと有効。
+  // どのスレッドから呼んでもよい。internとjoinは文字列のハッシュで選んだ区画だけをロックし、textはロックしない。
+  class Interner
+  {
+  public:
+    static Atom intern(std::string_view text);
+    // intern(text(scope) + "::" + text(name))と同じ。(scope, name)の組ごとに結果を覚えておくので、
+    // 2回目からは文字列を連結せずに整数の表を引くだけで済む。
+    static Atom join(Atom scope, Atom name);
+    static std::string_view text(Atom atom);
+    // 登録した文字列の数と、文字列に使ったバイト数
+    static size_t size();
+    static size_t bytes();
+  };
+  inline Atom Atom::intern(std::string_view text) { return Interner::intern(text); }
+  inline Atom Atom::join(Atom scope, Atom name) { return Interner::join(scope, name); }
+  inline std::string_view Atom::text() const { return Interner::text(*this); }
+}
+
+namespace std
+{
+  template<>
+  struct hash<pickc::Atom>
+  {
+    size_t operator()(pickc::Atom atom) const { return std::hash<uint32_t>()(atom.id); }
+  };
+}
+
+#endif // PICKC_UTILS_INTERNER_H_
\ No newline at end of file
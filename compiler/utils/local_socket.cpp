@@ -0,0 +1,219 @@
+#include "local_socket.h"
+
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <winsock2.h>
+  #include <afunix.h>
+#else
+  #include <sys/socket.h>
+  #include <sys/stat.h>
+  #include <sys/un.h>
+  #include <unistd.h>
+  #include <cerrno>
+#endif
+
+namespace pickc
+{
+  namespace
+  {
+  #ifdef _WIN32
+    constexpr intptr_t INVALID = static_cast<intptr_t>(INVALID_SOCKET);
+    SOCKET native(intptr_t handle)
+    {
+      return static_cast<SOCKET>(handle);
+    }
+    bool startup()
+    {
+      static const bool started = [] {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+      }();
+      return started;
+    }
+  #else
+    constexpr intptr_t INVALID = -1;
+    int native(intptr_t handle)
+    {
+      return static_cast<int>(handle);
+    }
+  #endif
+    // sun_pathに収まらないパスは使えない。
+    bool makeAddress(const std::string& path, sockaddr_un& addr)
+    {
+      std::memset(&addr, 0, sizeof(addr));
+      addr.sun_family = AF_UNIX;
+      if(path.size() >= sizeof(addr.sun_path)) return false;
+      std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+      return true;
+    }
+    intptr_t openSocket()
+    {
+    #ifdef _WIN32
+      if(!startup()) return INVALID;
+      return static_cast<intptr_t>(::socket(AF_UNIX, SOCK_STREAM, 0));
+    #else
+      return ::socket(AF_UNIX, SOCK_STREAM, 0);
+    #endif
+    }
+  }
+  LocalSocket::LocalSocket() : handle(INVALID) {}
+  LocalSocket::LocalSocket(LocalSocket&& socket) : LocalSocket()
+  {
+    *this = std::move(socket);
+  }
+  LocalSocket& LocalSocket::operator=(LocalSocket&& socket)
+  {
+    if(this != &socket) {
+      close();
+      std::swap(handle, socket.handle);
+      std::swap(boundPath, socket.boundPath);
+    }
+    return *this;
+  }
+  LocalSocket::~LocalSocket()
+  {
+    close();
+  }
+  void LocalSocket::close()
+  {
+    if(handle != INVALID) {
+    #ifdef _WIN32
+      closesocket(native(handle));
+    #else
+      ::close(native(handle));
+    #endif
+    }
+    handle = INVALID;
+    if(!boundPath.empty()) {
+      std::error_code err;
+      std::filesystem::remove(boundPath, err);
+      boundPath.clear();
+    }
+  }
+  Result<LocalSocket, std::string> LocalSocket::listen(const std::string& path)
+  {
+    sockaddr_un addr;
+    if(!makeAddress(path, addr)) return error("エラー: ソケットのパス " + path + " が長すぎます。");
+    LocalSocket socket;
+    socket.handle = openSocket();
+    if(socket.handle == INVALID) return error("エラー: ソケットが作れませんでした。");
+    // 前回のサーバーが残したソケットだけを消す。パスを打ち間違えてもソースファイルを消さないようにする。
+  #ifdef _WIN32
+    std::error_code err;
+    const auto status = std::filesystem::symlink_status(path, err);
+    if(std::filesystem::is_regular_file(status) || std::filesystem::is_directory(status)) {
+      return error("エラー: " + path + " は既に存在します。");
+    }
+    std::filesystem::remove(path, err);
+    const auto bound = ::bind(native(socket.handle), reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+  #else
+    struct stat st;
+    if(::lstat(path.c_str(), &st) == 0) {
+      if(!S_ISSOCK(st.st_mode)) return error("エラー: " + path + " は既に存在します。");
+      ::unlink(path.c_str());
+    }
+    // 他のユーザーが接続できないように、ソケットのファイルは0600で作る。
+    const auto mask = ::umask(0077);
+    const auto bound = ::bind(native(socket.handle), reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    ::umask(mask);
+  #endif
+    if(bound != 0) return error("エラー: ソケット " + path + " を作れませんでした。");
+    socket.boundPath = path;
+    if(::listen(native(socket.handle), SOMAXCONN) != 0) return error("エラー: ソケット " + path + " で待ち受けられませんでした。");
+    return Result<LocalSocket, std::string>(std::move(socket));
+  }
+  Result<LocalSocket, std::string> LocalSocket::connect(const std::string& path)
+  {
+    sockaddr_un addr;
+    if(!makeAddress(path, addr)) return error("エラー: ソケットのパス " + path + " が長すぎます。");
+    LocalSocket socket;
+    socket.handle = openSocket();
+    if(socket.handle == INVALID) return error("エラー: ソケットが作れませんでした。");
+    if(::connect(native(socket.handle), reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+      return error("エラー: ソケット " + path + " に接続できませんでした。");
+    }
+    return Result<LocalSocket, std::string>(std::move(socket));
+  }
+  Result<LocalSocket, std::string> LocalSocket::accept()
+  {
+    LocalSocket socket;
+    while(true) {
+      socket.handle = static_cast<intptr_t>(::accept(native(handle), nullptr, nullptr));
+      // 待っている間に相手が切断した接続は飛ばして、次の接続を待つ。
+    #ifdef _WIN32
+      if(socket.handle == INVALID && (WSAGetLastError() == WSAEINTR || WSAGetLastError() == WSAECONNRESET)) continue;
+    #else
+      if(socket.handle == INVALID && (errno == EINTR || errno == ECONNABORTED)) continue;
+    #endif
+      break;
+    }
+    if(socket.handle == INVALID) return error("エラー: 接続を受け付けられませんでした。");
+    return Result<LocalSocket, std::string>(std::move(socket));
+  }
+  bool LocalSocket::fromSameUser() const
+  {
+  #if defined(_WIN32)
+    return true;
+  #elif defined(SO_PEERCRED)
+    ucred cred;
+    socklen_t size = sizeof(cred);
+    if(::getsockopt(native(handle), SOL_SOCKET, SO_PEERCRED, &cred, &size) != 0) return false;
+    return cred.uid == ::geteuid();
+  #else
+    uid_t uid;
+    gid_t gid;
+    if(::getpeereid(native(handle), &uid, &gid) != 0) return false;
+    return uid == ::geteuid();
+  #endif
+  }
+  bool LocalSocket::send(const void* data, size_t size)
+  {
+    auto cur = static_cast<const char*>(data);
+    while(size > 0) {
+    #ifdef _WIN32
+      const auto n = ::send(native(handle), cur, static_cast<int>(std::min<size_t>(size, 1 << 30)), 0);
+    #else
+      const auto n = ::send(native(handle), cur, size, MSG_NOSIGNAL);
+      if(n < 0 && errno == EINTR) continue;
+    #endif
+      if(n <= 0) return false;
+      cur += n;
+      size -= static_cast<size_t>(n);
+    }
+    return true;
+  }
+  bool LocalSocket::receive(void* data, size_t size)
+  {
+    auto cur = static_cast<char*>(data);
+    while(size > 0) {
+    #ifdef _WIN32
+      const auto n = ::recv(native(handle), cur, static_cast<int>(std::min<size_t>(size, 1 << 30)), 0);
+    #else
+      const auto n = ::recv(native(handle), cur, size, 0);
+      if(n < 0 && errno == EINTR) continue;
+    #endif
+      if(n <= 0) return false;
+      cur += n;
+      size -= static_cast<size_t>(n);
+    }
+    return true;
+  }
+  bool LocalSocket::sendString(const std::string& str)
+  {
+    const auto size = static_cast<uint32_t>(str.size());
+    return send(&size, sizeof(size)) && send(str.data(), str.size());
+  }
+  bool LocalSocket::receiveString(std::string& str, size_t maxSize)
+  {
+    uint32_t size;
+    if(!receive(&size, sizeof(size)) || size > maxSize) return false;
+    str.resize(size);
+    return receive(str.data(), size);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef PICKC_UTILS_LOCAL_SOCKET_H_
+#define PICKC_UTILS_LOCAL_SOCKET_H_
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#include "result.h"
+
+namespace pickc
+{
+  // Unixドメインソケット。WindowsではAF_UNIXに対応したWinsockを使う。
+  // ムーブのみ可能で、破棄時に閉じる。
+  class LocalSocket
+  {
+    intptr_t handle;
+    // listenしたソケットならパス。閉じるときにファイルを消す。
+    std::string boundPath;
+    LocalSocket();
+    void close();
+  public:
+    LocalSocket(const LocalSocket&) = delete;
+    LocalSocket(LocalSocket&& socket);
+    LocalSocket& operator=(const LocalSocket&) = delete;
+    LocalSocket& operator=(LocalSocket&& socket);
+    ~LocalSocket();
+    // pathに残っている古いソケットのファイルは消してから作る。ソケットでないファイルがあれば消さずにエラーを返す。
+    // ソケットのファイルは作ったユーザーだけが読み書きできる。
+    static Result<LocalSocket, std::string> listen(const std::string& path);
+    static Result<LocalSocket, std::string> connect(const std::string& path);
+    Result<LocalSocket, std::string> accept();
+    // 接続相手がこのプロセスと同じユーザーならtrueを返す。Windowsでは確かめられないので、常にtrueを返す。
+    bool fromSameUser() const;
+    // sizeバイトすべてを送る、または受け取るまで待つ。途中で切断されたらfalseを返す。
+    bool send(const void* data, size_t size);
+    bool receive(void* data, size_t size);
+    // 長さ(4バイト)の後に本体を送る。
+    bool sendString(const std::string& str);
+    // 長さがmaxSizeを超えていたら、本体を受け取らずにfalseを返す。
+    bool receiveString(std::string& str, size_t maxSize = UINT32_MAX);
+  };
+}
+
+#endif // PICKC_UTILS_LOCAL_SOCKET_H_
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "lz.h"
+
+#include <cstring>
+#include <cstdint>
+#include <vector>
+
+namespace pickc
+{
+  namespace
+  {
+    constexpr size_t MIN_MATCH = 4;
+    constexpr size_t MAX_DISTANCE = 0xFFFF;
+    // 関数の本体は数百バイトのものが多いので、ハッシュ表は入力の大きさに合わせて小さくする。
+    constexpr size_t MAX_HASH_BITS = 12;
+
+    uint32_t read32(const uint8_t* p)
+    {
+      uint32_t value;
+      std::memcpy(&value, p, 4);
+      return value;
+    }
+    uint32_t hash(uint32_t value, size_t bits)
+    {
+      return (value * 2654435761u) >> (32 - bits);
+    }
+    // 15以上の長さの続きを書く。
+    void putLength(BinaryVec& out, size_t length)
+    {
+      for(; length >= 255; length -= 255) out.push_back(255);
+      out.push_back(static_cast<uint8_t>(length));
+    }
+    void putSequence(BinaryVec& out, const uint8_t* literals, size_t numOfLiterals, size_t distance, size_t matchLength)
+    {
+      const auto literalToken = numOfLiterals < 15 ? numOfLiterals : 15;
+      const auto matchToken = matchLength == 0 ? 0 : (matchLength - MIN_MATCH < 15 ? matchLength - MIN_MATCH : 15);
+      out.push_back(static_cast<uint8_t>(literalToken << 4 | matchToken));
+      if(literalToken == 15) putLength(out, numOfLiterals - 15);
+      out.insert(out.end(), literals, literals + numOfLiterals);
+      if(matchLength == 0) return;
+      out.push_back(static_cast<uint8_t>(distance));
+      out.push_back(static_cast<uint8_t>(distance >> 8));
+      if(matchToken == 15) putLength(out, matchLength - MIN_MATCH - 15);
+    }
+    // 長さの続きを読む。壊れていればfalseを返す。
+    bool getLength(const uint8_t*& p, const uint8_t* end, size_t& length)
+    {
+      uint8_t byte;
+      do {
+        if(p == end) return false;
+        byte = *p++;
+        length += byte;
+      } while(byte == 255);
+      return true;
+    }
+  }
+  BinaryVec compressLZ(BinaryView data)
+  {
+    BinaryVec out;
+    const auto src = data.data();
+    const auto size = data.size();
+    size_t anchor = 0;
+    if(size >= MIN_MATCH) {
+      size_t bits = 4;
+      while(bits < MAX_HASH_BITS && (static_cast<size_t>(1) << bits) < size) ++bits;
+      // 位置+1を入れる。0は空。
+      std::vector<uint32_t> table(static_cast<size_t>(1) << bits, 0);
+      size_t i = 0;
+      while(i + MIN_MATCH <= size) {
+        const auto value = read32(src + i);
+        auto& slot = table[hash(value, bits)];
+        const auto candidate = static_cast<size_t>(slot);
+        slot = static_cast<uint32_t>(i + 1);
+        if(candidate == 0 || i - (candidate - 1) > MAX_DISTANCE || read32(src + candidate - 1) != value) {
+          ++i;
+          continue;
+        }
+        const auto match = candidate - 1;
+        auto length = MIN_MATCH;
+        while(i + length < size && src[match + length] == src[i + length]) ++length;
+        putSequence(out, src + anchor, i - anchor, i - match, length);
+        i += length;
+        anchor = i;
+      }
+    }
+    putSequence(out, src + anchor, size - anchor, 0, 0);
+    return out;
+  }
+  Option<BinaryVec> decompressLZ(BinaryView data, size_t size)
+  {
+    // 入力1バイトで増える出力は高々255バイト。壊れたsizeで大きく確保しないように、先に弾く。
+    if(size / 255 > data.size()) return none;
+    BinaryVec out(size);
+    size_t pos = 0;
+    auto p = data.data();
+    const auto end = p + data.size();
+    while(p != end) {
+      const auto token = *p++;
+      size_t numOfLiterals = token >> 4;
+      if(numOfLiterals == 15 && !getLength(p, end, numOfLiterals)) return none;
+      if(numOfLiterals > static_cast<size_t>(end - p) || numOfLiterals > size - pos) return none;
+      if(numOfLiterals != 0) std::memcpy(out.data() + pos, p, numOfLiterals);
+      pos += numOfLiterals;
+      p += numOfLiterals;
+      // 最後のシーケンスはリテラルだけ。
+      if(p == end) break;
+      if(end - p < 2) return none;
+      const size_t distance = p[0] | static_cast<size_t>(p[1]) << 8;
+      p += 2;
+      size_t matchLength = (token & 0x0F) + MIN_MATCH;
+      if((token & 0x0F) == 15 && !getLength(p, end, matchLength)) return none;
+      if(distance == 0 || distance > pos || matchLength > size - pos) return none;
+      auto dst = out.data() + pos;
+      // 一致が自分自身と重なるときは、1バイトずつ写す。
+      if(distance >= matchLength) std::memcpy(dst, dst - distance, matchLength);
+      else for(size_t i = 0; i < matchLength; ++i) dst[i] = dst[i - distance];
+      pos += matchLength;
+    }
+    if(pos != size) return none;
+    return some(std::move(out));
+  }
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#ifndef PICKC_UTILS_LZ_H_
+#define PICKC_UTILS_LZ_H_
+
+#include <cstddef>
+
+#include "binary_vec.h"
+#include "option.h"
+
+namespace pickc
+{
+  // 外部のライブラリを使わない、展開の速さを優先したLZ77系の圧縮。形式はLZ4のブロックと同じ並び。
+  // シーケンスを並べたもので、1つのシーケンスは次の通り。最後のシーケンスはリテラルだけで終わる。
+  // - トークン1バイト。上位4bitがリテラルの長さ、下位4bitが一致長-4。15なら続くバイトを255未満になるまで足す。
+  // - リテラル
+  // - 一致の開始位置までの距離。2バイトのリトルエンディアンで、1以上。
+  // - 一致長の続き
+  BinaryVec compressLZ(BinaryView data);
+  // 展開後の大きさがちょうどsizeでなければ、壊れたデータとしてnoneを返す。
+  Option<BinaryVec> decompressLZ(BinaryView data, size_t size);
+}
+
+#endif // PICKC_UTILS_LZ_H_
\ No newline at end of file
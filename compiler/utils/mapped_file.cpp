@@ -0,0 +1,109 @@
+#include "mapped_file.h"
+
+#include <filesystem>
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace pickc
+{
+  MappedFile::MappedFile() :
+    head(nullptr),
+    length(0),
+  #ifdef _WIN32
+    file(INVALID_HANDLE_VALUE),
+    mapping(nullptr)
+  #else
+    fd(-1)
+  #endif
+  {}
+  MappedFile::MappedFile(MappedFile&& file) : MappedFile()
+  {
+    *this = std::move(file);
+  }
+  MappedFile& MappedFile::operator=(MappedFile&& file)
+  {
+    if(this != &file) {
+      close();
+      std::swap(head, file.head);
+      std::swap(length, file.length);
+    #ifdef _WIN32
+      std::swap(this->file, file.file);
+      std::swap(mapping, file.mapping);
+    #else
+      std::swap(fd, file.fd);
+    #endif
+    }
+    return *this;
+  }
+  MappedFile::~MappedFile()
+  {
+    close();
+  }
+  void MappedFile::close()
+  {
+  #ifdef _WIN32
+    if(head != nullptr) UnmapViewOfFile(head);
+    if(mapping != nullptr) CloseHandle(mapping);
+    if(file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    mapping = nullptr;
+    file = INVALID_HANDLE_VALUE;
+  #else
+    if(head != nullptr) munmap(const_cast<char*>(head), length);
+    if(fd != -1) ::close(fd);
+    fd = -1;
+  #endif
+    head = nullptr;
+    length = 0;
+  }
+  Result<MappedFile, std::string> MappedFile::open(const std::string& path)
+  {
+    MappedFile mapped;
+  #ifdef _WIN32
+    mapped.file = CreateFileW(std::filesystem::path(path).wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(mapped.file == INVALID_HANDLE_VALUE) return error("エラー: ファイル " + path + " が開けませんでした。");
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(mapped.file, &size)) return error("エラー: ファイル " + path + " のサイズが取得できませんでした。");
+    mapped.length = static_cast<size_t>(size.QuadPart);
+    // 空のファイルはマップできないので、空のまま返す。
+    if(mapped.length == 0) return Result<MappedFile, std::string>(std::move(mapped));
+    mapped.mapping = CreateFileMappingW(mapped.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mapped.mapping == nullptr) return error("エラー: ファイル " + path + " をマップできませんでした。");
+    mapped.head = static_cast<const char*>(MapViewOfFile(mapped.mapping, FILE_MAP_READ, 0, 0, 0));
+    if(mapped.head == nullptr) return error("エラー: ファイル " + path + " をマップできませんでした。");
+  #else
+    mapped.fd = ::open(path.c_str(), O_RDONLY);
+    if(mapped.fd == -1) return error("エラー: ファイル " + path + " が開けませんでした。");
+    struct stat st;
+    if(fstat(mapped.fd, &st) != 0) return error("エラー: ファイル " + path + " のサイズが取得できませんでした。");
+    mapped.length = static_cast<size_t>(st.st_size);
+    // 空のファイルはマップできないので、空のまま返す。
+    if(mapped.length == 0) return Result<MappedFile, std::string>(std::move(mapped));
+    auto addr = mmap(nullptr, mapped.length, PROT_READ, MAP_PRIVATE, mapped.fd, 0);
+    if(addr == MAP_FAILED) return error("エラー: ファイル " + path + " をマップできませんでした。");
+    mapped.head = static_cast<const char*>(addr);
+  #endif
+    return Result<MappedFile, std::string>(std::move(mapped));
+  }
+  const char* MappedFile::data() const
+  {
+    return head;
+  }
+  size_t MappedFile::size() const
+  {
+    return length;
+  }
+  std::string_view MappedFile::view() const
+  {
+    return std::string_view(head, length);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef PICKC_UTILS_MAPPED_FILE_H_
+#define PICKC_UTILS_MAPPED_FILE_H_
+
+#include <string>
+#include <string_view>
+
+#include "result.h"
+
+namespace pickc
+{
+  // 読み取り専用でメモリにマップしたファイル。
+  // ムーブのみ可能で、破棄時にマップを解除する。
+  class MappedFile
+  {
+    const char* head;
+    size_t length;
+  #ifdef _WIN32
+    void* file;
+    void* mapping;
+  #else
+    int fd;
+  #endif
+    MappedFile();
+    void close();
+  public:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&& file);
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&& file);
+    ~MappedFile();
+    static Result<MappedFile, std::string> open(const std::string& path);
+    const char* data() const;
+    size_t size() const;
+    std::string_view view() const;
+  };
+}
+
+#endif // PICKC_UTILS_MAPPED_FILE_H_
\ No newline at end of file
@@ -124,22 +124,28 @@ namespace pickc
     }
   };
 
+  // Resultのok_tと同じく、一時オブジェクトからOptionを作るときは値をムーブする。
   template<typename T>
   class some_t
   {
     T some;
   public:
-    explicit some_t(T some) : some(some) {}
+    explicit some_t(T some) : some(std::move(some)) {}
     template<typename Some>
-    operator Option<Some>() const
+    operator Option<Some>() const &
     {
       return Option<Some>(some);
     }
+    template<typename Some>
+    operator Option<Some>() &&
+    {
+      return Option<Some>(std::move(some));
+    }
   };
   template<typename T>
   some_t<T> some(T some)
   {
-    return some_t<T>(some);
+    return some_t<T>(std::move(some));
   }
 
   struct none_t
@@ -0,0 +1,45 @@
+#include "resident_cache.h"
+
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+namespace pickc
+{
+  namespace
+  {
+    std::atomic<bool> isEnabled{ false };
+    std::mutex entriesMutex;
+    std::unordered_map<std::string, std::shared_ptr<const std::string>> entries;
+    size_t totalBytes = 0;
+  }
+  void ResidentCache::enable()
+  {
+    isEnabled = true;
+  }
+  bool ResidentCache::enabled()
+  {
+    return isEnabled;
+  }
+  std::shared_ptr<const std::string> ResidentCache::get(const std::string& key)
+  {
+    if(!isEnabled) return nullptr;
+    std::lock_guard lock(entriesMutex);
+    auto itr = entries.find(key);
+    if(itr == entries.end()) return nullptr;
+    return itr->second;
+  }
+  void ResidentCache::put(const std::string& key, std::string entry)
+  {
+    if(!isEnabled) return;
+    std::lock_guard lock(entriesMutex);
+    auto& slot = entries[key];
+    if(slot) totalBytes -= slot->size();
+    totalBytes += entry.size();
+    slot = std::make_shared<const std::string>(std::move(entry));
+    if(totalBytes > MAX_BYTES) {
+      entries.clear();
+      totalBytes = 0;
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef PICKC_UTILS_RESIDENT_CACHE_H_
+#define PICKC_UTILS_RESIDENT_CACHE_H_
+
+#include <string>
+#include <memory>
+
+namespace pickc
+{
+  // --serverで常駐しているあいだ、ディスクに書いたキャッシュのエントリをメモリにも置いておく。
+  // キーはエントリのパス。enableを呼ぶまではgetは常にnullptrを返し、putは何もしない。
+  // 合計がMAX_BYTESを超えたら全部捨てる。
+  class ResidentCache
+  {
+  public:
+    static constexpr size_t MAX_BYTES = 512 * 1024 * 1024;
+    static void enable();
+    static bool enabled();
+    static std::shared_ptr<const std::string> get(const std::string& key);
+    static void put(const std::string& key, std::string entry);
+  };
+}
+
+#endif // PICKC_UTILS_RESIDENT_CACHE_H_
\ No newline at end of file
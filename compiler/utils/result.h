@@ -188,22 +188,28 @@ namespace pickc
 
   struct _ {};
 
+  // return ok(value);の一時オブジェクトからResultを作るときは、値をコピーせずにムーブする。
   template<typename T>
   class ok_t
   {
     T ok;
   public:
-    explicit ok_t(T ok) : ok(ok) {}
+    explicit ok_t(T ok) : ok(std::move(ok)) {}
     template<typename OK, typename Error>
-    operator Result<OK, Error>() const
+    operator Result<OK, Error>() const &
     {
       return Result<OK, Error>(ok);
     }
+    template<typename OK, typename Error>
+    operator Result<OK, Error>() &&
+    {
+      return Result<OK, Error>(std::move(ok));
+    }
   };
   template<typename OK>
   ok_t<OK> ok(OK ok)
   {
-    return ok_t<OK>(ok);
+    return ok_t<OK>(std::move(ok));
   }
   ok_t<_> ok();
 
@@ -212,17 +218,22 @@ namespace pickc
   {
     T error;
   public:
-    explicit error_t(T error) : error(error) {}
+    explicit error_t(T error) : error(std::move(error)) {}
     template<typename OK, typename Error>
-    operator Result<OK, Error>() const
+    operator Result<OK, Error>() const &
     {
       return Result<OK, Error>(error);
     }
+    template<typename OK, typename Error>
+    operator Result<OK, Error>() &&
+    {
+      return Result<OK, Error>(std::move(error));
+    }
   };
   template<typename Error>
   error_t<Error> error(Error error)
   {
-    return error_t<Error>(error);
+    return error_t<Error>(std::move(error));
   }
 }
 
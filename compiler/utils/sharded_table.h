@@ -0,0 +1,72 @@
+#ifndef PICKC_UTILS_SHARDED_TABLE_H_
+#define PICKC_UTILS_SHARDED_TABLE_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <atomic>
+#include <mutex>
+
+namespace pickc
+{
+  // 値を登録して32bitの番号を付ける表の土台。InternerとTypeContextが使う。
+  // キーから番号を引く表はShardに置き、キーのハッシュで選んだ区画だけをロックする。Shardはmutexを持つこと。
+  // 番号からValueを引く表はBLOCK_SIZE個ずつのブロックに分ける。ブロックは一度作ったら動かさないので、ロックせずに読める。
+  // 登録した値は変更も削除もしない。
+  template<typename Shard, typename Value, size_t BLOCK_BITS>
+  class ShardedTable
+  {
+    static constexpr size_t SHARD_BITS = 5;
+    static constexpr size_t NUM_SHARDS = size_t(1) << SHARD_BITS;
+    static constexpr size_t BLOCK_SIZE = size_t(1) << BLOCK_BITS;
+    static constexpr size_t MAX_BLOCKS = size_t(1) << 16;
+    Shard shards[NUM_SHARDS];
+    std::atomic<Value*> blocks[MAX_BLOCKS];
+    std::mutex blockMutex;
+    std::atomic<uint32_t> next;
+  public:
+    // firstより小さい番号は呼び出し側が予約し、setで埋める。
+    explicit ShardedTable(uint32_t first) : next(first)
+    {
+      for(auto& block : blocks) block.store(nullptr, std::memory_order_relaxed);
+    }
+    ShardedTable(const ShardedTable&) = delete;
+    ShardedTable& operator=(const ShardedTable&) = delete;
+    // hashは64bitによく混ぜたもの。上位のビットで区画を選ぶ。
+    Shard& shard(uint64_t hash)
+    {
+      return shards[hash >> (64 - SHARD_BITS)];
+    }
+    // 新しい番号を取る。番号を他のスレッドに渡す前にsetで値を書き込んでおくこと。
+    uint32_t allocate()
+    {
+      return next.fetch_add(1, std::memory_order_relaxed);
+    }
+    // 取った番号の数
+    size_t size() const
+    {
+      return next.load(std::memory_order_relaxed);
+    }
+    void set(uint32_t id, Value value)
+    {
+      if((id >> BLOCK_BITS) >= MAX_BLOCKS) std::abort();
+      auto& block = blocks[id >> BLOCK_BITS];
+      auto entries = block.load(std::memory_order_acquire);
+      if(entries == nullptr) {
+        std::lock_guard<std::mutex> lock(blockMutex);
+        entries = block.load(std::memory_order_relaxed);
+        if(entries == nullptr) {
+          entries = new Value[BLOCK_SIZE];
+          block.store(entries, std::memory_order_release);
+        }
+      }
+      entries[id & (BLOCK_SIZE - 1)] = value;
+    }
+    Value get(uint32_t id) const
+    {
+      return blocks[id >> BLOCK_BITS].load(std::memory_order_acquire)[id & (BLOCK_SIZE - 1)];
+    }
+  };
+}
+
+#endif // PICKC_UTILS_SHARDED_TABLE_H_
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace pickc
+{
+  ThreadPool::ThreadPool(size_t numThreads) :
+    numQueued(0),
+    numPending(0),
+    nextQueue(0),
+    stopping(false)
+  {
+    numThreads = std::max<size_t>(numThreads, 1);
+    for(size_t i = 0; i < numThreads; ++i) queues.push_back(std::make_unique<Queue>());
+    for(size_t i = 1; i < numThreads; ++i) workers.emplace_back(&ThreadPool::workerMain, this, i);
+  }
+  ThreadPool::~ThreadPool()
+  {
+    // 例外はwaitを呼んだ側に返す。誰も呼ばずに破棄されたときは捨てる。
+    try {
+      wait();
+    }
+    catch(...) {}
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wakeUp.notify_all();
+    for(auto& worker : workers) worker.join();
+  }
+  bool ThreadPool::runOne(size_t self)
+  {
+    std::function<void()> task;
+    {
+      auto& queue = *queues[self];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if(!queue.tasks.empty()) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      }
+    }
+    for(size_t i = 1, l = queues.size(); !task && i < l; ++i) {
+      auto& queue = *queues[(self + i) % l];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if(!queue.tasks.empty()) {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+    }
+    if(!task) return false;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      --numQueued;
+    }
+    // 例外を投げてもnumPendingは必ず減らす。減らさなければwaitが終わらない。
+    std::exception_ptr thrown;
+    try {
+      task();
+    }
+    catch(...) {
+      thrown = std::current_exception();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if(thrown && !error) error = thrown;
+    if(--numPending == 0) finished.notify_all();
+    return true;
+  }
+  void ThreadPool::workerMain(size_t self)
+  {
+    while(true) {
+      if(runOne(self)) continue;
+      std::unique_lock<std::mutex> lock(mutex);
+      wakeUp.wait(lock, [this] { return stopping || numQueued != 0; });
+      if(stopping && numQueued == 0) return;
+    }
+  }
+  void ThreadPool::submit(std::function<void()> task)
+  {
+    // numQueuedはキューに入れてから増やす。先に増やすと、ワーカーが空のキューを回り続ける。
+    // mutexを持ったまま入れるので、取り出した側がnumQueuedを減らすのは増やした後になる。
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++numPending;
+      {
+        auto& queue = *queues[nextQueue++ % queues.size()];
+        std::lock_guard<std::mutex> queueLock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+      }
+      ++numQueued;
+    }
+    wakeUp.notify_one();
+    finished.notify_all();
+  }
+  void ThreadPool::wait()
+  {
+    while(true) {
+      if(runOne(0)) continue;
+      std::unique_lock<std::mutex> lock(mutex);
+      if(numPending != 0) {
+        finished.wait(lock, [this] { return numPending == 0 || numQueued != 0; });
+        if(numPending != 0) continue;
+      }
+      if(error) std::rethrow_exception(std::exchange(error, nullptr));
+      return;
+    }
+  }
+  size_t ThreadPool::threadCount() const
+  {
+    return queues.size();
+  }
+  size_t ThreadPool::hardwareThreads()
+  {
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef PICKC_UTILS_THREAD_POOL_H_
+#define PICKC_UTILS_THREAD_POOL_H_
+
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+namespace pickc
+{
+  // ワークスティーリングのスレッドプール。
+  // スレッドごとにキューを持ち、自分のキューは後ろから、他のスレッドのキューは前から取り出す。
+  // waitを呼んだスレッドもタスクを実行するので、スレッド数がnならワーカーはn - 1個作る。
+  class ThreadPool
+  {
+    struct Queue
+    {
+      std::mutex mutex;
+      std::deque<std::function<void()>> tasks;
+    };
+    // queues[0]はwaitを呼んだスレッドが使う。
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable finished;
+    // 以下はmutexで保護する。
+    size_t numQueued;
+    size_t numPending;
+    size_t nextQueue;
+    bool stopping;
+    // タスクが投げた最初の例外。waitが投げ直す。
+    std::exception_ptr error;
+    bool runOne(size_t self);
+    void workerMain(size_t self);
+  public:
+    explicit ThreadPool(size_t numThreads);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+    void submit(std::function<void()> task);
+    // 登録したタスクがすべて終わるまで、自分もタスクを実行しながら待つ。
+    // タスクが例外を投げていれば、すべて終わった後で最初の例外を投げ直す。
+    void wait();
+    size_t threadCount() const;
+    // 使えるハードウェアスレッドの数。分からなければ1。
+    static size_t hardwareThreads();
+  };
+}
+
+#endif // PICKC_UTILS_THREAD_POOL_H_
\ No newline at end of file
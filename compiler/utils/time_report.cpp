@@ -0,0 +1,341 @@
+#include "time_report.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <cstdlib>
+#include <iomanip>
+#include <algorithm>
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+  #include <psapi.h>
+#else
+  #include <time.h>
+  #include <unistd.h>
+  #include <sys/resource.h>
+  #include <cstdio>
+#endif
+
+namespace
+{
+  std::atomic<uint64_t> processAllocations{ 0 };
+  thread_local uint64_t threadAllocations = 0;
+}
+
+// メモリ確保の回数を数えるために置き換える。new[]や配置指定のないnothrow版はこれを呼ぶ。
+void* operator new(std::size_t size)
+{
+  processAllocations.fetch_add(1, std::memory_order_relaxed);
+  ++threadAllocations;
+  if(size == 0) size = 1;
+  while(true) {
+    if(auto p = std::malloc(size)) return p;
+    auto handler = std::get_new_handler();
+    if(handler == nullptr) throw std::bad_alloc();
+    handler();
+  }
+}
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace pickc
+{
+  namespace
+  {
+    std::atomic<bool> isEnabled{ false };
+    std::mutex recordsMutex;
+    std::vector<TimeReport::Record> allRecords;
+
+    double processCPU()
+    {
+    #ifdef _WIN32
+      FILETIME creation, exit, kernel, user;
+      if(!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) return 0;
+      ULARGE_INTEGER k{ { kernel.dwLowDateTime, kernel.dwHighDateTime } };
+      ULARGE_INTEGER u{ { user.dwLowDateTime, user.dwHighDateTime } };
+      return (k.QuadPart + u.QuadPart) / 1e7;
+    #else
+      timespec ts;
+      if(clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) return 0;
+      return ts.tv_sec + ts.tv_nsec / 1e9;
+    #endif
+    }
+    double threadCPU()
+    {
+    #ifdef _WIN32
+      FILETIME creation, exit, kernel, user;
+      if(!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) return 0;
+      ULARGE_INTEGER k{ { kernel.dwLowDateTime, kernel.dwHighDateTime } };
+      ULARGE_INTEGER u{ { user.dwLowDateTime, user.dwHighDateTime } };
+      return (k.QuadPart + u.QuadPart) / 1e7;
+    #else
+      timespec ts;
+      if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0;
+      return ts.tv_sec + ts.tv_nsec / 1e9;
+    #endif
+    }
+    uint64_t peakRSS()
+    {
+    #ifdef _WIN32
+      PROCESS_MEMORY_COUNTERS counters;
+      if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+      return counters.PeakWorkingSetSize;
+    #else
+      rusage usage;
+      if(getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+      // Linuxではキロバイト単位
+      return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+    #endif
+    }
+    uint64_t currentRSS()
+    {
+    #ifdef _WIN32
+      PROCESS_MEMORY_COUNTERS counters;
+      if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+      return counters.WorkingSetSize;
+    #else
+      // 2番目の値が常駐しているページ数
+      auto file = std::fopen("/proc/self/statm", "r");
+      if(file == nullptr) return 0;
+      unsigned long long size = 0, resident = 0;
+      const auto read = std::fscanf(file, "%llu %llu", &size, &resident);
+      std::fclose(file);
+      if(read != 2) return 0;
+      return static_cast<uint64_t>(resident) * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    #endif
+    }
+
+    struct Phase
+    {
+      std::string name;
+      TimeReport::Stats total;
+      std::vector<TimeReport::Record> items;
+    };
+    void accumulate(TimeReport::Stats& to, const TimeReport::Stats& from)
+    {
+      to.wall += from.wall;
+      to.cpu += from.cpu;
+      to.allocations += from.allocations;
+      to.peakRSSDelta += from.peakRSSDelta;
+      // 同じフェーズを何度か計測したときは、最後の計測の時点の値を使う。
+      to.peakRSS = std::max(to.peakRSS, from.peakRSS);
+      if(from.rss != 0) to.rss = from.rss;
+    }
+    // 記録をフェーズごとにまとめる。フェーズは最初に記録された順に並べる。
+    std::vector<Phase> phases()
+    {
+      std::vector<Phase> result;
+      std::vector<bool> hasTotal;
+      for(const auto& record : TimeReport::records()) {
+        auto itr = std::find_if(result.begin(), result.end(), [&](const Phase& phase) { return phase.name == record.phase; });
+        if(itr == result.end()) {
+          result.push_back(Phase{ record.phase, TimeReport::Stats{ 0, 0, 0, 0, 0, 0 }, {} });
+          hasTotal.push_back(false);
+          itr = result.end() - 1;
+        }
+        const auto index = itr - result.begin();
+        if(record.item.empty()) {
+          if(!hasTotal[index]) itr->total = TimeReport::Stats{ 0, 0, 0, 0, 0, 0 };
+          hasTotal[index] = true;
+          accumulate(itr->total, record.stats);
+        }
+        else {
+          itr->items.push_back(record);
+          if(!hasTotal[index]) accumulate(itr->total, record.stats);
+        }
+      }
+      for(auto& phase : result) {
+        std::stable_sort(phase.items.begin(), phase.items.end(), [](const auto& a, const auto& b) { return a.stats.wall > b.stats.wall; });
+      }
+      return result;
+    }
+    void printRow(std::ostream& stream, const std::string& name, const TimeReport::Stats& stats)
+    {
+      stream << std::left << std::setw(40) << name << std::right
+             << std::setw(12) << stats.wall * 1000
+             << std::setw(12) << stats.cpu * 1000
+             << std::setw(12) << stats.allocations
+             << std::setw(14) << stats.peakRSSDelta / 1024 << '\n';
+    }
+    std::string escapeJSON(const std::string& str)
+    {
+      std::string res;
+      for(auto c : str) {
+        switch(c) {
+          case '"': res += "\\\""; break;
+          case '\\': res += "\\\\"; break;
+          case '\n': res += "\\n"; break;
+          case '\t': res += "\\t"; break;
+          default:
+            if(static_cast<unsigned char>(c) < 0x20) {
+              const char* digits = "0123456789abcdef";
+              res += "\\u00";
+              res += digits[c >> 4];
+              res += digits[c & 0xF];
+            }
+            else res += c;
+        }
+      }
+      return res;
+    }
+    void printJSONStats(std::ostream& stream, const std::string& name, const TimeReport::Stats& stats)
+    {
+      stream << "\"name\": \"" << escapeJSON(name) << "\", "
+             << "\"wall_ms\": " << stats.wall * 1000 << ", "
+             << "\"cpu_ms\": " << stats.cpu * 1000 << ", "
+             << "\"allocations\": " << stats.allocations << ", "
+             << "\"peak_rss_delta_bytes\": " << stats.peakRSSDelta << ", "
+             << "\"peak_rss_bytes\": " << stats.peakRSS;
+      if(stats.rss != 0) stream << ", \"rss_bytes\": " << stats.rss;
+    }
+  }
+  TimeReport::Scope::Scope(const char* phase, std::string item) :
+    phase(phase),
+    item(std::move(item)),
+    active(TimeReport::enabled()),
+    cpu(0),
+    allocations(0),
+    peakRSS(0)
+  {
+    if(!active) return;
+    peakRSS = ::pickc::peakRSS();
+    if(this->item.empty()) {
+      cpu = processCPU();
+      allocations = processAllocations.load(std::memory_order_relaxed);
+    }
+    else {
+      cpu = threadCPU();
+      allocations = threadAllocations;
+    }
+    wall = std::chrono::steady_clock::now();
+  }
+  TimeReport::Scope::~Scope()
+  {
+    if(!active) return;
+    Stats stats;
+    stats.wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall).count();
+    if(item.empty()) {
+      stats.cpu = processCPU() - cpu;
+      stats.allocations = processAllocations.load(std::memory_order_relaxed) - allocations;
+    }
+    else {
+      stats.cpu = threadCPU() - cpu;
+      stats.allocations = threadAllocations - allocations;
+    }
+    stats.peakRSS = ::pickc::peakRSS();
+    stats.peakRSSDelta = stats.peakRSS - peakRSS;
+    stats.rss = item.empty() ? currentRSS() : 0;
+    TimeReport::add(Record{ phase, std::move(item), stats });
+  }
+  void TimeReport::enable()
+  {
+    isEnabled = true;
+  }
+  bool TimeReport::enabled()
+  {
+    return isEnabled;
+  }
+  uint64_t TimeReport::processPeakRSS()
+  {
+    return peakRSS();
+  }
+  uint64_t TimeReport::processRSS()
+  {
+    return currentRSS();
+  }
+  void TimeReport::reset()
+  {
+    isEnabled = false;
+    std::lock_guard lock(recordsMutex);
+    allRecords.clear();
+  }
+  void TimeReport::add(Record record)
+  {
+    std::lock_guard lock(recordsMutex);
+    allRecords.push_back(std::move(record));
+  }
+  std::vector<TimeReport::Record> TimeReport::records()
+  {
+    std::lock_guard lock(recordsMutex);
+    return allRecords;
+  }
+  void TimeReport::printTable(std::ostream& stream)
+  {
+    // 長くなりすぎないように、モジュールや関数ごとの計測は時間のかかったものから表示する。
+    constexpr size_t MAX_ITEMS = 10;
+    stream << "Time Report\n";
+    stream << std::left << std::setw(40) << "Phase / Item" << std::right
+           << std::setw(12) << "Wall(ms)"
+           << std::setw(12) << "CPU(ms)"
+           << std::setw(12) << "Allocs"
+           << std::setw(14) << "PeakRSS(KB)" << '\n';
+    stream << std::fixed << std::setprecision(3);
+    Stats sum{ 0, 0, 0, 0, 0, 0 };
+    for(const auto& phase : phases()) {
+      printRow(stream, phase.name, phase.total);
+      accumulate(sum, phase.total);
+      for(size_t i = 0; i < phase.items.size() && i < MAX_ITEMS; ++i) {
+        printRow(stream, "  " + phase.items[i].item, phase.items[i].stats);
+      }
+      if(phase.items.size() > MAX_ITEMS) stream << "  ... 他 " << phase.items.size() - MAX_ITEMS << " 件\n";
+    }
+    printRow(stream, "total", sum);
+    stream << std::defaultfloat << std::flush;
+  }
+  void TimeReport::printJSON(std::ostream& stream)
+  {
+    stream << "{\n  \"phases\": [";
+    bool firstPhase = true;
+    for(const auto& phase : phases()) {
+      stream << (firstPhase ? "\n" : ",\n") << "    { ";
+      firstPhase = false;
+      printJSONStats(stream, phase.name, phase.total);
+      stream << ", \"items\": [";
+      bool firstItem = true;
+      for(const auto& item : phase.items) {
+        stream << (firstItem ? "\n" : ",\n") << "      { ";
+        firstItem = false;
+        printJSONStats(stream, item.item, item.stats);
+        stream << " }";
+      }
+      stream << (phase.items.empty() ? "] }" : "\n    ] }");
+    }
+    stream << "\n  ]\n}" << std::endl;
+  }
+  void TimeReport::printMemory(std::ostream& stream)
+  {
+    // フェーズは記録された順、つまりおおむね実行した順に並ぶ。
+    stream << "Memory Report\n";
+    stream << std::left << std::setw(40) << "Phase" << std::right
+           << std::setw(14) << "PeakRSS(KB)"
+           << std::setw(14) << "Growth(KB)"
+           << std::setw(14) << "RSS(KB)" << '\n';
+    uint64_t peak = 0;
+    std::string peakPhase;
+    for(const auto& phase : phases()) {
+      stream << std::left << std::setw(40) << phase.name << std::right
+             << std::setw(14) << phase.total.peakRSS / 1024
+             << std::setw(14) << phase.total.peakRSSDelta / 1024;
+      // モジュールや関数ごとにしか計測していないフェーズのRSSは測っていない。
+      if(phase.total.rss != 0) stream << std::setw(14) << phase.total.rss / 1024 << '\n';
+      else stream << std::setw(14) << '-' << '\n';
+      if(phase.total.peakRSSDelta != 0 && phase.total.peakRSS >= peak) {
+        peak = phase.total.peakRSS;
+        peakPhase = phase.name;
+      }
+    }
+    stream << "peak " << processPeakRSS() / 1024 << " KB";
+    if(!peakPhase.empty()) stream << " (" << peakPhase << ")";
+    stream << std::endl;
+  }
+}
\ No newline at end of file
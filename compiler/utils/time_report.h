@@ -0,0 +1,72 @@
+#ifndef PICKC_UTILS_TIME_REPORT_H_
+#define PICKC_UTILS_TIME_REPORT_H_
+
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <ostream>
+
+namespace pickc
+{
+  // --time-reportと--mem-reportのための計測。フェーズごと、またはモジュールや関数ごとに
+  // 経過時間、CPU時間、メモリ確保の回数、ピークRSSの増分を記録する。
+  // enableを呼ぶまでは何も記録しない。
+  class TimeReport
+  {
+  public:
+    struct Stats
+    {
+      // 秒
+      double wall;
+      double cpu;
+      uint64_t allocations;
+      // バイト。計測の間にプロセスのピークRSSが増えた分で、並列に動いている他の計測の分も含む。
+      uint64_t peakRSSDelta;
+      // バイト。計測を終えた時点のプロセスのピークRSSとRSS。RSSはフェーズ全体の計測でだけ測る。
+      uint64_t peakRSS;
+      uint64_t rss;
+    };
+    struct Record
+    {
+      std::string phase;
+      // モジュール名や関数名。フェーズ全体の計測なら空。
+      std::string item;
+      Stats stats;
+    };
+    // 生存期間を計測して記録する。
+    // itemが空ならプロセス全体のCPU時間とメモリ確保を、そうでなければ計測したスレッドの分だけを数える。
+    class Scope
+    {
+      const char* phase;
+      std::string item;
+      bool active;
+      std::chrono::steady_clock::time_point wall;
+      double cpu;
+      uint64_t allocations;
+      uint64_t peakRSS;
+    public:
+      Scope(const char* phase, std::string item = "");
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+      ~Scope();
+    };
+    static void enable();
+    static bool enabled();
+    // 記録を消して、計測をやめる。--serverで要求ごとに呼ぶ。
+    static void reset();
+    // プロセスのピークRSS(バイト)。enableしていなくても使える。
+    static uint64_t processPeakRSS();
+    // プロセスの現在のRSS(バイト)。
+    static uint64_t processRSS();
+    static void add(Record record);
+    static std::vector<Record> records();
+    // 全体の計測がないフェーズは、モジュールや関数ごとの計測の合計を全体とする。
+    static void printTable(std::ostream& stream);
+    static void printJSON(std::ostream& stream);
+    // フェーズごとに、終わった時点のピークRSSとRSSを出力する。
+    static void printMemory(std::ostream& stream);
+  };
+}
+
+#endif // PICKC_UTILS_TIME_REPORT_H_
\ No newline at end of file
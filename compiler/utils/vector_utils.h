@@ -2,13 +2,18 @@
 #define PICKC_UTILS_VECTOR_UTILS_H_
 
 #include <vector>
+#include <initializer_list>
+#include <algorithm>
+#include <iterator>
+#include <utility>
 #include <cassert>
 namespace pickc
 {
   template<typename T>
   std::vector<T> operator+(const std::vector<T>& v1, const std::vector<T>& v2)
   {
-    std::vector<T> result(v1.size() + v2.size());
+    std::vector<T> result;
+    result.reserve(v1.size() + v2.size());
     result.insert(result.end(), v1.begin(), v1.end());
     result.insert(result.end(), v2.begin(), v2.end());
     return result;
@@ -20,11 +25,29 @@ namespace pickc
     v1.insert(v1.end(), v2.begin(), v2.end());
     return v1;
   }
+  // v2が使い終わったものなら、要素をコピーせずにムーブする。
+  template<typename T>
+  std::vector<T>& operator+=(std::vector<T>& v1, std::vector<T>&& v2)
+  {
+    if(v1.empty()) {
+      v1 = std::move(v2);
+      return v1;
+    }
+    v1.reserve(v1.size() + v2.size());
+    v1.insert(v1.end(), std::make_move_iterator(v2.begin()), std::make_move_iterator(v2.end()));
+    return v1;
+  }
   template<typename T>
   inline bool includes(const std::vector<T>& vec, const T& value)
   {
     return std::find(vec.begin(), vec.end(), value) != vec.end();
   }
+  // includes({ a, b }, value)の形で呼ばれたときにvectorを作らないためのオーバーロード
+  template<typename T>
+  inline bool includes(std::initializer_list<T> list, const T& value)
+  {
+    return std::find(list.begin(), list.end(), value) != list.end();
+  }
   template<typename T>
   size_t indexOf(const std::vector<T>& vec, const T& value)
   {
@@ -3,20 +3,24 @@
 #include <filesystem>
 
 #include "utils/vector_utils.h"
+#include "utils/time_report.h"
 #include "pcir/pcir_format.h"
 
 #include "routine_compiler.h"
 
 namespace pickc::windows::x64
 {
-  Compiler::Compiler(const bundler::Bundle& bundle) : bundle(bundle) {}
+  Compiler::Compiler(bundler::Bundle&& bundle) : bundle(std::move(bundle)) {}
   Result<WindowsX64, std::vector<std::string>> Compiler::compile(const CompilerOption& option)
   {
+    TimeReport::Scope scope("x64 codegen");
     std::vector<std::string> errors;
     
     for(auto& fn : bundle.fns) {
+      TimeReport::Scope fnScope("x64 codegen", TimeReport::enabled() ? bundler::functionName(bundle, fn.first) : "");
       if(fn.second->fnType == pcir::FN_TYPE_FUNCTION) {
         if(auto res = RoutineCompiler(fn.second, &x64).compile()) {
+          res.get()->fn = nullptr;
           x64.routines[fn.first] = res.get();
         }
         else {
@@ -24,16 +28,20 @@ namespace pickc::windows::x64
         }
       }
       else {
-        x64.externs[fn.first] = fn.second->externName->text;
+        x64.externs[fn.first] = fn.second->externName->text.str();
         auto routine = new Routine();
         routine->code.push_back(new ExtJmpOperation(x64.externs[fn.first]));
         x64.routines[fn.first] = routine;
       }
+      // 以降はRoutineのOperationだけを使う。
+      delete fn.second;
+      fn.second = nullptr;
     }
 
     pcir::SymbolSection* mainSymbol = nullptr;
-    for(const auto& symbol : bundle.modules[option.mainModule]) {
-      if(symbol->name->text == "main") {
+    const auto main = Atom::intern("main");
+    for(const auto& symbol : bundle.modules[Atom::intern(option.mainModule)]) {
+      if(symbol->name->text == main) {
         mainSymbol = symbol;
         break;
       }
@@ -74,7 +82,7 @@ namespace pickc::windows::x64
     x64.invokeMain->code.push_back(new LeaveOperation());
     x64.invokeMain->code.push_back(new RetOperation());
     x64.routines[nullptr] = x64.invokeMain;
-    if(errors.empty()) return ok(x64);
-    return error(errors);
+    if(errors.empty()) return ok(std::move(x64));
+    return error(std::move(errors));
   }
 }
\ No newline at end of file
@@ -18,7 +18,8 @@ namespace pickc::windows::x64
     WindowsX64 x64;
     bundler::Bundle bundle;
   public:
-    Compiler(const bundler::Bundle& bundle);
+    // bundleはプログラム全体の関数を持つので、コピーせずに受け取る。
+    Compiler(bundler::Bundle&& bundle);
     Result<WindowsX64, std::vector<std::string>> compile(const CompilerOption& option);
   };
 }
@@ -1,9 +1,20 @@
 #include "lib_loader.h"
 
+#include <filesystem>
+#include <mutex>
+
 namespace pickc::windows::x64
 {
   namespace
   {
+    struct CachedLib
+    {
+      std::filesystem::file_time_type lastWriteTime;
+      uintmax_t size;
+      std::map<std::string, LibSymbol> symbols;
+    };
+    std::mutex cachedLibsMutex;
+    std::map<std::string, CachedLib> cachedLibs;
     inline size_t sstrlen(char* str, size_t max)
     {
       for (size_t i = 0; i < max; ++i) {
@@ -119,4 +130,21 @@ namespace pickc::windows::x64
     }
     return error(std::vector({ "エラー: 正しいlibファイルではありません。libファイルは!<arch>から始まる形式である必要があります。ファイル名: " + path }));
   }
+  Result<std::map<std::string, LibSymbol>, std::vector<std::string>> LibLoader::loadCached(const std::string& path)
+  {
+    std::error_code err;
+    const auto absolute = std::filesystem::absolute(path, err).string();
+    const auto lastWriteTime = std::filesystem::last_write_time(path, err);
+    const auto size = err ? 0 : std::filesystem::file_size(path, err);
+    // 日時が取れなければ、読み込みのエラーに任せる。
+    if(err) return LibLoader(path).load();
+    std::lock_guard lock(cachedLibsMutex);
+    auto itr = cachedLibs.find(absolute);
+    if(itr != cachedLibs.end() && itr->second.lastWriteTime == lastWriteTime && itr->second.size == size) {
+      return ok(itr->second.symbols);
+    }
+    auto res = LibLoader(path).load();
+    if(res) cachedLibs[absolute] = CachedLib{ lastWriteTime, size, res.get() };
+    return res;
+  }
 }
\ No newline at end of file
@@ -53,6 +53,9 @@ namespace pickc::windows::x64
   public:
     LibLoader(const std::string& path);
     Result<std::map<std::string, LibSymbol>, std::vector<std::string>> load();
+    // 一度読み込んだライブラリは、更新日時とサイズが変わっていなければ読み込み直さない。
+    // --serverで要求のたびにkernel32.Libなどを読み直さないようにするため。
+    static Result<std::map<std::string, LibSymbol>, std::vector<std::string>> loadCached(const std::string& path);
   };
 }
 
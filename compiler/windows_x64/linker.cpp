@@ -2,9 +2,11 @@
 
 #include <filesystem>
 #include <fstream>
+#include <algorithm>
 
 #include "utils/vector_utils.h"
 #include "utils/map_utils.h"
+#include "utils/time_report.h"
 #include "pcir/pcir_format.h"
 
 namespace pickc::windows::x64
@@ -13,8 +15,8 @@ namespace pickc::windows::x64
   {
     return (value + alignment - 1) / alignment * alignment;
   }
-  Linker::Linker(const WindowsX64& x64) :
-    x64(x64),
+  Linker::Linker(WindowsX64&& x64) :
+    x64(std::move(x64)),
     dosHeader{
       0x5A4D,                                     // Magic number
       0x0090,                                     // Bytes on last page of file
@@ -127,39 +129,55 @@ namespace pickc::windows::x64
   {
     std::vector<std::string> errors;
 
-    placeRoutines();
+    {
+      TimeReport::Scope scope("link");
+      placeRoutines();
 
-    ntHeader.fileHeader.numSections = 4;
-    ntHeader.optionalHeader.sizeOfHeaders = alignment(sizeof(DOSHeader) + sizeof(stub) + sizeof(NTHeader) + sizeof(SectionHeader) * ntHeader.fileHeader.numSections, ntHeader.optionalHeader.fileAlignment);
+      ntHeader.fileHeader.numSections = 4;
+      ntHeader.optionalHeader.sizeOfHeaders = alignment(sizeof(DOSHeader) + sizeof(stub) + sizeof(NTHeader) + sizeof(SectionHeader) * ntHeader.fileHeader.numSections, ntHeader.optionalHeader.fileAlignment);
 
-    placeTextSection();
-    auto libRes = loadLibs(option);
-    if(!libRes) errors += libRes.err();
-    placeRDataSection();
-    placeDataSection();
-    placeRelocation();
+      placeTextSection();
+      auto libRes = loadLibs(option);
+      if(!libRes) errors += libRes.err();
+      placeRDataSection();
+      placeDataSection();
+      placeRelocation();
 
-    ntHeader.optionalHeader.baseOfCode = textSection.virtualAddress;
+      ntHeader.optionalHeader.baseOfCode = textSection.virtualAddress;
 
-    ntHeader.optionalHeader.sizeOfImage = ntHeader.optionalHeader.addressOfEntryPoint + ntHeader.optionalHeader.sectionAlignment * ntHeader.fileHeader.numSections;
+      ntHeader.optionalHeader.sizeOfImage = ntHeader.optionalHeader.addressOfEntryPoint + ntHeader.optionalHeader.sectionAlignment * ntHeader.fileHeader.numSections;
+    }
 
     auto writeRes = write(option);
     if(!writeRes) errors += writeRes.err();
 
     if(errors.empty()) return ok();
-    return error(errors);
+    return error(std::move(errors));
   }
   void Linker::placeRoutines()
   {
     uint64_t routineAddress = 0;
     for(auto& routine : x64.routines) {
-      routine.second->address = routineAddress;
-      for(auto& op : routine.second->code) {
-        routine.second->codeIndexes[op] = routine.second->nativeCode.size();
-        routine.second->nativeCode << op->bin(x64, routine.second);
+      auto r = routine.second;
+      r->address = routineAddress;
+      r->codeIndexes.reserve(r->code.size() + 1);
+      for(auto op : r->code) {
+        const auto begin = r->nativeCode.size();
+        const auto numRelocs = x64.relocs.size();
+        r->codeIndexes.push_back(begin);
+        r->nativeCode << op->bin(x64, r);
+        // binが追加した再配置情報の位置を、命令内からnativeCode内に直す。
+        for(auto i = numRelocs; i < x64.relocs.size(); ++i) {
+          x64.relocs[i]->op = nullptr;
+          x64.relocs[i]->index += begin;
+          x64.relocs[i]->next = r->nativeCode.size();
+        }
       }
-      routine.second->codeIndexes[nullptr] = routine.second->nativeCode.size();
-      routineAddress += routine.second->nativeCode.size();
+      r->codeIndexes.push_back(r->nativeCode.size());
+      // 以降はnativeCodeだけを使うので、Operationはルーチンごとに解放する。
+      for(auto op : r->code) delete op;
+      r->code = std::vector<Operation*>();
+      routineAddress += r->nativeCode.size();
     }
   }
   void Linker::placeTextSection()
@@ -184,13 +202,16 @@ namespace pickc::windows::x64
                      + alignment(ntHeader.optionalHeader.sizeOfCode, ntHeader.optionalHeader.sectionAlignment)
                      + rdataSectionRawData.size();
 
-    for(auto& text : x64.texts) {
-      text.second = address;
-      address += text.first.size() + 1;
-      rdataSectionRawData.reserve(rdataSectionRawData.size() + text.first.size() + 1);
-      for(auto c : text.first) {
-        rdataSectionRawData.push_back(c);
-      }
+    // 文字列は文字列の順に並べる。Atomの番号の順にすると、同じソースでもプロセスごとに配置が変わってしまう。
+    std::vector<Atom> texts;
+    texts.reserve(x64.texts.size());
+    for(const auto& text : x64.texts) texts.push_back(text.first);
+    std::sort(texts.begin(), texts.end(), [](Atom a, Atom b) { return a.text() < b.text(); });
+    for(auto text : texts) {
+      const auto str = text.text();
+      x64.texts[text] = address;
+      address += str.size() + 1;
+      rdataSectionRawData.insert(rdataSectionRawData.end(), str.begin(), str.end());
       rdataSectionRawData.push_back('\0');
     }
     if(ntHeader.optionalHeader.sizeOfInitData == 0) {
@@ -223,24 +244,15 @@ namespace pickc::windows::x64
   {
     for(auto& reloc : x64.relocs) {
       size_t value;
-      auto index = reloc->routine->codeIndexes[reloc->op] + reloc->index;
+      auto index = reloc->index;
       size_t vaddress = reloc->routine->address + index - ntHeader.optionalHeader.imageBase;
       uint32_t rva = alignment(vaddress - 0x1000, 0x1000);
       switch(reloc->reloc.type) {
         case RelocationType::Function:
           switch(reloc->pos) {
-            case RelocationPosition::Relative: {
-              size_t base;
-              auto itr = std::find(reloc->routine->code.begin(), reloc->routine->code.end(), reloc->op) + 1;
-              if(itr != reloc->routine->code.end()) {
-                base = reloc->routine->codeIndexes[*(std::find(reloc->routine->code.begin(), reloc->routine->code.end(), reloc->op) + 1)];
-              }
-              else {
-                base = reloc->routine->codeIndexes[nullptr];
-              }
-              value = x64.routines[reloc->reloc.fn]->address - (reloc->routine->address + base);
+            case RelocationPosition::Relative:
+              value = x64.routines[reloc->reloc.fn]->address - (reloc->routine->address + reloc->next);
               break;
-            }
             case RelocationPosition::Absolute:
               value = x64.routines[reloc->reloc.fn]->address;
               relocs[rva].base.sizeOfBlock += 2;
@@ -261,20 +273,11 @@ namespace pickc::windows::x64
           relocs[rva].rva.push_back(0x3000 | ((vaddress) & 0x0FFF));
           break;
         case RelocationType::JmpTo:
-          value = reloc->routine->codeIndexes[reloc->routine->code[reloc->routine->bundleIndexes[reloc->reloc.jmpTo]]] - (reloc->routine->codeIndexes[reloc->op] + reloc->index + 4);
+          value = reloc->routine->codeIndexes[reloc->routine->bundleIndexes[reloc->reloc.jmpTo]] - (index + 4);
           break;
-        case RelocationType::Extern: {
-          size_t base;
-          auto itr = std::find(reloc->routine->code.begin(), reloc->routine->code.end(), reloc->op) + 1;
-          if(itr != reloc->routine->code.end()) {
-            base = reloc->routine->codeIndexes[*(std::find(reloc->routine->code.begin(), reloc->routine->code.end(), reloc->op) + 1)];
-          }
-          else {
-            base = reloc->routine->codeIndexes[nullptr];
-          }
-          value = libSymbols[reloc->reloc.ext].address - (reloc->routine->address + base);
+        case RelocationType::Extern:
+          value = libSymbols[reloc->reloc.ext].address - (reloc->routine->address + reloc->next);
           break;
-        }
         default:
           assert(false);
       }
@@ -307,6 +310,14 @@ namespace pickc::windows::x64
       }
     }
 
+    // 書き換えを終えたので、再配置情報と命令の位置は以降使わない。
+    for(auto reloc : x64.relocs) delete reloc;
+    x64.relocs = std::vector<RelocationInfo*>();
+    for(auto& routine : x64.routines) {
+      routine.second->codeIndexes = std::vector<size_t>();
+      routine.second->bundleIndexes = std::vector<size_t>();
+    }
+
     for(auto& reloc : relocs) {
       reloc.second.base.virtualAddress = reloc.first;
       reloc.second.base.sizeOfBlock += sizeof(ImageBaseRelocation);
@@ -330,7 +341,7 @@ namespace pickc::windows::x64
     std::vector<std::string> errors;
 
     for (const auto& lib : option.libraries) {
-      auto res = LibLoader(lib).load();
+      auto res = LibLoader::loadCached(lib);
       if (!res) errors += res.err();
       else libSymbols.merge(res.get());
     }
@@ -428,11 +439,13 @@ namespace pickc::windows::x64
     ntHeader.optionalHeader.sizeOfInitData = rdataSectionRawData.size();
 
     if (errors.empty()) return ok();
-    else return error(errors);
+    else return error(std::move(errors));
   }
   Result<_, std::vector<std::string>> Linker::write(const CompilerOption& option)
   {
     auto path = std::filesystem::path(option.outDir) / (option.out + ".exe");
+    TimeReport::Scope scope("write", path.filename().string());
+    std::filesystem::create_directories(option.outDir);
     std::ofstream stream(path, std::ios::binary);
     if(!stream) {
       return error(std::vector{ "ファイル " +  path.string() + " が開けません。" });
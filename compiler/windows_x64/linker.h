@@ -49,7 +49,8 @@ namespace pickc::windows::x64
     Result<_, std::vector<std::string>> loadLibs(const CompilerOption& option);
     Result<_, std::vector<std::string>> write(const CompilerOption& option);
   public:
-    Linker(const WindowsX64& x64);
+    // Compilerと同じく、x64はコピーせずに受け取る。
+    Linker(WindowsX64&& x64);
     Result<_, std::vector<std::string>> link(const CompilerOption& option);
   };
 }
@@ -53,7 +53,7 @@ namespace pickc::windows::x64
       case OperandType::Relocation:
         assert(fn.reloc.type == RelocationType::Function);
         code.push_back(0xE8);
-        x64.relocs.insert(new RelocationInfo(routine, fn.reloc, this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
+        x64.relocs.push_back(new RelocationInfo(routine, fn.reloc, this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
         code << 0;
         break;
       default:
@@ -7,7 +7,7 @@ namespace pickc::windows::x64
   {
     BinaryVec code;
     code.push_back(0xE9);
-    x64.relocs.insert(new RelocationInfo(routine, Relocation(to), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
+    x64.relocs.push_back(new RelocationInfo(routine, Relocation(to), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
     code << 0;
     return code;
   }
@@ -16,7 +16,7 @@ namespace pickc::windows::x64
     BinaryVec code;
     code.push_back(0x0F);
     code.push_back(0x84);
-    x64.relocs.insert(new RelocationInfo(routine, Relocation(to), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
+    x64.relocs.push_back(new RelocationInfo(routine, Relocation(to), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
     code << 0;
     return code;
   }
@@ -25,7 +25,7 @@ namespace pickc::windows::x64
     BinaryVec code;
     code.push_back(0x0F);
     code.push_back(0x85);
-    x64.relocs.insert(new RelocationInfo(routine, Relocation(to), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
+    x64.relocs.push_back(new RelocationInfo(routine, Relocation(to), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
     code << 0;
     return code;
   }
@@ -34,7 +34,7 @@ namespace pickc::windows::x64
     BinaryVec code;
     code.push_back(0x0F);
     code.push_back(0x8F);
-    x64.relocs.insert(new RelocationInfo(routine, Relocation(to), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
+    x64.relocs.push_back(new RelocationInfo(routine, Relocation(to), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
     code << 0;
     return code;
   }
@@ -43,7 +43,7 @@ namespace pickc::windows::x64
     BinaryVec code;
     code.push_back(0x0F);
     code.push_back(0x8D);
-    x64.relocs.insert(new RelocationInfo(routine, Relocation(to), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
+    x64.relocs.push_back(new RelocationInfo(routine, Relocation(to), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
     code << 0;
     return code;
   }
@@ -52,7 +52,7 @@ namespace pickc::windows::x64
     BinaryVec code;
     code.push_back(0x0F);
     code.push_back(0x8C);
-    x64.relocs.insert(new RelocationInfo(routine, Relocation(to), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
+    x64.relocs.push_back(new RelocationInfo(routine, Relocation(to), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
     code << 0;
     return code;
   }
@@ -61,7 +61,7 @@ namespace pickc::windows::x64
     BinaryVec code;
     code.push_back(0x0F);
     code.push_back(0x8E);
-    x64.relocs.insert(new RelocationInfo(routine, Relocation(to), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
+    x64.relocs.push_back(new RelocationInfo(routine, Relocation(to), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
     code << 0;
     return code;
   }
@@ -71,7 +71,7 @@ namespace pickc::windows::x64
     BinaryVec code;
     code.push_back(0xFF);
     code.push_back(0x25);
-    x64.relocs.insert(new RelocationInfo(routine, Relocation(ext), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
+    x64.relocs.push_back(new RelocationInfo(routine, Relocation(ext), this, code.size(), OperationSize::DWord, RelocationPosition::Relative));
     code << 0;
     return code;
   }
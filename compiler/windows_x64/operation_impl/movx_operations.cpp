@@ -131,7 +131,7 @@ namespace pickc::windows::x64
 
     code << static_cast<uint8_t>(REX | rex) << opcode << operand;
     if(src.type == OperandType::Relocation) {
-      x64.relocs.insert(new RelocationInfo(routine, src.reloc, this, code.size() - 4, OperationSize::DWord, RelocationPosition::Absolute));
+      x64.relocs.push_back(new RelocationInfo(routine, src.reloc, this, code.size() - 4, OperationSize::DWord, RelocationPosition::Absolute));
     }
     return code;
   }
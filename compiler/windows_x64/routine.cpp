@@ -233,5 +233,5 @@ namespace pickc::windows::x64
     }
     type = RelocationType::_NONE;
   }
-  RelocationInfo::RelocationInfo(Routine* routine, const Relocation& reloc, Operation* op, size_t index, OperationSize size, RelocationPosition pos) : routine(routine), reloc(reloc), op(op), index(index), size(size), pos(pos) {}
+  RelocationInfo::RelocationInfo(Routine* routine, const Relocation& reloc, Operation* op, size_t index, OperationSize size, RelocationPosition pos) : routine(routine), reloc(reloc), op(op), index(index), next(0), size(size), pos(pos) {}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define PICKC_WINDOWS_X64_ROUTINE_H_
 
 #include "utils/binary_vec.h"
+#include "utils/interner.h"
 #include "bundler/function.h"
 #include "type.h"
 
@@ -516,10 +517,12 @@ namespace pickc::windows::x64
     Routine* routine;
     // 再配置する要素
     Relocation reloc;
-    // 再配置が必要な命令
+    // 再配置が必要な命令。Linkerが配置した後はnullptr。
     Operation* op;
-    // 再配置をするアドレス
+    // 再配置をするアドレス。命令内の位置で、Linkerが配置した後はnativeCode内の位置。
     size_t index;
+    // 命令の次のnativeCode内の位置。相対値の基準になる。Linkerが配置するときに決める。
+    size_t next;
     // 書き換えサイズ
     OperationSize size;
     // 書き換える値が相対値であるか絶対値であるか。
@@ -529,14 +532,15 @@ namespace pickc::windows::x64
 
   struct Routine
   {
+    // コード生成中だけ使う。生成し終えたらbundler::Functionは解放される。
     bundler::Function* fn;
     std::vector<Operation*> code;
     BinaryVec nativeCode;
     // exeファイル内のこのルーチンが配置されるアドレス。
     uint64_t address;
-    // codeごとのnativeCode内の開始アドレス
-    // これとaddressを組み合わせて再配置を行う。
-    std::unordered_map<Operation*, size_t> codeIndexes;
+    // codeの各要素のnativeCode内の開始アドレス。最後の要素はnativeCodeの大きさ。
+    // これとaddressを組み合わせて再配置を行う。Linkerはこれを作ったらcodeを解放する。
+    std::vector<size_t> codeIndexes;
     // bundle命令とOperationのアドレス対応表
     std::vector<size_t> bundleIndexes;
     // 非volatileなレジスタを保存したり、RSPをアラインメントしたりした時のスタックのずれ
@@ -551,15 +555,15 @@ namespace pickc::windows::x64
     // シンボルと、それに対応するシンボルが配置されるアドレス。
     std::map<pcir::SymbolSection*, uint64_t> symbols;
     // テキストと、それに対応する文字列が配置されるアドレス。
-    std::map<std::string, uint64_t> texts;
+    std::unordered_map<Atom, uint64_t> texts;
     // 関数セクションと、ネイティブ関数
     std::map<pcir::FunctionSection*, Routine*> routines;
     // extern関数の名前対応表
     std::map<pcir::FunctionSection*, std::string> externs;
     // 型テーブル
     TypeTable typeTable;
-    // 再配置テーブル
-    std::unordered_set<RelocationInfo*> relocs;
+    // 再配置テーブル。binで追加した順に並ぶ。
+    std::vector<RelocationInfo*> relocs;
   };
 }
 
@@ -5,9 +5,10 @@
 namespace pickc::windows::x64
 {
   TypeTable::TypeTable() {}
-  const Type& TypeTable::operator[](pcir::TypeSection* pcirType)
+  const Type& TypeTable::operator[](const pcir::TypeSection* pcirType)
   {
-    if(types.find(pcirType) != types.end()) return types[pcirType];
+    const auto id = pcirType->type.id;
+    if(auto itr = types.find(id); itr != types.end()) return itr->second;
     
     if(includes({
       pcir::Types::I8, pcir::Types::U8,
@@ -16,13 +17,13 @@ namespace pickc::windows::x64
       pcir::Types::I64, pcir::Types::U64,
       pcir::Types::Ptr, pcir::Types::Function,
     }, pcirType->types)) {
-      types[pcirType] = Type(pcirType->types);
+      types[id] = Type(pcirType->types);
     }
     else {
       assert(false);
     }
 
-    return types[pcirType];
+    return types[id];
   }
   Type::Type() : type(pcir::Types::_UNDEFINED) {}
   Type::Type(pcir::Types langDefType) : type(langDefType)
@@ -17,12 +17,13 @@ namespace pickc::windows::x64
     Type();
     Type(pcir::Types langDefType);
   };
+  // PCIRの型ごとのレイアウト。PCIRの型はTypeContextで構造ごとに1つにまとめてあるので、TypeIdをキーにする。
   class TypeTable
   {
-    std::unordered_map<pcir::TypeSection*, Type> types;
+    std::unordered_map<pcir::TypeId, Type> types;
   public:
     TypeTable();
-    const Type& operator[](pcir::TypeSection* pcirType);
+    const Type& operator[](const pcir::TypeSection* pcirType);
   };
 }
 